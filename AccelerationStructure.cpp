@@ -0,0 +1,510 @@
+/* @file AccelerationStructure.cpp
+
+    Implementation of hardware acceleration structures of the scene.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <AccelerationStructure.hpp>
+#include <Environment.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+struct AccelerationStructure {
+    VkAccelerationStructureKHR handle;
+    VkBuffer                   buffer;
+    VkDeviceMemory             memory;
+    VkDeviceAddress            address;
+};
+
+// Extension entry points are not exported by the loader, loaded with the first scene of the device.
+static PFN_vkGetAccelerationStructureBuildSizesKHR vulkanGetAccelerationStructureBuildSizes;
+static PFN_vkCreateAccelerationStructureKHR vulkanCreateAccelerationStructure;
+static PFN_vkDestroyAccelerationStructureKHR vulkanDestroyAccelerationStructure;
+static PFN_vkCmdBuildAccelerationStructuresKHR vulkanCmdBuildAccelerationStructures;
+static PFN_vkGetAccelerationStructureDeviceAddressKHR vulkanGetAccelerationStructureDeviceAddress;
+static PFN_vkGetBufferDeviceAddress vulkanGetBufferDeviceAddress;
+
+static VkDeviceSize scratchAlignment;
+// Scenes may be loaded on several threads at once.
+static std::mutex loadFunctionsMutex;
+
+// Structures of one scene.
+struct SceneAccelerationStructures {
+    std::vector<AccelerationStructure>  bottomLevelStructures;
+    std::vector<uint32_t>               geometryFirstSpheres;
+    AccelerationStructure               topLevelStructure;
+    VkBuffer                            instanceBuffer;
+    VkDeviceMemory                      instanceBufferMemory;
+    VkAccelerationStructureInstanceKHR* instanceMapping;
+    uint32_t                            topLevelInstanceCount;
+    VkBuffer                            topLevelScratchBuffer;
+    VkDeviceMemory                      topLevelScratchBufferMemory;
+    VkDeviceAddress                     topLevelScratchAddress;
+};
+
+static uint64_t alignUp(IN uint64_t value, IN uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static VkResult loadFunctions(void)
+{
+    std::lock_guard<std::mutex> lock(loadFunctionsMutex);
+    vulkanGetAccelerationStructureBuildSizes = reinterpret_cast<PFN_vkGetAccelerationStructureBuildSizesKHR>(
+        vkGetDeviceProcAddr(vulkanLogicalDevice, "vkGetAccelerationStructureBuildSizesKHR"));
+    vulkanCreateAccelerationStructure = reinterpret_cast<PFN_vkCreateAccelerationStructureKHR>(
+        vkGetDeviceProcAddr(vulkanLogicalDevice, "vkCreateAccelerationStructureKHR"));
+    vulkanDestroyAccelerationStructure = reinterpret_cast<PFN_vkDestroyAccelerationStructureKHR>(
+        vkGetDeviceProcAddr(vulkanLogicalDevice, "vkDestroyAccelerationStructureKHR"));
+    vulkanCmdBuildAccelerationStructures = reinterpret_cast<PFN_vkCmdBuildAccelerationStructuresKHR>(
+        vkGetDeviceProcAddr(vulkanLogicalDevice, "vkCmdBuildAccelerationStructuresKHR"));
+    vulkanGetAccelerationStructureDeviceAddress = reinterpret_cast<PFN_vkGetAccelerationStructureDeviceAddressKHR>(
+        vkGetDeviceProcAddr(vulkanLogicalDevice, "vkGetAccelerationStructureDeviceAddressKHR"));
+    vulkanGetBufferDeviceAddress = reinterpret_cast<PFN_vkGetBufferDeviceAddress>(
+        vkGetDeviceProcAddr(vulkanLogicalDevice, "vkGetBufferDeviceAddress"));
+    if (vulkanGetAccelerationStructureBuildSizes == nullptr || vulkanCreateAccelerationStructure == nullptr ||
+        vulkanDestroyAccelerationStructure == nullptr || vulkanCmdBuildAccelerationStructures == nullptr ||
+        vulkanGetAccelerationStructureDeviceAddress == nullptr || vulkanGetBufferDeviceAddress == nullptr) {
+        return VK_ERROR_EXTENSION_NOT_PRESENT;
+    }
+
+    VkPhysicalDeviceAccelerationStructurePropertiesKHR accelerationStructureProperties = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_PROPERTIES_KHR
+    };
+    VkPhysicalDeviceProperties2 properties = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+        .pNext = &accelerationStructureProperties
+    };
+    vkGetPhysicalDeviceProperties2(vulkanPhysicalDevice, &properties);
+    scratchAlignment = std::max<VkDeviceSize>(1, accelerationStructureProperties.minAccelerationStructureScratchOffsetAlignment);
+    return VK_SUCCESS;
+}
+
+static VkDeviceAddress getBufferAddress(IN VkBuffer buffer)
+{
+    VkBufferDeviceAddressInfo addressInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO,
+        .buffer = buffer
+    };
+    return vulkanGetBufferDeviceAddress(vulkanLogicalDevice, &addressInfo);
+}
+
+// Scratch memory with room to align its start, the buffer address itself may be less aligned.
+static VkResult createScratchBuffer(IN VkDeviceSize size, OUT VkBuffer* buffer, OUT VkDeviceMemory* memory,
+                                    OUT VkDeviceAddress* address)
+{
+    VkResult result = CreateBuffer(size + scratchAlignment,
+                                   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, buffer, memory);
+    if (result == VK_SUCCESS) {
+        *address = alignUp(getBufferAddress(*buffer), scratchAlignment);
+    }
+    return result;
+}
+
+static VkResult createAccelerationStructure(IN VkAccelerationStructureTypeKHR type, IN VkDeviceSize size,
+                                            OUT AccelerationStructure* structure)
+{
+    VkResult result = CreateBuffer(size,
+        VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_STORAGE_BIT_KHR | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &structure->buffer, &structure->memory);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    VkAccelerationStructureCreateInfoKHR createInfo = {
+        .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_CREATE_INFO_KHR,
+        .buffer = structure->buffer,
+        .offset = 0,
+        .size = size,
+        .type = type
+    };
+    result = vulkanCreateAccelerationStructure(vulkanLogicalDevice, &createInfo, nullptr, &structure->handle);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    VkAccelerationStructureDeviceAddressInfoKHR addressInfo = {
+        .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_DEVICE_ADDRESS_INFO_KHR,
+        .accelerationStructure = structure->handle
+    };
+    structure->address = vulkanGetAccelerationStructureDeviceAddress(vulkanLogicalDevice, &addressInfo);
+    return VK_SUCCESS;
+}
+
+static void destroyAccelerationStructure(IN AccelerationStructure* structure)
+{
+    if (structure->handle != VK_NULL_HANDLE) {
+        vulkanDestroyAccelerationStructure(vulkanLogicalDevice, structure->handle, nullptr);
+    }
+    if (structure->buffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(vulkanLogicalDevice, structure->buffer, nullptr);
+    }
+    if (structure->memory != VK_NULL_HANDLE) {
+        vkFreeMemory(vulkanLogicalDevice, structure->memory, nullptr);
+    }
+    *structure = {};
+}
+
+// Builds are one-offs at load time, recorded into a transient pool & waited for.
+static VkResult beginCommands(OUT VkCommandPool* commandPool, OUT VkCommandBuffer* commandBuffer)
+{
+    VkCommandPoolCreateInfo poolInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+        .queueFamilyIndex = vulkanComputeQueueFamilyIndex,
+    };
+    VkResult result = vkCreateCommandPool(vulkanLogicalDevice, &poolInfo, nullptr, commandPool);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    VkCommandBufferAllocateInfo allocInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .commandPool = *commandPool,
+        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .commandBufferCount = 1
+    };
+    result = vkAllocateCommandBuffers(vulkanLogicalDevice, &allocInfo, commandBuffer);
+    if (result != VK_SUCCESS) {
+        vkDestroyCommandPool(vulkanLogicalDevice, *commandPool, nullptr);
+        return result;
+    }
+    VkCommandBufferBeginInfo beginInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+    };
+    return vkBeginCommandBuffer(*commandBuffer, &beginInfo);
+}
+
+static VkResult submitCommands(IN VkCommandPool commandPool, IN VkCommandBuffer commandBuffer)
+{
+    VkResult result = vkEndCommandBuffer(commandBuffer);
+    if (result == VK_SUCCESS) {
+        VkSubmitInfo submitInfo = {
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .commandBufferCount = 1,
+            .pCommandBuffers = &commandBuffer
+        };
+        result = SubmitVulkanQueueAndWait(vulkanComputeQueue, &submitInfo);
+    }
+    vkDestroyCommandPool(vulkanLogicalDevice, commandPool, nullptr);
+    return result;
+}
+
+static void recordBuildBarrier(IN VkCommandBuffer commandBuffer, IN VkAccessFlags srcAccessMask,
+                               IN VkAccessFlags dstAccessMask, IN VkPipelineStageFlags srcStage,
+                               IN VkPipelineStageFlags dstStage)
+{
+    VkMemoryBarrier barrier = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .srcAccessMask = srcAccessMask,
+        .dstAccessMask = dstAccessMask
+    };
+    vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+}
+
+// Instance transforms share the row-major 3x4 layout of scene files.
+static void writeInstances(IN SceneAccelerationStructures* structures, IN const SceneInstance* instances,
+                           IN uint32_t instanceCount)
+{
+    for (uint32_t iter = 0; iter < instanceCount; ++iter) {
+        VkAccelerationStructureInstanceKHR instance = {};
+        memcpy(&instance.transform, instances[iter].objectToWorld, sizeof(instance.transform));
+        instance.instanceCustomIndex = structures->geometryFirstSpheres[instances[iter].geometry];
+        instance.mask = 0xFF;
+        instance.instanceShaderBindingTableRecordOffset = 0;
+        instance.flags = 0;
+        instance.accelerationStructureReference = structures->bottomLevelStructures[instances[iter].geometry].address;
+        structures->instanceMapping[iter] = instance;
+    }
+}
+
+static void topLevelGeometry(IN const SceneAccelerationStructures* structures,
+                             OUT VkAccelerationStructureGeometryKHR* geometry,
+                             OUT VkAccelerationStructureBuildGeometryInfoKHR* buildInfo)
+{
+    *geometry = {
+        .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR,
+        .geometryType = VK_GEOMETRY_TYPE_INSTANCES_KHR,
+        .geometry = {
+            .instances = {
+                .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_INSTANCES_DATA_KHR,
+                .arrayOfPointers = VK_FALSE,
+                .data = { .deviceAddress = getBufferAddress(structures->instanceBuffer) }
+            }
+        },
+        .flags = VK_GEOMETRY_OPAQUE_BIT_KHR
+    };
+    *buildInfo = {
+        .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR,
+        .type = VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR,
+        .flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR,
+        .mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR,
+        .dstAccelerationStructure = structures->topLevelStructure.handle,
+        .geometryCount = 1,
+        .pGeometries = geometry,
+        .scratchData = { .deviceAddress = structures->topLevelScratchAddress }
+    };
+}
+
+// Rebuild the TLAS from the mapped instances & make it visible to the compute shader.
+static void recordTopLevelBuild(IN const SceneAccelerationStructures* structures, IN VkCommandBuffer commandBuffer)
+{
+    VkAccelerationStructureGeometryKHR geometry;
+    VkAccelerationStructureBuildGeometryInfoKHR buildInfo;
+    topLevelGeometry(structures, &geometry, &buildInfo);
+    VkAccelerationStructureBuildRangeInfoKHR range = {
+        .primitiveCount = structures->topLevelInstanceCount
+    };
+    const VkAccelerationStructureBuildRangeInfoKHR* ranges = &range;
+    vulkanCmdBuildAccelerationStructures(commandBuffer, 1, &buildInfo, &ranges);
+    recordBuildBarrier(commandBuffer, VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+                       VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR,
+                       VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+}
+
+// Instance buffer, TLAS & the scratch kept for rebuilding it.
+static VkResult createTopLevel(IN SceneAccelerationStructures* structures, IN const SceneInstance* instances,
+                               IN uint32_t instanceCount)
+{
+    structures->topLevelInstanceCount = instanceCount;
+    VkDeviceSize instanceSize = instanceCount * sizeof(VkAccelerationStructureInstanceKHR);
+    VkBufferUsageFlags usage = VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR |
+                               VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    VkResult result = CreateBuffer(instanceSize, usage,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        &structures->instanceBuffer, &structures->instanceBufferMemory);
+    if (result == VK_ERROR_FEATURE_NOT_PRESENT) {
+        result = CreateBuffer(instanceSize, usage,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            &structures->instanceBuffer, &structures->instanceBufferMemory);
+    }
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    result = vkMapMemory(vulkanLogicalDevice, structures->instanceBufferMemory, 0, VK_WHOLE_SIZE, 0,
+                         reinterpret_cast<void**>(&structures->instanceMapping));
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    writeInstances(structures, instances, instanceCount);
+
+    VkAccelerationStructureGeometryKHR geometry;
+    VkAccelerationStructureBuildGeometryInfoKHR buildInfo;
+    topLevelGeometry(structures, &geometry, &buildInfo);
+    VkAccelerationStructureBuildSizesInfoKHR sizes = {
+        .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR
+    };
+    vulkanGetAccelerationStructureBuildSizes(vulkanLogicalDevice, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR,
+                                             &buildInfo, &instanceCount, &sizes);
+    result = createAccelerationStructure(VK_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL_KHR, sizes.accelerationStructureSize,
+                                         &structures->topLevelStructure);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    return createScratchBuffer(sizes.buildScratchSize, &structures->topLevelScratchBuffer,
+                               &structures->topLevelScratchBufferMemory, &structures->topLevelScratchAddress);
+}
+
+VkResult BuildSceneAccelerationStructures(IN const SceneView* view, IN const SceneInstance* instances,
+                                          IN uint32_t instanceCount, OUT SceneAccelerationStructures** built)
+{
+    *built = nullptr;
+    if (view->sphereCount >= (1u << 24)) {
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+    VkResult result = loadFunctions();
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    SceneAccelerationStructures* structures = new SceneAccelerationStructures{};
+
+    // Sphere AABBs go straight from the mapped scene into staging, then into a device-local build input.
+    VkDeviceSize aabbSize = view->sphereCount * sizeof(VkAabbPositionsKHR);
+    VkBuffer stagingBuffer = VK_NULL_HANDLE, aabbBuffer = VK_NULL_HANDLE, scratchBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory stagingBufferMemory = VK_NULL_HANDLE, aabbBufferMemory = VK_NULL_HANDLE,
+                   scratchBufferMemory = VK_NULL_HANDLE;
+    result = CreateBuffer(aabbSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                          &stagingBuffer, &stagingBufferMemory);
+    VkAabbPositionsKHR* aabbs = nullptr;
+    if (result == VK_SUCCESS) {
+        result = vkMapMemory(vulkanLogicalDevice, stagingBufferMemory, 0, VK_WHOLE_SIZE, 0,
+                             reinterpret_cast<void**>(&aabbs));
+    }
+    if (result == VK_SUCCESS) {
+        for (uint64_t iter = 0; iter < view->sphereCount; ++iter) {
+            const SceneSphere* sphere = &view->spheres[iter];
+            float radius = fabsf(sphere->radius);
+            aabbs[iter] = {
+                .minX = sphere->center[0] - radius,
+                .minY = sphere->center[1] - radius,
+                .minZ = sphere->center[2] - radius,
+                .maxX = sphere->center[0] + radius,
+                .maxY = sphere->center[1] + radius,
+                .maxZ = sphere->center[2] + radius
+            };
+        }
+        vkUnmapMemory(vulkanLogicalDevice, stagingBufferMemory);
+        result = CreateBuffer(aabbSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                              VK_BUFFER_USAGE_ACCELERATION_STRUCTURE_BUILD_INPUT_READ_ONLY_BIT_KHR |
+                              VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &aabbBuffer, &aabbBufferMemory);
+    }
+
+    // One BLAS per geometry over its range of AABBs, sharing one scratch buffer.
+    uint64_t geometryCount = view->geometries != nullptr ? view->geometryCount : 1;
+    std::vector<VkAccelerationStructureGeometryKHR> geometries(geometryCount);
+    std::vector<VkAccelerationStructureBuildGeometryInfoKHR> buildInfos(geometryCount);
+    std::vector<VkAccelerationStructureBuildRangeInfoKHR> ranges(geometryCount);
+    std::vector<const VkAccelerationStructureBuildRangeInfoKHR*> rangePointers(geometryCount);
+    std::vector<VkDeviceSize> scratchOffsets(geometryCount);
+    VkDeviceSize scratchSize = 0;
+    structures->bottomLevelStructures.assign(geometryCount, AccelerationStructure{});
+    structures->geometryFirstSpheres.resize(geometryCount);
+    for (uint64_t iter = 0; iter < geometryCount && result == VK_SUCCESS; ++iter) {
+        uint32_t firstSphere = view->geometries != nullptr ? view->geometries[iter].firstSphere : 0;
+        uint32_t sphereCount = view->geometries != nullptr ? view->geometries[iter].sphereCount
+                                                           : static_cast<uint32_t>(view->sphereCount);
+        structures->geometryFirstSpheres[iter] = firstSphere;
+        geometries[iter] = {
+            .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR,
+            .geometryType = VK_GEOMETRY_TYPE_AABBS_KHR,
+            .geometry = {
+                .aabbs = {
+                    .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_AABBS_DATA_KHR,
+                    .data = { .deviceAddress = getBufferAddress(aabbBuffer) },
+                    .stride = sizeof(VkAabbPositionsKHR)
+                }
+            },
+            .flags = VK_GEOMETRY_OPAQUE_BIT_KHR
+        };
+        buildInfos[iter] = {
+            .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_GEOMETRY_INFO_KHR,
+            .type = VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR,
+            .flags = VK_BUILD_ACCELERATION_STRUCTURE_PREFER_FAST_TRACE_BIT_KHR,
+            .mode = VK_BUILD_ACCELERATION_STRUCTURE_MODE_BUILD_KHR,
+            .geometryCount = 1,
+            .pGeometries = &geometries[iter]
+        };
+        ranges[iter] = {
+            .primitiveCount = sphereCount,
+            .primitiveOffset = static_cast<uint32_t>(firstSphere * sizeof(VkAabbPositionsKHR))
+        };
+        rangePointers[iter] = &ranges[iter];
+
+        VkAccelerationStructureBuildSizesInfoKHR sizes = {
+            .sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_BUILD_SIZES_INFO_KHR
+        };
+        vulkanGetAccelerationStructureBuildSizes(vulkanLogicalDevice, VK_ACCELERATION_STRUCTURE_BUILD_TYPE_DEVICE_KHR,
+                                                 &buildInfos[iter], &sphereCount, &sizes);
+        result = createAccelerationStructure(VK_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL_KHR,
+                                             sizes.accelerationStructureSize, &structures->bottomLevelStructures[iter]);
+        buildInfos[iter].dstAccelerationStructure = structures->bottomLevelStructures[iter].handle;
+        scratchOffsets[iter] = scratchSize;
+        scratchSize = alignUp(scratchSize + sizes.buildScratchSize, scratchAlignment);
+    }
+    VkDeviceAddress scratchAddress = 0;
+    if (result == VK_SUCCESS) {
+        result = createScratchBuffer(scratchSize, &scratchBuffer, &scratchBufferMemory, &scratchAddress);
+    }
+    for (uint64_t iter = 0; iter < geometryCount; ++iter) {
+        buildInfos[iter].scratchData.deviceAddress = scratchAddress + scratchOffsets[iter];
+    }
+    if (result == VK_SUCCESS) {
+        result = createTopLevel(structures, instances, instanceCount);
+    }
+
+    VkCommandPool commandPool;
+    VkCommandBuffer commandBuffer;
+    if (result == VK_SUCCESS) {
+        result = beginCommands(&commandPool, &commandBuffer);
+    }
+    if (result == VK_SUCCESS) {
+        VkBufferCopy region = {
+            .srcOffset = 0,
+            .dstOffset = 0,
+            .size = aabbSize
+        };
+        vkCmdCopyBuffer(commandBuffer, stagingBuffer, aabbBuffer, 1, &region);
+        recordBuildBarrier(commandBuffer, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR);
+        vulkanCmdBuildAccelerationStructures(commandBuffer, static_cast<uint32_t>(geometryCount), buildInfos.data(),
+                                             rangePointers.data());
+        recordBuildBarrier(commandBuffer, VK_ACCESS_ACCELERATION_STRUCTURE_WRITE_BIT_KHR,
+                           VK_ACCESS_ACCELERATION_STRUCTURE_READ_BIT_KHR,
+                           VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR,
+                           VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR);
+        recordTopLevelBuild(structures, commandBuffer);
+        result = submitCommands(commandPool, commandBuffer);
+    }
+
+    // Built structures do not reference their inputs.
+    if (stagingBuffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(vulkanLogicalDevice, stagingBuffer, nullptr);
+        vkFreeMemory(vulkanLogicalDevice, stagingBufferMemory, nullptr);
+    }
+    if (aabbBuffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(vulkanLogicalDevice, aabbBuffer, nullptr);
+        vkFreeMemory(vulkanLogicalDevice, aabbBufferMemory, nullptr);
+    }
+    if (scratchBuffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(vulkanLogicalDevice, scratchBuffer, nullptr);
+        vkFreeMemory(vulkanLogicalDevice, scratchBufferMemory, nullptr);
+    }
+    if (result != VK_SUCCESS) {
+        DestroySceneAccelerationStructures(structures);
+        return result;
+    }
+    *built = structures;
+    return VK_SUCCESS;
+}
+
+VkResult UpdateSceneAccelerationStructureInstances(IN SceneAccelerationStructures* structures,
+                                                   IN const SceneInstance* instances, IN uint32_t instanceCount)
+{
+    if (structures->topLevelStructure.handle == VK_NULL_HANDLE || instanceCount != structures->topLevelInstanceCount) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    writeInstances(structures, instances, instanceCount);
+    VkCommandPool commandPool;
+    VkCommandBuffer commandBuffer;
+    VkResult result = beginCommands(&commandPool, &commandBuffer);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    recordTopLevelBuild(structures, commandBuffer);
+    return submitCommands(commandPool, commandBuffer);
+}
+
+VkAccelerationStructureKHR GetSceneAccelerationStructure(IN const SceneAccelerationStructures* structures)
+{
+    return structures != nullptr ? structures->topLevelStructure.handle : VK_NULL_HANDLE;
+}
+
+void DestroySceneAccelerationStructures(IN SceneAccelerationStructures* structures)
+{
+    if (structures == nullptr) {
+        return;
+    }
+    destroyAccelerationStructure(&structures->topLevelStructure);
+    for (AccelerationStructure& structure : structures->bottomLevelStructures) {
+        destroyAccelerationStructure(&structure);
+    }
+    if (structures->instanceBuffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(vulkanLogicalDevice, structures->instanceBuffer, nullptr);
+    }
+    if (structures->instanceBufferMemory != VK_NULL_HANDLE) {
+        // Freeing implicitly unmaps.
+        vkFreeMemory(vulkanLogicalDevice, structures->instanceBufferMemory, nullptr);
+    }
+    if (structures->topLevelScratchBuffer != VK_NULL_HANDLE) {
+        vkDestroyBuffer(vulkanLogicalDevice, structures->topLevelScratchBuffer, nullptr);
+    }
+    if (structures->topLevelScratchBufferMemory != VK_NULL_HANDLE) {
+        vkFreeMemory(vulkanLogicalDevice, structures->topLevelScratchBufferMemory, nullptr);
+    }
+    delete structures;
+}
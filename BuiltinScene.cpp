@@ -0,0 +1,987 @@
+/* @file BuiltinScene.cpp
+
+    Book scene of Ray Tracing in One Weekend, formerly hardcoded in globals.glsl.
+    Small spheres are generated by SceneGenerator.cpp, one material per sphere.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <SceneFile.hpp>
+
+const SceneSphere builtinSceneSpheres[] = {
+    {{-10.13f, 0.20f, -10.25f}, 0.2f, 0},
+    {{-10.13f, 0.20f, -9.10f}, 0.2f, 1},
+    {{-10.90f, 0.20f, -8.12f}, 0.2f, 2},
+    {{-10.55f, 0.20f, -7.21f}, 0.2f, 3},
+    {{-10.57f, 0.20f, -6.33f}, 0.2f, 4},
+    {{-10.87f, 0.20f, -5.21f}, 0.2f, 5},
+    {{-10.89f, 0.20f, -4.40f}, 0.2f, 6},
+    {{-10.29f, 0.20f, -3.56f}, 0.2f, 7},
+    {{-10.59f, 0.20f, -2.42f}, 0.2f, 8},
+    {{-10.26f, 0.20f, -1.26f}, 0.2f, 9},
+    {{-10.79f, 0.20f, -0.31f}, 0.2f, 10},
+    {{-10.18f, 0.20f, 0.20f}, 0.2f, 11},
+    {{-10.46f, 0.20f, 1.71f}, 0.2f, 12},
+    {{-10.53f, 0.20f, 2.19f}, 0.2f, 13},
+    {{-10.64f, 0.20f, 3.14f}, 0.2f, 14},
+    {{-10.65f, 0.20f, 4.65f}, 0.2f, 15},
+    {{-10.69f, 0.20f, 5.42f}, 0.2f, 16},
+    {{-10.50f, 0.20f, 6.45f}, 0.2f, 17},
+    {{-10.55f, 0.20f, 7.54f}, 0.2f, 18},
+    {{-10.23f, 0.20f, 8.31f}, 0.2f, 19},
+    {{-10.75f, 0.20f, 9.09f}, 0.2f, 20},
+    {{-10.44f, 0.20f, 10.07f}, 0.2f, 21},
+    {{-9.66f, 0.20f, -10.88f}, 0.2f, 22},
+    {{-9.26f, 0.20f, -9.12f}, 0.2f, 23},
+    {{-9.97f, 0.20f, -8.69f}, 0.2f, 24},
+    {{-9.56f, 0.20f, -7.80f}, 0.2f, 25},
+    {{-9.71f, 0.20f, -6.95f}, 0.2f, 26},
+    {{-9.66f, 0.20f, -5.56f}, 0.2f, 27},
+    {{-9.69f, 0.20f, -4.65f}, 0.2f, 28},
+    {{-9.56f, 0.20f, -3.18f}, 0.2f, 29},
+    {{-9.51f, 0.20f, -2.17f}, 0.2f, 30},
+    {{-9.65f, 0.20f, -1.99f}, 0.2f, 31},
+    {{-9.20f, 0.20f, -0.82f}, 0.2f, 32},
+    {{-9.42f, 0.20f, 0.08f}, 0.2f, 33},
+    {{-9.85f, 0.20f, 1.64f}, 0.2f, 34},
+    {{-9.71f, 0.20f, 2.75f}, 0.2f, 35},
+    {{-9.31f, 0.20f, 3.16f}, 0.2f, 36},
+    {{-9.91f, 0.20f, 4.22f}, 0.2f, 37},
+    {{-9.83f, 0.20f, 5.20f}, 0.2f, 38},
+    {{-9.31f, 0.20f, 6.14f}, 0.2f, 39},
+    {{-9.88f, 0.20f, 7.30f}, 0.2f, 40},
+    {{-9.74f, 0.20f, 8.01f}, 0.2f, 41},
+    {{-9.62f, 0.20f, 9.46f}, 0.2f, 42},
+    {{-9.45f, 0.20f, 10.43f}, 0.2f, 43},
+    {{-8.72f, 0.20f, -10.46f}, 0.2f, 44},
+    {{-8.52f, 0.20f, -9.14f}, 0.2f, 45},
+    {{-8.37f, 0.20f, -8.79f}, 0.2f, 46},
+    {{-8.61f, 0.20f, -7.57f}, 0.2f, 47},
+    {{-8.83f, 0.20f, -6.44f}, 0.2f, 48},
+    {{-8.54f, 0.20f, -5.84f}, 0.2f, 49},
+    {{-8.82f, 0.20f, -4.56f}, 0.2f, 50},
+    {{-8.85f, 0.20f, -3.15f}, 0.2f, 51},
+    {{-8.72f, 0.20f, -2.50f}, 0.2f, 52},
+    {{-8.21f, 0.20f, -1.72f}, 0.2f, 53},
+    {{-8.59f, 0.20f, -0.99f}, 0.2f, 54},
+    {{-8.84f, 0.20f, 0.21f}, 0.2f, 55},
+    {{-8.98f, 0.20f, 1.43f}, 0.2f, 56},
+    {{-8.19f, 0.20f, 2.48f}, 0.2f, 57},
+    {{-8.18f, 0.20f, 3.18f}, 0.2f, 58},
+    {{-8.96f, 0.20f, 4.53f}, 0.2f, 59},
+    {{-8.12f, 0.20f, 5.70f}, 0.2f, 60},
+    {{-8.71f, 0.20f, 6.27f}, 0.2f, 61},
+    {{-8.33f, 0.20f, 7.30f}, 0.2f, 62},
+    {{-8.94f, 0.20f, 8.06f}, 0.2f, 63},
+    {{-8.13f, 0.20f, 9.11f}, 0.2f, 64},
+    {{-8.45f, 0.20f, 10.05f}, 0.2f, 65},
+    {{-7.80f, 0.20f, -10.29f}, 0.2f, 66},
+    {{-7.75f, 0.20f, -9.41f}, 0.2f, 67},
+    {{-7.60f, 0.20f, -9.00f}, 0.2f, 68},
+    {{-7.63f, 0.20f, -7.56f}, 0.2f, 69},
+    {{-7.70f, 0.20f, -6.32f}, 0.2f, 70},
+    {{-7.17f, 0.20f, -5.92f}, 0.2f, 71},
+    {{-7.30f, 0.20f, -4.99f}, 0.2f, 72},
+    {{-7.12f, 0.20f, -3.89f}, 0.2f, 73},
+    {{-7.99f, 0.20f, -2.61f}, 0.2f, 74},
+    {{-7.68f, 0.20f, -1.23f}, 0.2f, 75},
+    {{-7.32f, 0.20f, -0.12f}, 0.2f, 76},
+    {{-7.22f, 0.20f, 0.69f}, 0.2f, 77},
+    {{-7.25f, 0.20f, 1.30f}, 0.2f, 78},
+    {{-7.68f, 0.20f, 2.68f}, 0.2f, 79},
+    {{-7.12f, 0.20f, 3.05f}, 0.2f, 80},
+    {{-7.45f, 0.20f, 4.66f}, 0.2f, 81},
+    {{-7.22f, 0.20f, 5.28f}, 0.2f, 82},
+    {{-7.86f, 0.20f, 6.60f}, 0.2f, 83},
+    {{-7.58f, 0.20f, 7.71f}, 0.2f, 84},
+    {{-7.91f, 0.20f, 8.53f}, 0.2f, 85},
+    {{-7.17f, 0.20f, 9.20f}, 0.2f, 86},
+    {{-7.58f, 0.20f, 10.39f}, 0.2f, 87},
+    {{-6.60f, 0.20f, -10.42f}, 0.2f, 88},
+    {{-6.52f, 0.20f, -9.93f}, 0.2f, 89},
+    {{-6.39f, 0.20f, -8.59f}, 0.2f, 90},
+    {{-6.25f, 0.20f, -7.98f}, 0.2f, 91},
+    {{-6.30f, 0.20f, -6.63f}, 0.2f, 92},
+    {{-6.75f, 0.20f, -5.92f}, 0.2f, 93},
+    {{-6.49f, 0.20f, -4.47f}, 0.2f, 94},
+    {{-6.50f, 0.20f, -3.46f}, 0.2f, 95},
+    {{-6.88f, 0.20f, -2.63f}, 0.2f, 96},
+    {{-6.80f, 0.20f, -1.94f}, 0.2f, 97},
+    {{-6.38f, 0.20f, -0.38f}, 0.2f, 98},
+    {{-6.11f, 0.20f, 0.33f}, 0.2f, 99},
+    {{-6.68f, 0.20f, 1.85f}, 0.2f, 100},
+    {{-6.40f, 0.20f, 2.06f}, 0.2f, 101},
+    {{-6.85f, 0.20f, 3.33f}, 0.2f, 102},
+    {{-6.91f, 0.20f, 4.41f}, 0.2f, 103},
+    {{-6.81f, 0.20f, 5.59f}, 0.2f, 104},
+    {{-6.63f, 0.20f, 6.80f}, 0.2f, 105},
+    {{-6.67f, 0.20f, 7.30f}, 0.2f, 106},
+    {{-6.56f, 0.20f, 8.64f}, 0.2f, 107},
+    {{-6.87f, 0.20f, 9.33f}, 0.2f, 108},
+    {{-6.96f, 0.20f, 10.30f}, 0.2f, 109},
+    {{-5.88f, 0.20f, -10.77f}, 0.2f, 110},
+    {{-5.30f, 0.20f, -9.71f}, 0.2f, 111},
+    {{-5.36f, 0.20f, -8.11f}, 0.2f, 112},
+    {{-5.47f, 0.20f, -7.35f}, 0.2f, 113},
+    {{-5.55f, 0.20f, -6.50f}, 0.2f, 114},
+    {{-5.40f, 0.20f, -5.69f}, 0.2f, 115},
+    {{-5.36f, 0.20f, -4.70f}, 0.2f, 116},
+    {{-5.55f, 0.20f, -3.30f}, 0.2f, 117},
+    {{-5.82f, 0.20f, -2.64f}, 0.2f, 118},
+    {{-5.88f, 0.20f, -1.25f}, 0.2f, 119},
+    {{-5.39f, 0.20f, -0.80f}, 0.2f, 120},
+    {{-5.21f, 0.20f, 0.86f}, 0.2f, 121},
+    {{-5.91f, 0.20f, 1.61f}, 0.2f, 122},
+    {{-5.92f, 0.20f, 2.19f}, 0.2f, 123},
+    {{-5.24f, 0.20f, 3.52f}, 0.2f, 124},
+    {{-5.25f, 0.20f, 4.18f}, 0.2f, 125},
+    {{-5.80f, 0.20f, 5.83f}, 0.2f, 126},
+    {{-5.69f, 0.20f, 6.49f}, 0.2f, 127},
+    {{-5.25f, 0.20f, 7.55f}, 0.2f, 128},
+    {{-5.34f, 0.20f, 8.49f}, 0.2f, 129},
+    {{-5.67f, 0.20f, 9.03f}, 0.2f, 130},
+    {{-5.67f, 0.20f, 10.47f}, 0.2f, 131},
+    {{-4.92f, 0.20f, -10.70f}, 0.2f, 132},
+    {{-4.23f, 0.20f, -9.14f}, 0.2f, 133},
+    {{-4.52f, 0.20f, -8.26f}, 0.2f, 134},
+    {{-4.34f, 0.20f, -7.29f}, 0.2f, 135},
+    {{-4.44f, 0.20f, -6.91f}, 0.2f, 136},
+    {{-4.12f, 0.20f, -5.95f}, 0.2f, 137},
+    {{-4.49f, 0.20f, -4.17f}, 0.2f, 138},
+    {{-4.49f, 0.20f, -3.46f}, 0.2f, 139},
+    {{-4.52f, 0.20f, -2.52f}, 0.2f, 140},
+    {{-4.70f, 0.20f, -1.34f}, 0.2f, 141},
+    {{-4.40f, 0.20f, -0.65f}, 0.2f, 142},
+    {{-4.90f, 0.20f, 0.44f}, 0.2f, 143},
+    {{-4.98f, 0.20f, 1.06f}, 0.2f, 144},
+    {{-4.78f, 0.20f, 2.82f}, 0.2f, 145},
+    {{-4.49f, 0.20f, 3.40f}, 0.2f, 146},
+    {{-4.20f, 0.20f, 4.57f}, 0.2f, 147},
+    {{-5.00f, 0.20f, 5.02f}, 0.2f, 148},
+    {{-4.25f, 0.20f, 6.77f}, 0.2f, 149},
+    {{-4.39f, 0.20f, 7.42f}, 0.2f, 150},
+    {{-4.61f, 0.20f, 8.51f}, 0.2f, 151},
+    {{-4.20f, 0.20f, 9.30f}, 0.2f, 152},
+    {{-4.74f, 0.20f, 10.28f}, 0.2f, 153},
+    {{-3.96f, 0.20f, -10.16f}, 0.2f, 154},
+    {{-3.52f, 0.20f, -9.51f}, 0.2f, 155},
+    {{-3.62f, 0.20f, -8.17f}, 0.2f, 156},
+    {{-3.76f, 0.20f, -7.26f}, 0.2f, 157},
+    {{-3.17f, 0.20f, -6.96f}, 0.2f, 158},
+    {{-3.89f, 0.20f, -5.66f}, 0.2f, 159},
+    {{-3.64f, 0.20f, -4.72f}, 0.2f, 160},
+    {{-3.27f, 0.20f, -3.96f}, 0.2f, 161},
+    {{-3.39f, 0.20f, -2.22f}, 0.2f, 162},
+    {{-3.57f, 0.20f, -1.18f}, 0.2f, 163},
+    {{-3.36f, 0.20f, -0.19f}, 0.2f, 164},
+    {{-3.64f, 0.20f, 0.85f}, 0.2f, 165},
+    {{-3.88f, 0.20f, 1.07f}, 0.2f, 166},
+    {{-3.41f, 0.20f, 2.74f}, 0.2f, 167},
+    {{-3.40f, 0.20f, 3.70f}, 0.2f, 168},
+    {{-3.27f, 0.20f, 4.57f}, 0.2f, 169},
+    {{-3.88f, 0.20f, 5.19f}, 0.2f, 170},
+    {{-3.59f, 0.20f, 6.59f}, 0.2f, 171},
+    {{-3.46f, 0.20f, 7.58f}, 0.2f, 172},
+    {{-3.46f, 0.20f, 8.17f}, 0.2f, 173},
+    {{-3.75f, 0.20f, 9.52f}, 0.2f, 174},
+    {{-3.74f, 0.20f, 10.27f}, 0.2f, 175},
+    {{-2.53f, 0.20f, -10.28f}, 0.2f, 176},
+    {{-2.71f, 0.20f, -9.52f}, 0.2f, 177},
+    {{-2.77f, 0.20f, -8.11f}, 0.2f, 178},
+    {{-2.89f, 0.20f, -7.24f}, 0.2f, 179},
+    {{-2.70f, 0.20f, -6.14f}, 0.2f, 180},
+    {{-2.81f, 0.20f, -5.82f}, 0.2f, 181},
+    {{-2.55f, 0.20f, -4.72f}, 0.2f, 182},
+    {{-2.70f, 0.20f, -3.63f}, 0.2f, 183},
+    {{-2.34f, 0.20f, -2.35f}, 0.2f, 184},
+    {{-2.33f, 0.20f, -1.58f}, 0.2f, 185},
+    {{-2.34f, 0.20f, -0.19f}, 0.2f, 186},
+    {{-2.88f, 0.20f, 0.19f}, 0.2f, 187},
+    {{-2.26f, 0.20f, 1.77f}, 0.2f, 188},
+    {{-2.35f, 0.20f, 2.48f}, 0.2f, 189},
+    {{-2.59f, 0.20f, 3.36f}, 0.2f, 190},
+    {{-2.69f, 0.20f, 4.63f}, 0.2f, 191},
+    {{-2.99f, 0.20f, 5.67f}, 0.2f, 192},
+    {{-2.65f, 0.20f, 6.14f}, 0.2f, 193},
+    {{-2.59f, 0.20f, 7.45f}, 0.2f, 194},
+    {{-2.93f, 0.20f, 8.64f}, 0.2f, 195},
+    {{-2.45f, 0.20f, 9.30f}, 0.2f, 196},
+    {{-2.90f, 0.20f, 10.09f}, 0.2f, 197},
+    {{-1.60f, 0.20f, -10.53f}, 0.2f, 198},
+    {{-1.63f, 0.20f, -9.15f}, 0.2f, 199},
+    {{-1.16f, 0.20f, -8.63f}, 0.2f, 200},
+    {{-1.35f, 0.20f, -7.91f}, 0.2f, 201},
+    {{-1.70f, 0.20f, -6.59f}, 0.2f, 202},
+    {{-1.62f, 0.20f, -5.61f}, 0.2f, 203},
+    {{-1.93f, 0.20f, -4.18f}, 0.2f, 204},
+    {{-1.97f, 0.20f, -3.92f}, 0.2f, 205},
+    {{-1.14f, 0.20f, -2.29f}, 0.2f, 206},
+    {{-1.49f, 0.20f, -1.99f}, 0.2f, 207},
+    {{-1.75f, 0.20f, -0.33f}, 0.2f, 208},
+    {{-1.74f, 0.20f, 0.89f}, 0.2f, 209},
+    {{-1.69f, 0.20f, 1.79f}, 0.2f, 210},
+    {{-1.73f, 0.20f, 2.01f}, 0.2f, 211},
+    {{-1.23f, 0.20f, 3.09f}, 0.2f, 212},
+    {{-1.30f, 0.20f, 4.49f}, 0.2f, 213},
+    {{-1.66f, 0.20f, 5.79f}, 0.2f, 214},
+    {{-1.17f, 0.20f, 6.86f}, 0.2f, 215},
+    {{-1.99f, 0.20f, 7.81f}, 0.2f, 216},
+    {{-1.91f, 0.20f, 8.54f}, 0.2f, 217},
+    {{-1.97f, 0.20f, 9.23f}, 0.2f, 218},
+    {{-1.77f, 0.20f, 10.40f}, 0.2f, 219},
+    {{-0.20f, 0.20f, -10.75f}, 0.2f, 220},
+    {{-0.35f, 0.20f, -9.29f}, 0.2f, 221},
+    {{-0.55f, 0.20f, -8.25f}, 0.2f, 222},
+    {{-0.49f, 0.20f, -7.72f}, 0.2f, 223},
+    {{-0.47f, 0.20f, -6.43f}, 0.2f, 224},
+    {{-0.89f, 0.20f, -5.35f}, 0.2f, 225},
+    {{-0.66f, 0.20f, -4.95f}, 0.2f, 226},
+    {{-0.19f, 0.20f, -3.14f}, 0.2f, 227},
+    {{-0.66f, 0.20f, -2.87f}, 0.2f, 228},
+    {{-0.33f, 0.20f, -1.39f}, 0.2f, 229},
+    {{-0.72f, 0.20f, -0.75f}, 0.2f, 230},
+    {{-0.85f, 0.20f, 0.88f}, 0.2f, 231},
+    {{-0.59f, 0.20f, 1.27f}, 0.2f, 232},
+    {{-0.13f, 0.20f, 2.73f}, 0.2f, 233},
+    {{-0.83f, 0.20f, 3.38f}, 0.2f, 234},
+    {{-0.10f, 0.20f, 4.90f}, 0.2f, 235},
+    {{-0.79f, 0.20f, 5.09f}, 0.2f, 236},
+    {{-0.27f, 0.20f, 6.48f}, 0.2f, 237},
+    {{-0.63f, 0.20f, 7.71f}, 0.2f, 238},
+    {{-0.40f, 0.20f, 8.06f}, 0.2f, 239},
+    {{-0.99f, 0.20f, 9.55f}, 0.2f, 240},
+    {{-0.62f, 0.20f, 10.47f}, 0.2f, 241},
+    {{0.33f, 0.20f, -10.13f}, 0.2f, 242},
+    {{0.46f, 0.20f, -9.54f}, 0.2f, 243},
+    {{0.08f, 0.20f, -8.87f}, 0.2f, 244},
+    {{0.49f, 0.20f, -7.75f}, 0.2f, 245},
+    {{0.29f, 0.20f, -6.48f}, 0.2f, 246},
+    {{0.55f, 0.20f, -5.24f}, 0.2f, 247},
+    {{0.87f, 0.20f, -4.97f}, 0.2f, 248},
+    {{0.64f, 0.20f, -3.66f}, 0.2f, 249},
+    {{0.36f, 0.20f, -2.93f}, 0.2f, 250},
+    {{0.49f, 0.20f, -1.93f}, 0.2f, 251},
+    {{0.43f, 0.20f, -0.74f}, 0.2f, 252},
+    {{0.54f, 0.20f, 0.40f}, 0.2f, 253},
+    {{0.09f, 0.20f, 1.13f}, 0.2f, 254},
+    {{0.42f, 0.20f, 2.39f}, 0.2f, 255},
+    {{0.51f, 0.20f, 3.49f}, 0.2f, 256},
+    {{0.70f, 0.20f, 4.87f}, 0.2f, 257},
+    {{0.81f, 0.20f, 5.57f}, 0.2f, 258},
+    {{0.56f, 0.20f, 6.72f}, 0.2f, 259},
+    {{0.14f, 0.20f, 7.67f}, 0.2f, 260},
+    {{0.35f, 0.20f, 8.33f}, 0.2f, 261},
+    {{0.39f, 0.20f, 9.07f}, 0.2f, 262},
+    {{0.19f, 0.20f, 10.61f}, 0.2f, 263},
+    {{1.61f, 0.20f, -10.41f}, 0.2f, 264},
+    {{1.85f, 0.20f, -9.45f}, 0.2f, 265},
+    {{1.58f, 0.20f, -9.00f}, 0.2f, 266},
+    {{1.08f, 0.20f, -7.44f}, 0.2f, 267},
+    {{1.53f, 0.20f, -6.87f}, 0.2f, 268},
+    {{1.28f, 0.20f, -5.12f}, 0.2f, 269},
+    {{1.40f, 0.20f, -4.79f}, 0.2f, 270},
+    {{1.70f, 0.20f, -3.91f}, 0.2f, 271},
+    {{1.63f, 0.20f, -2.31f}, 0.2f, 272},
+    {{1.84f, 0.20f, -1.50f}, 0.2f, 273},
+    {{1.02f, 0.20f, -0.24f}, 0.2f, 274},
+    {{1.05f, 0.20f, 0.23f}, 0.2f, 275},
+    {{1.47f, 0.20f, 1.26f}, 0.2f, 276},
+    {{1.74f, 0.20f, 2.74f}, 0.2f, 277},
+    {{1.53f, 0.20f, 3.26f}, 0.2f, 278},
+    {{1.88f, 0.20f, 4.34f}, 0.2f, 279},
+    {{1.33f, 0.20f, 5.36f}, 0.2f, 280},
+    {{1.26f, 0.20f, 6.67f}, 0.2f, 281},
+    {{1.26f, 0.20f, 7.68f}, 0.2f, 282},
+    {{1.89f, 0.20f, 8.62f}, 0.2f, 283},
+    {{1.08f, 0.20f, 9.33f}, 0.2f, 284},
+    {{1.24f, 0.20f, 10.42f}, 0.2f, 285},
+    {{2.04f, 0.20f, -10.88f}, 0.2f, 286},
+    {{2.36f, 0.20f, -9.18f}, 0.2f, 287},
+    {{2.56f, 0.20f, -8.71f}, 0.2f, 288},
+    {{2.38f, 0.20f, -7.80f}, 0.2f, 289},
+    {{2.73f, 0.20f, -6.38f}, 0.2f, 290},
+    {{2.76f, 0.20f, -5.60f}, 0.2f, 291},
+    {{2.22f, 0.20f, -4.12f}, 0.2f, 292},
+    {{2.25f, 0.20f, -3.15f}, 0.2f, 293},
+    {{2.58f, 0.20f, -2.39f}, 0.2f, 294},
+    {{2.46f, 0.20f, -1.46f}, 0.2f, 295},
+    {{2.10f, 0.20f, -0.32f}, 0.2f, 296},
+    {{2.70f, 0.20f, 0.29f}, 0.2f, 297},
+    {{2.77f, 0.20f, 1.06f}, 0.2f, 298},
+    {{2.32f, 0.20f, 2.18f}, 0.2f, 299},
+    {{2.43f, 0.20f, 3.32f}, 0.2f, 300},
+    {{2.07f, 0.20f, 4.05f}, 0.2f, 301},
+    {{2.47f, 0.20f, 5.52f}, 0.2f, 302},
+    {{2.40f, 0.20f, 6.23f}, 0.2f, 303},
+    {{2.87f, 0.20f, 7.20f}, 0.2f, 304},
+    {{2.73f, 0.20f, 8.23f}, 0.2f, 305},
+    {{2.62f, 0.20f, 9.24f}, 0.2f, 306},
+    {{2.08f, 0.20f, 10.69f}, 0.2f, 307},
+    {{3.49f, 0.20f, -10.89f}, 0.2f, 308},
+    {{3.30f, 0.20f, -9.91f}, 0.2f, 309},
+    {{3.48f, 0.20f, -8.94f}, 0.2f, 310},
+    {{3.02f, 0.20f, -7.25f}, 0.2f, 311},
+    {{3.70f, 0.20f, -6.55f}, 0.2f, 312},
+    {{3.27f, 0.20f, -5.74f}, 0.2f, 313},
+    {{3.89f, 0.20f, -4.56f}, 0.2f, 314},
+    {{3.87f, 0.20f, -3.21f}, 0.2f, 315},
+    {{3.63f, 0.20f, -2.28f}, 0.2f, 316},
+    {{3.51f, 0.20f, -1.33f}, 0.2f, 317},
+    {{3.17f, 0.20f, 1.75f}, 0.2f, 318},
+    {{3.20f, 0.20f, 2.78f}, 0.2f, 319},
+    {{3.48f, 0.20f, 3.79f}, 0.2f, 320},
+    {{3.05f, 0.20f, 4.61f}, 0.2f, 321},
+    {{3.69f, 0.20f, 5.37f}, 0.2f, 322},
+    {{3.39f, 0.20f, 6.50f}, 0.2f, 323},
+    {{3.33f, 0.20f, 7.75f}, 0.2f, 324},
+    {{3.85f, 0.20f, 8.76f}, 0.2f, 325},
+    {{3.21f, 0.20f, 9.04f}, 0.2f, 326},
+    {{3.20f, 0.20f, 10.83f}, 0.2f, 327},
+    {{4.34f, 0.20f, -10.91f}, 0.2f, 328},
+    {{4.23f, 0.20f, -9.28f}, 0.2f, 329},
+    {{4.65f, 0.20f, -8.72f}, 0.2f, 330},
+    {{4.30f, 0.20f, -7.70f}, 0.2f, 331},
+    {{4.19f, 0.20f, -6.20f}, 0.2f, 332},
+    {{4.81f, 0.20f, -5.37f}, 0.2f, 333},
+    {{4.54f, 0.20f, -4.29f}, 0.2f, 334},
+    {{4.21f, 0.20f, -3.89f}, 0.2f, 335},
+    {{4.37f, 0.20f, -2.72f}, 0.2f, 336},
+    {{4.33f, 0.20f, -1.16f}, 0.2f, 337},
+    {{4.84f, 0.20f, 0.68f}, 0.2f, 338},
+    {{4.17f, 0.20f, 1.27f}, 0.2f, 339},
+    {{4.63f, 0.20f, 2.70f}, 0.2f, 340},
+    {{4.27f, 0.20f, 3.60f}, 0.2f, 341},
+    {{4.27f, 0.20f, 4.20f}, 0.2f, 342},
+    {{4.21f, 0.20f, 5.52f}, 0.2f, 343},
+    {{4.10f, 0.20f, 6.75f}, 0.2f, 344},
+    {{4.21f, 0.20f, 7.34f}, 0.2f, 345},
+    {{4.02f, 0.20f, 8.45f}, 0.2f, 346},
+    {{4.21f, 0.20f, 9.35f}, 0.2f, 347},
+    {{4.82f, 0.20f, 10.19f}, 0.2f, 348},
+    {{5.31f, 0.20f, -10.45f}, 0.2f, 349},
+    {{5.78f, 0.20f, -9.84f}, 0.2f, 350},
+    {{5.12f, 0.20f, -8.71f}, 0.2f, 351},
+    {{5.41f, 0.20f, -7.82f}, 0.2f, 352},
+    {{5.07f, 0.20f, -6.53f}, 0.2f, 353},
+    {{5.89f, 0.20f, -5.95f}, 0.2f, 354},
+    {{5.15f, 0.20f, -4.88f}, 0.2f, 355},
+    {{5.27f, 0.20f, -3.46f}, 0.2f, 356},
+    {{5.46f, 0.20f, -2.83f}, 0.2f, 357},
+    {{5.70f, 0.20f, -1.77f}, 0.2f, 358},
+    {{5.43f, 0.20f, -0.70f}, 0.2f, 359},
+    {{5.72f, 0.20f, 0.39f}, 0.2f, 360},
+    {{5.09f, 0.20f, 1.72f}, 0.2f, 361},
+    {{5.54f, 0.20f, 2.48f}, 0.2f, 362},
+    {{5.51f, 0.20f, 3.39f}, 0.2f, 363},
+    {{5.19f, 0.20f, 4.02f}, 0.2f, 364},
+    {{5.37f, 0.20f, 5.20f}, 0.2f, 365},
+    {{5.06f, 0.20f, 6.78f}, 0.2f, 366},
+    {{5.36f, 0.20f, 7.62f}, 0.2f, 367},
+    {{5.86f, 0.20f, 8.33f}, 0.2f, 368},
+    {{5.41f, 0.20f, 9.20f}, 0.2f, 369},
+    {{5.38f, 0.20f, 10.19f}, 0.2f, 370},
+    {{6.85f, 0.20f, -10.13f}, 0.2f, 371},
+    {{6.18f, 0.20f, -9.44f}, 0.2f, 372},
+    {{6.72f, 0.20f, -8.64f}, 0.2f, 373},
+    {{6.53f, 0.20f, -7.99f}, 0.2f, 374},
+    {{6.27f, 0.20f, -6.77f}, 0.2f, 375},
+    {{6.72f, 0.20f, -5.87f}, 0.2f, 376},
+    {{6.07f, 0.20f, -4.92f}, 0.2f, 377},
+    {{6.51f, 0.20f, -3.65f}, 0.2f, 378},
+    {{6.32f, 0.20f, -2.99f}, 0.2f, 379},
+    {{6.18f, 0.20f, -1.85f}, 0.2f, 380},
+    {{6.78f, 0.20f, -0.86f}, 0.2f, 381},
+    {{6.58f, 0.20f, 0.86f}, 0.2f, 382},
+    {{6.30f, 0.20f, 1.54f}, 0.2f, 383},
+    {{6.48f, 0.20f, 2.50f}, 0.2f, 384},
+    {{6.10f, 0.20f, 3.54f}, 0.2f, 385},
+    {{6.07f, 0.20f, 4.63f}, 0.2f, 386},
+    {{6.10f, 0.20f, 5.05f}, 0.2f, 387},
+    {{6.59f, 0.20f, 6.73f}, 0.2f, 388},
+    {{6.88f, 0.20f, 7.13f}, 0.2f, 389},
+    {{6.30f, 0.20f, 8.20f}, 0.2f, 390},
+    {{6.05f, 0.20f, 9.05f}, 0.2f, 391},
+    {{6.70f, 0.20f, 10.53f}, 0.2f, 392},
+    {{7.58f, 0.20f, -10.59f}, 0.2f, 393},
+    {{7.82f, 0.20f, -9.15f}, 0.2f, 394},
+    {{7.30f, 0.20f, -8.27f}, 0.2f, 395},
+    {{7.82f, 0.20f, -7.14f}, 0.2f, 396},
+    {{7.12f, 0.20f, -6.31f}, 0.2f, 397},
+    {{7.18f, 0.20f, -5.22f}, 0.2f, 398},
+    {{7.21f, 0.20f, -4.91f}, 0.2f, 399},
+    {{7.77f, 0.20f, -3.16f}, 0.2f, 400},
+    {{7.70f, 0.20f, -2.26f}, 0.2f, 401},
+    {{7.28f, 0.20f, -1.85f}, 0.2f, 402},
+    {{7.22f, 0.20f, -0.70f}, 0.2f, 403},
+    {{7.59f, 0.20f, 0.19f}, 0.2f, 404},
+    {{7.34f, 0.20f, 1.24f}, 0.2f, 405},
+    {{7.81f, 0.20f, 2.39f}, 0.2f, 406},
+    {{7.04f, 0.20f, 3.56f}, 0.2f, 407},
+    {{7.57f, 0.20f, 4.58f}, 0.2f, 408},
+    {{7.46f, 0.20f, 5.54f}, 0.2f, 409},
+    {{7.40f, 0.20f, 6.38f}, 0.2f, 410},
+    {{7.13f, 0.20f, 7.37f}, 0.2f, 411},
+    {{7.73f, 0.20f, 8.15f}, 0.2f, 412},
+    {{7.33f, 0.20f, 9.31f}, 0.2f, 413},
+    {{7.04f, 0.20f, 10.57f}, 0.2f, 414},
+    {{8.21f, 0.20f, -10.64f}, 0.2f, 415},
+    {{8.80f, 0.20f, -9.93f}, 0.2f, 416},
+    {{8.03f, 0.20f, -8.85f}, 0.2f, 417},
+    {{8.51f, 0.20f, -7.59f}, 0.2f, 418},
+    {{8.03f, 0.20f, -6.98f}, 0.2f, 419},
+    {{8.42f, 0.20f, -5.69f}, 0.2f, 420},
+    {{8.42f, 0.20f, -4.39f}, 0.2f, 421},
+    {{8.43f, 0.20f, -3.43f}, 0.2f, 422},
+    {{8.12f, 0.20f, -3.00f}, 0.2f, 423},
+    {{8.68f, 0.20f, -1.15f}, 0.2f, 424},
+    {{8.24f, 0.20f, -0.15f}, 0.2f, 425},
+    {{8.41f, 0.20f, 0.53f}, 0.2f, 426},
+    {{8.23f, 0.20f, 1.67f}, 0.2f, 427},
+    {{8.76f, 0.20f, 2.66f}, 0.2f, 428},
+    {{8.20f, 0.20f, 3.70f}, 0.2f, 429},
+    {{8.20f, 0.20f, 4.84f}, 0.2f, 430},
+    {{8.00f, 0.20f, 5.33f}, 0.2f, 431},
+    {{8.54f, 0.20f, 6.42f}, 0.2f, 432},
+    {{8.69f, 0.20f, 7.80f}, 0.2f, 433},
+    {{8.83f, 0.20f, 8.22f}, 0.2f, 434},
+    {{8.17f, 0.20f, 9.13f}, 0.2f, 435},
+    {{8.16f, 0.20f, 10.58f}, 0.2f, 436},
+    {{9.18f, 0.20f, -10.39f}, 0.2f, 437},
+    {{9.41f, 0.20f, -9.56f}, 0.2f, 438},
+    {{9.67f, 0.20f, -8.10f}, 0.2f, 439},
+    {{9.19f, 0.20f, -7.41f}, 0.2f, 440},
+    {{9.51f, 0.20f, -6.75f}, 0.2f, 441},
+    {{9.08f, 0.20f, -5.41f}, 0.2f, 442},
+    {{9.16f, 0.20f, -4.29f}, 0.2f, 443},
+    {{9.25f, 0.20f, -3.11f}, 0.2f, 444},
+    {{9.31f, 0.20f, -2.35f}, 0.2f, 445},
+    {{9.79f, 0.20f, -1.23f}, 0.2f, 446},
+    {{9.89f, 0.20f, -0.25f}, 0.2f, 447},
+    {{9.30f, 0.20f, 0.78f}, 0.2f, 448},
+    {{9.04f, 0.20f, 1.18f}, 0.2f, 449},
+    {{9.12f, 0.20f, 2.42f}, 0.2f, 450},
+    {{9.75f, 0.20f, 3.79f}, 0.2f, 451},
+    {{9.65f, 0.20f, 4.15f}, 0.2f, 452},
+    {{9.78f, 0.20f, 5.84f}, 0.2f, 453},
+    {{9.16f, 0.20f, 6.67f}, 0.2f, 454},
+    {{9.80f, 0.20f, 7.49f}, 0.2f, 455},
+    {{9.20f, 0.20f, 8.08f}, 0.2f, 456},
+    {{9.11f, 0.20f, 9.34f}, 0.2f, 457},
+    {{9.42f, 0.20f, 10.87f}, 0.2f, 458},
+    {{10.88f, 0.20f, -10.33f}, 0.2f, 459},
+    {{10.29f, 0.20f, -9.96f}, 0.2f, 460},
+    {{10.01f, 0.20f, -8.44f}, 0.2f, 461},
+    {{10.85f, 0.20f, -7.86f}, 0.2f, 462},
+    {{10.15f, 0.20f, -6.15f}, 0.2f, 463},
+    {{10.01f, 0.20f, -5.18f}, 0.2f, 464},
+    {{10.33f, 0.20f, -4.42f}, 0.2f, 465},
+    {{10.25f, 0.20f, -3.22f}, 0.2f, 466},
+    {{10.46f, 0.20f, -2.62f}, 0.2f, 467},
+    {{10.45f, 0.20f, -1.36f}, 0.2f, 468},
+    {{10.63f, 0.20f, -0.59f}, 0.2f, 469},
+    {{10.12f, 0.20f, 0.64f}, 0.2f, 470},
+    {{10.39f, 0.20f, 1.30f}, 0.2f, 471},
+    {{10.82f, 0.20f, 2.46f}, 0.2f, 472},
+    {{10.78f, 0.20f, 3.44f}, 0.2f, 473},
+    {{10.20f, 0.20f, 4.73f}, 0.2f, 474},
+    {{10.73f, 0.20f, 5.41f}, 0.2f, 475},
+    {{10.36f, 0.20f, 6.43f}, 0.2f, 476},
+    {{10.34f, 0.20f, 7.48f}, 0.2f, 477},
+    {{10.13f, 0.20f, 8.04f}, 0.2f, 478},
+    {{10.16f, 0.20f, 9.03f}, 0.2f, 479},
+    {{10.80f, 0.20f, 10.66f}, 0.2f, 480},
+    {{0.0f, 1.0f, 0.0f}, 1.0f, 481},
+    {{-4.0f, 1.0f, 0.0f}, 1.0f, 482},
+    {{4.0f, 1.0f, 0.0f}, 1.0f, 483},
+    {{0.0f, -1000.0f, 0.0f}, 1000.0f, 484},
+};
+const uint32_t builtinSceneSphereCount = sizeof(builtinSceneSpheres) / sizeof(builtinSceneSpheres[0]);
+
+const SceneMaterial builtinSceneMaterials[] = {
+    {{0.19f, 0.55f, 0.31f}, SCENE_MATERIAL_LAMBERTIAN, 0.22f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.11f, 0.00f, 0.30f}, SCENE_MATERIAL_LAMBERTIAN, 0.80f},
+    {{0.68f, 0.21f, 0.36f}, SCENE_MATERIAL_LAMBERTIAN, 0.80f},
+    {{0.80f, 0.30f, 0.17f}, SCENE_MATERIAL_LAMBERTIAN, 0.42f},
+    {{0.76f, 0.13f, 0.82f}, SCENE_MATERIAL_LAMBERTIAN, 0.99f},
+    {{0.41f, 0.04f, 0.05f}, SCENE_MATERIAL_LAMBERTIAN, 0.21f},
+    {{0.00f, 0.71f, 0.81f}, SCENE_MATERIAL_LAMBERTIAN, 0.92f},
+    {{0.81f, 0.88f, 0.57f}, SCENE_MATERIAL_LAMBERTIAN, 0.77f},
+    {{0.58f, 0.42f, 0.41f}, SCENE_MATERIAL_LAMBERTIAN, 0.94f},
+    {{0.30f, 0.33f, 0.99f}, SCENE_MATERIAL_LAMBERTIAN, 0.81f},
+    {{0.99f, 0.78f, 0.96f}, SCENE_MATERIAL_LAMBERTIAN, 0.85f},
+    {{0.39f, 0.68f, 0.70f}, SCENE_MATERIAL_LAMBERTIAN, 0.73f},
+    {{0.36f, 0.59f, 0.35f}, SCENE_MATERIAL_LAMBERTIAN, 0.40f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.62f, 0.86f, 0.44f}, SCENE_MATERIAL_LAMBERTIAN, 0.93f},
+    {{0.72f, 0.99f, 0.72f}, SCENE_MATERIAL_LAMBERTIAN, 0.53f},
+    {{0.45f, 0.55f, 0.46f}, SCENE_MATERIAL_METAL, 0.50f},
+    {{0.36f, 0.98f, 0.03f}, SCENE_MATERIAL_METAL, 0.98f},
+    {{0.13f, 0.75f, 0.66f}, SCENE_MATERIAL_LAMBERTIAN, 0.05f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.44f, 0.53f, 0.68f}, SCENE_MATERIAL_METAL, 0.01f},
+    {{0.50f, 0.25f, 0.04f}, SCENE_MATERIAL_LAMBERTIAN, 0.76f},
+    {{0.54f, 0.25f, 0.05f}, SCENE_MATERIAL_METAL, 0.30f},
+    {{0.27f, 0.21f, 0.88f}, SCENE_MATERIAL_METAL, 0.16f},
+    {{0.44f, 0.76f, 0.65f}, SCENE_MATERIAL_LAMBERTIAN, 0.95f},
+    {{0.26f, 0.81f, 0.91f}, SCENE_MATERIAL_LAMBERTIAN, 0.40f},
+    {{0.81f, 0.62f, 0.29f}, SCENE_MATERIAL_LAMBERTIAN, 0.72f},
+    {{0.46f, 0.38f, 0.67f}, SCENE_MATERIAL_LAMBERTIAN, 0.82f},
+    {{0.87f, 0.39f, 0.11f}, SCENE_MATERIAL_LAMBERTIAN, 0.76f},
+    {{0.99f, 0.95f, 0.20f}, SCENE_MATERIAL_LAMBERTIAN, 0.14f},
+    {{0.02f, 0.54f, 0.48f}, SCENE_MATERIAL_LAMBERTIAN, 0.78f},
+    {{0.80f, 0.24f, 0.15f}, SCENE_MATERIAL_METAL, 0.44f},
+    {{0.35f, 0.73f, 0.58f}, SCENE_MATERIAL_LAMBERTIAN, 0.63f},
+    {{0.80f, 0.04f, 0.45f}, SCENE_MATERIAL_LAMBERTIAN, 0.13f},
+    {{0.11f, 0.78f, 0.42f}, SCENE_MATERIAL_LAMBERTIAN, 0.66f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.21f, 0.97f, 0.28f}, SCENE_MATERIAL_LAMBERTIAN, 0.34f},
+    {{0.30f, 0.17f, 0.41f}, SCENE_MATERIAL_LAMBERTIAN, 0.40f},
+    {{0.58f, 0.02f, 0.96f}, SCENE_MATERIAL_LAMBERTIAN, 0.88f},
+    {{0.50f, 0.23f, 0.85f}, SCENE_MATERIAL_LAMBERTIAN, 0.29f},
+    {{0.72f, 0.36f, 0.38f}, SCENE_MATERIAL_LAMBERTIAN, 0.10f},
+    {{0.26f, 0.40f, 0.25f}, SCENE_MATERIAL_LAMBERTIAN, 0.69f},
+    {{0.33f, 0.25f, 0.51f}, SCENE_MATERIAL_METAL, 0.49f},
+    {{0.32f, 0.75f, 0.23f}, SCENE_MATERIAL_LAMBERTIAN, 0.96f},
+    {{0.29f, 0.67f, 0.93f}, SCENE_MATERIAL_LAMBERTIAN, 0.87f},
+    {{0.14f, 0.94f, 0.42f}, SCENE_MATERIAL_LAMBERTIAN, 0.20f},
+    {{0.08f, 0.91f, 0.51f}, SCENE_MATERIAL_LAMBERTIAN, 0.24f},
+    {{0.91f, 0.86f, 0.28f}, SCENE_MATERIAL_LAMBERTIAN, 0.40f},
+    {{0.29f, 0.82f, 0.36f}, SCENE_MATERIAL_LAMBERTIAN, 0.82f},
+    {{0.88f, 0.62f, 0.20f}, SCENE_MATERIAL_LAMBERTIAN, 0.86f},
+    {{0.13f, 0.60f, 0.56f}, SCENE_MATERIAL_LAMBERTIAN, 0.97f},
+    {{0.82f, 0.24f, 0.74f}, SCENE_MATERIAL_LAMBERTIAN, 0.12f},
+    {{0.13f, 0.06f, 0.74f}, SCENE_MATERIAL_LAMBERTIAN, 0.67f},
+    {{0.34f, 0.50f, 0.53f}, SCENE_MATERIAL_LAMBERTIAN, 0.63f},
+    {{0.71f, 0.88f, 0.73f}, SCENE_MATERIAL_LAMBERTIAN, 0.60f},
+    {{0.47f, 0.08f, 0.65f}, SCENE_MATERIAL_LAMBERTIAN, 0.75f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.33f, 0.33f, 0.85f}, SCENE_MATERIAL_LAMBERTIAN, 0.37f},
+    {{0.43f, 0.49f, 0.49f}, SCENE_MATERIAL_LAMBERTIAN, 0.77f},
+    {{0.63f, 0.07f, 0.63f}, SCENE_MATERIAL_LAMBERTIAN, 0.75f},
+    {{0.72f, 0.52f, 0.99f}, SCENE_MATERIAL_LAMBERTIAN, 0.63f},
+    {{0.46f, 0.08f, 0.68f}, SCENE_MATERIAL_LAMBERTIAN, 0.68f},
+    {{0.13f, 0.48f, 0.26f}, SCENE_MATERIAL_LAMBERTIAN, 0.53f},
+    {{0.42f, 0.72f, 0.27f}, SCENE_MATERIAL_LAMBERTIAN, 0.76f},
+    {{0.92f, 0.94f, 0.90f}, SCENE_MATERIAL_LAMBERTIAN, 0.49f},
+    {{0.71f, 0.23f, 0.51f}, SCENE_MATERIAL_LAMBERTIAN, 0.45f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.25f, 0.22f, 0.30f}, SCENE_MATERIAL_LAMBERTIAN, 0.97f},
+    {{0.28f, 0.72f, 0.54f}, SCENE_MATERIAL_METAL, 0.22f},
+    {{0.88f, 0.01f, 0.86f}, SCENE_MATERIAL_LAMBERTIAN, 0.80f},
+    {{0.95f, 0.90f, 0.98f}, SCENE_MATERIAL_LAMBERTIAN, 0.91f},
+    {{0.33f, 0.65f, 0.59f}, SCENE_MATERIAL_METAL, 0.03f},
+    {{0.07f, 0.71f, 0.66f}, SCENE_MATERIAL_LAMBERTIAN, 0.53f},
+    {{0.99f, 0.31f, 0.34f}, SCENE_MATERIAL_LAMBERTIAN, 0.07f},
+    {{0.96f, 0.22f, 0.84f}, SCENE_MATERIAL_LAMBERTIAN, 0.75f},
+    {{0.83f, 0.20f, 0.35f}, SCENE_MATERIAL_LAMBERTIAN, 0.19f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.49f, 0.21f, 0.12f}, SCENE_MATERIAL_LAMBERTIAN, 0.55f},
+    {{0.83f, 0.85f, 0.98f}, SCENE_MATERIAL_LAMBERTIAN, 0.77f},
+    {{0.03f, 0.08f, 0.87f}, SCENE_MATERIAL_LAMBERTIAN, 0.84f},
+    {{0.92f, 0.27f, 0.95f}, SCENE_MATERIAL_LAMBERTIAN, 0.66f},
+    {{0.94f, 0.56f, 0.81f}, SCENE_MATERIAL_LAMBERTIAN, 0.23f},
+    {{0.07f, 0.18f, 0.63f}, SCENE_MATERIAL_LAMBERTIAN, 0.97f},
+    {{0.01f, 0.90f, 0.65f}, SCENE_MATERIAL_LAMBERTIAN, 0.88f},
+    {{0.69f, 0.33f, 0.23f}, SCENE_MATERIAL_LAMBERTIAN, 0.99f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.64f, 0.15f, 0.84f}, SCENE_MATERIAL_METAL, 0.56f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.26f, 0.19f, 0.74f}, SCENE_MATERIAL_LAMBERTIAN, 0.78f},
+    {{0.32f, 0.10f, 0.19f}, SCENE_MATERIAL_LAMBERTIAN, 0.18f},
+    {{0.30f, 0.16f, 0.14f}, SCENE_MATERIAL_LAMBERTIAN, 0.24f},
+    {{0.95f, 0.29f, 0.02f}, SCENE_MATERIAL_LAMBERTIAN, 0.44f},
+    {{0.59f, 0.80f, 0.75f}, SCENE_MATERIAL_LAMBERTIAN, 0.20f},
+    {{0.26f, 0.02f, 0.90f}, SCENE_MATERIAL_LAMBERTIAN, 0.19f},
+    {{0.04f, 0.40f, 0.93f}, SCENE_MATERIAL_LAMBERTIAN, 0.10f},
+    {{0.45f, 0.85f, 0.06f}, SCENE_MATERIAL_LAMBERTIAN, 0.61f},
+    {{0.74f, 0.95f, 0.98f}, SCENE_MATERIAL_LAMBERTIAN, 0.64f},
+    {{0.74f, 0.44f, 0.99f}, SCENE_MATERIAL_LAMBERTIAN, 0.23f},
+    {{0.85f, 0.40f, 0.84f}, SCENE_MATERIAL_LAMBERTIAN, 0.73f},
+    {{0.84f, 0.72f, 0.40f}, SCENE_MATERIAL_LAMBERTIAN, 0.38f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.40f, 0.40f, 0.15f}, SCENE_MATERIAL_LAMBERTIAN, 0.11f},
+    {{0.73f, 0.75f, 0.47f}, SCENE_MATERIAL_LAMBERTIAN, 0.92f},
+    {{0.81f, 0.42f, 0.06f}, SCENE_MATERIAL_LAMBERTIAN, 0.05f},
+    {{0.68f, 0.07f, 0.03f}, SCENE_MATERIAL_LAMBERTIAN, 0.20f},
+    {{0.06f, 0.09f, 0.18f}, SCENE_MATERIAL_LAMBERTIAN, 0.80f},
+    {{0.38f, 0.07f, 0.40f}, SCENE_MATERIAL_LAMBERTIAN, 0.91f},
+    {{0.53f, 1.00f, 0.87f}, SCENE_MATERIAL_METAL, 0.42f},
+    {{0.43f, 0.33f, 0.18f}, SCENE_MATERIAL_LAMBERTIAN, 0.86f},
+    {{0.58f, 0.28f, 0.95f}, SCENE_MATERIAL_LAMBERTIAN, 0.09f},
+    {{0.39f, 0.01f, 0.19f}, SCENE_MATERIAL_LAMBERTIAN, 0.37f},
+    {{0.88f, 0.93f, 0.62f}, SCENE_MATERIAL_METAL, 0.64f},
+    {{0.46f, 0.30f, 0.64f}, SCENE_MATERIAL_LAMBERTIAN, 0.06f},
+    {{0.90f, 0.93f, 0.71f}, SCENE_MATERIAL_METAL, 0.13f},
+    {{0.43f, 0.64f, 0.27f}, SCENE_MATERIAL_LAMBERTIAN, 0.66f},
+    {{0.60f, 0.92f, 0.24f}, SCENE_MATERIAL_METAL, 0.65f},
+    {{0.24f, 0.28f, 0.40f}, SCENE_MATERIAL_LAMBERTIAN, 0.89f},
+    {{0.50f, 0.78f, 0.61f}, SCENE_MATERIAL_LAMBERTIAN, 0.77f},
+    {{0.98f, 0.13f, 0.50f}, SCENE_MATERIAL_LAMBERTIAN, 0.25f},
+    {{0.84f, 0.91f, 0.67f}, SCENE_MATERIAL_LAMBERTIAN, 0.45f},
+    {{0.84f, 0.42f, 0.97f}, SCENE_MATERIAL_LAMBERTIAN, 0.71f},
+    {{0.08f, 0.78f, 0.22f}, SCENE_MATERIAL_LAMBERTIAN, 0.70f},
+    {{0.92f, 0.17f, 0.98f}, SCENE_MATERIAL_LAMBERTIAN, 0.52f},
+    {{0.20f, 0.01f, 0.01f}, SCENE_MATERIAL_LAMBERTIAN, 0.39f},
+    {{0.28f, 0.29f, 0.08f}, SCENE_MATERIAL_LAMBERTIAN, 0.78f},
+    {{0.05f, 0.33f, 0.08f}, SCENE_MATERIAL_LAMBERTIAN, 0.28f},
+    {{0.90f, 0.86f, 1.00f}, SCENE_MATERIAL_LAMBERTIAN, 0.53f},
+    {{0.76f, 0.75f, 0.65f}, SCENE_MATERIAL_LAMBERTIAN, 0.99f},
+    {{0.97f, 0.59f, 0.49f}, SCENE_MATERIAL_LAMBERTIAN, 0.78f},
+    {{0.44f, 0.48f, 0.78f}, SCENE_MATERIAL_LAMBERTIAN, 0.08f},
+    {{0.47f, 0.02f, 0.60f}, SCENE_MATERIAL_LAMBERTIAN, 0.12f},
+    {{0.04f, 0.48f, 0.52f}, SCENE_MATERIAL_LAMBERTIAN, 0.21f},
+    {{0.92f, 0.82f, 0.86f}, SCENE_MATERIAL_METAL, 0.98f},
+    {{0.86f, 0.02f, 0.17f}, SCENE_MATERIAL_LAMBERTIAN, 0.91f},
+    {{0.92f, 0.56f, 0.59f}, SCENE_MATERIAL_METAL, 0.73f},
+    {{0.57f, 0.32f, 0.29f}, SCENE_MATERIAL_LAMBERTIAN, 0.73f},
+    {{0.97f, 0.32f, 0.64f}, SCENE_MATERIAL_LAMBERTIAN, 0.79f},
+    {{0.98f, 0.12f, 0.96f}, SCENE_MATERIAL_LAMBERTIAN, 0.45f},
+    {{0.51f, 0.06f, 0.41f}, SCENE_MATERIAL_LAMBERTIAN, 0.76f},
+    {{0.37f, 0.33f, 0.47f}, SCENE_MATERIAL_LAMBERTIAN, 0.68f},
+    {{0.10f, 0.91f, 0.06f}, SCENE_MATERIAL_LAMBERTIAN, 0.66f},
+    {{0.41f, 0.21f, 0.46f}, SCENE_MATERIAL_LAMBERTIAN, 0.50f},
+    {{0.26f, 0.33f, 0.29f}, SCENE_MATERIAL_LAMBERTIAN, 0.36f},
+    {{0.60f, 0.74f, 0.90f}, SCENE_MATERIAL_LAMBERTIAN, 0.13f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.35f, 0.56f, 0.04f}, SCENE_MATERIAL_METAL, 0.35f},
+    {{0.68f, 0.66f, 0.34f}, SCENE_MATERIAL_LAMBERTIAN, 0.86f},
+    {{0.63f, 0.20f, 1.00f}, SCENE_MATERIAL_LAMBERTIAN, 0.39f},
+    {{0.42f, 0.65f, 0.28f}, SCENE_MATERIAL_METAL, 0.92f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.28f, 0.98f, 0.92f}, SCENE_MATERIAL_METAL, 0.32f},
+    {{0.12f, 0.52f, 0.31f}, SCENE_MATERIAL_LAMBERTIAN, 0.11f},
+    {{0.49f, 0.26f, 0.41f}, SCENE_MATERIAL_LAMBERTIAN, 0.33f},
+    {{0.21f, 0.45f, 0.78f}, SCENE_MATERIAL_LAMBERTIAN, 0.98f},
+    {{0.15f, 0.65f, 0.08f}, SCENE_MATERIAL_LAMBERTIAN, 0.67f},
+    {{0.44f, 0.80f, 0.62f}, SCENE_MATERIAL_LAMBERTIAN, 0.64f},
+    {{0.97f, 0.80f, 0.71f}, SCENE_MATERIAL_LAMBERTIAN, 0.06f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.89f, 0.87f, 0.01f}, SCENE_MATERIAL_LAMBERTIAN, 0.44f},
+    {{0.29f, 0.55f, 0.22f}, SCENE_MATERIAL_LAMBERTIAN, 0.40f},
+    {{0.43f, 0.23f, 0.31f}, SCENE_MATERIAL_LAMBERTIAN, 0.62f},
+    {{0.64f, 0.17f, 0.80f}, SCENE_MATERIAL_LAMBERTIAN, 0.58f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.89f, 0.23f, 0.53f}, SCENE_MATERIAL_LAMBERTIAN, 0.43f},
+    {{0.89f, 0.21f, 0.45f}, SCENE_MATERIAL_LAMBERTIAN, 0.03f},
+    {{0.84f, 0.81f, 0.87f}, SCENE_MATERIAL_METAL, 0.51f},
+    {{0.68f, 0.82f, 0.28f}, SCENE_MATERIAL_METAL, 0.90f},
+    {{0.65f, 0.57f, 0.20f}, SCENE_MATERIAL_LAMBERTIAN, 0.75f},
+    {{0.95f, 0.03f, 0.73f}, SCENE_MATERIAL_LAMBERTIAN, 0.79f},
+    {{0.70f, 0.01f, 0.89f}, SCENE_MATERIAL_LAMBERTIAN, 0.87f},
+    {{0.53f, 0.44f, 0.57f}, SCENE_MATERIAL_METAL, 0.73f},
+    {{0.25f, 0.13f, 0.68f}, SCENE_MATERIAL_LAMBERTIAN, 0.77f},
+    {{0.90f, 0.30f, 0.34f}, SCENE_MATERIAL_LAMBERTIAN, 0.77f},
+    {{0.14f, 0.19f, 0.70f}, SCENE_MATERIAL_LAMBERTIAN, 0.16f},
+    {{0.17f, 0.74f, 0.14f}, SCENE_MATERIAL_LAMBERTIAN, 0.00f},
+    {{0.46f, 0.87f, 0.70f}, SCENE_MATERIAL_LAMBERTIAN, 0.09f},
+    {{0.38f, 0.25f, 0.56f}, SCENE_MATERIAL_METAL, 0.18f},
+    {{0.38f, 0.73f, 0.44f}, SCENE_MATERIAL_LAMBERTIAN, 0.42f},
+    {{0.79f, 1.00f, 0.79f}, SCENE_MATERIAL_LAMBERTIAN, 0.48f},
+    {{0.69f, 0.97f, 0.61f}, SCENE_MATERIAL_LAMBERTIAN, 0.05f},
+    {{0.02f, 0.72f, 0.87f}, SCENE_MATERIAL_LAMBERTIAN, 0.86f},
+    {{0.80f, 0.13f, 0.71f}, SCENE_MATERIAL_LAMBERTIAN, 0.73f},
+    {{0.67f, 0.78f, 0.31f}, SCENE_MATERIAL_LAMBERTIAN, 0.62f},
+    {{0.11f, 0.10f, 0.64f}, SCENE_MATERIAL_LAMBERTIAN, 0.64f},
+    {{0.97f, 0.55f, 0.80f}, SCENE_MATERIAL_LAMBERTIAN, 0.09f},
+    {{0.11f, 0.91f, 0.40f}, SCENE_MATERIAL_LAMBERTIAN, 0.79f},
+    {{0.96f, 0.60f, 0.09f}, SCENE_MATERIAL_LAMBERTIAN, 0.07f},
+    {{0.77f, 0.16f, 0.67f}, SCENE_MATERIAL_LAMBERTIAN, 0.47f},
+    {{0.46f, 0.14f, 0.58f}, SCENE_MATERIAL_LAMBERTIAN, 0.21f},
+    {{0.30f, 0.78f, 0.56f}, SCENE_MATERIAL_LAMBERTIAN, 0.62f},
+    {{0.13f, 0.32f, 0.39f}, SCENE_MATERIAL_METAL, 0.02f},
+    {{0.79f, 0.97f, 0.28f}, SCENE_MATERIAL_LAMBERTIAN, 1.00f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.15f, 0.85f, 0.60f}, SCENE_MATERIAL_METAL, 0.12f},
+    {{0.99f, 0.86f, 0.00f}, SCENE_MATERIAL_LAMBERTIAN, 0.72f},
+    {{0.16f, 0.12f, 0.03f}, SCENE_MATERIAL_LAMBERTIAN, 0.91f},
+    {{0.86f, 0.17f, 0.50f}, SCENE_MATERIAL_LAMBERTIAN, 0.94f},
+    {{0.85f, 0.31f, 0.15f}, SCENE_MATERIAL_LAMBERTIAN, 0.32f},
+    {{0.87f, 0.64f, 0.36f}, SCENE_MATERIAL_LAMBERTIAN, 0.77f},
+    {{0.34f, 0.35f, 0.81f}, SCENE_MATERIAL_METAL, 0.44f},
+    {{0.06f, 0.90f, 0.41f}, SCENE_MATERIAL_LAMBERTIAN, 0.01f},
+    {{0.25f, 0.10f, 0.22f}, SCENE_MATERIAL_METAL, 0.42f},
+    {{0.75f, 0.01f, 0.15f}, SCENE_MATERIAL_LAMBERTIAN, 0.44f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.25f, 0.85f, 0.15f}, SCENE_MATERIAL_LAMBERTIAN, 0.12f},
+    {{0.42f, 0.59f, 0.69f}, SCENE_MATERIAL_METAL, 0.35f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.42f, 0.51f, 0.81f}, SCENE_MATERIAL_LAMBERTIAN, 0.93f},
+    {{0.71f, 0.06f, 0.78f}, SCENE_MATERIAL_LAMBERTIAN, 0.27f},
+    {{0.60f, 0.18f, 0.44f}, SCENE_MATERIAL_LAMBERTIAN, 0.72f},
+    {{0.44f, 0.75f, 0.70f}, SCENE_MATERIAL_LAMBERTIAN, 0.64f},
+    {{0.31f, 0.58f, 0.48f}, SCENE_MATERIAL_METAL, 0.31f},
+    {{0.74f, 0.56f, 0.72f}, SCENE_MATERIAL_LAMBERTIAN, 0.29f},
+    {{0.50f, 0.95f, 0.65f}, SCENE_MATERIAL_LAMBERTIAN, 0.33f},
+    {{0.95f, 0.39f, 0.46f}, SCENE_MATERIAL_LAMBERTIAN, 0.38f},
+    {{0.00f, 0.02f, 0.94f}, SCENE_MATERIAL_LAMBERTIAN, 0.67f},
+    {{0.62f, 0.61f, 0.17f}, SCENE_MATERIAL_LAMBERTIAN, 0.39f},
+    {{0.11f, 0.95f, 0.72f}, SCENE_MATERIAL_LAMBERTIAN, 0.34f},
+    {{0.35f, 0.24f, 0.80f}, SCENE_MATERIAL_METAL, 0.76f},
+    {{0.46f, 0.15f, 0.29f}, SCENE_MATERIAL_LAMBERTIAN, 0.78f},
+    {{0.54f, 0.38f, 0.02f}, SCENE_MATERIAL_LAMBERTIAN, 0.28f},
+    {{0.37f, 0.56f, 0.91f}, SCENE_MATERIAL_LAMBERTIAN, 0.84f},
+    {{0.53f, 0.94f, 0.07f}, SCENE_MATERIAL_LAMBERTIAN, 0.08f},
+    {{0.74f, 0.61f, 0.83f}, SCENE_MATERIAL_LAMBERTIAN, 0.99f},
+    {{0.67f, 0.67f, 0.72f}, SCENE_MATERIAL_LAMBERTIAN, 0.68f},
+    {{0.65f, 0.53f, 0.11f}, SCENE_MATERIAL_LAMBERTIAN, 0.62f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.82f, 0.72f, 0.53f}, SCENE_MATERIAL_METAL, 0.68f},
+    {{0.84f, 0.02f, 0.58f}, SCENE_MATERIAL_LAMBERTIAN, 0.92f},
+    {{0.38f, 0.17f, 0.48f}, SCENE_MATERIAL_LAMBERTIAN, 0.01f},
+    {{0.68f, 0.41f, 0.73f}, SCENE_MATERIAL_LAMBERTIAN, 0.87f},
+    {{0.59f, 0.08f, 0.15f}, SCENE_MATERIAL_LAMBERTIAN, 0.69f},
+    {{0.11f, 0.47f, 0.70f}, SCENE_MATERIAL_LAMBERTIAN, 0.10f},
+    {{0.55f, 0.08f, 0.39f}, SCENE_MATERIAL_LAMBERTIAN, 0.11f},
+    {{0.78f, 0.72f, 0.60f}, SCENE_MATERIAL_LAMBERTIAN, 0.64f},
+    {{0.95f, 0.34f, 0.70f}, SCENE_MATERIAL_LAMBERTIAN, 0.38f},
+    {{0.74f, 0.38f, 0.30f}, SCENE_MATERIAL_METAL, 0.12f},
+    {{0.87f, 0.04f, 0.69f}, SCENE_MATERIAL_LAMBERTIAN, 0.90f},
+    {{0.37f, 0.80f, 0.45f}, SCENE_MATERIAL_LAMBERTIAN, 0.82f},
+    {{0.53f, 0.21f, 0.63f}, SCENE_MATERIAL_LAMBERTIAN, 0.33f},
+    {{0.33f, 0.47f, 0.83f}, SCENE_MATERIAL_LAMBERTIAN, 0.50f},
+    {{0.55f, 0.60f, 0.50f}, SCENE_MATERIAL_METAL, 0.34f},
+    {{0.83f, 0.80f, 0.17f}, SCENE_MATERIAL_LAMBERTIAN, 0.03f},
+    {{0.82f, 0.87f, 0.39f}, SCENE_MATERIAL_LAMBERTIAN, 0.74f},
+    {{0.66f, 0.08f, 0.78f}, SCENE_MATERIAL_LAMBERTIAN, 0.04f},
+    {{0.92f, 0.34f, 0.03f}, SCENE_MATERIAL_LAMBERTIAN, 0.28f},
+    {{0.93f, 0.05f, 0.37f}, SCENE_MATERIAL_LAMBERTIAN, 0.81f},
+    {{0.11f, 0.20f, 0.08f}, SCENE_MATERIAL_METAL, 0.67f},
+    {{0.82f, 0.85f, 0.22f}, SCENE_MATERIAL_LAMBERTIAN, 0.47f},
+    {{0.35f, 0.41f, 0.45f}, SCENE_MATERIAL_LAMBERTIAN, 0.31f},
+    {{0.69f, 0.52f, 0.17f}, SCENE_MATERIAL_LAMBERTIAN, 0.38f},
+    {{0.19f, 0.05f, 0.99f}, SCENE_MATERIAL_LAMBERTIAN, 0.81f},
+    {{0.49f, 0.43f, 0.22f}, SCENE_MATERIAL_LAMBERTIAN, 0.36f},
+    {{0.60f, 0.31f, 0.49f}, SCENE_MATERIAL_LAMBERTIAN, 0.55f},
+    {{0.13f, 0.94f, 0.89f}, SCENE_MATERIAL_LAMBERTIAN, 0.86f},
+    {{0.56f, 0.47f, 0.43f}, SCENE_MATERIAL_LAMBERTIAN, 0.61f},
+    {{0.30f, 0.90f, 0.25f}, SCENE_MATERIAL_METAL, 0.19f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.18f, 0.34f, 0.86f}, SCENE_MATERIAL_LAMBERTIAN, 0.18f},
+    {{0.64f, 0.59f, 0.39f}, SCENE_MATERIAL_LAMBERTIAN, 0.16f},
+    {{0.74f, 0.64f, 0.72f}, SCENE_MATERIAL_LAMBERTIAN, 0.69f},
+    {{0.92f, 0.61f, 0.32f}, SCENE_MATERIAL_LAMBERTIAN, 0.65f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.77f, 0.78f, 0.49f}, SCENE_MATERIAL_LAMBERTIAN, 0.33f},
+    {{0.80f, 0.93f, 0.20f}, SCENE_MATERIAL_LAMBERTIAN, 0.45f},
+    {{0.13f, 0.94f, 0.65f}, SCENE_MATERIAL_LAMBERTIAN, 0.44f},
+    {{0.71f, 0.66f, 0.81f}, SCENE_MATERIAL_LAMBERTIAN, 0.10f},
+    {{0.02f, 0.99f, 0.90f}, SCENE_MATERIAL_METAL, 0.83f},
+    {{0.68f, 0.39f, 0.59f}, SCENE_MATERIAL_LAMBERTIAN, 0.55f},
+    {{0.83f, 0.76f, 0.53f}, SCENE_MATERIAL_LAMBERTIAN, 0.61f},
+    {{0.49f, 0.22f, 0.74f}, SCENE_MATERIAL_LAMBERTIAN, 0.02f},
+    {{0.49f, 0.84f, 0.40f}, SCENE_MATERIAL_LAMBERTIAN, 0.99f},
+    {{0.73f, 0.24f, 0.77f}, SCENE_MATERIAL_LAMBERTIAN, 0.92f},
+    {{0.36f, 0.71f, 0.52f}, SCENE_MATERIAL_LAMBERTIAN, 0.14f},
+    {{0.28f, 0.14f, 0.71f}, SCENE_MATERIAL_LAMBERTIAN, 0.56f},
+    {{0.66f, 0.54f, 0.83f}, SCENE_MATERIAL_LAMBERTIAN, 0.15f},
+    {{0.34f, 0.02f, 0.77f}, SCENE_MATERIAL_LAMBERTIAN, 0.22f},
+    {{0.06f, 0.67f, 0.22f}, SCENE_MATERIAL_LAMBERTIAN, 0.35f},
+    {{0.88f, 0.98f, 0.74f}, SCENE_MATERIAL_LAMBERTIAN, 0.75f},
+    {{0.75f, 0.45f, 0.58f}, SCENE_MATERIAL_LAMBERTIAN, 0.04f},
+    {{0.08f, 0.62f, 0.51f}, SCENE_MATERIAL_LAMBERTIAN, 0.25f},
+    {{0.70f, 0.18f, 0.92f}, SCENE_MATERIAL_LAMBERTIAN, 0.19f},
+    {{0.78f, 0.08f, 0.61f}, SCENE_MATERIAL_LAMBERTIAN, 0.83f},
+    {{0.33f, 0.84f, 0.64f}, SCENE_MATERIAL_METAL, 0.92f},
+    {{0.90f, 0.96f, 0.66f}, SCENE_MATERIAL_LAMBERTIAN, 0.99f},
+    {{0.63f, 0.47f, 0.14f}, SCENE_MATERIAL_LAMBERTIAN, 0.54f},
+    {{0.92f, 0.12f, 0.92f}, SCENE_MATERIAL_METAL, 0.71f},
+    {{0.32f, 0.25f, 0.92f}, SCENE_MATERIAL_LAMBERTIAN, 0.72f},
+    {{0.83f, 0.57f, 0.48f}, SCENE_MATERIAL_LAMBERTIAN, 0.49f},
+    {{0.43f, 0.15f, 0.13f}, SCENE_MATERIAL_LAMBERTIAN, 0.82f},
+    {{0.30f, 0.45f, 0.28f}, SCENE_MATERIAL_LAMBERTIAN, 0.40f},
+    {{0.27f, 0.65f, 0.53f}, SCENE_MATERIAL_LAMBERTIAN, 0.09f},
+    {{0.35f, 0.99f, 0.12f}, SCENE_MATERIAL_LAMBERTIAN, 0.61f},
+    {{0.29f, 0.00f, 0.29f}, SCENE_MATERIAL_LAMBERTIAN, 0.53f},
+    {{0.33f, 0.55f, 0.99f}, SCENE_MATERIAL_LAMBERTIAN, 0.65f},
+    {{0.04f, 0.59f, 0.82f}, SCENE_MATERIAL_LAMBERTIAN, 0.16f},
+    {{0.98f, 0.78f, 0.65f}, SCENE_MATERIAL_LAMBERTIAN, 0.31f},
+    {{0.35f, 0.55f, 0.28f}, SCENE_MATERIAL_LAMBERTIAN, 0.34f},
+    {{0.08f, 0.35f, 0.30f}, SCENE_MATERIAL_LAMBERTIAN, 0.22f},
+    {{0.79f, 0.31f, 0.83f}, SCENE_MATERIAL_LAMBERTIAN, 0.74f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.73f, 0.72f, 0.21f}, SCENE_MATERIAL_LAMBERTIAN, 0.95f},
+    {{0.74f, 0.00f, 0.90f}, SCENE_MATERIAL_LAMBERTIAN, 0.68f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.77f, 0.84f, 0.87f}, SCENE_MATERIAL_METAL, 0.23f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.16f, 0.55f, 0.78f}, SCENE_MATERIAL_LAMBERTIAN, 0.89f},
+    {{0.48f, 0.55f, 0.71f}, SCENE_MATERIAL_LAMBERTIAN, 0.50f},
+    {{0.69f, 1.00f, 0.50f}, SCENE_MATERIAL_LAMBERTIAN, 0.95f},
+    {{0.41f, 0.86f, 0.17f}, SCENE_MATERIAL_LAMBERTIAN, 0.11f},
+    {{0.31f, 0.44f, 0.77f}, SCENE_MATERIAL_LAMBERTIAN, 0.88f},
+    {{0.60f, 0.11f, 0.71f}, SCENE_MATERIAL_LAMBERTIAN, 0.61f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.02f, 0.07f, 0.43f}, SCENE_MATERIAL_METAL, 0.38f},
+    {{0.98f, 0.60f, 0.54f}, SCENE_MATERIAL_METAL, 0.21f},
+    {{0.63f, 0.50f, 0.95f}, SCENE_MATERIAL_LAMBERTIAN, 0.79f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.02f, 0.61f, 0.45f}, SCENE_MATERIAL_METAL, 0.28f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.85f, 0.77f, 0.37f}, SCENE_MATERIAL_METAL, 0.47f},
+    {{0.32f, 0.96f, 0.62f}, SCENE_MATERIAL_METAL, 0.52f},
+    {{0.79f, 0.08f, 0.55f}, SCENE_MATERIAL_LAMBERTIAN, 0.95f},
+    {{0.29f, 0.50f, 0.12f}, SCENE_MATERIAL_LAMBERTIAN, 0.62f},
+    {{0.58f, 0.42f, 0.60f}, SCENE_MATERIAL_LAMBERTIAN, 0.64f},
+    {{0.43f, 0.67f, 0.07f}, SCENE_MATERIAL_LAMBERTIAN, 0.13f},
+    {{0.61f, 0.37f, 0.92f}, SCENE_MATERIAL_LAMBERTIAN, 0.87f},
+    {{0.48f, 0.76f, 0.32f}, SCENE_MATERIAL_LAMBERTIAN, 0.14f},
+    {{0.60f, 0.68f, 0.72f}, SCENE_MATERIAL_LAMBERTIAN, 0.53f},
+    {{0.13f, 0.33f, 0.83f}, SCENE_MATERIAL_LAMBERTIAN, 0.10f},
+    {{0.03f, 0.18f, 0.64f}, SCENE_MATERIAL_LAMBERTIAN, 0.90f},
+    {{0.85f, 0.86f, 0.36f}, SCENE_MATERIAL_LAMBERTIAN, 0.98f},
+    {{0.60f, 0.16f, 0.62f}, SCENE_MATERIAL_LAMBERTIAN, 0.83f},
+    {{0.47f, 0.60f, 0.83f}, SCENE_MATERIAL_LAMBERTIAN, 0.05f},
+    {{0.04f, 0.60f, 0.21f}, SCENE_MATERIAL_LAMBERTIAN, 0.97f},
+    {{0.22f, 0.36f, 0.82f}, SCENE_MATERIAL_LAMBERTIAN, 0.29f},
+    {{0.02f, 0.08f, 0.85f}, SCENE_MATERIAL_LAMBERTIAN, 0.74f},
+    {{0.55f, 0.46f, 0.61f}, SCENE_MATERIAL_LAMBERTIAN, 0.91f},
+    {{1.00f, 0.40f, 0.60f}, SCENE_MATERIAL_LAMBERTIAN, 0.10f},
+    {{0.31f, 0.74f, 0.23f}, SCENE_MATERIAL_LAMBERTIAN, 0.17f},
+    {{0.90f, 0.16f, 0.76f}, SCENE_MATERIAL_METAL, 0.86f},
+    {{0.83f, 0.09f, 0.56f}, SCENE_MATERIAL_LAMBERTIAN, 0.69f},
+    {{0.37f, 0.41f, 0.06f}, SCENE_MATERIAL_LAMBERTIAN, 0.31f},
+    {{0.22f, 0.17f, 0.26f}, SCENE_MATERIAL_METAL, 0.49f},
+    {{0.23f, 0.81f, 0.48f}, SCENE_MATERIAL_METAL, 0.45f},
+    {{0.67f, 0.23f, 0.36f}, SCENE_MATERIAL_LAMBERTIAN, 0.21f},
+    {{0.65f, 0.00f, 0.84f}, SCENE_MATERIAL_METAL, 0.58f},
+    {{0.75f, 0.24f, 0.38f}, SCENE_MATERIAL_METAL, 0.11f},
+    {{0.72f, 0.26f, 0.95f}, SCENE_MATERIAL_METAL, 0.15f},
+    {{0.91f, 0.39f, 0.59f}, SCENE_MATERIAL_LAMBERTIAN, 0.10f},
+    {{0.90f, 0.73f, 0.99f}, SCENE_MATERIAL_LAMBERTIAN, 0.83f},
+    {{0.87f, 0.30f, 0.87f}, SCENE_MATERIAL_METAL, 0.91f},
+    {{0.18f, 0.30f, 0.82f}, SCENE_MATERIAL_LAMBERTIAN, 0.75f},
+    {{0.65f, 0.17f, 0.14f}, SCENE_MATERIAL_LAMBERTIAN, 0.91f},
+    {{0.92f, 0.65f, 0.01f}, SCENE_MATERIAL_LAMBERTIAN, 0.94f},
+    {{0.56f, 0.87f, 0.82f}, SCENE_MATERIAL_LAMBERTIAN, 0.92f},
+    {{0.11f, 0.75f, 0.79f}, SCENE_MATERIAL_LAMBERTIAN, 0.43f},
+    {{0.45f, 0.35f, 0.41f}, SCENE_MATERIAL_LAMBERTIAN, 0.23f},
+    {{0.85f, 0.66f, 0.95f}, SCENE_MATERIAL_LAMBERTIAN, 0.80f},
+    {{0.17f, 0.65f, 0.48f}, SCENE_MATERIAL_METAL, 0.34f},
+    {{0.86f, 0.40f, 0.53f}, SCENE_MATERIAL_LAMBERTIAN, 0.67f},
+    {{0.66f, 0.60f, 0.89f}, SCENE_MATERIAL_LAMBERTIAN, 0.65f},
+    {{0.31f, 0.61f, 0.23f}, SCENE_MATERIAL_LAMBERTIAN, 0.71f},
+    {{0.84f, 0.09f, 0.36f}, SCENE_MATERIAL_LAMBERTIAN, 0.25f},
+    {{0.96f, 0.27f, 0.60f}, SCENE_MATERIAL_LAMBERTIAN, 0.13f},
+    {{0.92f, 0.38f, 0.44f}, SCENE_MATERIAL_LAMBERTIAN, 0.05f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.42f, 0.19f, 0.46f}, SCENE_MATERIAL_LAMBERTIAN, 0.80f},
+    {{0.07f, 0.80f, 0.20f}, SCENE_MATERIAL_METAL, 0.64f},
+    {{0.16f, 0.20f, 0.74f}, SCENE_MATERIAL_METAL, 0.81f},
+    {{0.59f, 0.48f, 0.59f}, SCENE_MATERIAL_LAMBERTIAN, 0.07f},
+    {{0.32f, 0.44f, 0.64f}, SCENE_MATERIAL_LAMBERTIAN, 0.92f},
+    {{0.96f, 0.52f, 0.09f}, SCENE_MATERIAL_LAMBERTIAN, 0.39f},
+    {{0.23f, 0.86f, 0.77f}, SCENE_MATERIAL_LAMBERTIAN, 0.71f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.63f, 0.00f, 0.07f}, SCENE_MATERIAL_METAL, 0.69f},
+    {{0.87f, 0.04f, 0.03f}, SCENE_MATERIAL_LAMBERTIAN, 0.13f},
+    {{0.63f, 0.31f, 0.99f}, SCENE_MATERIAL_LAMBERTIAN, 0.03f},
+    {{0.26f, 0.26f, 0.59f}, SCENE_MATERIAL_LAMBERTIAN, 0.99f},
+    {{0.59f, 0.23f, 0.90f}, SCENE_MATERIAL_METAL, 0.12f},
+    {{0.65f, 0.53f, 0.39f}, SCENE_MATERIAL_LAMBERTIAN, 0.96f},
+    {{0.01f, 0.47f, 0.59f}, SCENE_MATERIAL_LAMBERTIAN, 0.44f},
+    {{0.12f, 0.56f, 0.54f}, SCENE_MATERIAL_LAMBERTIAN, 0.24f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.42f, 0.98f, 0.36f}, SCENE_MATERIAL_LAMBERTIAN, 0.77f},
+    {{0.49f, 0.42f, 0.10f}, SCENE_MATERIAL_LAMBERTIAN, 0.18f},
+    {{0.70f, 0.55f, 0.85f}, SCENE_MATERIAL_METAL, 0.72f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.95f, 0.26f, 0.21f}, SCENE_MATERIAL_LAMBERTIAN, 0.22f},
+    {{0.67f, 0.21f, 0.93f}, SCENE_MATERIAL_METAL, 0.77f},
+    {{0.84f, 0.23f, 0.72f}, SCENE_MATERIAL_LAMBERTIAN, 0.70f},
+    {{0.97f, 0.90f, 0.25f}, SCENE_MATERIAL_LAMBERTIAN, 0.65f},
+    {{0.28f, 0.51f, 0.91f}, SCENE_MATERIAL_LAMBERTIAN, 0.97f},
+    {{0.64f, 0.22f, 0.93f}, SCENE_MATERIAL_LAMBERTIAN, 0.97f},
+    {{0.87f, 0.39f, 0.64f}, SCENE_MATERIAL_LAMBERTIAN, 0.02f},
+    {{0.82f, 0.39f, 0.60f}, SCENE_MATERIAL_LAMBERTIAN, 0.62f},
+    {{0.21f, 0.81f, 0.66f}, SCENE_MATERIAL_LAMBERTIAN, 0.79f},
+    {{0.31f, 0.53f, 0.34f}, SCENE_MATERIAL_LAMBERTIAN, 0.14f},
+    {{0.79f, 0.49f, 0.61f}, SCENE_MATERIAL_LAMBERTIAN, 0.24f},
+    {{0.73f, 0.08f, 0.47f}, SCENE_MATERIAL_LAMBERTIAN, 0.70f},
+    {{0.82f, 0.41f, 0.19f}, SCENE_MATERIAL_LAMBERTIAN, 0.87f},
+    {{0.75f, 0.60f, 0.99f}, SCENE_MATERIAL_METAL, 0.17f},
+    {{0.60f, 0.58f, 0.94f}, SCENE_MATERIAL_LAMBERTIAN, 0.77f},
+    {{0.75f, 0.04f, 0.02f}, SCENE_MATERIAL_LAMBERTIAN, 0.91f},
+    {{0.88f, 0.95f, 0.97f}, SCENE_MATERIAL_LAMBERTIAN, 0.52f},
+    {{0.83f, 0.43f, 0.29f}, SCENE_MATERIAL_LAMBERTIAN, 0.16f},
+    {{0.57f, 0.44f, 0.46f}, SCENE_MATERIAL_LAMBERTIAN, 0.46f},
+    {{0.03f, 0.03f, 0.12f}, SCENE_MATERIAL_METAL, 0.89f},
+    {{0.20f, 0.84f, 0.32f}, SCENE_MATERIAL_LAMBERTIAN, 0.49f},
+    {{0.23f, 0.38f, 0.87f}, SCENE_MATERIAL_LAMBERTIAN, 0.36f},
+    {{0.06f, 0.92f, 0.98f}, SCENE_MATERIAL_LAMBERTIAN, 0.26f},
+    {{0.10f, 0.53f, 0.81f}, SCENE_MATERIAL_LAMBERTIAN, 0.41f},
+    {{0.74f, 0.03f, 0.46f}, SCENE_MATERIAL_LAMBERTIAN, 0.46f},
+    {{0.97f, 0.92f, 0.58f}, SCENE_MATERIAL_LAMBERTIAN, 0.84f},
+    {{0.10f, 0.05f, 0.61f}, SCENE_MATERIAL_LAMBERTIAN, 0.07f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.02f, 0.23f, 0.75f}, SCENE_MATERIAL_LAMBERTIAN, 0.16f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.32f, 0.24f, 0.43f}, SCENE_MATERIAL_LAMBERTIAN, 0.46f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.10f, 0.44f, 0.91f}, SCENE_MATERIAL_LAMBERTIAN, 0.20f},
+    {{0.39f, 0.85f, 0.26f}, SCENE_MATERIAL_LAMBERTIAN, 0.38f},
+    {{0.56f, 0.63f, 0.11f}, SCENE_MATERIAL_LAMBERTIAN, 0.57f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.84f, 0.54f, 0.75f}, SCENE_MATERIAL_LAMBERTIAN, 0.99f},
+    {{0.20f, 0.19f, 0.07f}, SCENE_MATERIAL_LAMBERTIAN, 0.01f},
+    {{0.89f, 0.95f, 0.20f}, SCENE_MATERIAL_METAL, 0.92f},
+    {{0.79f, 0.51f, 0.55f}, SCENE_MATERIAL_METAL, 0.92f},
+    {{0.98f, 0.82f, 0.63f}, SCENE_MATERIAL_LAMBERTIAN, 0.66f},
+    {{0.14f, 0.84f, 0.73f}, SCENE_MATERIAL_METAL, 0.45f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.73f, 0.77f, 0.46f}, SCENE_MATERIAL_METAL, 0.93f},
+    {{0.62f, 0.10f, 0.53f}, SCENE_MATERIAL_METAL, 0.22f},
+    {{0.19f, 0.33f, 0.37f}, SCENE_MATERIAL_LAMBERTIAN, 0.80f},
+    {{0.93f, 0.52f, 0.40f}, SCENE_MATERIAL_LAMBERTIAN, 0.36f},
+    {{0.27f, 0.78f, 0.08f}, SCENE_MATERIAL_LAMBERTIAN, 0.49f},
+    {{0.16f, 0.17f, 0.54f}, SCENE_MATERIAL_LAMBERTIAN, 0.36f},
+    {{0.01f, 0.06f, 0.87f}, SCENE_MATERIAL_LAMBERTIAN, 0.88f},
+    {{0.88f, 0.16f, 0.20f}, SCENE_MATERIAL_LAMBERTIAN, 0.28f},
+    {{0.20f, 0.83f, 0.47f}, SCENE_MATERIAL_LAMBERTIAN, 0.75f},
+    {{0.92f, 0.08f, 0.20f}, SCENE_MATERIAL_METAL, 0.64f},
+    {{0.51f, 0.76f, 0.42f}, SCENE_MATERIAL_LAMBERTIAN, 0.80f},
+    {{0.81f, 0.22f, 0.65f}, SCENE_MATERIAL_LAMBERTIAN, 0.71f},
+    {{0.29f, 0.07f, 0.66f}, SCENE_MATERIAL_METAL, 0.85f},
+    {{0.45f, 0.02f, 0.13f}, SCENE_MATERIAL_LAMBERTIAN, 0.92f},
+    {{0.91f, 0.07f, 0.35f}, SCENE_MATERIAL_LAMBERTIAN, 0.09f},
+    {{0.90f, 0.87f, 0.90f}, SCENE_MATERIAL_LAMBERTIAN, 0.85f},
+    {{0.63f, 0.39f, 0.87f}, SCENE_MATERIAL_LAMBERTIAN, 0.91f},
+    {{0.66f, 0.97f, 0.30f}, SCENE_MATERIAL_LAMBERTIAN, 0.93f},
+    {{0.54f, 0.13f, 0.87f}, SCENE_MATERIAL_LAMBERTIAN, 0.15f},
+    {{0.73f, 0.41f, 0.22f}, SCENE_MATERIAL_LAMBERTIAN, 0.20f},
+    {{0.57f, 0.72f, 0.46f}, SCENE_MATERIAL_LAMBERTIAN, 0.48f},
+    {{0.53f, 0.11f, 0.55f}, SCENE_MATERIAL_METAL, 0.97f},
+    {{0.16f, 0.30f, 0.61f}, SCENE_MATERIAL_LAMBERTIAN, 0.98f},
+    {{0.80f, 0.86f, 0.00f}, SCENE_MATERIAL_LAMBERTIAN, 0.06f},
+    {{0.23f, 0.25f, 0.94f}, SCENE_MATERIAL_LAMBERTIAN, 0.32f},
+    {{0.08f, 0.52f, 0.94f}, SCENE_MATERIAL_LAMBERTIAN, 0.62f},
+    {{0.12f, 0.27f, 0.40f}, SCENE_MATERIAL_LAMBERTIAN, 0.70f},
+    {{0.12f, 0.02f, 0.45f}, SCENE_MATERIAL_METAL, 0.52f},
+    {{0.95f, 0.61f, 0.77f}, SCENE_MATERIAL_LAMBERTIAN, 0.99f},
+    {{0.69f, 0.94f, 0.64f}, SCENE_MATERIAL_METAL, 0.18f},
+    {{0.56f, 0.68f, 0.21f}, SCENE_MATERIAL_LAMBERTIAN, 0.84f},
+    {{0.80f, 0.38f, 0.91f}, SCENE_MATERIAL_METAL, 0.93f},
+    {{0.38f, 0.96f, 0.25f}, SCENE_MATERIAL_LAMBERTIAN, 0.37f},
+    {{0.34f, 0.91f, 0.08f}, SCENE_MATERIAL_LAMBERTIAN, 0.03f},
+    {{0.18f, 0.16f, 0.76f}, SCENE_MATERIAL_LAMBERTIAN, 0.03f},
+    {{0.72f, 0.80f, 0.73f}, SCENE_MATERIAL_LAMBERTIAN, 0.11f},
+    {{0.77f, 0.73f, 0.39f}, SCENE_MATERIAL_METAL, 0.09f},
+    {{0.48f, 0.90f, 0.29f}, SCENE_MATERIAL_LAMBERTIAN, 0.44f},
+    {{0.58f, 0.58f, 0.61f}, SCENE_MATERIAL_LAMBERTIAN, 0.95f},
+    {{0.90f, 0.78f, 0.12f}, SCENE_MATERIAL_LAMBERTIAN, 0.17f},
+    {{0.55f, 0.47f, 0.98f}, SCENE_MATERIAL_METAL, 0.40f},
+    {{0.02f, 0.90f, 0.91f}, SCENE_MATERIAL_LAMBERTIAN, 0.35f},
+    {{0.86f, 0.49f, 0.34f}, SCENE_MATERIAL_LAMBERTIAN, 0.18f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.33f, 0.15f, 0.72f}, SCENE_MATERIAL_LAMBERTIAN, 0.55f},
+    {{0.21f, 0.57f, 0.34f}, SCENE_MATERIAL_LAMBERTIAN, 0.23f},
+    {{0.99f, 0.21f, 0.48f}, SCENE_MATERIAL_LAMBERTIAN, 0.25f},
+    {{0.70f, 0.78f, 0.87f}, SCENE_MATERIAL_LAMBERTIAN, 0.15f},
+    {{0.54f, 0.00f, 0.81f}, SCENE_MATERIAL_LAMBERTIAN, 0.39f},
+    {{0.37f, 0.86f, 0.91f}, SCENE_MATERIAL_METAL, 0.36f},
+    {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f},
+    {{0.4f, 0.2f, 0.1f}, SCENE_MATERIAL_LAMBERTIAN, 1.0f},
+    {{0.7f, 0.6f, 0.5f}, SCENE_MATERIAL_METAL, 1.0f},
+    {{0.5f, 0.5f, 0.5f}, SCENE_MATERIAL_LAMBERTIAN, 1.0f},
+};
+const uint32_t builtinSceneMaterialCount = sizeof(builtinSceneMaterials) / sizeof(builtinSceneMaterials[0]);
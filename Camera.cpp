@@ -0,0 +1,88 @@
+/* @file Camera.cpp
+
+    Implementation of camera description & conversion to shader-side parameters.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <Camera.hpp>
+#include <cmath>
+
+const Camera defaultCamera = {
+    .lookfrom = { 13.f, 2.f, 3.f },
+    .lookat = { 0.f, 0.f, 0.f },
+    .vup = { 0.f, 1.f, 0.f },
+    .vfov = 20.f
+};
+
+static void cross(IN const float* a, IN const float* b, OUT float* out)
+{
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static float normalize(IN OUT float* v)
+{
+    float length = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    v[0] /= length;
+    v[1] /= length;
+    v[2] /= length;
+    return length;
+}
+
+void ComputeCameraBasis(IN const Camera* camera, IN uint32_t imageWidth, IN uint32_t imageHeight,
+                        OUT CameraBasis* basis)
+{
+    // Calculate the u,v,w unit basis vectors for the camera coordinate frame.
+    float w[3] = {
+        camera->lookfrom[0] - camera->lookat[0],
+        camera->lookfrom[1] - camera->lookat[1],
+        camera->lookfrom[2] - camera->lookat[2]
+    };
+    float focalLength = normalize(w);
+    float u[3], v[3];
+    cross(camera->vup, w, u);
+    normalize(u);
+    cross(w, u, v);
+
+    // Determine viewport dimensions.
+    float theta = camera->vfov * 3.14159265f / 180.f;
+    float viewportHeight = 2.f * tanf(theta / 2.f) * focalLength;
+    float viewportWidth = viewportHeight * (static_cast<float>(imageWidth) / static_cast<float>(imageHeight));
+
+    for (int axis = 0; axis < 3; ++axis) {
+        // Vectors across the horizontal and down the vertical viewport edges.
+        float viewportU = viewportWidth * u[axis];
+        float viewportV = viewportHeight * -v[axis];
+        float upperLeft = camera->lookfrom[axis] - focalLength * w[axis] - viewportU / 2.f - viewportV / 2.f;
+
+        basis->center[axis] = camera->lookfrom[axis];
+        basis->pixelDeltaU[axis] = viewportU / static_cast<float>(imageWidth);
+        basis->pixelDeltaV[axis] = viewportV / static_cast<float>(imageHeight);
+        basis->pixel00[axis] = upperLeft + 0.5f * (basis->pixelDeltaU[axis] + basis->pixelDeltaV[axis]);
+    }
+    basis->center[3] = basis->pixel00[3] = basis->pixelDeltaU[3] = basis->pixelDeltaV[3] = 0.f;
+}
+
+void OrbitCamera(IN OUT Camera* camera, IN float yawDegrees, IN float distanceScale)
+{
+    float axis[3] = { camera->vup[0], camera->vup[1], camera->vup[2] };
+    normalize(axis);
+    float offset[3] = {
+        camera->lookfrom[0] - camera->lookat[0],
+        camera->lookfrom[1] - camera->lookat[1],
+        camera->lookfrom[2] - camera->lookat[2]
+    };
+    // Rodrigues' rotation of the offset around the up axis.
+    float angle = yawDegrees * 3.14159265f / 180.f;
+    float cosine = cosf(angle);
+    float sine = sinf(angle);
+    float across[3];
+    cross(axis, offset, across);
+    float along = axis[0] * offset[0] + axis[1] * offset[1] + axis[2] * offset[2];
+    for (int iter = 0; iter < 3; ++iter) {
+        float rotated = offset[iter] * cosine + across[iter] * sine + axis[iter] * along * (1.f - cosine);
+        camera->lookfrom[iter] = camera->lookat[iter] + rotated * distanceScale;
+    }
+}
@@ -0,0 +1,75 @@
+/* @file Checkpoint.cpp
+
+    Implementation of render checkpoints.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <Checkpoint.hpp>
+#include <Utility.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+
+uint64_t HashCheckpointKey(IN const void* scene, IN size_t sceneSize, IN const RenderOptions* options)
+{
+    uint64_t hash = HashBytes(FNV_OFFSET_BASIS, scene, sceneSize);
+    hash = HashBytes(hash, &options->camera, sizeof(options->camera));
+    hash = HashBytes(hash, &options->imageWidth, sizeof(options->imageWidth));
+    hash = HashBytes(hash, &options->imageHeight, sizeof(options->imageHeight));
+    hash = HashBytes(hash, &options->samplesPerPixel, sizeof(options->samplesPerPixel));
+    hash = HashBytes(hash, &options->samplesPerTile, sizeof(options->samplesPerTile));
+    return HashBytes(hash, &options->tileSize, sizeof(options->tileSize));
+}
+
+VkResult WriteCheckpoint(IN const char* filename, IN const Checkpoint* checkpoint)
+{
+    CheckpointHeader header = {
+        .magic = CHECKPOINT_MAGIC,
+        .version = CHECKPOINT_VERSION,
+        .key = checkpoint->key,
+        .imageWidth = checkpoint->imageWidth,
+        .imageHeight = checkpoint->imageHeight,
+        .workCount = static_cast<uint32_t>(checkpoint->done.size()),
+        .doneCount = checkpoint->doneCount
+    };
+    FileChunk chunks[] = {
+        { .data = &header, .size = sizeof(header) },
+        { .data = checkpoint->done.data(), .size = checkpoint->done.size() },
+        { .data = checkpoint->accumulation.data(), .size = checkpoint->accumulation.size() * sizeof(float) }
+    };
+    return WriteFileAtomic(filename, chunks, 3) ? VK_SUCCESS : VK_ERROR_INITIALIZATION_FAILED;
+}
+
+VkResult ReadCheckpoint(IN const char* filename, IN uint64_t key, IN uint32_t imageWidth, IN uint32_t imageHeight,
+                        IN uint32_t workCount, OUT Checkpoint* checkpoint)
+{
+    std::error_code error;
+    uint64_t fileSize = std::filesystem::file_size(filename, error);
+    FILE* file = error ? nullptr : fopen(filename, "rb");
+    if (file == nullptr) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    uint64_t expectedSize = sizeof(CheckpointHeader) + workCount +
+                            static_cast<uint64_t>(imageWidth) * imageHeight * 4 * sizeof(float);
+    CheckpointHeader header;
+    VkResult result = VK_ERROR_FORMAT_NOT_SUPPORTED;
+    if (fread(&header, sizeof(header), 1, file) == 1 && header.magic == CHECKPOINT_MAGIC &&
+        header.version == CHECKPOINT_VERSION && header.key == key && header.imageWidth == imageWidth &&
+        header.imageHeight == imageHeight && header.workCount == workCount && header.doneCount <= workCount &&
+        fileSize == expectedSize) {
+        checkpoint->key = header.key;
+        checkpoint->imageWidth = header.imageWidth;
+        checkpoint->imageHeight = header.imageHeight;
+        checkpoint->doneCount = header.doneCount;
+        checkpoint->done.resize(header.workCount);
+        checkpoint->accumulation.resize(static_cast<size_t>(header.imageWidth) * header.imageHeight * 4);
+        if (fread(checkpoint->done.data(), 1, checkpoint->done.size(), file) == checkpoint->done.size() &&
+            fread(checkpoint->accumulation.data(), sizeof(float), checkpoint->accumulation.size(), file) ==
+                checkpoint->accumulation.size()) {
+            result = VK_SUCCESS;
+        }
+    }
+    fclose(file);
+    return result;
+}
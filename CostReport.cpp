@@ -0,0 +1,110 @@
+/* @file CostReport.cpp
+
+    Histograms & heatmaps of the per pixel cost counters.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <CostReport.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+// Per counter: name, unit of the per sample average & the average at the hot end of the heatmap.
+// Scales must match cost_scales in shader.comp.
+static const struct {
+    const char* name;
+    const char* unit;
+    float       unitScale;
+    float       heatScale;
+} costCounters[COST_COUNTER_COUNT] = {
+    { "bounces", "per sample", 1.0f, 16.0f },
+    { "sphere tests", "per sample", 1.0f, 1024.0f },
+    { "BVH nodes", "per sample", 1.0f, 256.0f },
+    { "capped paths", "per 1000 samples", 1000.0f, 1.0f }
+};
+
+// Bucket 0 holds [0, 1), bucket n [2^(n-1), 2^n).
+constexpr uint32_t HISTOGRAM_BUCKETS = 32;
+constexpr uint32_t HISTOGRAM_BAR_WIDTH = 48;
+
+static float percentile(std::vector<float>& sorted, double fraction)
+{
+    size_t index = std::min(sorted.size() - 1, static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5));
+    return sorted[index];
+}
+
+void PrintCostHistograms(IN uint32_t width, IN uint32_t height, IN const float* image, IN const uint32_t* costs)
+{
+    size_t pixelCount = static_cast<size_t>(width) * height;
+    if (pixelCount == 0) {
+        return;
+    }
+    std::vector<float> values(pixelCount);
+    for (uint32_t counter = 0; counter < COST_COUNTER_COUNT; ++counter) {
+        uint64_t buckets[HISTOGRAM_BUCKETS] = {};
+        double sum = 0.0;
+        for (size_t pixel = 0; pixel < pixelCount; ++pixel) {
+            float samples = std::max(image[pixel * 4 + 3], 1.0f);
+            float value = costs[pixel * COST_COUNTER_COUNT + counter] / samples * costCounters[counter].unitScale;
+            uint32_t bucket = value < 1.0f ? 0 : static_cast<uint32_t>(std::log2(value)) + 1;
+            buckets[std::min(bucket, HISTOGRAM_BUCKETS - 1)]++;
+            values[pixel] = value;
+            sum += value;
+        }
+        std::sort(values.begin(), values.end());
+        printf("Cost: %s %s, mean %.2f, p50 %.2f, p90 %.2f, p99 %.2f, max %.2f.\n", costCounters[counter].name,
+               costCounters[counter].unit, sum / pixelCount, percentile(values, 0.5), percentile(values, 0.9),
+               percentile(values, 0.99), values.back());
+
+        uint32_t first = 0;
+        uint32_t last = 0;
+        uint64_t largest = 0;
+        for (uint32_t bucket = 0; bucket < HISTOGRAM_BUCKETS; ++bucket) {
+            if (buckets[bucket] != 0) {
+                first = largest == 0 ? bucket : first;
+                last = bucket;
+                largest = std::max(largest, buckets[bucket]);
+            }
+        }
+        for (uint32_t bucket = first; bucket <= last; ++bucket) {
+            char bar[HISTOGRAM_BAR_WIDTH + 1] = {};
+            uint32_t length = static_cast<uint32_t>((buckets[bucket] * HISTOGRAM_BAR_WIDTH + largest - 1) / largest);
+            std::fill(bar, bar + length, '#');
+            double low = bucket == 0 ? 0.0 : std::ldexp(1.0, bucket - 1);
+            printf("Cost:   %10.0f .. %-10.0f %6.2f%% %s\n", low, std::ldexp(1.0, bucket),
+                   100.0 * buckets[bucket] / pixelCount, bar);
+        }
+    }
+}
+
+void PrintRenderStatistics(IN const RenderStatistics* statistics, IN bool queried, IN uint64_t pixelSamples)
+{
+    printf("Statistics: %llu submissions.\n", static_cast<unsigned long long>(statistics->submissions));
+    if (!queried) {
+        printf("Statistics: no pipeline statistics queries on this device.\n");
+        return;
+    }
+    printf("Statistics: %llu compute shader invocations", static_cast<unsigned long long>(statistics->computeInvocations));
+    if (pixelSamples != 0) {
+        printf(", %.4f per pixel sample", static_cast<double>(statistics->computeInvocations) / pixelSamples);
+    }
+    printf(".\n");
+}
+
+void BuildCostHeatmap(IN uint32_t width, IN uint32_t height, IN const float* image, IN const uint32_t* costs,
+                      IN CostCounter counter, OUT float* heatmap)
+{
+    size_t pixelCount = static_cast<size_t>(width) * height;
+    float scale = std::log2(1.0f + costCounters[counter].heatScale);
+    for (size_t pixel = 0; pixel < pixelCount; ++pixel) {
+        float average = costs[pixel * COST_COUNTER_COUNT + counter] / std::max(image[pixel * 4 + 3], 1.0f);
+        float level = std::min(std::max(std::log2(1.0f + average) / scale, 0.0f), 1.0f);
+        // Blue over green & yellow to red, as heat_colour in shader.comp.
+        heatmap[pixel * 4 + 0] = std::min(std::max(1.5f - std::abs(4.0f * level - 3.0f), 0.0f), 1.0f);
+        heatmap[pixel * 4 + 1] = std::min(std::max(1.5f - std::abs(4.0f * level - 2.0f), 0.0f), 1.0f);
+        heatmap[pixel * 4 + 2] = std::min(std::max(1.5f - std::abs(4.0f * level - 1.0f), 0.0f), 1.0f);
+        heatmap[pixel * 4 + 3] = 1.0f;
+    }
+}
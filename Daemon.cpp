@@ -0,0 +1,444 @@
+/* @file Daemon.cpp
+
+    Implementation of the render daemon & its client.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <Daemon.hpp>
+#include <ImageOutput.hpp>
+#include <Network.hpp>
+#include <Options.hpp>
+#include <Renderer.hpp>
+#include <Scene.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Scenes kept loaded with their session, the least recently used one goes first.
+constexpr uint32_t DAEMON_RESIDENT_SCENES = 4;
+// Tile edge of the daemon's sessions, small jobs render in a single submission.
+constexpr uint32_t DAEMON_TILE_SIZE = 512;
+constexpr uint32_t DAEMON_MAX_IMAGE_SIZE = 16384;
+constexpr uint32_t DAEMON_MAX_SCENE_PATH = 4096;
+
+using Clock = std::chrono::steady_clock;
+
+static uint64_t microsecondsSince(IN Clock::time_point begin)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - begin).count();
+}
+
+// Paths are compared as given by the filesystem, clients may send relative ones.
+static std::string normalizeScenePath(IN const std::string& path)
+{
+    if (path.empty()) {
+        return path;
+    }
+    std::error_code error;
+    std::filesystem::path absolute = std::filesystem::absolute(path, error);
+    return error ? path : absolute.lexically_normal().string();
+}
+
+// Shared memory results, POSIX only. The daemon creates, fills & unlinks the object, the client maps it.
+
+static bool writeSharedMemory(IN const void* data, IN size_t size, OUT char* name, IN size_t nameSize)
+{
+#if defined(_WIN32)
+    return false;
+#else
+    static std::atomic<uint64_t> objects;
+    snprintf(name, nameSize, "/vcrt-%ld-%llu", static_cast<long>(getpid()),
+             static_cast<unsigned long long>(objects++));
+    int descriptor = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (descriptor < 0) {
+        return false;
+    }
+    void* mapping = MAP_FAILED;
+    if (ftruncate(descriptor, static_cast<off_t>(size)) == 0) {
+        mapping = mmap(nullptr, size, PROT_WRITE, MAP_SHARED, descriptor, 0);
+    }
+    close(descriptor);
+    if (mapping == MAP_FAILED) {
+        shm_unlink(name);
+        return false;
+    }
+    memcpy(mapping, data, size);
+    munmap(mapping, size);
+    return true;
+#endif
+}
+
+static bool readSharedMemory(IN const char* name, OUT void* data, IN size_t size)
+{
+#if defined(_WIN32)
+    return false;
+#else
+    int descriptor = shm_open(name, O_RDONLY, 0);
+    if (descriptor < 0) {
+        return false;
+    }
+    struct stat status;
+    void* mapping = MAP_FAILED;
+    if (fstat(descriptor, &status) == 0 && static_cast<size_t>(status.st_size) >= size) {
+        mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0);
+    }
+    close(descriptor);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    memcpy(data, mapping, size);
+    munmap(mapping, size);
+    return true;
+#endif
+}
+
+static void unlinkSharedMemory(IN const char* name)
+{
+#if !defined(_WIN32)
+    shm_unlink(name);
+#endif
+}
+
+// Daemon side.
+
+struct PendingJob {
+    DaemonJob          job;
+    std::string        scenePath;
+    uint64_t           arrival;
+    Clock::time_point  queued;
+    bool               done;
+    DaemonResult       result;
+    std::vector<float> image;
+};
+
+struct JobPrecedence {
+    bool operator()(IN const PendingJob* a, IN const PendingJob* b) const
+    {
+        return a->job.priority != b->job.priority ? a->job.priority < b->job.priority : a->arrival > b->arrival;
+    }
+};
+
+struct JobQueue {
+    std::mutex              mutex;
+    std::condition_variable changed;
+    std::priority_queue<PendingJob*, std::vector<PendingJob*>, JobPrecedence> jobs;
+    uint64_t                arrivals = 0;
+};
+
+struct ResidentScene {
+    std::string                     path;
+    std::filesystem::file_time_type modified;   // Reloaded when the file changes.
+    RenderScene*                    scene;
+    RenderContext*                  context;
+    uint64_t                        lastUsed;
+};
+
+static std::filesystem::file_time_type sceneModified(IN const std::string& path)
+{
+    std::error_code error;
+    return path.empty() ? std::filesystem::file_time_type() : std::filesystem::last_write_time(path, error);
+}
+
+static void releaseScene(IN ResidentScene* resident)
+{
+    EndRenderingOperation(resident->context);
+    DestroyRenderScene(resident->scene);
+}
+
+// Session of the scene at path, loading it (& evicting the least recently used one) if not resident.
+static VkResult acquireScene(IN std::vector<ResidentScene>* residents, IN const std::string& path,
+                             IN uint64_t useCount, OUT ResidentScene** acquired, OUT bool* resident)
+{
+    std::filesystem::file_time_type modified = sceneModified(path);
+    for (size_t iter = 0; iter < residents->size(); ++iter) {
+        ResidentScene& candidate = (*residents)[iter];
+        if (candidate.path != path) {
+            continue;
+        }
+        if (candidate.modified == modified) {
+            candidate.lastUsed = useCount;
+            *acquired = &candidate;
+            *resident = true;
+            return VK_SUCCESS;
+        }
+        releaseScene(&candidate);
+        residents->erase(residents->begin() + iter);
+        break;
+    }
+    *resident = false;
+    if (residents->size() >= DAEMON_RESIDENT_SCENES) {
+        auto oldest = residents->begin();
+        for (auto iter = residents->begin(); iter != residents->end(); ++iter) {
+            oldest = iter->lastUsed < oldest->lastUsed ? iter : oldest;
+        }
+        printf("Daemon: evicting %s.\n", oldest->path.empty() ? "built-in scene" : oldest->path.c_str());
+        releaseScene(&*oldest);
+        residents->erase(oldest);
+    }
+
+    ResidentScene loaded = {
+        .path = path,
+        .modified = modified,
+        .scene = nullptr,
+        .context = nullptr,
+        .lastUsed = useCount
+    };
+    VkResult result = LoadRenderScene(path.empty() ? nullptr : path.c_str(), &loaded.scene);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    result = BeginOffscreenRenderingOperation(loaded.scene, DAEMON_TILE_SIZE, DAEMON_TILE_SIZE, &loaded.context);
+    if (result != VK_SUCCESS) {
+        DestroyRenderScene(loaded.scene);
+        return result;
+    }
+    residents->push_back(loaded);
+    *acquired = &residents->back();
+    return VK_SUCCESS;
+}
+
+// Owns the device: renders the highest priority job, one at a time, forever.
+static void renderJobs(IN JobQueue* queue)
+{
+    std::vector<ResidentScene> residents;
+    uint64_t useCount = 0;
+    // Scenes named on the daemon's command line are warm before the first job.
+    if (renderOptions.sceneFile != nullptr) {
+        ResidentScene* preloaded;
+        bool resident;
+        if (acquireScene(&residents, normalizeScenePath(renderOptions.sceneFile), useCount, &preloaded,
+                         &resident) != VK_SUCCESS) {
+            fprintf(stderr, "Daemon: cannot preload %s.\n", renderOptions.sceneFile);
+        }
+    }
+
+    for (;;) {
+        PendingJob* pending;
+        {
+            std::unique_lock<std::mutex> lock(queue->mutex);
+            while (queue->jobs.empty()) {
+                queue->changed.wait(lock);
+            }
+            pending = queue->jobs.top();
+            queue->jobs.pop();
+        }
+
+        Clock::time_point begin = Clock::now();
+        const DaemonJob& job = pending->job;
+        DaemonResult result = {
+            .status = VK_SUCCESS,
+            .imageWidth = job.imageWidth,
+            .imageHeight = job.imageHeight,
+            .sceneResident = 0,
+            .queuedMicroseconds = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(begin - pending->queued).count()),
+            .renderMicroseconds = 0,
+            .sharedMemoryName = {}
+        };
+        ResidentScene* resident;
+        bool wasResident = false;
+        result.status = acquireScene(&residents, pending->scenePath, ++useCount, &resident, &wasResident);
+        if (result.status == VK_SUCCESS) {
+            result.sceneResident = wasResident ? 1 : 0;
+            pending->image.resize(static_cast<size_t>(job.imageWidth) * job.imageHeight * 4);
+            // All samples of a tile in one submission, the session splits them into short dispatches.
+            result.status = RenderOffscreenImage(resident->context, &job.camera, job.imageWidth, job.imageHeight,
+                                                 job.samplesPerPixel, job.samplesPerPixel, pending->image.data());
+        }
+        result.renderMicroseconds = microsecondsSince(begin);
+        printf("Daemon: %ux%u, %u spp, priority %d, %s scene, queued %.3f ms, rendered %.3f ms.\n",
+               job.imageWidth, job.imageHeight, job.samplesPerPixel, job.priority,
+               wasResident ? "resident" : "cold", result.queuedMicroseconds * 1e-3, result.renderMicroseconds * 1e-3);
+        fflush(stdout);
+
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        pending->result = result;
+        pending->done = true;
+        queue->changed.notify_all();
+    }
+}
+
+static bool sendResult(IN NetSocket connection, IN PendingJob* pending)
+{
+    DaemonResult& result = pending->result;
+    size_t pixelBytes = result.status == VK_SUCCESS ? pending->image.size() * sizeof(float) : 0;
+    if (pixelBytes > 0 && (pending->job.flags & DAEMON_JOB_SHARED_MEMORY) != 0) {
+        if (writeSharedMemory(pending->image.data(), pixelBytes, result.sharedMemoryName,
+                              sizeof(result.sharedMemoryName))) {
+            pixelBytes = 0;
+        } else {
+            // Not available here, the pixels follow as usual.
+            result.sharedMemoryName[0] = '\0';
+        }
+    }
+    DaemonMessageHeader header = {
+        .magic = DAEMON_MAGIC,
+        .type = DAEMON_MESSAGE_RESULT,
+        .payloadSize = sizeof(result) + pixelBytes
+    };
+    bool sent = NetSendAll(connection, &header, sizeof(header)) && NetSendAll(connection, &result, sizeof(result)) &&
+                (pixelBytes == 0 || NetSendAll(connection, pending->image.data(), pixelBytes));
+    if (result.sharedMemoryName[0] != '\0') {
+        // Kept until the client read it or is gone, a client dying in between must not leak the object.
+        sent = sent && NetReceiveAll(connection, &header, sizeof(header)) && header.magic == DAEMON_MAGIC &&
+               header.type == DAEMON_MESSAGE_RESULT_READ && header.payloadSize == 0;
+        unlinkSharedMemory(result.sharedMemoryName);
+    }
+    return sent;
+}
+
+static void serveClient(IN NetSocket connection, IN JobQueue* queue)
+{
+    DaemonMessageHeader header;
+    while (NetReceiveAll(connection, &header, sizeof(header)) && header.magic == DAEMON_MAGIC &&
+           header.type == DAEMON_MESSAGE_JOB) {
+        PendingJob pending = {};
+        DaemonJob& job = pending.job;
+        if (header.payloadSize < sizeof(job) || !NetReceiveAll(connection, &job, sizeof(job)) ||
+            job.scenePathSize > DAEMON_MAX_SCENE_PATH || header.payloadSize != sizeof(job) + job.scenePathSize) {
+            fprintf(stderr, "Daemon: invalid job message.\n");
+            break;
+        }
+        std::string scenePath(job.scenePathSize, '\0');
+        if (!NetReceiveAll(connection, scenePath.data(), scenePath.size())) {
+            break;
+        }
+        pending.scenePath = normalizeScenePath(scenePath);
+
+        if (job.imageWidth == 0 || job.imageHeight == 0 || job.samplesPerPixel == 0 ||
+            job.imageWidth > DAEMON_MAX_IMAGE_SIZE || job.imageHeight > DAEMON_MAX_IMAGE_SIZE) {
+            pending.result.status = VK_ERROR_FORMAT_NOT_SUPPORTED;
+        } else {
+            std::unique_lock<std::mutex> lock(queue->mutex);
+            pending.arrival = queue->arrivals++;
+            pending.queued = Clock::now();
+            queue->jobs.push(&pending);
+            queue->changed.notify_all();
+            while (!pending.done) {
+                queue->changed.wait(lock);
+            }
+        }
+        if (!sendResult(connection, &pending)) {
+            break;
+        }
+    }
+    NetClose(connection);
+}
+
+VkResult RunRenderDaemon(IN const char* socketPath)
+{
+    if (!NetInitialize()) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    bool pathInUse;
+    NetSocket listener = NetListenLocal(socketPath, &pathInUse);
+    if (listener == INVALID_NET_SOCKET) {
+        if (pathInUse) {
+            fprintf(stderr, "Daemon: %s exists, a daemon is already running there or it is not a socket.\n",
+                    socketPath);
+        } else {
+            fprintf(stderr, "Daemon: cannot listen on %s.\n", socketPath);
+        }
+        NetCleanup();
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    printf("Daemon: listening on %s.\n", socketPath);
+
+    // Clients wait on their own threads, only the render loop touches the device.
+    static JobQueue queue;
+    std::thread([listener]() {
+        for (;;) {
+            NetSocket connection = NetAccept(listener);
+            if (connection != INVALID_NET_SOCKET) {
+                std::thread(serveClient, connection, &queue).detach();
+            }
+        }
+    }).detach();
+    renderJobs(&queue);
+    return VK_SUCCESS;
+}
+
+// Client side.
+
+VkResult SubmitRenderJob(IN const char* socketPath)
+{
+    if (!NetInitialize()) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    NetSocket connection = NetConnectLocal(socketPath);
+    if (connection == INVALID_NET_SOCKET) {
+        fprintf(stderr, "Client: cannot connect to daemon at %s.\n", socketPath);
+        NetCleanup();
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    Clock::time_point begin = Clock::now();
+    // The daemon may run elsewhere in the filesystem.
+    std::string scenePath = renderOptions.sceneFile != nullptr ? normalizeScenePath(renderOptions.sceneFile) : "";
+    DaemonJob job = {
+        .imageWidth = renderOptions.imageWidth,
+        .imageHeight = renderOptions.imageHeight,
+        .samplesPerPixel = renderOptions.samplesPerPixel,
+        .priority = renderOptions.jobPriority,
+        .camera = renderOptions.camera,
+        .flags = renderOptions.sharedMemoryResult ? static_cast<uint32_t>(DAEMON_JOB_SHARED_MEMORY) : 0,
+        .scenePathSize = static_cast<uint32_t>(scenePath.size())
+    };
+    DaemonMessageHeader header = {
+        .magic = DAEMON_MAGIC,
+        .type = DAEMON_MESSAGE_JOB,
+        .payloadSize = sizeof(job) + scenePath.size()
+    };
+    DaemonResult result;
+    std::vector<float> image(static_cast<size_t>(job.imageWidth) * job.imageHeight * 4);
+    size_t pixelBytes = image.size() * sizeof(float);
+    bool received = NetSendAll(connection, &header, sizeof(header)) && NetSendAll(connection, &job, sizeof(job)) &&
+                    NetSendAll(connection, scenePath.data(), scenePath.size()) &&
+                    NetReceiveAll(connection, &header, sizeof(header)) && header.magic == DAEMON_MAGIC &&
+                    header.type == DAEMON_MESSAGE_RESULT && header.payloadSize >= sizeof(result) &&
+                    NetReceiveAll(connection, &result, sizeof(result));
+    result.sharedMemoryName[sizeof(result.sharedMemoryName) - 1] = '\0';
+    if (received && result.status == VK_SUCCESS && result.sharedMemoryName[0] != '\0') {
+        received = readSharedMemory(result.sharedMemoryName, image.data(), pixelBytes);
+        header = {
+            .magic = DAEMON_MAGIC,
+            .type = DAEMON_MESSAGE_RESULT_READ,
+            .payloadSize = 0
+        };
+        NetSendAll(connection, &header, sizeof(header));
+    } else if (received && result.status == VK_SUCCESS) {
+        received = header.payloadSize == sizeof(result) + pixelBytes &&
+                   NetReceiveAll(connection, image.data(), pixelBytes);
+    }
+    NetClose(connection);
+    NetCleanup();
+    if (!received) {
+        fprintf(stderr, "Client: lost the daemon.\n");
+        return VK_ERROR_DEVICE_LOST;
+    }
+    if (result.status != VK_SUCCESS) {
+        fprintf(stderr, "Client: job failed (%d).\n", result.status);
+        return static_cast<VkResult>(result.status);
+    }
+    printf("Client: %s scene, queued %.3f ms, rendered %.3f ms, round trip %.3f ms%s.\n",
+           result.sceneResident ? "resident" : "cold", result.queuedMicroseconds * 1e-3,
+           result.renderMicroseconds * 1e-3, microsecondsSince(begin) * 1e-3,
+           result.sharedMemoryName[0] != '\0' ? " via shared memory" : "");
+    return WriteAccumulationImage(renderOptions.outputFile, job.imageWidth, job.imageHeight, image.data());
+}
@@ -0,0 +1,522 @@
+/* @file Distributed.cpp
+
+    Implementation of distributed tile rendering.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <Distributed.hpp>
+#include <Checkpoint.hpp>
+#include <ImageOutput.hpp>
+#include <Network.hpp>
+#include <Options.hpp>
+#include <Scene.hpp>
+#include <SceneFile.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// A worker silent for this long is considered dead, its work is re-issued.
+constexpr uint32_t WORKER_TIMEOUT_SECONDS = 120;
+// Workers busy with one tile report progress this often, slow devices may take longer than the timeout per tile.
+constexpr uint32_t WORKER_PROGRESS_SECONDS = 10;
+// Idle workers duplicate unfinished work up to this many copies, the first result wins.
+constexpr uint32_t MAX_WORK_COPIES = 2;
+
+static bool sendMessage(IN NetSocket socket, IN DistributedMessageType type,
+                        IN const void* payload, IN size_t payloadSize)
+{
+    DistributedMessageHeader header = {
+        .magic = DISTRIBUTED_MAGIC,
+        .type = type,
+        .payloadSize = payloadSize
+    };
+    return NetSendAll(socket, &header, sizeof(header)) &&
+           (payloadSize == 0 || NetSendAll(socket, payload, payloadSize));
+}
+
+static bool receiveHeader(IN NetSocket socket, OUT DistributedMessageHeader* header)
+{
+    return NetReceiveAll(socket, header, sizeof(*header)) && header->magic == DISTRIBUTED_MAGIC;
+}
+
+// Worker side.
+
+// Sends DISTRIBUTED_MESSAGE_PROGRESS while rendering stays set. The tile result is only sent after clearing
+// it under mutex, so the messages never interleave.
+struct ProgressReporter {
+    std::mutex              mutex;
+    std::condition_variable changed;
+    bool                    rendering = false;
+    bool                    stop = false;
+};
+
+static void reportProgress(IN NetSocket connection, IN ProgressReporter* reporter)
+{
+    std::unique_lock<std::mutex> lock(reporter->mutex);
+    while (!reporter->stop) {
+        if (!reporter->rendering) {
+            reporter->changed.wait(lock, [reporter]() { return reporter->rendering || reporter->stop; });
+        } else if (!reporter->changed.wait_for(lock, std::chrono::seconds(WORKER_PROGRESS_SECONDS),
+                                               [reporter]() { return !reporter->rendering || reporter->stop; })) {
+            sendMessage(connection, DISTRIBUTED_MESSAGE_PROGRESS, nullptr, 0);
+        }
+    }
+}
+
+static void setRendering(IN ProgressReporter* reporter, IN bool rendering)
+{
+    {
+        std::lock_guard<std::mutex> lock(reporter->mutex);
+        reporter->rendering = rendering;
+    }
+    reporter->changed.notify_all();
+}
+
+static bool serveCoordinator(IN NetSocket connection)
+{
+    DistributedMessageHeader header;
+    DistributedSetup setup;
+    if (!receiveHeader(connection, &header) || header.type != DISTRIBUTED_MESSAGE_SETUP ||
+        header.payloadSize < sizeof(setup) || !NetReceiveAll(connection, &setup, sizeof(setup)) ||
+        header.payloadSize != sizeof(setup) + setup.sceneSize) {
+        fprintf(stderr, "Worker: invalid setup message.\n");
+        return false;
+    }
+    std::vector<uint8_t> scene(setup.sceneSize);
+    if (!NetReceiveAll(connection, scene.data(), scene.size())) {
+        fprintf(stderr, "Worker: cannot receive scene.\n");
+        return false;
+    }
+    RenderScene* renderScene;
+    if (LoadRenderSceneFromMemory(scene.data(), scene.size(), &renderScene) != VK_SUCCESS) {
+        fprintf(stderr, "Worker: cannot load scene.\n");
+        return false;
+    }
+    // Uploaded to the device, the host copy is not needed while rendering.
+    std::vector<uint8_t>().swap(scene);
+
+    RenderContext* context;
+    if (BeginOffscreenRenderingOperation(renderScene, setup.maxTileWidth, setup.maxTileHeight,
+                                         &context) != VK_SUCCESS) {
+        fprintf(stderr, "Worker: cannot begin offscreen rendering.\n");
+        DestroyRenderScene(renderScene);
+        return false;
+    }
+    SetRenderCamera(context, &setup.camera, setup.imageWidth, setup.imageHeight);
+    printf("Worker: rendering %ux%u.\n", setup.imageWidth, setup.imageHeight);
+
+    std::vector<float> accumulation(static_cast<size_t>(setup.maxTileWidth) * setup.maxTileHeight * 4);
+    bool succeeded = false;
+    // Rendering throughput of the session, compares shader options on the same scene.
+    std::chrono::steady_clock::duration renderTime{};
+    uint64_t renderedSamples = 0;
+    uint32_t renderedTiles = 0;
+    ProgressReporter reporter;
+    std::thread progressThread(reportProgress, connection, &reporter);
+    while (receiveHeader(connection, &header)) {
+        if (header.type == DISTRIBUTED_MESSAGE_BYE) {
+            succeeded = true;
+            break;
+        }
+        DistributedTileHeader request;
+        if (header.type != DISTRIBUTED_MESSAGE_TILE_REQUEST || header.payloadSize != sizeof(request) ||
+            !NetReceiveAll(connection, &request, sizeof(request))) {
+            fprintf(stderr, "Worker: invalid tile request.\n");
+            break;
+        }
+        auto begin = std::chrono::steady_clock::now();
+        setRendering(&reporter, true);
+        VkResult result = RenderOffscreenTile(context, &request.tile, accumulation.data());
+        setRendering(&reporter, false);
+        if (result != VK_SUCCESS) {
+            fprintf(stderr, "Worker: cannot render tile.\n");
+            break;
+        }
+        renderTime += std::chrono::steady_clock::now() - begin;
+        renderedSamples += static_cast<uint64_t>(request.tile.width) * request.tile.height * request.tile.sampleCount;
+        ++renderedTiles;
+
+        size_t pixelBytes = static_cast<size_t>(request.tile.width) * request.tile.height * 4 * sizeof(float);
+        DistributedMessageHeader resultHeader = {
+            .magic = DISTRIBUTED_MAGIC,
+            .type = DISTRIBUTED_MESSAGE_TILE_RESULT,
+            .payloadSize = sizeof(request) + pixelBytes
+        };
+        if (!NetSendAll(connection, &resultHeader, sizeof(resultHeader)) ||
+            !NetSendAll(connection, &request, sizeof(request)) ||
+            !NetSendAll(connection, accumulation.data(), pixelBytes)) {
+            break;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(reporter.mutex);
+        reporter.stop = true;
+    }
+    reporter.changed.notify_all();
+    progressThread.join();
+
+    double seconds = std::chrono::duration<double>(renderTime).count();
+    printf("Worker: %u tiles, %.3f s, %.2f Msamples/s.\n", renderedTiles, seconds,
+           seconds > 0 ? renderedSamples / seconds * 1e-6 : 0.0);
+    EndRenderingOperation(context);
+    DestroyRenderScene(renderScene);
+    return succeeded;
+}
+
+VkResult RunRenderWorker(IN uint16_t port)
+{
+    if (!NetInitialize()) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    NetSocket listener = NetListen(port);
+    if (listener == INVALID_NET_SOCKET) {
+        fprintf(stderr, "Worker: cannot listen on port %u.\n", port);
+        NetCleanup();
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    printf("Worker: listening on port %u.\n", port);
+    // One coordinator at a time, a new frame starts with a new connection.
+    for (;;) {
+        NetSocket connection = NetAccept(listener);
+        if (connection == INVALID_NET_SOCKET) {
+            continue;
+        }
+        serveCoordinator(connection);
+        NetClose(connection);
+    }
+}
+
+// Coordinator side.
+
+// Header of the next message other than progress reports, each of which restarts the receive timeout.
+static bool receiveResultHeader(IN NetSocket socket, OUT DistributedMessageHeader* header)
+{
+    while (receiveHeader(socket, header)) {
+        if (header->type != DISTRIBUTED_MESSAGE_PROGRESS) {
+            return true;
+        }
+        if (header->payloadSize != 0) {
+            return false;
+        }
+    }
+    return false;
+}
+
+struct WorkItem {
+    RenderTile tile;
+    uint32_t   copies;  // Workers currently rendering this item.
+    bool       done;
+};
+
+struct WorkQueue {
+    std::mutex              mutex;
+    std::condition_variable changed;
+    std::vector<WorkItem>   items;
+    std::deque<uint32_t>    pending;
+    uint32_t                doneCount = 0;
+    std::vector<float>      accumulation;   // Merged RGB sums & sample counts of the whole image.
+    bool                    finished = false; // All workers are done or lost.
+};
+
+static void splitWork(IN const RenderOptions* options, OUT WorkQueue* queue)
+{
+    // Sample ranges outermost, so the first pass covers the whole image early.
+    for (uint32_t sampleBase = 0; sampleBase < options->samplesPerPixel; sampleBase += options->samplesPerTile) {
+        for (uint32_t y = 0; y < options->imageHeight; y += options->tileSize) {
+            for (uint32_t x = 0; x < options->imageWidth; x += options->tileSize) {
+                WorkItem item = {
+                    .tile = {
+                        .x = x,
+                        .y = y,
+                        .width = std::min(options->tileSize, options->imageWidth - x),
+                        .height = std::min(options->tileSize, options->imageHeight - y),
+                        .sampleBase = sampleBase,
+                        .sampleCount = std::min(options->samplesPerTile, options->samplesPerPixel - sampleBase)
+                    },
+                    .copies = 0,
+                    .done = false
+                };
+                queue->pending.push_back(static_cast<uint32_t>(queue->items.size()));
+                queue->items.push_back(item);
+            }
+        }
+    }
+}
+
+// Take the next item, or duplicate the least-copied unfinished one. UINT32_MAX when the frame is done.
+static uint32_t acquireWork(IN WorkQueue* queue)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    for (;;) {
+        if (queue->doneCount == queue->items.size()) {
+            return UINT32_MAX;
+        }
+        while (!queue->pending.empty()) {
+            uint32_t workId = queue->pending.front();
+            queue->pending.pop_front();
+            if (!queue->items[workId].done) {
+                queue->items[workId].copies++;
+                return workId;
+            }
+        }
+        uint32_t straggler = UINT32_MAX;
+        for (uint32_t iter = 0; iter < queue->items.size(); ++iter) {
+            const WorkItem& item = queue->items[iter];
+            if (!item.done && item.copies < MAX_WORK_COPIES &&
+                (straggler == UINT32_MAX || item.copies < queue->items[straggler].copies)) {
+                straggler = iter;
+            }
+        }
+        if (straggler != UINT32_MAX) {
+            queue->items[straggler].copies++;
+            return straggler;
+        }
+        queue->changed.wait(lock);
+    }
+}
+
+static void releaseWork(IN WorkQueue* queue, IN uint32_t workId, IN const float* accumulation)
+{
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    WorkItem& item = queue->items[workId];
+    item.copies--;
+    if (accumulation != nullptr && !item.done) {
+        uint32_t imageWidth = renderOptions.imageWidth;
+        for (uint32_t row = 0; row < item.tile.height; ++row) {
+            float* destination = queue->accumulation.data() +
+                                 (static_cast<size_t>(item.tile.y + row) * imageWidth + item.tile.x) * 4;
+            const float* source = accumulation + static_cast<size_t>(row) * item.tile.width * 4;
+            for (uint32_t iter = 0; iter < item.tile.width * 4; ++iter) {
+                destination[iter] += source[iter];
+            }
+        }
+        item.done = true;
+        queue->doneCount++;
+        if (queue->doneCount % 64 == 0 || queue->doneCount == queue->items.size()) {
+            printf("Coordinator: %u/%zu work items done.\n", queue->doneCount, queue->items.size());
+        }
+    } else if (!item.done && item.copies == 0) {
+        // Lost with its worker, hand it to someone else first.
+        queue->pending.push_front(workId);
+    }
+    queue->changed.notify_all();
+}
+
+static void snapshotWork(IN WorkQueue* queue, IN OUT Checkpoint* checkpoint)
+{
+    checkpoint->doneCount = queue->doneCount;
+    for (size_t iter = 0; iter < queue->items.size(); ++iter) {
+        checkpoint->done[iter] = queue->items[iter].done ? 1 : 0;
+    }
+    checkpoint->accumulation = queue->accumulation;
+}
+
+// Copy the merged work into the snapshot every interval & write it while the workers keep merging,
+// they only wait for the copy. The last snapshot is taken once the workers are finished.
+static void checkpointWork(IN WorkQueue* queue, IN const char* filename, IN uint64_t key)
+{
+    Checkpoint checkpoint = {
+        .key = key,
+        .imageWidth = renderOptions.imageWidth,
+        .imageHeight = renderOptions.imageHeight,
+        .doneCount = 0,
+        .done = std::vector<uint8_t>(queue->items.size())
+    };
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    uint32_t written = queue->doneCount;
+    for (;;) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(renderOptions.checkpointInterval);
+        bool finished = queue->changed.wait_until(lock, deadline, [queue]() { return queue->finished; });
+        if (queue->doneCount != written) {
+            snapshotWork(queue, &checkpoint);
+            written = queue->doneCount;
+            lock.unlock();
+            if (WriteCheckpoint(filename, &checkpoint) == VK_SUCCESS) {
+                printf("Coordinator: checkpoint of %u/%zu work items written to %s.\n", checkpoint.doneCount,
+                       checkpoint.done.size(), filename);
+            } else {
+                fprintf(stderr, "Coordinator: cannot write checkpoint %s.\n", filename);
+            }
+            lock.lock();
+        }
+        if (finished) {
+            return;
+        }
+    }
+}
+
+// Take the done work items & their accumulation from a checkpoint of the same render.
+static VkResult resumeWork(IN const char* filename, IN uint64_t key, IN OUT WorkQueue* queue)
+{
+    Checkpoint checkpoint;
+    VkResult result = ReadCheckpoint(filename, key, renderOptions.imageWidth, renderOptions.imageHeight,
+                                     static_cast<uint32_t>(queue->items.size()), &checkpoint);
+    if (result == VK_ERROR_FORMAT_NOT_SUPPORTED) {
+        fprintf(stderr, "Coordinator: checkpoint %s is damaged or belongs to another scene, camera or work split.\n",
+                filename);
+        return result;
+    }
+    if (result != VK_SUCCESS) {
+        fprintf(stderr, "Coordinator: cannot read checkpoint %s.\n", filename);
+        return result;
+    }
+    // Done items stay in pending, acquireWork skips them.
+    for (size_t iter = 0; iter < queue->items.size(); ++iter) {
+        queue->items[iter].done = checkpoint.done[iter] != 0;
+        queue->doneCount += checkpoint.done[iter] != 0 ? 1 : 0;
+    }
+    queue->accumulation = std::move(checkpoint.accumulation);
+    printf("Coordinator: resuming %s with %u/%zu work items done.\n", filename, queue->doneCount, queue->items.size());
+    return VK_SUCCESS;
+}
+
+static void driveWorker(IN NetSocket connection, IN const char* name, IN WorkQueue* queue)
+{
+    std::vector<float> accumulation(static_cast<size_t>(renderOptions.tileSize) * renderOptions.tileSize * 4);
+    uint32_t workId;
+    while ((workId = acquireWork(queue)) != UINT32_MAX) {
+        DistributedTileHeader request = {
+            .workId = workId,
+            .tile = queue->items[workId].tile
+        };
+        size_t pixelBytes = static_cast<size_t>(request.tile.width) * request.tile.height * 4 * sizeof(float);
+        DistributedMessageHeader header;
+        DistributedTileHeader response;
+        if (!sendMessage(connection, DISTRIBUTED_MESSAGE_TILE_REQUEST, &request, sizeof(request)) ||
+            !receiveResultHeader(connection, &header) || header.type != DISTRIBUTED_MESSAGE_TILE_RESULT ||
+            header.payloadSize != sizeof(response) + pixelBytes ||
+            !NetReceiveAll(connection, &response, sizeof(response)) || response.workId != workId ||
+            !NetReceiveAll(connection, accumulation.data(), pixelBytes)) {
+            fprintf(stderr, "Coordinator: lost worker %s, re-issuing its work.\n", name);
+            releaseWork(queue, workId, nullptr);
+            return;
+        }
+        releaseWork(queue, workId, accumulation.data());
+    }
+    sendMessage(connection, DISTRIBUTED_MESSAGE_BYE, nullptr, 0);
+}
+
+static NetSocket connectWorker(IN const char* address, IN const DistributedSetup* setup, IN const void* scene)
+{
+    char host[256];
+    const char* colon = strrchr(address, ':');
+    if (colon == nullptr || static_cast<size_t>(colon - address) >= sizeof(host)) {
+        fprintf(stderr, "Coordinator: invalid worker address %s.\n", address);
+        return INVALID_NET_SOCKET;
+    }
+    memcpy(host, address, colon - address);
+    host[colon - address] = '\0';
+    uint16_t port = static_cast<uint16_t>(atoi(colon + 1));
+
+    NetSocket connection = NetConnect(host, port);
+    if (connection == INVALID_NET_SOCKET) {
+        fprintf(stderr, "Coordinator: cannot connect to worker %s.\n", address);
+        return INVALID_NET_SOCKET;
+    }
+    NetSetReceiveTimeout(connection, WORKER_TIMEOUT_SECONDS);
+    DistributedMessageHeader header = {
+        .magic = DISTRIBUTED_MAGIC,
+        .type = DISTRIBUTED_MESSAGE_SETUP,
+        .payloadSize = sizeof(*setup) + setup->sceneSize
+    };
+    if (!NetSendAll(connection, &header, sizeof(header)) || !NetSendAll(connection, setup, sizeof(*setup)) ||
+        !NetSendAll(connection, scene, setup->sceneSize)) {
+        fprintf(stderr, "Coordinator: cannot set up worker %s.\n", address);
+        NetClose(connection);
+        return INVALID_NET_SOCKET;
+    }
+    return connection;
+}
+
+VkResult RunRenderCoordinator(void)
+{
+    if (!NetInitialize()) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    // Workers get the file image as is, including a cached BVH.
+    MappedSceneFile scene = {};
+    if (renderOptions.sceneFile != nullptr && MapSceneFile(renderOptions.sceneFile, &scene) != VK_SUCCESS) {
+        fprintf(stderr, "Coordinator: cannot map %s.\n", renderOptions.sceneFile);
+        NetCleanup();
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    DistributedSetup setup = {
+        .imageWidth = renderOptions.imageWidth,
+        .imageHeight = renderOptions.imageHeight,
+        .maxTileWidth = renderOptions.tileSize,
+        .maxTileHeight = renderOptions.tileSize,
+        .camera = renderOptions.camera,
+        .sceneSize = scene.size
+    };
+
+    WorkQueue queue;
+    queue.accumulation.assign(static_cast<size_t>(setup.imageWidth) * setup.imageHeight * 4, 0.f);
+    splitWork(&renderOptions, &queue);
+
+    const char* checkpointFile = renderOptions.checkpointFile;
+    uint64_t checkpointKey = HashCheckpointKey(scene.data, scene.size, &renderOptions);
+    if (renderOptions.resume && resumeWork(checkpointFile, checkpointKey, &queue) != VK_SUCCESS) {
+        UnmapSceneFile(&scene);
+        NetCleanup();
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    std::thread checkpointer;
+    if (checkpointFile != nullptr) {
+        checkpointer = std::thread(checkpointWork, &queue, checkpointFile, checkpointKey);
+    }
+
+    // Keep the address strings alive for the worker threads.
+    std::vector<std::string> addresses;
+    for (const char* cursor = renderOptions.workers; cursor != nullptr && *cursor != '\0';) {
+        const char* comma = strchr(cursor, ',');
+        addresses.emplace_back(cursor, comma == nullptr ? strlen(cursor) : static_cast<size_t>(comma - cursor));
+        cursor = comma == nullptr ? nullptr : comma + 1;
+    }
+
+    std::vector<std::thread> threads;
+    for (const std::string& address : addresses) {
+        NetSocket connection = connectWorker(address.c_str(), &setup, scene.data);
+        if (connection == INVALID_NET_SOCKET) {
+            continue;
+        }
+        threads.emplace_back([connection, &address, &queue]() {
+            driveWorker(connection, address.c_str(), &queue);
+            NetClose(connection);
+        });
+    }
+
+    printf("Coordinator: %zu work items on %zu workers.\n", queue.items.size(), threads.size());
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    if (checkpointer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.finished = true;
+        }
+        queue.changed.notify_all();
+        checkpointer.join();
+    }
+    UnmapSceneFile(&scene);
+    NetCleanup();
+
+    if (queue.doneCount != queue.items.size()) {
+        fprintf(stderr, "Coordinator: all workers lost, %u/%zu work items done.\n",
+                queue.doneCount, queue.items.size());
+        return VK_ERROR_DEVICE_LOST;
+    }
+    return WriteAccumulationImage(renderOptions.outputFile, setup.imageWidth, setup.imageHeight,
+                                  queue.accumulation.data());
+}
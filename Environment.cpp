@@ -13,11 +13,15 @@
 
 
 #include <Environment.hpp>
+#include <Options.hpp>
 #include <Platform.hpp>
 
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <iostream>
+#include <iterator>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -33,6 +37,17 @@ VkPhysicalDevice vulkanPhysicalDevice;
 VkSurfaceKHR     vulkanWindowSurface;
 uint32_t vulkanGraphicsQueueFamilyIndex = UINT32_MAX;
 uint32_t vulkanComputeQueueFamilyIndex = UINT32_MAX;
+uint32_t vulkanApiVersion = VK_API_VERSION_1_0;
+bool vulkanRayQueryEnabled;
+bool vulkanSubgroupBallotSupported;
+bool vulkanFloat16Enabled;
+bool vulkanPipelineStatisticsEnabled;
+float vulkanTimestampPeriod;
+uint32_t vulkanTimestampValidBits;
+static uint32_t vulkanInstanceApiVersion = VK_API_VERSION_1_0;
+// Queues need external synchronization, render sessions on other threads share them.
+// One lock for all, the graphics & compute queue may be the same VkQueue anyway.
+static std::mutex vulkanQueueMutex;
 
 #ifdef DEBUG_INFORMATION
 const char*        enabledLayers[] = {
@@ -51,6 +66,26 @@ const char* enabledExtensions[] = {
 };
 const uint32_t enabledExtensionCount = static_cast<uint32_t>(sizeof(enabledExtensions) / sizeof(const char*));
 
+const char* rayQueryExtensions[] = {
+    "VK_KHR_acceleration_structure",
+    "VK_KHR_ray_query",
+    "VK_KHR_deferred_host_operations"   // Required by VK_KHR_acceleration_structure.
+};
+
+static bool deviceExtensionSupported(IN VkPhysicalDevice device, IN const char* name)
+{
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+    std::vector<VkExtensionProperties> extensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, extensions.data());
+    for (const VkExtensionProperties& extension : extensions) {
+        if (strcmp(name, extension.extensionName) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 static std::vector<const char*> ReduceUnsupportedValidationLayer() {
 #ifdef DEBUG_INFORMATION
     uint32_t layerCount;
@@ -73,18 +108,29 @@ static std::vector<const char*> ReduceUnsupportedValidationLayer() {
 #endif
 }
 
-VkResult CreateVulkanRuntimeEnvironment(void)
+VkResult CreateVulkanRuntimeEnvironment(IN bool headless)
 {
 
     VkResult result;
 
+    // As new as the loader allows up to 1.2: subgroup ballots & fp16 shading need 1.1, ray queries 1.2.
+    // A 1.0 loader has no vkEnumerateInstanceVersion & rejects anything but 1.0.
+    PFN_vkEnumerateInstanceVersion enumerateInstanceVersion = reinterpret_cast<PFN_vkEnumerateInstanceVersion>(
+        vkGetInstanceProcAddr(nullptr, "vkEnumerateInstanceVersion"));
+    uint32_t loaderApiVersion = VK_API_VERSION_1_0;
+    if (enumerateInstanceVersion != nullptr && enumerateInstanceVersion(&loaderApiVersion) == VK_SUCCESS) {
+        loaderApiVersion = VK_MAKE_API_VERSION(0, VK_API_VERSION_MAJOR(loaderApiVersion),
+                                               VK_API_VERSION_MINOR(loaderApiVersion), 0);
+        vulkanInstanceApiVersion = std::min<uint32_t>(loaderApiVersion, VK_API_VERSION_1_2);
+    }
+
     VkApplicationInfo appInfo = {
         .sType = VK_STRUCTURE_TYPE_APPLICATION_INFO,
         .pApplicationName = applicationNameNarrow,
         .applicationVersion = VK_MAKE_VERSION(1, 0, 0),
         .pEngineName = applicationNameNarrow,
         .engineVersion = VK_MAKE_VERSION(1, 0, 0),
-        .apiVersion = VK_API_VERSION_1_0
+        .apiVersion = vulkanInstanceApiVersion
     };
 
     std::vector<const char*> layers = ReduceUnsupportedValidationLayer();
@@ -93,8 +139,8 @@ VkResult CreateVulkanRuntimeEnvironment(void)
         .pApplicationInfo = &appInfo,
         .enabledLayerCount = static_cast<uint32_t>(layers.size()),
         .ppEnabledLayerNames = layers.data(),
-        .enabledExtensionCount = platformExtensionCount,
-        .ppEnabledExtensionNames = platformExtensions
+        .enabledExtensionCount = headless ? 0 : platformExtensionCount,
+        .ppEnabledExtensionNames = headless ? nullptr : platformExtensions
     };
 
     result = vkCreateInstance(&createInfo, nullptr, &vulkanInstance);
@@ -122,6 +168,7 @@ static VkResult getDeviceQueueIndexByName(IN VkPhysicalDevice device)
         if (properties[iter].queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)) {
             vulkanGraphicsQueueFamilyIndex = iter;
             vulkanComputeQueueFamilyIndex = iter;
+            vulkanTimestampValidBits = properties[iter].timestampValidBits;
             break;
         }
     }
@@ -134,7 +181,81 @@ static VkResult getDeviceQueueIndexByName(IN VkPhysicalDevice device)
     return result;
 }
 
-VkResult CreateVulkanWindowEnvironment(void)
+// Hardware traversal needs a 1.2 device with the ray query extensions & buffer device addresses.
+static bool queryRayQuerySupport(IN VkPhysicalDevice device)
+{
+    // Persistent threads & fp16 shading are compute traversal kernels, unless ray queries are explicitly asked for.
+    if (renderOptions.traversal == TRAVERSAL_COMPUTE || renderOptions.traversal == TRAVERSAL_LINEAR ||
+        (renderOptions.traversal == TRAVERSAL_AUTO && renderOptions.persistentWorkgroups != 0) ||
+        (renderOptions.traversal == TRAVERSAL_AUTO && renderOptions.shadingPrecision == SHADING_PRECISION_FP16) ||
+        vulkanApiVersion < VK_API_VERSION_1_2) {
+        return false;
+    }
+    for (const char* required : rayQueryExtensions) {
+        if (!deviceExtensionSupported(device, required)) {
+            return false;
+        }
+    }
+
+    VkPhysicalDeviceRayQueryFeaturesKHR rayQueryFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_QUERY_FEATURES_KHR
+    };
+    VkPhysicalDeviceAccelerationStructureFeaturesKHR accelerationStructureFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR,
+        .pNext = &rayQueryFeatures
+    };
+    VkPhysicalDeviceVulkan12Features vulkan12Features = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+        .pNext = &accelerationStructureFeatures
+    };
+    VkPhysicalDeviceFeatures2 features = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+        .pNext = &vulkan12Features
+    };
+    vkGetPhysicalDeviceFeatures2(device, &features);
+    return vulkan12Features.bufferDeviceAddress && accelerationStructureFeatures.accelerationStructure &&
+           rayQueryFeatures.rayQuery;
+}
+
+// Persistent threads refill idle lanes through subgroup ballots, core in 1.1 but optional per stage.
+static bool querySubgroupBallotSupport(IN VkPhysicalDevice device)
+{
+    if (vulkanApiVersion < VK_API_VERSION_1_1) {
+        return false;
+    }
+    VkPhysicalDeviceSubgroupProperties subgroupProperties = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES
+    };
+    VkPhysicalDeviceProperties2 properties2 = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+        .pNext = &subgroupProperties
+    };
+    vkGetPhysicalDeviceProperties2(device, &properties2);
+    VkSubgroupFeatureFlags required = VK_SUBGROUP_FEATURE_BASIC_BIT | VK_SUBGROUP_FEATURE_BALLOT_BIT;
+    return (subgroupProperties.supportedStages & VK_SHADER_STAGE_COMPUTE_BIT) != 0 &&
+           (subgroupProperties.supportedOperations & required) == required;
+}
+
+// Half float arithmetic in shaders, for the fp16 shading variant. Core in 1.2, an extension on 1.1.
+static bool queryFloat16Support(IN VkPhysicalDevice device)
+{
+    if (vulkanApiVersion < VK_API_VERSION_1_1 ||
+        (vulkanApiVersion < VK_API_VERSION_1_2 &&
+         !deviceExtensionSupported(device, VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME))) {
+        return false;
+    }
+    VkPhysicalDeviceShaderFloat16Int8FeaturesKHR float16Features = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_FLOAT16_INT8_FEATURES_KHR
+    };
+    VkPhysicalDeviceFeatures2 features = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+        .pNext = &float16Features
+    };
+    vkGetPhysicalDeviceFeatures2(device, &features);
+    return float16Features.shaderFloat16;
+}
+
+static VkResult createLogicalDevice(IN bool presentable)
 {
     VkResult result;
     uint32_t deviceCount;
@@ -192,13 +313,64 @@ selection_done:
         });
     }
 
+    vulkanApiVersion = std::min(vulkanInstanceApiVersion, deviceProperties.apiVersion);
+    vulkanTimestampPeriod = deviceProperties.limits.timestampPeriod;
+    vulkanRayQueryEnabled = queryRayQuerySupport(vulkanPhysicalDevice);
+    vulkanSubgroupBallotSupported = querySubgroupBallotSupport(vulkanPhysicalDevice);
+    vulkanFloat16Enabled = queryFloat16Support(vulkanPhysicalDevice);
+    if (renderOptions.traversal == TRAVERSAL_RAY_QUERY && !vulkanRayQueryEnabled) {
+        fprintf(stderr, "%s does not support ray queries.\n", deviceProperties.deviceName);
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+    std::vector<const char*> extensions;
+    if (presentable) {
+        extensions.insert(extensions.end(), enabledExtensions, enabledExtensions + enabledExtensionCount);
+    }
+    if (vulkanRayQueryEnabled) {
+        extensions.insert(extensions.end(), std::begin(rayQueryExtensions), std::end(rayQueryExtensions));
+    }
+    if (vulkanFloat16Enabled && vulkanApiVersion < VK_API_VERSION_1_2) {
+        extensions.push_back(VK_KHR_SHADER_FLOAT16_INT8_EXTENSION_NAME);
+    }
+
+    VkPhysicalDeviceRayQueryFeaturesKHR rayQueryFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_RAY_QUERY_FEATURES_KHR,
+        .rayQuery = VK_TRUE
+    };
+    VkPhysicalDeviceAccelerationStructureFeaturesKHR accelerationStructureFeatures = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_ACCELERATION_STRUCTURE_FEATURES_KHR,
+        .pNext = &rayQueryFeatures,
+        .accelerationStructure = VK_TRUE
+    };
+    VkPhysicalDeviceVulkan12Features vulkan12Features = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+        .pNext = &accelerationStructureFeatures,
+        .shaderFloat16 = vulkanFloat16Enabled ? VK_TRUE : VK_FALSE,
+        .bufferDeviceAddress = VK_TRUE
+    };
+    // Must not be chained next to the 1.2 features, which then enable it instead.
+    VkPhysicalDeviceShaderFloat16Int8FeaturesKHR float16Features = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_FLOAT16_INT8_FEATURES_KHR,
+        .shaderFloat16 = VK_TRUE
+    };
+    void* features = nullptr;
+    if (vulkanRayQueryEnabled) {
+        features = &vulkan12Features;
+    } else if (vulkanFloat16Enabled) {
+        features = &float16Features;
+    }
+    VkPhysicalDeviceFeatures supportedFeatures;
+    vkGetPhysicalDeviceFeatures(vulkanPhysicalDevice, &supportedFeatures);
+    vulkanPipelineStatisticsEnabled = renderOptions.costCounters && supportedFeatures.pipelineStatisticsQuery;
     VkPhysicalDeviceFeatures deviceFeatures{};
+    deviceFeatures.pipelineStatisticsQuery = vulkanPipelineStatisticsEnabled ? VK_TRUE : VK_FALSE;
     VkDeviceCreateInfo createInfo = {
         .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
+        .pNext = features,
         .queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size()),
         .pQueueCreateInfos = queueCreateInfos.data(),
-        .enabledExtensionCount = enabledExtensionCount,
-        .ppEnabledExtensionNames = enabledExtensions,
+        .enabledExtensionCount = static_cast<uint32_t>(extensions.size()),
+        .ppEnabledExtensionNames = extensions.data(),
         .pEnabledFeatures = &deviceFeatures,
     };
 
@@ -208,18 +380,120 @@ selection_done:
     }
     vkGetDeviceQueue(vulkanLogicalDevice, vulkanGraphicsQueueFamilyIndex, 0, &vulkanGraphicsQueue);
     vkGetDeviceQueue(vulkanLogicalDevice, vulkanComputeQueueFamilyIndex, 0, &vulkanComputeQueue);
+    return VK_SUCCESS;
+}
 
-    // Create Window.
-    result = PlatformCreateWindow(&vulkanWindowSurface);
+VkResult CreateVulkanWindowDevice(void)
+{
+    return createLogicalDevice(true);
+}
+
+VkResult CreateVulkanWindowSurface(void)
+{
+    return PlatformCreateWindow(&vulkanWindowSurface);
+}
+
+VkResult CreateVulkanHeadlessEnvironment(void)
+{
+    return createLogicalDevice(false);
+}
+
+uint32_t FindMemoryType(IN uint32_t typeFilter, IN VkMemoryPropertyFlags properties)
+{
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(vulkanPhysicalDevice, &memProperties);
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+        if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+    return UINT32_MAX;
+}
+
+VkResult CreateBuffer(IN VkDeviceSize size, IN VkBufferUsageFlags usage, IN VkMemoryPropertyFlags properties,
+                      OUT VkBuffer* buffer, OUT VkDeviceMemory* memory)
+{
+    VkBufferCreateInfo bufferInfo = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = size,
+        .usage = usage,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE
+    };
+    VkResult result = vkCreateBuffer(vulkanLogicalDevice, &bufferInfo, nullptr, buffer);
     if (result != VK_SUCCESS) {
         return result;
     }
-    return VK_SUCCESS;
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(vulkanLogicalDevice, *buffer, &memRequirements);
+    // Buffers used by address (acceleration structure inputs) need memory allocated for it.
+    VkMemoryAllocateFlagsInfo allocateFlagsInfo = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO,
+        .flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT
+    };
+    VkMemoryAllocateInfo memoryAllocateInfo = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .pNext = (usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) ? &allocateFlagsInfo : nullptr,
+        .allocationSize = memRequirements.size,
+        .memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, properties)
+    };
+    if (memoryAllocateInfo.memoryTypeIndex == UINT32_MAX) {
+        vkDestroyBuffer(vulkanLogicalDevice, *buffer, nullptr);
+        *buffer = VK_NULL_HANDLE;
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+    result = vkAllocateMemory(vulkanLogicalDevice, &memoryAllocateInfo, nullptr, memory);
+    if (result != VK_SUCCESS) {
+        vkDestroyBuffer(vulkanLogicalDevice, *buffer, nullptr);
+        *buffer = VK_NULL_HANDLE;
+        return result;
+    }
+    return vkBindBufferMemory(vulkanLogicalDevice, *buffer, *memory, 0);
+}
+
+VkResult SubmitVulkanQueue(IN VkQueue queue, IN uint32_t submitCount, IN const VkSubmitInfo* submits,
+                           IN VkFence fence)
+{
+    std::lock_guard<std::mutex> lock(vulkanQueueMutex);
+    return vkQueueSubmit(queue, submitCount, submits, fence);
+}
+
+VkResult PresentVulkanQueue(IN VkQueue queue, IN const VkPresentInfoKHR* presentInfo)
+{
+    std::lock_guard<std::mutex> lock(vulkanQueueMutex);
+    return vkQueuePresentKHR(queue, presentInfo);
+}
+
+VkResult SubmitVulkanQueueAndWait(IN VkQueue queue, IN const VkSubmitInfo* submit)
+{
+    // Wait on a fence of our own, vkQueueWaitIdle would also wait for (& need the lock of) other sessions.
+    VkFenceCreateInfo fenceInfo = {
+        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO
+    };
+    VkFence fence;
+    VkResult result = vkCreateFence(vulkanLogicalDevice, &fenceInfo, nullptr, &fence);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    result = SubmitVulkanQueue(queue, 1, submit, fence);
+    if (result == VK_SUCCESS) {
+        result = vkWaitForFences(vulkanLogicalDevice, 1, &fence, VK_TRUE, UINT64_MAX);
+    }
+    vkDestroyFence(vulkanLogicalDevice, fence, nullptr);
+    return result;
+}
+
+VkResult WaitVulkanDeviceIdle(void)
+{
+    std::lock_guard<std::mutex> lock(vulkanQueueMutex);
+    return vkDeviceWaitIdle(vulkanLogicalDevice);
 }
 
 VkResult DestroyVulkanRuntimeEnvironment(void)
 {
-    vkDestroySurfaceKHR(vulkanInstance, vulkanWindowSurface, nullptr);
+    if (vulkanWindowSurface != nullptr) {
+        vkDestroySurfaceKHR(vulkanInstance, vulkanWindowSurface, nullptr);
+    }
     vkDestroyDevice(vulkanLogicalDevice, nullptr);
     vkDestroyInstance(vulkanInstance, nullptr);
     return VK_SUCCESS;
@@ -0,0 +1,284 @@
+/* @file ImageOutput.cpp
+
+    Implementation of writing rendered images to disk.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <ImageOutput.hpp>
+#include <Utility.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static uint8_t linearToSrgb(IN float value)
+{
+    value = std::clamp(value, 0.f, 1.f);
+    value = (value <= 0.0031308f) ? value * 12.92f : 1.055f * powf(value, 1.f / 2.4f) - 0.055f;
+    return static_cast<uint8_t>(value * 255.f + 0.5f);
+}
+
+VkResult WriteAccumulationImage(IN const char* filename, IN uint32_t width, IN uint32_t height,
+                                IN const float* accumulation)
+{
+    FILE* file = fopen(filename, "wb");
+    if (file == nullptr) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+
+    bool floatingPoint = HasExtension(filename, ".pfm");
+    // PFM is little-endian (negative scale) and stored bottom-to-top.
+    fprintf(file, floatingPoint ? "PF\n%u %u\n-1.0\n" : "P6\n%u %u\n255\n", width, height);
+
+    std::vector<float> floatRow(floatingPoint ? width * 3 : 0);
+    std::vector<uint8_t> byteRow(floatingPoint ? 0 : width * 3);
+    for (uint32_t row = 0; row < height; ++row) {
+        uint32_t y = floatingPoint ? height - 1 - row : row;
+        const float* pixel = accumulation + static_cast<size_t>(y) * width * 4;
+        for (uint32_t x = 0; x < width; ++x, pixel += 4) {
+            float samples = pixel[3] > 0.f ? pixel[3] : 1.f;
+            for (uint32_t channel = 0; channel < 3; ++channel) {
+                float value = pixel[channel] / samples;
+                if (floatingPoint) {
+                    floatRow[x * 3 + channel] = value;
+                } else {
+                    byteRow[x * 3 + channel] = linearToSrgb(value);
+                }
+            }
+        }
+        if (floatingPoint) {
+            fwrite(floatRow.data(), sizeof(float), floatRow.size(), file);
+        } else {
+            fwrite(byteRow.data(), 1, byteRow.size(), file);
+        }
+    }
+
+    bool failed = ferror(file) != 0;
+    fclose(file);
+    return failed ? VK_ERROR_UNKNOWN : VK_SUCCESS;
+}
+
+VkResult WriteVideoStreamHeader(IN FILE* stream, IN VideoStreamFormat format, IN uint32_t width, IN uint32_t height,
+                                IN uint32_t framesPerSecond)
+{
+    if (format == VIDEO_STREAM_Y4M) {
+        fprintf(stream, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C444 XCOLORRANGE=LIMITED\n", width, height, framesPerSecond);
+    }
+    return ferror(stream) != 0 ? VK_ERROR_UNKNOWN : VK_SUCCESS;
+}
+
+VkResult WriteVideoStreamFrame(IN FILE* stream, IN VideoStreamFormat format, IN uint32_t width, IN uint32_t height,
+                               IN const float* accumulation)
+{
+    size_t pixelCount = static_cast<size_t>(width) * height;
+    // Interleaved RGB, or the Y, Cb & Cr planes one after the other.
+    std::vector<uint8_t> frame(pixelCount * 3);
+    for (size_t iter = 0; iter < pixelCount; ++iter) {
+        const float* pixel = accumulation + iter * 4;
+        float samples = pixel[3] > 0.f ? pixel[3] : 1.f;
+        uint8_t rgb[3];
+        for (uint32_t channel = 0; channel < 3; ++channel) {
+            rgb[channel] = linearToSrgb(pixel[channel] / samples);
+        }
+        if (format == VIDEO_STREAM_RGB24) {
+            memcpy(&frame[iter * 3], rgb, 3);
+            continue;
+        }
+        // Studio range BT.601, what players assume for Y4M.
+        float r = rgb[0] / 255.f, g = rgb[1] / 255.f, b = rgb[2] / 255.f;
+        float y = 0.299f * r + 0.587f * g + 0.114f * b;
+        frame[iter] = static_cast<uint8_t>(16.f + 219.f * y + 0.5f);
+        frame[pixelCount + iter] = static_cast<uint8_t>(128.f + 224.f * (b - y) / 1.772f + 0.5f);
+        frame[pixelCount * 2 + iter] = static_cast<uint8_t>(128.f + 224.f * (r - y) / 1.402f + 0.5f);
+    }
+    if (format == VIDEO_STREAM_Y4M) {
+        fputs("FRAME\n", stream);
+    }
+    fwrite(frame.data(), 1, frame.size(), stream);
+    return ferror(stream) != 0 ? VK_ERROR_UNKNOWN : VK_SUCCESS;
+}
+
+struct TiledImageWriter {
+    FILE*                 file;
+    uint64_t              position;     // Bytes written, ftell is 32-bit on some platforms.
+    bool                  big;          // BigTIFF: 64-bit offsets.
+    uint32_t              width;
+    uint32_t              height;
+    uint32_t              tileSize;
+    uint32_t              tilesAcross;
+    std::vector<uint64_t> tileOffsets;  // 0 while not written.
+    std::vector<uint8_t>  tile;
+};
+
+enum TiffType {
+    TIFF_SHORT = 3,
+    TIFF_LONG = 4,
+    TIFF_LONG8 = 16
+};
+
+static void writeTiff(TiledImageWriter* writer, const void* data, size_t size)
+{
+    fwrite(data, 1, size, writer->file);
+    writer->position += size;
+}
+
+// Offsets & counts are 4 bytes in TIFF, 8 in BigTIFF.
+static void writeTiffOffset(TiledImageWriter* writer, uint64_t value)
+{
+    uint32_t narrow = static_cast<uint32_t>(value);
+    writeTiff(writer, writer->big ? static_cast<const void*>(&value) : &narrow, writer->big ? 8 : 4);
+}
+
+// Directory entry. Values that fit the offset field are stored in place, value is the offset of the others.
+static void writeTiffEntry(TiledImageWriter* writer, uint16_t tag, TiffType type, uint64_t count, uint64_t value)
+{
+    uint16_t tagType[2] = { tag, static_cast<uint16_t>(type) };
+    writeTiff(writer, tagType, sizeof(tagType));
+    writeTiffOffset(writer, count);
+    if (type == TIFF_SHORT && count == 1) {
+        uint16_t shortValue[4] = { static_cast<uint16_t>(value) };
+        writeTiff(writer, shortValue, writer->big ? 8 : 4);
+    } else {
+        writeTiffOffset(writer, value);
+    }
+}
+
+// Shorts in place if they fit the offset field, else at offset.
+static void writeTiffShorts(TiledImageWriter* writer, uint16_t tag, uint64_t count, const uint16_t* values,
+                            uint64_t offset)
+{
+    if (count * sizeof(uint16_t) > (writer->big ? 8u : 4u)) {
+        writeTiffEntry(writer, tag, TIFF_SHORT, count, offset);
+        return;
+    }
+    uint16_t tagType[2] = { tag, static_cast<uint16_t>(TIFF_SHORT) };
+    writeTiff(writer, tagType, sizeof(tagType));
+    writeTiffOffset(writer, count);
+    uint16_t inPlace[4] = {};
+    std::copy(values, values + count, inPlace);
+    writeTiff(writer, inPlace, writer->big ? 8 : 4);
+}
+
+VkResult BeginTiledImage(IN const char* filename, IN uint32_t width, IN uint32_t height, IN uint32_t tileSize,
+                         OUT TiledImageWriter** writer)
+{
+    if (tileSize == 0 || tileSize % TIFF_TILE_ALIGNMENT != 0 || width == 0 || height == 0) {
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+    }
+    FILE* file = fopen(filename, "wb");
+    if (file == nullptr) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    uint32_t tilesAcross = (width + tileSize - 1) / tileSize;
+    uint32_t tilesDown = (height + tileSize - 1) / tileSize;
+    uint64_t tileBytes = static_cast<uint64_t>(tileSize) * tileSize * 3;
+    uint64_t tileCount = static_cast<uint64_t>(tilesAcross) * tilesDown;
+    TiledImageWriter* created = new TiledImageWriter{};
+    created->file = file;
+    // Tiles plus directory & its offset arrays, generously.
+    created->big = tileCount * (tileBytes + 16) + 4096 > UINT32_MAX;
+    created->width = width;
+    created->height = height;
+    created->tileSize = tileSize;
+    created->tilesAcross = tilesAcross;
+    created->tileOffsets.assign(tileCount, 0);
+    created->tile.resize(tileBytes);
+
+    // Little-endian header, the directory offset is patched in at the end.
+    if (created->big) {
+        uint16_t header[4] = { 0x4949, 43, 8, 0 };
+        writeTiff(created, header, sizeof(header));
+    } else {
+        uint16_t header[2] = { 0x4949, 42 };
+        writeTiff(created, header, sizeof(header));
+    }
+    writeTiffOffset(created, 0);
+    *writer = created;
+    return ferror(file) != 0 ? VK_ERROR_UNKNOWN : VK_SUCCESS;
+}
+
+VkResult WriteImageTile(IN TiledImageWriter* writer, IN uint32_t x, IN uint32_t y, IN uint32_t width,
+                        IN uint32_t height, IN const float* accumulation)
+{
+    if (x % writer->tileSize != 0 || y % writer->tileSize != 0 || x >= writer->width || y >= writer->height ||
+        width > writer->tileSize || height > writer->tileSize) {
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+    }
+    // Tiles are always whole, what lies beyond the image is padding.
+    std::fill(writer->tile.begin(), writer->tile.end(), 0);
+    for (uint32_t row = 0; row < height; ++row) {
+        const float* pixel = accumulation + static_cast<size_t>(row) * width * 4;
+        uint8_t* destination = &writer->tile[static_cast<size_t>(row) * writer->tileSize * 3];
+        for (uint32_t column = 0; column < width; ++column, pixel += 4) {
+            float samples = pixel[3] > 0.f ? pixel[3] : 1.f;
+            for (uint32_t channel = 0; channel < 3; ++channel) {
+                *destination++ = linearToSrgb(pixel[channel] / samples);
+            }
+        }
+    }
+    size_t index = static_cast<size_t>(y / writer->tileSize) * writer->tilesAcross + x / writer->tileSize;
+    writer->tileOffsets[index] = writer->position;
+    writeTiff(writer, writer->tile.data(), writer->tile.size());
+    return ferror(writer->file) != 0 ? VK_ERROR_UNKNOWN : VK_SUCCESS;
+}
+
+VkResult EndTiledImage(IN TiledImageWriter* writer)
+{
+    uint64_t tileCount = writer->tileOffsets.size();
+    // Tiles never written point at a black one.
+    uint64_t blackTile = 0;
+    for (uint64_t iter = 0; iter < tileCount && blackTile == 0; ++iter) {
+        if (writer->tileOffsets[iter] == 0) {
+            blackTile = writer->position;
+            std::fill(writer->tile.begin(), writer->tile.end(), 0);
+            writeTiff(writer, writer->tile.data(), writer->tile.size());
+        }
+    }
+    uint64_t bitsPerSampleOffset = writer->position;
+    uint16_t bitsPerSample[3] = { 8, 8, 8 };
+    writeTiff(writer, bitsPerSample, sizeof(bitsPerSample));
+    uint64_t offsetsOffset = writer->position;
+    for (uint64_t offset : writer->tileOffsets) {
+        writeTiffOffset(writer, offset != 0 ? offset : blackTile);
+    }
+    uint64_t countsOffset = writer->position;
+    for (uint64_t iter = 0; iter < tileCount; ++iter) {
+        writeTiffOffset(writer, writer->tile.size());
+    }
+    // Directories start on a word boundary.
+    if (writer->position % 2 != 0) {
+        writeTiff(writer, "", 1);
+    }
+    uint64_t directoryOffset = writer->position;
+    TiffType offsetType = writer->big ? TIFF_LONG8 : TIFF_LONG;
+    // A single tile's offset & byte count are stored in place.
+    if (tileCount == 1) {
+        offsetsOffset = writer->tileOffsets[0] != 0 ? writer->tileOffsets[0] : blackTile;
+        countsOffset = writer->tile.size();
+    }
+    // Entry counts are 2 bytes in TIFF, 8 in BigTIFF.
+    uint64_t entryCount = 11;
+    writeTiff(writer, &entryCount, writer->big ? 8 : 2);
+    // Sorted by tag.
+    writeTiffEntry(writer, 256, TIFF_LONG, 1, writer->width);           // ImageWidth
+    writeTiffEntry(writer, 257, TIFF_LONG, 1, writer->height);          // ImageLength
+    writeTiffShorts(writer, 258, 3, bitsPerSample, bitsPerSampleOffset); // BitsPerSample
+    writeTiffEntry(writer, 259, TIFF_SHORT, 1, 1);                      // Compression: none
+    writeTiffEntry(writer, 262, TIFF_SHORT, 1, 2);                      // PhotometricInterpretation: RGB
+    writeTiffEntry(writer, 277, TIFF_SHORT, 1, 3);                      // SamplesPerPixel
+    writeTiffEntry(writer, 284, TIFF_SHORT, 1, 1);                      // PlanarConfiguration: chunky
+    writeTiffEntry(writer, 322, TIFF_LONG, 1, writer->tileSize);        // TileWidth
+    writeTiffEntry(writer, 323, TIFF_LONG, 1, writer->tileSize);        // TileLength
+    writeTiffEntry(writer, 324, offsetType, tileCount, offsetsOffset);  // TileOffsets
+    writeTiffEntry(writer, 325, offsetType, tileCount, countsOffset);   // TileByteCounts
+    writeTiffOffset(writer, 0);                                         // No next directory.
+
+    fseek(writer->file, writer->big ? 8 : 4, SEEK_SET);
+    writeTiffOffset(writer, directoryOffset);
+    bool failed = ferror(writer->file) != 0;
+    failed = fclose(writer->file) != 0 || failed;
+    delete writer;
+    return failed ? VK_ERROR_UNKNOWN : VK_SUCCESS;
+}
@@ -0,0 +1,281 @@
+/* @file Network.cpp
+
+    Implementation of minimal blocking TCP & local socket wrappers.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <Network.hpp>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <afunix.h>
+typedef int socklen_t;
+#define closesocket_impl closesocket
+#ifndef IO_REPARSE_TAG_AF_UNIX
+#define IO_REPARSE_TAG_AF_UNIX 0x80000023L
+#endif
+#else
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define closesocket_impl close
+#endif
+
+bool NetInitialize(void)
+{
+#if defined(_WIN32)
+    WSADATA data;
+    return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+#else
+    // A worker vanishing mid-send must not kill the coordinator.
+    signal(SIGPIPE, SIG_IGN);
+    return true;
+#endif
+}
+
+void NetCleanup(void)
+{
+#if defined(_WIN32)
+    WSACleanup();
+#endif
+}
+
+static void setNoDelay(IN NetSocket socket)
+{
+    int enable = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&enable), sizeof(enable));
+}
+
+NetSocket NetListen(IN uint16_t port)
+{
+    NetSocket listener = socket(AF_INET, SOCK_STREAM, 0);
+    if (listener == INVALID_NET_SOCKET) {
+        return INVALID_NET_SOCKET;
+    }
+
+    int reuse = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(port);
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listener, 4) != 0) {
+        NetClose(listener);
+        return INVALID_NET_SOCKET;
+    }
+    return listener;
+}
+
+NetSocket NetAccept(IN NetSocket listener)
+{
+    sockaddr_storage address;
+    socklen_t addressLength = sizeof(address);
+    NetSocket connection = accept(listener, reinterpret_cast<sockaddr*>(&address), &addressLength);
+    if (connection != INVALID_NET_SOCKET && address.ss_family != AF_UNIX) {
+        setNoDelay(connection);
+    }
+    return connection;
+}
+
+NetSocket NetConnect(IN const char* host, IN uint16_t port)
+{
+    char service[8];
+    snprintf(service, sizeof(service), "%u", port);
+
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses;
+    if (getaddrinfo(host, service, &hints, &addresses) != 0) {
+        return INVALID_NET_SOCKET;
+    }
+
+    NetSocket connection = INVALID_NET_SOCKET;
+    for (addrinfo* iter = addresses; iter != nullptr; iter = iter->ai_next) {
+        connection = socket(iter->ai_family, iter->ai_socktype, iter->ai_protocol);
+        if (connection == INVALID_NET_SOCKET) {
+            continue;
+        }
+        if (connect(connection, iter->ai_addr, static_cast<socklen_t>(iter->ai_addrlen)) == 0) {
+            break;
+        }
+        NetClose(connection);
+        connection = INVALID_NET_SOCKET;
+    }
+    freeaddrinfo(addresses);
+
+    if (connection != INVALID_NET_SOCKET) {
+        setNoDelay(connection);
+    }
+    return connection;
+}
+
+static bool localAddress(IN const char* path, OUT sockaddr_un* address)
+{
+    *address = {};
+    address->sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(address->sun_path)) {
+        return false;
+    }
+    strcpy(address->sun_path, path);
+    return true;
+}
+
+static bool localPathExists(IN const char* path)
+{
+#if defined(_WIN32)
+    return GetFileAttributesA(path) != INVALID_FILE_ATTRIBUTES;
+#else
+    struct stat status;
+    return lstat(path, &status) == 0;
+#endif
+}
+
+// A UNIX domain socket nobody listens on any more, left behind by a daemon that died.
+static bool isStaleLocalSocket(IN const char* path, IN const sockaddr_un* address)
+{
+#if defined(_WIN32)
+    WIN32_FIND_DATAA data;
+    HANDLE find = FindFirstFileA(path, &data);
+    if (find == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    FindClose(find);
+    if ((data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) == 0 || data.dwReserved0 != IO_REPARSE_TAG_AF_UNIX) {
+        return false;
+    }
+#else
+    struct stat status;
+    if (lstat(path, &status) != 0 || !S_ISSOCK(status.st_mode)) {
+        return false;
+    }
+#endif
+    NetSocket probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probe == INVALID_NET_SOCKET) {
+        return false;
+    }
+    bool refused = connect(probe, reinterpret_cast<const sockaddr*>(address), sizeof(*address)) != 0;
+#if defined(_WIN32)
+    refused = refused && WSAGetLastError() == WSAECONNREFUSED;
+#else
+    refused = refused && errno == ECONNREFUSED;
+#endif
+    NetClose(probe);
+    return refused;
+}
+
+NetSocket NetListenLocal(IN const char* path, OUT bool* pathInUse)
+{
+    sockaddr_un address;
+    if (pathInUse != nullptr) {
+        *pathInUse = false;
+    }
+    if (!localAddress(path, &address)) {
+        return INVALID_NET_SOCKET;
+    }
+    // Only a stale socket is replaced: anything else at path is someone's file or a daemon still serving.
+    if (localPathExists(path)) {
+        if (!isStaleLocalSocket(path, &address)) {
+            if (pathInUse != nullptr) {
+                *pathInUse = true;
+            }
+            return INVALID_NET_SOCKET;
+        }
+#if defined(_WIN32)
+        DeleteFileA(path);
+#else
+        unlink(path);
+#endif
+    }
+    NetSocket listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener == INVALID_NET_SOCKET) {
+        return INVALID_NET_SOCKET;
+    }
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listener, 16) != 0) {
+        NetClose(listener);
+        return INVALID_NET_SOCKET;
+    }
+    return listener;
+}
+
+NetSocket NetConnectLocal(IN const char* path)
+{
+    sockaddr_un address;
+    if (!localAddress(path, &address)) {
+        return INVALID_NET_SOCKET;
+    }
+    NetSocket connection = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (connection == INVALID_NET_SOCKET) {
+        return INVALID_NET_SOCKET;
+    }
+    if (connect(connection, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        NetClose(connection);
+        return INVALID_NET_SOCKET;
+    }
+    return connection;
+}
+
+bool NetSetReceiveTimeout(IN NetSocket socket, IN uint32_t timeoutSeconds)
+{
+#if defined(_WIN32)
+    DWORD timeout = timeoutSeconds * 1000;
+#else
+    timeval timeout = {
+        .tv_sec = static_cast<time_t>(timeoutSeconds),
+        .tv_usec = 0
+    };
+#endif
+    return setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout)) == 0;
+}
+
+bool NetSendAll(IN NetSocket socket, IN const void* data, IN size_t size)
+{
+    const char* cursor = static_cast<const char*>(data);
+    while (size > 0) {
+        int chunk = size > (1 << 30) ? (1 << 30) : static_cast<int>(size);
+        auto sent = send(socket, cursor, chunk, 0);
+        if (sent <= 0) {
+            return false;
+        }
+        cursor += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool NetReceiveAll(IN NetSocket socket, OUT void* data, IN size_t size)
+{
+    char* cursor = static_cast<char*>(data);
+    while (size > 0) {
+        int chunk = size > (1 << 30) ? (1 << 30) : static_cast<int>(size);
+        auto received = recv(socket, cursor, chunk, 0);
+        if (received <= 0) {
+            return false;
+        }
+        cursor += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+void NetClose(IN NetSocket socket)
+{
+    if (socket != INVALID_NET_SOCKET) {
+        closesocket_impl(socket);
+    }
+}
@@ -0,0 +1,329 @@
+/* @file Options.cpp
+
+    Implementation of command line parsing.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <Options.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+RenderOptions renderOptions;
+
+static void printUsage(IN const char* executable)
+{
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --worker PORT          Render tiles for a coordinator, listening on PORT.\n"
+        "  --coordinator LIST     Distribute the frame over workers in LIST (host:port,host:port,...).\n"
+        "  --checkpoint FILE      Coordinator: save the progress to FILE periodically & when all workers are lost.\n"
+        "  --checkpoint-interval S\n"
+        "                         Seconds between checkpoints (default %u).\n"
+        "  --resume               Coordinator: continue from --checkpoint FILE, which must match scene, camera,\n"
+        "                         size, --spp, --tile & --tile-spp.\n"
+        "  --size WxH             Image size of offline renders (default %ux%u).\n"
+        "  --spp N                Samples per pixel of offline renders (default %u).\n"
+        "  --tile N               Tile edge length handed to a worker (default %u).\n"
+        "  --tile-spp N           Samples per pixel of one work item (default %u).\n"
+        "  --lookfrom X,Y,Z       Camera position.\n"
+        "  --lookat X,Y,Z         Camera target.\n"
+        "  --vfov DEGREES         Camera vertical field of view.\n"
+        "  --output FILE          Output image of offline renders, .ppm or .pfm (default %s).\n"
+        "  --scene FILE           Scene file written by SceneGenerator (default: built-in scene).\n"
+        "  --traversal MODE       auto (default), compute, rayquery or linear: BVH in the compute shader, hardware ray\n"
+        "                         queries or a brute force scan through shared memory (small scenes, comparisons).\n"
+        "  --pipeline-cache DIR   Where compiled shader variants are kept (default: per-user cache directory).\n"
+        "  --first-hit-cache N    Window: cache primary hits of N fixed sub-pixel positions (1, 4, 16 or 64).\n"
+        "  --tile-culling on|off  Primary rays only test the spheres projected onto their 16x16 tile (default off).\n"
+        "  --persistent-threads N|on|off\n"
+        "                         Compute BVH: N resident workgroups pull pixels from a queue instead of one thread\n"
+        "                         per pixel (on: %u), pays off when path lengths vary a lot.\n"
+        "  --pixel-order ORDER    rows (default), morton or strips: pixels of a workgroup in Z-order, strips also\n"
+        "                         keeps workgroups running together close.\n"
+        "  --ray-binning on|off   Sort the bounce rays of a workgroup by direction & origin before tracing them.\n"
+        "  --display-format F     Window presentation image: rgba16f (default), b10g11r11 or rgba32f (the fp32\n"
+        "                         accumulation image itself). Falls back when the device cannot store the format.\n"
+        "  --frame-budget B       Samples per window frame: fit B ms of GPU time (default %.0f), throughput to\n"
+        "                         maximize samples per second, or fixed for %u per frame.\n"
+        "  --window-samples N     The window stops rendering once N samples per pixel are accumulated & nothing\n"
+        "                         changes, it only presents again when exposed (default %u, 0: never stops).\n"
+        "  --frame-pacing P       compositor (default): the Linux window draws when the compositor can show a frame\n"
+        "                         & sleeps otherwise, or throughput: draws as fast as possible.\n"
+        "  --shading-precision P  fp32 (default) or fp16: half float shading math with the compute BVH, where the\n"
+        "                         device supports shaderFloat16.\n"
+        "  --compare-precision    Render offline with fp32 & fp16 shading, print the difference & write the fp16\n"
+        "                         image to the output file.\n"
+        "  --camera-path FILE     Render a sequence along the keyframes in FILE (frame, lookfrom, lookat, vfov per\n"
+        "                         line). --output takes numbered images (frame%%04d.ppm), a .y4m/.rgb video file or\n"
+        "                         \"|command\" to pipe the frames into, e.g. \"|ffmpeg -i - out.mp4\".\n"
+        "  --fps N                Frame rate of sequence videos (default %u).\n"
+        "  --stream-format F      y4m (default) or rgb: frames piped to a command as YUV4MPEG2 or raw 8-bit RGB.\n"
+        "  --daemon SOCKET        Keep the device & scenes resident and render jobs sent to the local socket SOCKET.\n"
+        "  --submit SOCKET        Send the offline render described by the other options to the daemon at SOCKET.\n"
+        "  --priority N           Of a submitted job, higher ones render first (default 0).\n"
+        "  --shared-memory        Receive the submitted job's image through POSIX shared memory.\n"
+        "  --cost-overlay C       Count per pixel costs & blend a false colour heatmap of counter C over the\n"
+        "                         window: bounces, spheres (hit_sphere calls), nodes (BVH nodes visited) or capped\n"
+        "                         (paths cut at the bounce limit).\n"
+        "  --poster               Render offline one tile at a time, with all its samples, & stream the tiles into\n"
+        "                         the tiled TIFF --output (.tif), so memory use does not grow with --size. --tile\n"
+        "                         must be a multiple of 16.\n"
+        "  --cost-report          Render offline with cost counters & pipeline statistics, print a histogram of\n"
+        "                         each counter & write the heatmap of --cost-overlay (default spheres) to --output.\n",
+        executable, DEFAULT_CHECKPOINT_INTERVAL, renderOptions.imageWidth, renderOptions.imageHeight, renderOptions.samplesPerPixel,
+        renderOptions.tileSize, renderOptions.samplesPerTile, renderOptions.outputFile, DEFAULT_PERSISTENT_WORKGROUPS,
+        static_cast<double>(DEFAULT_FRAME_BUDGET_MS), static_cast<unsigned>(SAMPLES_PER_FRAME), DEFAULT_WINDOW_SAMPLES,
+        renderOptions.framesPerSecond);
+}
+
+static bool parseUnsigned(IN const char* text, OUT uint32_t* value)
+{
+    char* end;
+    unsigned long parsed = strtoul(text, &end, 10);
+    if (end == text || *end != '\0' || parsed == 0 || parsed > UINT32_MAX) {
+        return false;
+    }
+    *value = static_cast<uint32_t>(parsed);
+    return true;
+}
+
+// Like parseUnsigned, for options where 0 means off.
+static bool parseCount(IN const char* text, OUT uint32_t* value)
+{
+    char* end;
+    unsigned long parsed = strtoul(text, &end, 10);
+    if (end == text || *end != '\0' || parsed > UINT32_MAX) {
+        return false;
+    }
+    *value = static_cast<uint32_t>(parsed);
+    return true;
+}
+
+static bool parseFloat(IN const char* text, OUT float* value)
+{
+    char* end;
+    *value = strtof(text, &end);
+    return end != text && *end == '\0';
+}
+
+static bool parseVector(IN const char* text, OUT float* value)
+{
+    return sscanf(text, "%f,%f,%f", &value[0], &value[1], &value[2]) == 3;
+}
+
+bool ParseCommandLine(IN int argc, IN char** argv)
+{
+    const char* checkpointOption = nullptr;
+    for (int iter = 1; iter < argc; ++iter) {
+        const char* option = argv[iter];
+        const char* value = (iter + 1 < argc) ? argv[iter + 1] : nullptr;
+        bool valid = value != nullptr;
+        uint32_t number = 0;
+
+        if (strcmp(option, "--worker") == 0) {
+            renderOptions.mode = RENDER_MODE_WORKER;
+            valid = valid && parseUnsigned(value, &number) && number <= UINT16_MAX;
+            renderOptions.listenPort = static_cast<uint16_t>(number);
+        } else if (strcmp(option, "--coordinator") == 0) {
+            renderOptions.mode = RENDER_MODE_COORDINATOR;
+            renderOptions.workers = value;
+        } else if (strcmp(option, "--checkpoint") == 0) {
+            renderOptions.checkpointFile = value;
+            checkpointOption = option;
+        } else if (strcmp(option, "--checkpoint-interval") == 0) {
+            valid = valid && parseUnsigned(value, &renderOptions.checkpointInterval) &&
+                    renderOptions.checkpointInterval > 0;
+            checkpointOption = option;
+        } else if (strcmp(option, "--resume") == 0) {
+            renderOptions.resume = true;
+            checkpointOption = option;
+            continue; // Takes no value.
+        } else if (strcmp(option, "--size") == 0) {
+            valid = valid && sscanf(value, "%ux%u", &renderOptions.imageWidth, &renderOptions.imageHeight) == 2 &&
+                    renderOptions.imageWidth > 0 && renderOptions.imageHeight > 0;
+        } else if (strcmp(option, "--spp") == 0) {
+            valid = valid && parseUnsigned(value, &renderOptions.samplesPerPixel);
+        } else if (strcmp(option, "--tile") == 0) {
+            valid = valid && parseUnsigned(value, &renderOptions.tileSize);
+        } else if (strcmp(option, "--tile-spp") == 0) {
+            valid = valid && parseUnsigned(value, &renderOptions.samplesPerTile);
+        } else if (strcmp(option, "--lookfrom") == 0) {
+            valid = valid && parseVector(value, renderOptions.camera.lookfrom);
+        } else if (strcmp(option, "--lookat") == 0) {
+            valid = valid && parseVector(value, renderOptions.camera.lookat);
+        } else if (strcmp(option, "--vfov") == 0) {
+            valid = valid && sscanf(value, "%f", &renderOptions.camera.vfov) == 1;
+        } else if (strcmp(option, "--output") == 0) {
+            renderOptions.outputFile = value;
+        } else if (strcmp(option, "--scene") == 0) {
+            renderOptions.sceneFile = value;
+        } else if (strcmp(option, "--traversal") == 0) {
+            if (valid && strcmp(value, "auto") == 0) {
+                renderOptions.traversal = TRAVERSAL_AUTO;
+            } else if (valid && strcmp(value, "compute") == 0) {
+                renderOptions.traversal = TRAVERSAL_COMPUTE;
+            } else if (valid && strcmp(value, "rayquery") == 0) {
+                renderOptions.traversal = TRAVERSAL_RAY_QUERY;
+            } else if (valid && strcmp(value, "linear") == 0) {
+                renderOptions.traversal = TRAVERSAL_LINEAR;
+            } else {
+                valid = false;
+            }
+        } else if (strcmp(option, "--pipeline-cache") == 0) {
+            renderOptions.pipelineCacheDirectory = value;
+        } else if (strcmp(option, "--first-hit-cache") == 0) {
+            // Square, so the positions form a regular grid.
+            valid = valid && parseUnsigned(value, &renderOptions.firstHitStrata) &&
+                    (renderOptions.firstHitStrata == 1 || renderOptions.firstHitStrata == 4 ||
+                     renderOptions.firstHitStrata == 16 || renderOptions.firstHitStrata == 64);
+        } else if (strcmp(option, "--persistent-threads") == 0) {
+            if (valid && strcmp(value, "on") == 0) {
+                renderOptions.persistentWorkgroups = DEFAULT_PERSISTENT_WORKGROUPS;
+            } else if (valid && strcmp(value, "off") == 0) {
+                renderOptions.persistentWorkgroups = 0;
+            } else {
+                valid = valid && parseUnsigned(value, &renderOptions.persistentWorkgroups);
+            }
+        } else if (strcmp(option, "--pixel-order") == 0) {
+            if (valid && strcmp(value, "rows") == 0) {
+                renderOptions.pixelOrder = PIXEL_ORDER_ROWS;
+            } else if (valid && strcmp(value, "morton") == 0) {
+                renderOptions.pixelOrder = PIXEL_ORDER_MORTON;
+            } else if (valid && strcmp(value, "strips") == 0) {
+                renderOptions.pixelOrder = PIXEL_ORDER_STRIPS;
+            } else {
+                valid = false;
+            }
+        } else if (strcmp(option, "--ray-binning") == 0) {
+            if (valid && strcmp(value, "on") == 0) {
+                renderOptions.rayBinning = true;
+            } else if (valid && strcmp(value, "off") == 0) {
+                renderOptions.rayBinning = false;
+            } else {
+                valid = false;
+            }
+        } else if (strcmp(option, "--display-format") == 0) {
+            if (valid && strcmp(value, "rgba32f") == 0) {
+                renderOptions.displayFormat = DISPLAY_FORMAT_RGBA32F;
+            } else if (valid && strcmp(value, "rgba16f") == 0) {
+                renderOptions.displayFormat = DISPLAY_FORMAT_RGBA16F;
+            } else if (valid && strcmp(value, "b10g11r11") == 0) {
+                renderOptions.displayFormat = DISPLAY_FORMAT_B10G11R11;
+            } else {
+                valid = false;
+            }
+        } else if (strcmp(option, "--frame-budget") == 0) {
+            if (valid && strcmp(value, "throughput") == 0) {
+                renderOptions.sampleControl = SAMPLE_CONTROL_THROUGHPUT;
+            } else if (valid && strcmp(value, "fixed") == 0) {
+                renderOptions.sampleControl = SAMPLE_CONTROL_FIXED;
+            } else {
+                renderOptions.sampleControl = SAMPLE_CONTROL_FRAME_TIME;
+                valid = valid && parseFloat(value, &renderOptions.frameBudget) && renderOptions.frameBudget > 0.f;
+            }
+        } else if (strcmp(option, "--window-samples") == 0) {
+            valid = valid && parseCount(value, &renderOptions.windowSamples);
+        } else if (strcmp(option, "--frame-pacing") == 0) {
+            if (valid && strcmp(value, "compositor") == 0) {
+                renderOptions.framePacing = FRAME_PACING_COMPOSITOR;
+            } else if (valid && strcmp(value, "throughput") == 0) {
+                renderOptions.framePacing = FRAME_PACING_THROUGHPUT;
+            } else {
+                valid = false;
+            }
+        } else if (strcmp(option, "--shading-precision") == 0) {
+            if (valid && strcmp(value, "fp32") == 0) {
+                renderOptions.shadingPrecision = SHADING_PRECISION_FP32;
+            } else if (valid && strcmp(value, "fp16") == 0) {
+                renderOptions.shadingPrecision = SHADING_PRECISION_FP16;
+            } else {
+                valid = false;
+            }
+        } else if (strcmp(option, "--compare-precision") == 0) {
+            renderOptions.mode = RENDER_MODE_COMPARE_PRECISION;
+            continue; // Takes no value.
+        } else if (strcmp(option, "--camera-path") == 0) {
+            renderOptions.mode = RENDER_MODE_SEQUENCE;
+            renderOptions.cameraPath = value;
+        } else if (strcmp(option, "--fps") == 0) {
+            valid = valid && parseUnsigned(value, &renderOptions.framesPerSecond);
+        } else if (strcmp(option, "--stream-format") == 0) {
+            if (valid && strcmp(value, "y4m") == 0) {
+                renderOptions.streamFormat = VIDEO_STREAM_Y4M;
+            } else if (valid && strcmp(value, "rgb") == 0) {
+                renderOptions.streamFormat = VIDEO_STREAM_RGB24;
+            } else {
+                valid = false;
+            }
+        } else if (strcmp(option, "--daemon") == 0) {
+            renderOptions.mode = RENDER_MODE_DAEMON;
+            renderOptions.daemonSocket = value;
+        } else if (strcmp(option, "--submit") == 0) {
+            renderOptions.mode = RENDER_MODE_SUBMIT;
+            renderOptions.daemonSocket = value;
+        } else if (strcmp(option, "--priority") == 0) {
+            char* end = nullptr;
+            long parsed = valid ? strtol(value, &end, 10) : 0;
+            valid = valid && end != value && *end == '\0' && parsed >= INT32_MIN && parsed <= INT32_MAX;
+            renderOptions.jobPriority = static_cast<int32_t>(parsed);
+        } else if (strcmp(option, "--shared-memory") == 0) {
+            renderOptions.sharedMemoryResult = true;
+            continue; // Takes no value.
+        } else if (strcmp(option, "--cost-overlay") == 0) {
+            renderOptions.costCounters = true;
+            if (valid && strcmp(value, "bounces") == 0) {
+                renderOptions.costOverlay = COST_OVERLAY_BOUNCES;
+            } else if (valid && strcmp(value, "spheres") == 0) {
+                renderOptions.costOverlay = COST_OVERLAY_SPHERE_TESTS;
+            } else if (valid && strcmp(value, "nodes") == 0) {
+                renderOptions.costOverlay = COST_OVERLAY_NODES;
+            } else if (valid && strcmp(value, "capped") == 0) {
+                renderOptions.costOverlay = COST_OVERLAY_CAPPED_PATHS;
+            } else {
+                valid = false;
+            }
+        } else if (strcmp(option, "--poster") == 0) {
+            renderOptions.mode = RENDER_MODE_POSTER;
+            continue; // Takes no value.
+        } else if (strcmp(option, "--cost-report") == 0) {
+            renderOptions.mode = RENDER_MODE_COST_REPORT;
+            renderOptions.costCounters = true;
+            continue; // Takes no value.
+        } else if (strcmp(option, "--tile-culling") == 0) {
+            if (valid && strcmp(value, "on") == 0) {
+                renderOptions.tileCulling = true;
+            } else if (valid && strcmp(value, "off") == 0) {
+                renderOptions.tileCulling = false;
+            } else {
+                valid = false;
+            }
+        } else {
+            if (strcmp(option, "--help") != 0) {
+                fprintf(stderr, "Unknown option: %s\n", option);
+            }
+            printUsage(argv[0]);
+            return false;
+        }
+
+        if (!valid) {
+            fprintf(stderr, "Invalid value for %s\n", option);
+            printUsage(argv[0]);
+            return false;
+        }
+        ++iter;
+    }
+    // Only the coordinator owns the progress of a render, other modes would silently ignore these.
+    if (checkpointOption != nullptr && renderOptions.mode != RENDER_MODE_COORDINATOR) {
+        fprintf(stderr, "%s needs --coordinator\n", checkpointOption);
+        printUsage(argv[0]);
+        return false;
+    }
+    if (renderOptions.resume && renderOptions.checkpointFile == nullptr) {
+        fprintf(stderr, "--resume needs --checkpoint FILE\n");
+        printUsage(argv[0]);
+        return false;
+    }
+    return true;
+}
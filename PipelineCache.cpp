@@ -0,0 +1,129 @@
+/* @file PipelineCache.cpp
+
+    Implementation of compute pipelines cached on disk.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <PipelineCache.hpp>
+#include <Environment.hpp>
+#include <Options.hpp>
+#include <Utility.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <vector>
+
+static std::filesystem::path cacheDirectory(void)
+{
+    if (renderOptions.pipelineCacheDirectory != nullptr) {
+        return renderOptions.pipelineCacheDirectory;
+    }
+    const char* base = getenv("XDG_CACHE_HOME");
+    if (base != nullptr && base[0] != '\0') {
+        return std::filesystem::path(base) / "VulkanComputeRayTracing";
+    }
+    base = getenv("HOME");
+    if (base != nullptr && base[0] != '\0') {
+        return std::filesystem::path(base) / ".cache" / "VulkanComputeRayTracing";
+    }
+    base = getenv("LOCALAPPDATA");
+    if (base != nullptr && base[0] != '\0') {
+        return std::filesystem::path(base) / "VulkanComputeRayTracing";
+    }
+    return "pipeline-cache";
+}
+
+static std::vector<uint8_t> readFile(IN const std::filesystem::path& path)
+{
+    std::vector<uint8_t> data;
+    FILE* file = fopen(path.string().c_str(), "rb");
+    if (file == nullptr) {
+        return data;
+    }
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long size = ftell(file);
+        if (size > 0 && fseek(file, 0, SEEK_SET) == 0) {
+            data.resize(static_cast<size_t>(size));
+            if (fread(data.data(), 1, data.size(), file) != data.size()) {
+                data.clear();
+            }
+        }
+    }
+    fclose(file);
+    return data;
+}
+
+// Other processes may be loading the same variant while it is written.
+static bool writeFile(IN const std::filesystem::path& path, IN const std::vector<uint8_t>& data)
+{
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    FileChunk chunk = { .data = data.data(), .size = data.size() };
+    return WriteFileAtomic(path, &chunk, 1);
+}
+
+VkResult CreateCachedComputePipeline(IN const VkComputePipelineCreateInfo* createInfo, IN uint64_t codeHash,
+                                     OUT VkPipeline* pipeline)
+{
+    // Pipeline cache data is only valid for the same device & driver.
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(vulkanPhysicalDevice, &properties);
+    uint64_t hash = HashBytes(codeHash, &properties.vendorID, sizeof(properties.vendorID));
+    hash = HashBytes(hash, &properties.deviceID, sizeof(properties.deviceID));
+    hash = HashBytes(hash, &properties.driverVersion, sizeof(properties.driverVersion));
+    hash = HashBytes(hash, properties.pipelineCacheUUID, sizeof(properties.pipelineCacheUUID));
+    const VkSpecializationInfo* specialization = createInfo->stage.pSpecializationInfo;
+    if (specialization != nullptr) {
+        hash = HashBytes(hash, specialization->pMapEntries,
+                         specialization->mapEntryCount * sizeof(VkSpecializationMapEntry));
+        hash = HashBytes(hash, specialization->pData, specialization->dataSize);
+    }
+    char filename[32];
+    snprintf(filename, sizeof(filename), "%016llx.cache", static_cast<unsigned long long>(hash));
+    std::filesystem::path path = cacheDirectory() / filename;
+
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<uint8_t> initialData = readFile(path);
+    VkPipelineCacheCreateInfo cacheInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .initialDataSize = initialData.size(),
+        .pInitialData = initialData.data()
+    };
+    VkPipelineCache pipelineCache;
+    VkResult result = vkCreatePipelineCache(vulkanLogicalDevice, &cacheInfo, nullptr, &pipelineCache);
+    if (result != VK_SUCCESS) {
+        // Data the driver rejects outright, start over.
+        cacheInfo.initialDataSize = 0;
+        cacheInfo.pInitialData = nullptr;
+        initialData.clear();
+        result = vkCreatePipelineCache(vulkanLogicalDevice, &cacheInfo, nullptr, &pipelineCache);
+    }
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    result = vkCreateComputePipelines(vulkanLogicalDevice, pipelineCache, 1, createInfo, nullptr, pipeline);
+    auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+
+    // Write back what the driver compiled, unless the file already held the same.
+    size_t dataSize = 0;
+    if (result == VK_SUCCESS &&
+        vkGetPipelineCacheData(vulkanLogicalDevice, pipelineCache, &dataSize, nullptr) == VK_SUCCESS &&
+        dataSize != initialData.size()) {
+        std::vector<uint8_t> data(dataSize);
+        if (vkGetPipelineCacheData(vulkanLogicalDevice, pipelineCache, &dataSize, data.data()) == VK_SUCCESS) {
+            data.resize(dataSize);
+            if (!writeFile(path, data)) {
+                fprintf(stderr, "Renderer: cannot write pipeline cache %s.\n", path.string().c_str());
+            }
+        }
+    }
+    if (result == VK_SUCCESS) {
+        printf("Renderer: pipeline variant %016llx %s in %lld ms.\n", static_cast<unsigned long long>(hash),
+               initialData.empty() ? "compiled" : "loaded", static_cast<long long>(milliseconds.count()));
+    }
+    vkDestroyPipelineCache(vulkanLogicalDevice, pipelineCache, nullptr);
+    return result;
+}
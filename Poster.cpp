@@ -0,0 +1,119 @@
+/* @file Poster.cpp
+
+    Implementation of out-of-core poster rendering.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <Poster.hpp>
+#include <ImageOutput.hpp>
+#include <Options.hpp>
+#include <Renderer.hpp>
+#include <Scene.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static bool isTiffFile(IN const char* filename)
+{
+    const char* extension = strrchr(filename, '.');
+    return extension != nullptr && (strcmp(extension, ".tif") == 0 || strcmp(extension, ".tiff") == 0);
+}
+
+// Every sample of a tile before the next one, so a tile is final when it is written. Per pixel the sample
+// ranges are added in the same order as RenderOffscreenImage does.
+static VkResult renderTiles(IN RenderContext* context, IN TiledImageWriter* writer)
+{
+    uint32_t width = renderOptions.imageWidth;
+    uint32_t height = renderOptions.imageHeight;
+    uint32_t tileSize = renderOptions.tileSize;
+    uint32_t samplesPerPixel = renderOptions.samplesPerPixel;
+    uint32_t samplesPerTile = renderOptions.samplesPerTile;
+    std::vector<float> tileImage(static_cast<size_t>(tileSize) * tileSize * 4);
+    std::vector<float> tileSamples(tileImage.size());
+    SetRenderCamera(context, &renderOptions.camera, width, height);
+    for (uint32_t y = 0; y < height; y += tileSize) {
+        for (uint32_t x = 0; x < width; x += tileSize) {
+            RenderTile tile = {
+                .x = x,
+                .y = y,
+                .width = std::min(tileSize, width - x),
+                .height = std::min(tileSize, height - y)
+            };
+            size_t floatCount = static_cast<size_t>(tile.width) * tile.height * 4;
+            std::fill(tileImage.begin(), tileImage.begin() + floatCount, 0.f);
+            for (uint32_t sampleBase = 0; sampleBase < samplesPerPixel; sampleBase += samplesPerTile) {
+                tile.sampleBase = sampleBase;
+                tile.sampleCount = std::min(samplesPerTile, samplesPerPixel - sampleBase);
+                VkResult result = RenderOffscreenTile(context, &tile, tileSamples.data());
+                if (result != VK_SUCCESS) {
+                    return result;
+                }
+                for (size_t iter = 0; iter < floatCount; ++iter) {
+                    tileImage[iter] += tileSamples[iter];
+                }
+            }
+            VkResult result = WriteImageTile(writer, x, y, tile.width, tile.height, tileImage.data());
+            if (result != VK_SUCCESS) {
+                fprintf(stderr, "Poster: cannot write %s.\n", renderOptions.outputFile);
+                return result;
+            }
+        }
+        printf("Poster: %u/%u rows of tiles done.\n", y / tileSize + 1, (height + tileSize - 1) / tileSize);
+    }
+    return VK_SUCCESS;
+}
+
+VkResult RunPosterRendering(void)
+{
+    if (!isTiffFile(renderOptions.outputFile) || renderOptions.tileSize % TIFF_TILE_ALIGNMENT != 0 ||
+        renderOptions.tileSize == 0 || renderOptions.samplesPerTile == 0) {
+        fprintf(stderr, "Poster: --output must be a .tif file & --tile a multiple of %u.\n", TIFF_TILE_ALIGNMENT);
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+    }
+    // Candidate lists cover the whole camera image, more than the device holds at poster sizes.
+    if (renderOptions.tileCulling) {
+        printf("Poster: tile culling is off for posters.\n");
+        renderOptions.tileCulling = false;
+    }
+    TiledImageWriter* writer;
+    VkResult result = BeginTiledImage(renderOptions.outputFile, renderOptions.imageWidth, renderOptions.imageHeight,
+                                      renderOptions.tileSize, &writer);
+    if (result != VK_SUCCESS) {
+        fprintf(stderr, "Poster: cannot open %s.\n", renderOptions.outputFile);
+        return result;
+    }
+    RenderScene* scene;
+    result = LoadRenderScene(renderOptions.sceneFile, &scene);
+    if (result != VK_SUCCESS) {
+        fprintf(stderr, "Poster: cannot load scene.\n");
+        EndTiledImage(writer);
+        return result;
+    }
+    RenderContext* context;
+    result = BeginOffscreenRenderingOperation(scene, renderOptions.tileSize, renderOptions.tileSize, &context);
+    if (result != VK_SUCCESS) {
+        fprintf(stderr, "Poster: cannot begin rendering.\n");
+        DestroyRenderScene(scene);
+        EndTiledImage(writer);
+        return result;
+    }
+    printf("Poster: %ux%u in %u pixel tiles, %u spp.\n", renderOptions.imageWidth, renderOptions.imageHeight,
+           renderOptions.tileSize, renderOptions.samplesPerPixel);
+
+    auto begin = std::chrono::steady_clock::now();
+    result = renderTiles(context, writer);
+    EndRenderingOperation(context);
+    DestroyRenderScene(scene);
+    // Finish the file either way, tiles not rendered stay black.
+    VkResult written = EndTiledImage(writer);
+    if (result == VK_SUCCESS && written != VK_SUCCESS) {
+        fprintf(stderr, "Poster: cannot write %s.\n", renderOptions.outputFile);
+        result = written;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    printf("Poster: %s after %.1f s.\n", result == VK_SUCCESS ? "done" : "failed", seconds);
+    return result;
+}
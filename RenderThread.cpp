@@ -0,0 +1,136 @@
+/* @file RenderThread.cpp
+
+    Implementation of the window's render thread & its event queue.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <RenderThread.hpp>
+#include <Environment.hpp>
+#include <Scene.hpp>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+static_assert((RENDER_EVENT_QUEUE_SIZE & (RENDER_EVENT_QUEUE_SIZE - 1)) == 0, "Queue size must be a power of two.");
+
+struct RenderThread {
+    RenderContext*          context;
+    uint32_t                flags;
+    void                    (*beginFrame)(void);
+    std::thread             thread;
+    // Free running counts of posted & taken events, each written by one side only.
+    alignas(64) std::atomic<uint32_t> posted;
+    alignas(64) std::atomic<uint32_t> taken;
+    RenderEvent             events[RENDER_EVENT_QUEUE_SIZE];
+};
+
+static bool takeRenderEvent(RenderThread* thread, RenderEvent* event)
+{
+    uint32_t taken = thread->taken.load(std::memory_order_relaxed);
+    if (thread->posted.load(std::memory_order_acquire) == taken) {
+        return false;
+    }
+    *event = thread->events[taken % RENDER_EVENT_QUEUE_SIZE];
+    thread->taken.store(taken + 1, std::memory_order_release);
+    return true;
+}
+
+static void renderFrames(RenderThread* thread)
+{
+    bool visible = true;
+    bool frameWanted = true;
+    bool surfaceLost = false;
+    bool exposed = false;
+    for (;;) {
+        // Frame boundary: whatever was posted during the last frame applies to the next one.
+        RenderEvent event;
+        bool idle = false;
+        bool quit = false;
+        while (takeRenderEvent(thread, &event)) {
+            switch (event.type) {
+                case RENDER_EVENT_CAMERA:
+                    SetRenderCamera(thread->context, &event.camera, WINDOW_WIDTH, WINDOW_HEIGHT);
+                    break;
+                case RENDER_EVENT_INSTANCE_TRANSFORM:
+                    // The scene buffers must not change under the frame still in flight.
+                    if (!idle) {
+                        WaitVulkanDeviceIdle();
+                        idle = true;
+                    }
+                    if (SetRenderSceneInstanceTransform(GetRenderContextScene(thread->context), event.instance,
+                                                        event.objectToWorld) != VK_SUCCESS) {
+                        fprintf(stderr, "Render thread: cannot move instance %u.\n", event.instance);
+                    }
+                    break;
+                case RENDER_EVENT_VISIBILITY:
+                    visible = event.visible;
+                    break;
+                case RENDER_EVENT_FRAME_WANTED:
+                    frameWanted = true;
+                    break;
+                case RENDER_EVENT_EXPOSE:
+                    exposed = true;
+                    break;
+                case RENDER_EVENT_QUIT:
+                    quit = true;
+                    break;
+            }
+        }
+        if (quit) {
+            return;
+        }
+        // Camera & scene changes restart accumulation, so a converged session only draws when exposed.
+        bool converged = IsRenderConverged(thread->context) && !exposed;
+        if (!visible || !frameWanted || surfaceLost || converged) {
+            // Nothing to draw, sleep until the platform thread posts something.
+            thread->posted.wait(thread->taken.load(std::memory_order_relaxed), std::memory_order_acquire);
+            continue;
+        }
+        if (thread->beginFrame != nullptr) {
+            thread->beginFrame();
+        }
+        frameWanted = (thread->flags & RENDER_THREAD_FRAME_CALLBACKS) == 0;
+        exposed = false;
+        VkResult result = DrawNextFrame(thread->context);
+        if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_ERROR_SURFACE_LOST_KHR) {
+            // The window is going away, wait for the platform thread to say so.
+            surfaceLost = true;
+        } else if (result != VK_SUCCESS) {
+            // Nothing was committed, a requested frame callback may never come.
+            frameWanted = true;
+        }
+    }
+}
+
+RenderThread* StartRenderThread(IN RenderContext* context, IN uint32_t flags, IN void (*beginFrame)(void))
+{
+    RenderThread* thread = new RenderThread{};
+    thread->context = context;
+    thread->flags = flags;
+    thread->beginFrame = beginFrame;
+    thread->thread = std::thread(renderFrames, thread);
+    return thread;
+}
+
+void PostRenderEvent(IN RenderThread* thread, IN const RenderEvent* event)
+{
+    uint32_t posted = thread->posted.load(std::memory_order_relaxed);
+    // Full only if the render thread is stuck in a long frame, it takes everything at the next boundary.
+    while (posted - thread->taken.load(std::memory_order_acquire) == RENDER_EVENT_QUEUE_SIZE) {
+        std::this_thread::yield();
+    }
+    thread->events[posted % RENDER_EVENT_QUEUE_SIZE] = *event;
+    thread->posted.store(posted + 1, std::memory_order_release);
+    thread->posted.notify_one();
+}
+
+void StopRenderThread(IN RenderThread* thread)
+{
+    RenderEvent quit = {
+        .type = RENDER_EVENT_QUIT
+    };
+    PostRenderEvent(thread, &quit);
+    thread->thread.join();
+    delete thread;
+}
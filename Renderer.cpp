@@ -9,40 +9,135 @@
 #include <Environment.hpp>
 #include <Frontend.hpp>
 #include <Shader.hpp>
+#include <Scene.hpp>
+#include <PipelineCache.hpp>
+#include <Options.hpp>
+#include <Startup.hpp>
+#include <SampleBudget.hpp>
+#include <cstdio>
+#include <cstring>
+
+// Host copy of one frame of a sequence, reused once the frame is released.
+struct SequenceReadback {
+    VkCommandBuffer commandBuffer;
+    VkFence         fence;          // Signaled when the copy has landed.
+    VkBuffer        buffer;
+    VkDeviceMemory  memory;
+    void*           mapping;
+};
 
-static VkPipelineLayout vulkanGraphicsPipelineLayout;
-static VkPipelineLayout vulkanComputePipelineLayout;
-static VkRenderPass vulkanRenderPass;
-static VkPipeline vulkanGraphicsPipeline;
-static VkPipeline vulkanComputePipeline;
-static VkFramebuffer *swapChainFramebuffers;
-static VkCommandPool vulkanCommandPool;
-static VkCommandBuffer vulkanGraphicsCommandBuffer;
-static VkCommandBuffer vulkanComputeCommandBuffer;
-static VkSemaphore vulkanImageAvailableSemaphore;
-static VkSemaphore vulkanRenderFinishedSemaphore;
-static VkFence vulkanInFlightFence;
-static VkSampler vulkanComputeResultImageSampler;
-static VkImage vulkanComputeResultImage;
-static VkImageView vulkanComputeResultImageView;
-static VkDeviceMemory vulkanComputeResultImageMemory;
-static VkDescriptorSetLayout vulkanComputeDescriptorSetLayout;
-static VkPipelineShaderStageCreateInfo GraphicsShaderStages[2];
-static VkPipelineShaderStageCreateInfo ComputeShaderStage;
-static VkDescriptorPool vulkanDescriptorPool;
-static VkDescriptorSet vulkanComputeDescriptorSet;
-
-static uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-
-    VkPhysicalDeviceMemoryProperties memProperties;
-    vkGetPhysicalDeviceMemoryProperties(vulkanPhysicalDevice, &memProperties);
-    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        if (typeFilter & (1 << i)) {
-            return i;
-        }
-    }
-    return -1;
-}
+// One render session, see Renderer.hpp. Only the window session has the graphics half.
+struct RenderContext {
+    RenderScene*                    scene;
+    VkPipelineLayout                graphicsPipelineLayout;
+    VkPipelineLayout                computePipelineLayout;
+    VkRenderPass                    renderPass;
+    VkPipeline                      graphicsPipeline;
+    VkPipeline                      computePipeline;
+    VkFramebuffer*                  swapChainFramebuffers;
+    VkCommandPool                   commandPool;
+    VkCommandBuffer                 graphicsCommandBuffer;
+    VkCommandBuffer                 computeCommandBuffer;
+    VkSemaphore                     imageAvailableSemaphore;
+    VkSemaphore                     renderFinishedSemaphore;
+    VkFence                         inFlightFence;
+    VkSampler                       resultImageSampler;
+    VkImage                         resultImage;
+    VkImageView                     resultImageView;
+    VkDeviceMemory                  resultImageMemory;
+    VkImage                         displayImage;
+    VkImageView                     displayImageView;       // Sampled for presentation.
+    VkImageView                     displayStorageView;     // Written by the compute shader.
+    VkDeviceMemory                  displayImageMemory;
+    VkImage                         presentedImage;         // Display or result image, whichever the fragment shader samples.
+    VkDescriptorSetLayout           descriptorSetLayout;
+    VkPipelineShaderStageCreateInfo graphicsShaderStages[2];
+    VkPipelineShaderStageCreateInfo computeShaderStage;
+    VkDescriptorPool                descriptorPool;
+    VkDescriptorSet                 descriptorSet;
+    VkBuffer                        readbackBuffer;
+    VkDeviceMemory                  readbackBufferMemory;
+    void*                           readbackBufferMapping;
+    VkBuffer                        firstHitBuffer;
+    VkDeviceMemory                  firstHitBufferMemory;
+    VkPipelineShaderStageCreateInfo cullShaderStage;
+    VkPipeline                      cullPipeline;
+    VkBuffer                        tileCullingBuffer;
+    VkDeviceMemory                  tileCullingBufferMemory;
+    VkDeviceSize                    tileCullingBufferSize;
+    bool                            tileCullingDirty;
+    uint64_t                        culledSceneVersion;
+    VkBuffer                        workQueueBuffer;
+    VkDeviceMemory                  workQueueBufferMemory;
+    uint32_t                        persistentWorkgroups;
+    uint64_t                        renderedSceneVersion;
+    uint32_t                        resultImageWidth;
+    uint32_t                        resultImageHeight;
+    RenderPushConstants             renderParameters;
+    uint32_t                        accumulatedSamples;
+    SequenceReadback                sequenceReadbacks[SEQUENCE_FRAMES_IN_FLIGHT];  // Sequence sessions only.
+    uint64_t                        sequenceSubmitted;      // Frames, readback buffer is the count modulo the ring.
+    uint64_t                        sequenceAcquired;
+    uint64_t                        sequenceReleased;
+    bool                            costCounters;           // The shader sums per pixel costs into costImage.
+    VkImage                         costImage;
+    VkImageView                     costImageView;
+    VkDeviceMemory                  costImageMemory;
+    VkQueryPool                     statisticsQuery;        // Compute invocations, counting sessions only.
+    bool                            statisticsPending;      // Query of the window frame in flight.
+    RenderStatistics                statistics;
+    VkQueryPool                     timestampQuery;         // Start & end of the window frame's compute work.
+    bool                            timestampsPending;
+    uint32_t                        frameSamples;           // Of the window frame recorded last.
+    SampleBudget                    sampleBudget;           // Window only.
+    uint32_t                        sampleTarget;           // Window samples per pixel, 0 never converges.
+};
+
+// Specialization constants of the compute shader, must match constant_id in globals.glsl.
+struct ComputeSpecialization {
+    uint32_t materialTypes;
+    uint32_t bvhStackSize;
+    uint32_t tlasStackSize;
+    uint32_t samplesPerDispatch;    // 0: sample_count of the push constants.
+    uint32_t firstHitStrata;        // 0: no first hit cache.
+    uint32_t tileCulling;           // 0: primary rays traverse the whole scene.
+    uint32_t pixelOrder;            // PixelOrder.
+    uint32_t rayBinning;            // 0: lanes trace their own bounce rays.
+    uint32_t materialIdBits;
+    uint32_t displayFormat;         // DisplayFormat.
+    uint32_t costCounters;          // 0: costs compiled out.
+    uint32_t costOverlay;           // CostOverlay, window only.
+};
+
+// After the scene buffers & the acceleration structure, always bound, a few bytes if unused.
+constexpr uint32_t FIRST_HIT_CACHE_BINDING = SCENE_ACCELERATION_STRUCTURE_BINDING + 1;
+constexpr VkDeviceSize FIRST_HIT_ENTRY_SIZE = 16;
+// Candidate lists of the tile culling pre-pass, a few bytes if unused. Must match globals.glsl.
+constexpr uint32_t TILE_CULLING_BINDING = FIRST_HIT_CACHE_BINDING + 1;
+constexpr uint32_t CULL_TILE_SIZE = 16;
+constexpr uint32_t TILE_CANDIDATE_CAPACITY = 128;
+constexpr uint32_t CULL_WORKGROUP_SIZE = 64;
+// Counter handing out pixels to the persistent threads kernel, a few bytes if unused.
+constexpr uint32_t WORK_QUEUE_BINDING = TILE_CULLING_BINDING + 1;
+constexpr uint32_t COMPUTE_WORKGROUP_SIZE = 16 * 16;
+// Presentation image of the window, 1x1 & never written offscreen. Must match shader.comp.
+constexpr uint32_t DISPLAY_IMAGE_BINDING = WORK_QUEUE_BINDING + 1;
+// Per pixel cost counters of the result image, 1x1 unless counting. Must match shader.comp.
+constexpr uint32_t COST_IMAGE_BINDING = DISPLAY_IMAGE_BINDING + 1;
+
+// Per DisplayFormat: sampled format & the view the compute shader stores through.
+static const struct {
+    const char* name;
+    VkFormat    format;
+    VkFormat    storageFormat;
+} displayFormats[] = {
+    { "rgba32f", VK_FORMAT_R16G16B16A16_SFLOAT, VK_FORMAT_R16G16B16A16_SFLOAT },    // Placeholder only.
+    { "rgba16f", VK_FORMAT_R16G16B16A16_SFLOAT, VK_FORMAT_R16G16B16A16_SFLOAT },
+    { "b10g11r11", VK_FORMAT_B10G11R11_UFLOAT_PACK32, VK_FORMAT_R32_UINT }           // Packed in the shader.
+};
+
+// Upper bound of samples in one dispatch of an offscreen tile, keeps each dispatch short.
+constexpr uint32_t OFFSCREEN_SAMPLES_PER_DISPATCH = 16;
 
 enum TransitionFlow {
     TRANSITION_FROM_NULL_TO_COMPUTE,
@@ -50,14 +145,14 @@ enum TransitionFlow {
     TRANSITION_FROM_GRAPHICS_TO_COMPUTE
 };
 
-static VkResult transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, TransitionFlow flow) {
+static VkResult transitionImageLayout(RenderContext* context, VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, TransitionFlow flow) {
 
     VkResult result;
     VkCommandBuffer commandBuffer;
 
     VkCommandBufferAllocateInfo allocInfo = {
         .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
-        .commandPool = vulkanCommandPool,
+        .commandPool = context->commandPool,
         .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
         .commandBufferCount = 1
     };
@@ -134,14 +229,13 @@ static VkResult transitionImageLayout(VkImage image, VkFormat format, VkImageLay
         .pCommandBuffers = &commandBuffer
     };
 
-    vkQueueSubmit(vulkanComputeQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(vulkanComputeQueue);
+    result = SubmitVulkanQueueAndWait(vulkanComputeQueue, &submitInfo);
 
-    vkFreeCommandBuffers(vulkanLogicalDevice, vulkanCommandPool, 1, &commandBuffer);
-    return VK_SUCCESS;
+    vkFreeCommandBuffers(vulkanLogicalDevice, context->commandPool, 1, &commandBuffer);
+    return result;
 }
 
-static VkResult recordGraphicsCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex)
+static VkResult recordGraphicsCommandBuffer(RenderContext* context, VkCommandBuffer commandBuffer, uint32_t imageIndex)
 {
 
     VkResult result;
@@ -157,8 +251,8 @@ static VkResult recordGraphicsCommandBuffer(VkCommandBuffer commandBuffer, uint3
     VkClearValue clearColor = { {{0.0f, 0.0f, 0.0f, 1.0f}} };
     VkRenderPassBeginInfo renderPassInfo = {
         .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-        .renderPass = vulkanRenderPass,
-        .framebuffer = swapChainFramebuffers[imageIndex],
+        .renderPass = context->renderPass,
+        .framebuffer = context->swapChainFramebuffers[imageIndex],
         .renderArea = {
             .offset = {0, 0},
             .extent = {
@@ -171,10 +265,10 @@ static VkResult recordGraphicsCommandBuffer(VkCommandBuffer commandBuffer, uint3
     };
 
     vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkanGraphicsPipeline);
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, context->graphicsPipeline);
     VkDeviceSize offsets[] = { 0 };
-    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, vulkanGraphicsPipelineLayout,
-        0, 1, &vulkanComputeDescriptorSet, 0, 0);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, context->graphicsPipelineLayout,
+        0, 1, &context->descriptorSet, 0, 0);
 
     VkViewport viewport = {
         .x = 0.0f,
@@ -201,383 +295,776 @@ static VkResult recordGraphicsCommandBuffer(VkCommandBuffer commandBuffer, uint3
     return vkEndCommandBuffer(commandBuffer);
 }
 
-static VkResult recordComputeCommandBuffer(VkCommandBuffer commandBuffer)
+static void recordImageBarrier(VkCommandBuffer commandBuffer, VkImage image,
+                               VkAccessFlags srcAccessMask, VkAccessFlags dstAccessMask,
+                               VkPipelineStageFlags srcStageMask, VkPipelineStageFlags dstStageMask)
 {
-
-    VkResult result;
-    VkCommandBufferBeginInfo beginInfo = {
-        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+    VkImageMemoryBarrier barrier = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .srcAccessMask = srcAccessMask,
+        .dstAccessMask = dstAccessMask,
+        .oldLayout = VK_IMAGE_LAYOUT_GENERAL,
+        .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .image = image,
+        .subresourceRange = {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .baseMipLevel = 0,
+            .levelCount = 1,
+            .baseArrayLayer = 0,
+            .layerCount = 1,
+        }
     };
-
-    result = vkBeginCommandBuffer(commandBuffer, &beginInfo);
-    if (result != VK_SUCCESS) {
-        return result;
-    }
-
-    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkanComputePipeline);
-    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, vulkanComputePipelineLayout,
-        0, 1, &vulkanComputeDescriptorSet, 0, 0);
-
-    vkCmdDispatch(commandBuffer, WINDOW_WIDTH / 16, WINDOW_HEIGHT / 16, 1);
-
-
-    return vkEndCommandBuffer(commandBuffer);
+    vkCmdPipelineBarrier(commandBuffer, srcStageMask, dstStageMask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
 }
 
-// Create pipeline, submit tasks...
-VkResult BeginRenderingOperation(void)
+// Storage usage of an aliased display image only has to be supported by its storage view format, with
+// VK_IMAGE_CREATE_EXTENDED_USAGE_BIT (Vulkan 1.1). Hardly any device stores to b10g11r11 itself.
+static bool hasExtendedUsage(DisplayFormat displayFormat)
 {
+    return displayFormats[displayFormat].format != displayFormats[displayFormat].storageFormat &&
+           vulkanApiVersion >= VK_API_VERSION_1_1;
+}
 
-    VkResult result;
-    result = CreateShaderStageFromFile("shader.frag.spv",VK_SHADER_STAGE_FRAGMENT_BIT,&GraphicsShaderStages[0]);
-    if (result != VK_SUCCESS) {
-        return result;
+// The requested format if the device can sample it & store through its storage view, else the next
+// smaller saving down to presenting the fp32 accumulation. Without extended usage the image format
+// itself needs storage support too.
+static DisplayFormat selectDisplayFormat(DisplayFormat requested)
+{
+    for (int32_t format = requested; format > DISPLAY_FORMAT_RGBA32F; --format) {
+        VkFormatProperties properties;
+        vkGetPhysicalDeviceFormatProperties(vulkanPhysicalDevice, displayFormats[format].format, &properties);
+        VkFormatFeatureFlags features = properties.optimalTilingFeatures;
+        vkGetPhysicalDeviceFormatProperties(vulkanPhysicalDevice, displayFormats[format].storageFormat, &properties);
+        if ((features & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0 &&
+            ((features & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) != 0 ||
+             hasExtendedUsage(static_cast<DisplayFormat>(format))) &&
+            (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) != 0) {
+            return static_cast<DisplayFormat>(format);
+        }
+        fprintf(stderr, "Renderer: %s display images are not supported, falling back.\n", displayFormats[format].name);
     }
-    result = CreateShaderStageFromFile("shader.vert.spv", VK_SHADER_STAGE_VERTEX_BIT, &GraphicsShaderStages[1]);
-    if (result != VK_SUCCESS) {
-        return result;
+    return DISPLAY_FORMAT_RGBA32F;
+}
+
+// Image with a sampled & a storage view, mutable when the two formats differ.
+static VkResult createDisplayImage(RenderContext* context, uint32_t width, uint32_t height, DisplayFormat displayFormat)
+{
+    VkFormat format = displayFormats[displayFormat].format;
+    VkFormat storageFormat = displayFormats[displayFormat].storageFormat;
+    bool extendedUsage = hasExtendedUsage(displayFormat);
+    VkImageCreateFlags flags = 0;
+    if (format != storageFormat) {
+        flags |= VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT;
     }
-    result = CreateShaderStageFromFile("shader.comp.spv", VK_SHADER_STAGE_COMPUTE_BIT, &ComputeShaderStage);
-    if (result != VK_SUCCESS) {
-        return result;
+    if (extendedUsage) {
+        flags |= VK_IMAGE_CREATE_EXTENDED_USAGE_BIT;
     }
-    VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT,VK_DYNAMIC_STATE_SCISSOR};
-    VkPipelineDynamicStateCreateInfo dynamicState = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
-        .dynamicStateCount = sizeof(dynamicStates) / sizeof(VkDynamicState),
-        .pDynamicStates = dynamicStates
-    };
-
-    VkPipelineVertexInputStateCreateInfo vertexInputInfo = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
-        .vertexBindingDescriptionCount = 0,
-        .pVertexBindingDescriptions = nullptr, // Optional
-        .vertexAttributeDescriptionCount = 0,
-        .pVertexAttributeDescriptions = nullptr
-    };
-
-    VkPipelineInputAssemblyStateCreateInfo inputAssembly = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
-        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
-        .primitiveRestartEnable = VK_FALSE
-    };
-
-    VkViewport viewport = {
-        .x = 0.0f,
-        .y = 0.0f,
-        .width = WINDOW_WIDTH,
-        .height = WINDOW_HEIGHT,
-        .minDepth = 0.0f,
-        .maxDepth = 1.0f
-    };
-
-    VkRect2D scissor = {
-        .offset = { 0, 0 },
+    VkImageCreateInfo imageInfo = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .flags = flags,
+        .imageType = VK_IMAGE_TYPE_2D,
+        .format = format,
         .extent = {
-            .width = WINDOW_WIDTH,
-            .height = WINDOW_HEIGHT
-        }
-    };
-
-    VkPipelineViewportStateCreateInfo viewportState = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
-        .viewportCount = 1,
-        .pViewports = &viewport,
-        .scissorCount = 1,
-        .pScissors = &scissor
-    };
-
-    VkPipelineRasterizationStateCreateInfo rasterizer = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
-        .depthClampEnable = VK_FALSE,
-        .rasterizerDiscardEnable = VK_FALSE,
-        .polygonMode = VK_POLYGON_MODE_FILL,
-        .lineWidth = 1.0f,
-    };
-
-    VkPipelineMultisampleStateCreateInfo multisampling = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
-        .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
-        .sampleShadingEnable = VK_FALSE,
-        .minSampleShading = 1.0f, // Optional
-        .pSampleMask = nullptr, // Optional
-        .alphaToCoverageEnable = VK_FALSE, // Optional
-        .alphaToOneEnable = VK_FALSE // Optional
-    };
-
-    VkPipelineColorBlendAttachmentState colorBlendAttachment = {
-        .blendEnable = VK_FALSE,
-        .srcColorBlendFactor = VK_BLEND_FACTOR_ONE,
-        .dstColorBlendFactor = VK_BLEND_FACTOR_ZERO,
-        .colorBlendOp = VK_BLEND_OP_ADD,
-        .srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
-        .dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO,
-        .alphaBlendOp = VK_BLEND_OP_ADD,
-        .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
-    };
-
-    VkPipelineColorBlendStateCreateInfo colorBlending = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
-        .logicOpEnable = VK_FALSE,
-        .logicOp = VK_LOGIC_OP_COPY,
-        .attachmentCount = 1,
-        .pAttachments = &colorBlendAttachment
-    };
-
-
-    VkAttachmentDescription colorAttachment = {
-        .format = vulkanSurfaceFormat.format,
+            .width = width,
+            .height = height,
+            .depth = 1
+        },
+        .mipLevels = 1,
+        .arrayLayers = 1,
         .samples = VK_SAMPLE_COUNT_1_BIT,
-        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
-        .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
-        .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
-        .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
-        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-        .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
-    };
-    
-    VkAttachmentReference colorAttachmentRef = {
-        .attachment = 0,
-        .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-    };
-
-    VkSubpassDescription subpass = {
-        .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
-        .colorAttachmentCount = 1,
-        .pColorAttachments = &colorAttachmentRef
-    };
-
-    VkSubpassDependency dependency = {
-        .srcSubpass = VK_SUBPASS_EXTERNAL,
-        .dstSubpass = 0,
-        .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-        .dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-        .srcAccessMask = 0,
-        .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
-    };
-
-    VkRenderPassCreateInfo renderPassInfo = {
-        .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
-        .attachmentCount = 1,
-        .pAttachments = &colorAttachment,
-        .subpassCount = 1,
-        .pSubpasses = &subpass,
-        .dependencyCount = 1,
-        .pDependencies = &dependency
+        .usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
     };
-
-    result = vkCreateRenderPass(vulkanLogicalDevice, &renderPassInfo, nullptr, &vulkanRenderPass);
+    VkResult result = vkCreateImage(vulkanLogicalDevice, &imageInfo, nullptr, &context->displayImage);
     if (result != VK_SUCCESS) {
         return result;
     }
 
-    VkFramebufferCreateInfo framebufferInfo = {
-        .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
-        .renderPass = vulkanRenderPass,
-        .attachmentCount = 1,
-        .width = WINDOW_WIDTH,
-        .height = WINDOW_HEIGHT,
-        .layers = 1,
-    };
-
-    swapChainFramebuffers = new VkFramebuffer[vulkanSwapChainImageCount];
-    for (uint32_t iter = 0; iter < vulkanSwapChainImageCount; ++iter) {
-        framebufferInfo.pAttachments = &vulkanSwapChainImageViews[iter];
-        result = vkCreateFramebuffer(vulkanLogicalDevice, &framebufferInfo, nullptr, &swapChainFramebuffers[iter]);
-        if (result != VK_SUCCESS) {
-            return result;
-        }
-    }
-
-    VkCommandPoolCreateInfo poolInfo = {
-        .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
-        .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
-        .queueFamilyIndex = vulkanGraphicsQueueFamilyIndex,
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(vulkanLogicalDevice, context->displayImage, &memRequirements);
+    VkMemoryAllocateInfo memoryAllocateInfo = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .allocationSize = memRequirements.size,
+        .memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
     };
-
-    result = vkCreateCommandPool(vulkanLogicalDevice, &poolInfo, nullptr, &vulkanCommandPool);
+    result = vkAllocateMemory(vulkanLogicalDevice, &memoryAllocateInfo, nullptr, &context->displayImageMemory);
     if (result != VK_SUCCESS) {
         return result;
     }
+    vkBindImageMemory(vulkanLogicalDevice, context->displayImage, context->displayImageMemory, 0);
 
-    VkCommandBufferAllocateInfo allocInfo = {
-        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
-        .commandPool = vulkanCommandPool,
-        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
-        .commandBufferCount = 1
+    // The sampled view drops the storage usage its format may not support.
+    VkImageViewUsageCreateInfo sampledUsage = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_USAGE_CREATE_INFO,
+        .usage = VK_IMAGE_USAGE_SAMPLED_BIT
     };
-
-    result = vkAllocateCommandBuffers(vulkanLogicalDevice, &allocInfo, &vulkanGraphicsCommandBuffer);
-    if (result != VK_SUCCESS) {
-        return result;
-    }
-
-    result = vkAllocateCommandBuffers(vulkanLogicalDevice, &allocInfo, &vulkanComputeCommandBuffer);
+    VkImageViewCreateInfo viewInfo = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+        .pNext = extendedUsage ? &sampledUsage : nullptr,
+        .image = context->displayImage,
+        .viewType = VK_IMAGE_VIEW_TYPE_2D,
+        .format = format,
+        .subresourceRange = {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .baseMipLevel = 0,
+            .levelCount = 1,
+            .baseArrayLayer = 0,
+            .layerCount = 1
+        }
+    };
+    result = vkCreateImageView(vulkanLogicalDevice, &viewInfo, nullptr, &context->displayImageView);
     if (result != VK_SUCCESS) {
         return result;
     }
+    viewInfo.pNext = nullptr;
+    viewInfo.format = storageFormat;
+    return vkCreateImageView(vulkanLogicalDevice, &viewInfo, nullptr, &context->displayStorageView);
+}
 
-    VkSemaphoreCreateInfo semaphoreInfo = {
-        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO
-    };
-    VkFenceCreateInfo fenceInfo = {
-        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
-        .flags = VK_FENCE_CREATE_SIGNALED_BIT
-    };
-    if (vkCreateSemaphore(vulkanLogicalDevice, &semaphoreInfo, nullptr, &vulkanImageAvailableSemaphore) != VK_SUCCESS ||
-        vkCreateSemaphore(vulkanLogicalDevice, &semaphoreInfo, nullptr, &vulkanRenderFinishedSemaphore) != VK_SUCCESS ||
-        vkCreateFence(vulkanLogicalDevice, &fenceInfo, nullptr, &vulkanInFlightFence) != VK_SUCCESS) {
-        return VK_ERROR_UNKNOWN;
-    }
-
+// Cost counters as RGBA32UI, one component per CostCounter, copied out after the result image.
+static VkResult createCostImage(RenderContext* context, uint32_t width, uint32_t height)
+{
     VkImageCreateInfo imageInfo = {
         .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
         .imageType = VK_IMAGE_TYPE_2D,
-        .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+        .format = VK_FORMAT_R32G32B32A32_UINT,
         .extent = {
-            .width = WINDOW_WIDTH,
-            .height = WINDOW_HEIGHT,
+            .width = width,
+            .height = height,
             .depth = 1
         },
         .mipLevels = 1,
         .arrayLayers = 1,
         .samples = VK_SAMPLE_COUNT_1_BIT,
-        .usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT,
+        .usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
         .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
         .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
     };
-
-    result = vkCreateImage(vulkanLogicalDevice, &imageInfo, nullptr, &vulkanComputeResultImage);
+    VkResult result = vkCreateImage(vulkanLogicalDevice, &imageInfo, nullptr, &context->costImage);
     if (result != VK_SUCCESS) {
         return result;
     }
 
     VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(vulkanLogicalDevice, vulkanComputeResultImage, &memRequirements);
-
+    vkGetImageMemoryRequirements(vulkanLogicalDevice, context->costImage, &memRequirements);
     VkMemoryAllocateInfo memoryAllocateInfo = {
         .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
         .allocationSize = memRequirements.size,
-        .memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
+        .memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
     };
-
-    result = vkAllocateMemory(vulkanLogicalDevice, &memoryAllocateInfo, nullptr, &vulkanComputeResultImageMemory);
+    result = vkAllocateMemory(vulkanLogicalDevice, &memoryAllocateInfo, nullptr, &context->costImageMemory);
     if (result != VK_SUCCESS) {
         return result;
     }
-    vkBindImageMemory(vulkanLogicalDevice, vulkanComputeResultImage, vulkanComputeResultImageMemory, 0);
-
-    VkDescriptorSetLayoutBinding descriptorSetLayoutBinding[] = {
-        {
-            .binding = 0,
-            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-            .descriptorCount = 1,
-            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
-        },
-        {
-            .binding = 1,
-            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            .descriptorCount = 1,
-            .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT
-        }
-    };
+    vkBindImageMemory(vulkanLogicalDevice, context->costImage, context->costImageMemory, 0);
 
-    VkDescriptorSetLayoutCreateInfo layoutInfo = {
-        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
-        .bindingCount = 2,
-        .pBindings = descriptorSetLayoutBinding
+    VkImageViewCreateInfo viewInfo = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+        .image = context->costImage,
+        .viewType = VK_IMAGE_VIEW_TYPE_2D,
+        .format = VK_FORMAT_R32G32B32A32_UINT,
+        .subresourceRange = {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .baseMipLevel = 0,
+            .levelCount = 1,
+            .baseArrayLayer = 0,
+            .layerCount = 1
+        }
     };
-    result = vkCreateDescriptorSetLayout(vulkanLogicalDevice, &layoutInfo, nullptr, &vulkanComputeDescriptorSetLayout);
+    return vkCreateImageView(vulkanLogicalDevice, &viewInfo, nullptr, &context->costImageView);
+}
+
+static VkDeviceSize tileCullingSize(uint32_t imageWidth, uint32_t imageHeight)
+{
+    VkDeviceSize tiles = static_cast<VkDeviceSize>((imageWidth + CULL_TILE_SIZE - 1) / CULL_TILE_SIZE) *
+                         ((imageHeight + CULL_TILE_SIZE - 1) / CULL_TILE_SIZE);
+    return tiles * (1 + 2 * TILE_CANDIDATE_CAPACITY) * sizeof(uint32_t);
+}
+
+static VkResult createTileCullingBuffer(RenderContext* context, VkDeviceSize size)
+{
+    VkResult result = CreateBuffer(size, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                   VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                   &context->tileCullingBuffer, &context->tileCullingBufferMemory);
+    context->tileCullingBufferSize = result == VK_SUCCESS ? size : 0;
+    return result;
+}
+
+static void destroyTileCullingBuffer(RenderContext* context)
+{
+    if (context->tileCullingBuffer != nullptr) {
+        vkDestroyBuffer(vulkanLogicalDevice, context->tileCullingBuffer, nullptr);
+        context->tileCullingBuffer = VK_NULL_HANDLE;
+    }
+    if (context->tileCullingBufferMemory != nullptr) {
+        vkFreeMemory(vulkanLogicalDevice, context->tileCullingBufferMemory, nullptr);
+        context->tileCullingBufferMemory = VK_NULL_HANDLE;
+    }
+    context->tileCullingBufferSize = 0;
+}
+
+// Grow the candidate lists to the image of the camera. Rewrites the descriptor set, so it must not be
+// in any recorded command buffer: the window sizes them upfront, offscreen images grow before recording
+// after waiting for the session's fence.
+static VkResult reserveTileCulling(RenderContext* context)
+{
+    VkDeviceSize size = tileCullingSize(context->renderParameters.imageWidth, context->renderParameters.imageHeight);
+    if (context->cullPipeline == VK_NULL_HANDLE || size <= context->tileCullingBufferSize) {
+        return VK_SUCCESS;
+    }
+    destroyTileCullingBuffer(context);
+    VkResult result = createTileCullingBuffer(context, size);
     if (result != VK_SUCCESS) {
         return result;
     }
+    VkDescriptorBufferInfo tileCullingBufferInfo = {
+        .buffer = context->tileCullingBuffer,
+        .offset = 0,
+        .range = VK_WHOLE_SIZE
+    };
+    VkWriteDescriptorSet write = {
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet = context->descriptorSet,
+        .dstBinding = TILE_CULLING_BINDING,
+        .dstArrayElement = 0,
+        .descriptorCount = 1,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .pBufferInfo = &tileCullingBufferInfo
+    };
+    vkUpdateDescriptorSets(vulkanLogicalDevice, 1, &write, 0, nullptr);
+    context->tileCullingDirty = true;
+    return VK_SUCCESS;
+}
 
-    VkPipelineLayoutCreateInfo graphicsPipelineLayoutInfo = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-        .setLayoutCount = 1,
-        .pSetLayouts = &vulkanComputeDescriptorSetLayout,
-        .pushConstantRangeCount = 0,
-        .pPushConstantRanges = nullptr
+// Rebuild the candidate lists of every tile after the camera or the scene changed.
+// Binds the cull pipeline & the descriptor set, the caller binds its own pipeline after.
+static void recordTileCulling(RenderContext* context, VkCommandBuffer commandBuffer)
+{
+    if (context->cullPipeline == VK_NULL_HANDLE) {
+        return;
+    }
+    if (GetRenderSceneVersion(context->scene) != context->culledSceneVersion) {
+        context->culledSceneVersion = GetRenderSceneVersion(context->scene);
+        context->tileCullingDirty = true;
+    }
+    if (!context->tileCullingDirty) {
+        return;
+    }
+    context->tileCullingDirty = false;
+
+    uint32_t tileCount = ((context->renderParameters.imageWidth + CULL_TILE_SIZE - 1) / CULL_TILE_SIZE) *
+                         ((context->renderParameters.imageHeight + CULL_TILE_SIZE - 1) / CULL_TILE_SIZE);
+    VkBufferMemoryBarrier barrier = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_SHADER_READ_BIT,
+        .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = context->tileCullingBuffer,
+        .offset = 0,
+        .size = VK_WHOLE_SIZE
+    };
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 0, nullptr, 1, &barrier, 0, nullptr);
+    vkCmdFillBuffer(commandBuffer, context->tileCullingBuffer, 0, tileCount * sizeof(uint32_t), 0);
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, context->cullPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, context->computePipelineLayout,
+        0, 1, &context->descriptorSet, 0, 0);
+    vkCmdPushConstants(commandBuffer, context->computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+        0, sizeof(context->renderParameters), &context->renderParameters);
+    // One invocation per sphere of the largest geometry & instance, instances beyond the limit are strided.
+    RenderSceneTraits traits;
+    GetRenderSceneTraits(context->scene, &traits);
+    vkCmdDispatch(commandBuffer, (traits.maxSphereCount + CULL_WORKGROUP_SIZE - 1) / CULL_WORKGROUP_SIZE,
+        std::clamp<uint32_t>(GetRenderSceneInstanceCount(context->scene), 1, 65535), 1);
+
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0, 0, nullptr, 1, &barrier, 0, nullptr);
+}
+
+// Dispatch a width x height grid of pixels: one thread per pixel, or the persistent threads kernel after
+// emptying its queue. Follows a dispatch that may still read the queue.
+static void recordComputeDispatch(RenderContext* context, VkCommandBuffer commandBuffer, uint32_t width, uint32_t height)
+{
+    if (context->persistentWorkgroups == 0) {
+        vkCmdDispatch(commandBuffer, (width + 15) / 16, (height + 15) / 16, 1);
+        return;
+    }
+    VkBufferMemoryBarrier barrier = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = context->workQueueBuffer,
+        .offset = 0,
+        .size = VK_WHOLE_SIZE
+    };
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0, 0, nullptr, 1, &barrier, 0, nullptr);
+    vkCmdFillBuffer(commandBuffer, context->workQueueBuffer, 0, VK_WHOLE_SIZE, 0);
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0, 0, nullptr, 1, &barrier, 0, nullptr);
+    uint32_t pixelWorkgroups = (width * height + COMPUTE_WORKGROUP_SIZE - 1) / COMPUTE_WORKGROUP_SIZE;
+    vkCmdDispatch(commandBuffer, std::min(context->persistentWorkgroups, pixelWorkgroups), 1, 1);
+}
 
+static VkResult recordComputeCommandBuffer(RenderContext* context, VkCommandBuffer commandBuffer)
+{
+
+    VkResult result;
+    VkCommandBufferBeginInfo beginInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
     };
 
-    result = vkCreatePipelineLayout(vulkanLogicalDevice, &graphicsPipelineLayoutInfo, nullptr, &vulkanGraphicsPipelineLayout);
+    // A changed scene restarts accumulation, which also refills the first hit cache.
+    if (GetRenderSceneVersion(context->scene) != context->renderedSceneVersion) {
+        context->renderedSceneVersion = GetRenderSceneVersion(context->scene);
+        context->accumulatedSamples = 0;
+    }
+
+    result = vkBeginCommandBuffer(commandBuffer, &beginInfo);
     if (result != VK_SUCCESS) {
         return result;
     }
 
-    VkGraphicsPipelineCreateInfo pipelineInfo = {
-        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-        .pNext = nullptr,
-        .stageCount = 2,
-        .pStages = GraphicsShaderStages,
-        .pVertexInputState = &vertexInputInfo,
-        .pInputAssemblyState = &inputAssembly,
-        .pViewportState = &viewportState,
-        .pRasterizationState = &rasterizer,
-        .pMultisampleState = &multisampling,
-        .pDepthStencilState = nullptr, // Optional
-        .pColorBlendState = &colorBlending,
-        .pDynamicState = &dynamicState,
-        .layout = vulkanGraphicsPipelineLayout,
-        .renderPass = vulkanRenderPass,
-        .subpass = 0
+    if (context->timestampQuery != VK_NULL_HANDLE) {
+        vkCmdResetQueryPool(commandBuffer, context->timestampQuery, 0, 2);
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, context->timestampQuery, 0);
+    }
+    recordTileCulling(context, commandBuffer);
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, context->computePipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, context->computePipelineLayout,
+        0, 1, &context->descriptorSet, 0, 0);
+
+    context->frameSamples = context->sampleBudget.samples;
+    if (context->sampleTarget != 0) {
+        context->frameSamples = std::min(context->frameSamples, context->sampleTarget - context->accumulatedSamples);
+    }
+    RenderPushConstants constants = context->renderParameters;
+    constants.sampleBase = context->accumulatedSamples;
+    constants.sampleCount = context->frameSamples;
+    constants.flags = context->accumulatedSamples > 0 ? RENDER_FLAG_ACCUMULATE : 0;
+    vkCmdPushConstants(commandBuffer, context->computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+        0, sizeof(constants), &constants);
+
+    if (context->statisticsQuery != VK_NULL_HANDLE) {
+        vkCmdResetQueryPool(commandBuffer, context->statisticsQuery, 0, 1);
+        vkCmdBeginQuery(commandBuffer, context->statisticsQuery, 0, 0);
+    }
+    recordComputeDispatch(context, commandBuffer, WINDOW_WIDTH, WINDOW_HEIGHT);
+    if (context->statisticsQuery != VK_NULL_HANDLE) {
+        vkCmdEndQuery(commandBuffer, context->statisticsQuery, 0);
+    }
+    if (context->timestampQuery != VK_NULL_HANDLE) {
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, context->timestampQuery, 1);
+    }
+
+    // Display image or accumulated result is sampled by the following graphics submission.
+    recordImageBarrier(commandBuffer, context->presentedImage, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+
+    return vkEndCommandBuffer(commandBuffer);
+}
+
+// Command pool, result image, descriptors & compute pipeline, shared by windowed and offscreen rendering.
+// The scene must be loaded before, the pipeline is specialized on it.
+// firstHitStrata: primary hits cached per pixel & fixed sub-pixel position, 0 to always trace them.
+// Tile culling lists are sized for imageWidth x imageHeight & grow with the camera image.
+// displayFormat: what binding 1 presents, DISPLAY_FORMAT_RGBA32F samples the result image itself.
+static VkResult createComputeResources(RenderContext* context, uint32_t imageWidth, uint32_t imageHeight,
+                                       VkImageUsageFlags imageUsage, uint32_t samplesPerDispatch,
+                                       uint32_t firstHitStrata, DisplayFormat displayFormat)
+{
+
+    // Scenes with a TLAS use the ray query variant of the shader, which binds it last.
+    VkAccelerationStructureKHR accelerationStructure = GetRenderSceneAccelerationStructure(context->scene);
+    uint32_t bindingCount = 7 + SCENE_BUFFER_COUNT + (accelerationStructure != VK_NULL_HANDLE ? 1 : 0);
+    const char* shaderFile = "shader.comp.spv";
+    const char* traversal = "compute BVH";
+    bool float16Shading = false;
+    if (accelerationStructure != VK_NULL_HANDLE) {
+        shaderFile = "shader.rayquery.comp.spv";
+        traversal = "ray query";
+    } else if (renderOptions.traversal == TRAVERSAL_LINEAR) {
+        shaderFile = "shader.linear.comp.spv";
+        traversal = "shared memory linear";
+    } else if (renderOptions.persistentWorkgroups != 0 && vulkanSubgroupBallotSupported) {
+        // Also drops the first hit cache, paths of a pixel run one after the other.
+        shaderFile = "shader.persistent.comp.spv";
+        traversal = "persistent threads compute BVH";
+        context->persistentWorkgroups = renderOptions.persistentWorkgroups;
+        if (firstHitStrata != 0) {
+            fprintf(stderr, "Renderer: the first hit cache does not work with persistent threads, ignored.\n");
+        }
+        firstHitStrata = 0;
+        // One dimensional dispatch, the device caps its size.
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(vulkanPhysicalDevice, &properties);
+        if (context->persistentWorkgroups > properties.limits.maxComputeWorkGroupCount[0]) {
+            context->persistentWorkgroups = properties.limits.maxComputeWorkGroupCount[0];
+            fprintf(stderr, "Renderer: persistent threads limited to %u workgroups by the device.\n",
+                    context->persistentWorkgroups);
+        }
+    } else if (renderOptions.shadingPrecision == SHADING_PRECISION_FP16 && vulkanFloat16Enabled) {
+        shaderFile = "shader.float16.comp.spv";
+        float16Shading = true;
+    }
+    if (renderOptions.shadingPrecision == SHADING_PRECISION_FP16 && !float16Shading) {
+        fprintf(stderr, "Renderer: fp16 shading needs the plain compute BVH traversal & shaderFloat16, using fp32.\n");
+    }
+    if (renderOptions.persistentWorkgroups != 0 && context->persistentWorkgroups == 0) {
+        fprintf(stderr, "Renderer: persistent threads need the compute BVH traversal & subgroup ballots, ignored.\n");
+    }
+    VkResult result;
+    uint64_t codeHash;
+    result = CreateShaderStageFromFile(shaderFile, VK_SHADER_STAGE_COMPUTE_BIT, &context->computeShaderStage, &codeHash);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    printf("Renderer: %s traversal%s%s.\n", traversal, float16Shading ? ", fp16 shading" : "",
+           renderOptions.tileCulling ? ", tile culling" : "");
+    uint64_t cullCodeHash = 0;
+    if (renderOptions.tileCulling) {
+        result = CreateShaderStageFromFile("cull.comp.spv", VK_SHADER_STAGE_COMPUTE_BIT, &context->cullShaderStage,
+                                           &cullCodeHash);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+
+    VkCommandPoolCreateInfo poolInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+        .flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
+        .queueFamilyIndex = vulkanGraphicsQueueFamilyIndex,
+    };
+
+    result = vkCreateCommandPool(vulkanLogicalDevice, &poolInfo, nullptr, &context->commandPool);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkCommandBufferAllocateInfo allocInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .commandPool = context->commandPool,
+        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .commandBufferCount = 1
+    };
+
+    result = vkAllocateCommandBuffers(vulkanLogicalDevice, &allocInfo, &context->computeCommandBuffer);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkFenceCreateInfo fenceInfo = {
+        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+        .flags = VK_FENCE_CREATE_SIGNALED_BIT
+    };
+    result = vkCreateFence(vulkanLogicalDevice, &fenceInfo, nullptr, &context->inFlightFence);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    context->resultImageWidth = imageWidth;
+    context->resultImageHeight = imageHeight;
+    VkImageCreateInfo imageInfo = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .imageType = VK_IMAGE_TYPE_2D,
+        .format = VK_FORMAT_R32G32B32A32_SFLOAT,
+        .extent = {
+            .width = imageWidth,
+            .height = imageHeight,
+            .depth = 1
+        },
+        .mipLevels = 1,
+        .arrayLayers = 1,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .usage = imageUsage,
+        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
+    };
+
+    result = vkCreateImage(vulkanLogicalDevice, &imageInfo, nullptr, &context->resultImage);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(vulkanLogicalDevice, context->resultImage, &memRequirements);
+
+    VkMemoryAllocateInfo memoryAllocateInfo = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        .allocationSize = memRequirements.size,
+        .memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)
+    };
+
+    result = vkAllocateMemory(vulkanLogicalDevice, &memoryAllocateInfo, nullptr, &context->resultImageMemory);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    vkBindImageMemory(vulkanLogicalDevice, context->resultImage, context->resultImageMemory, 0);
+
+    // The shader declares the display image whether it writes it or not, it is bound regardless.
+    if (displayFormat != DISPLAY_FORMAT_RGBA32F) {
+        result = createDisplayImage(context, imageWidth, imageHeight, displayFormat);
+        context->presentedImage = context->displayImage;
+    } else {
+        result = createDisplayImage(context, 1, 1, displayFormat);
+        context->presentedImage = context->resultImage;
+    }
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    result = context->costCounters ? createCostImage(context, imageWidth, imageHeight) : createCostImage(context, 1, 1);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    if (context->costCounters && vulkanPipelineStatisticsEnabled) {
+        VkQueryPoolCreateInfo queryInfo = {
+            .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+            .queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS,
+            .queryCount = 1,
+            .pipelineStatistics = VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT
+        };
+        result = vkCreateQueryPool(vulkanLogicalDevice, &queryInfo, nullptr, &context->statisticsQuery);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+
+    // Cached first hits of every pixel & stratum, written by the first samples after a restart.
+    VkDeviceSize firstHitSize = std::max<VkDeviceSize>(FIRST_HIT_ENTRY_SIZE,
+        static_cast<VkDeviceSize>(imageWidth) * imageHeight * firstHitStrata * FIRST_HIT_ENTRY_SIZE);
+    result = CreateBuffer(firstHitSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                          &context->firstHitBuffer, &context->firstHitBufferMemory);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    result = createTileCullingBuffer(context, renderOptions.tileCulling ? tileCullingSize(imageWidth, imageHeight)
+                                                               : sizeof(uint32_t));
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    result = CreateBuffer(sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                          VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &context->workQueueBuffer, &context->workQueueBufferMemory);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkDescriptorSetLayoutBinding descriptorSetLayoutBinding[7 + SCENE_BUFFER_COUNT + 1] = {
+        {
+            .binding = 0,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+            .descriptorCount = 1,
+            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
+        },
+        {
+            .binding = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            .descriptorCount = 1,
+            .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT
+        }
+    };
+    for (uint32_t iter = 0; iter < SCENE_BUFFER_COUNT; ++iter) {
+        descriptorSetLayoutBinding[2 + iter] = {
+            .binding = SCENE_BUFFER_FIRST_BINDING + iter,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = 1,
+            .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
+        };
+    }
+    descriptorSetLayoutBinding[2 + SCENE_BUFFER_COUNT] = {
+        .binding = FIRST_HIT_CACHE_BINDING,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .descriptorCount = 1,
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
+    };
+    descriptorSetLayoutBinding[3 + SCENE_BUFFER_COUNT] = {
+        .binding = TILE_CULLING_BINDING,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .descriptorCount = 1,
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
+    };
+    descriptorSetLayoutBinding[4 + SCENE_BUFFER_COUNT] = {
+        .binding = WORK_QUEUE_BINDING,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .descriptorCount = 1,
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
+    };
+    descriptorSetLayoutBinding[5 + SCENE_BUFFER_COUNT] = {
+        .binding = DISPLAY_IMAGE_BINDING,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+        .descriptorCount = 1,
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
+    };
+    descriptorSetLayoutBinding[6 + SCENE_BUFFER_COUNT] = {
+        .binding = COST_IMAGE_BINDING,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+        .descriptorCount = 1,
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
+    };
+    descriptorSetLayoutBinding[7 + SCENE_BUFFER_COUNT] = {
+        .binding = SCENE_ACCELERATION_STRUCTURE_BINDING,
+        .descriptorType = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
+        .descriptorCount = 1,
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
+    };
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+        .bindingCount = bindingCount,
+        .pBindings = descriptorSetLayoutBinding
+    };
+    result = vkCreateDescriptorSetLayout(vulkanLogicalDevice, &layoutInfo, nullptr, &context->descriptorSetLayout);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkPushConstantRange pushConstantRange = {
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+        .offset = 0,
+        .size = sizeof(RenderPushConstants)
+    };
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+        .setLayoutCount = 1,
+        .pSetLayouts = &context->descriptorSetLayout,
+        .pushConstantRangeCount = 1,
+        .pPushConstantRanges = &pushConstantRange
     };
 
-    result = vkCreateGraphicsPipelines(vulkanLogicalDevice, VK_NULL_HANDLE, 1,&pipelineInfo, nullptr, &vulkanGraphicsPipeline);
+    result = vkCreatePipelineLayout(vulkanLogicalDevice, &pipelineLayoutInfo, nullptr, &context->computePipelineLayout);
     if (result != VK_SUCCESS) {
         return result;
     }
 
-    vulkanComputePipelineLayout = vulkanGraphicsPipelineLayout;
+    // Absent material types & deeper stacks than the scene needs are compiled out.
+    RenderSceneTraits traits;
+    GetRenderSceneTraits(context->scene, &traits);
+    ComputeSpecialization specialization = {
+        .materialTypes = traits.materialTypes,
+        .bvhStackSize = traits.bvhDepth,
+        .tlasStackSize = traits.tlasDepth,
+        .samplesPerDispatch = samplesPerDispatch,
+        .firstHitStrata = firstHitStrata,
+        .tileCulling = renderOptions.tileCulling ? 1u : 0u,
+        .pixelOrder = static_cast<uint32_t>(renderOptions.pixelOrder),
+        // The linear scan & persistent threads variants have no binning.
+        .rayBinning = renderOptions.rayBinning && renderOptions.traversal != TRAVERSAL_LINEAR &&
+                      context->persistentWorkgroups == 0 ? 1u : 0u,
+        .materialIdBits = traits.materialIdBits,
+        .displayFormat = static_cast<uint32_t>(displayFormat),
+        .costCounters = context->costCounters ? 1u : 0u,
+        // Only the window's display image shows the overlay.
+        .costOverlay = context->costCounters && displayFormat != DISPLAY_FORMAT_RGBA32F ?
+                       static_cast<uint32_t>(renderOptions.costOverlay) : 0u
+    };
+    VkSpecializationMapEntry specializationEntries[] = {
+        { .constantID = 0, .offset = offsetof(ComputeSpecialization, materialTypes), .size = sizeof(uint32_t) },
+        { .constantID = 1, .offset = offsetof(ComputeSpecialization, bvhStackSize), .size = sizeof(uint32_t) },
+        { .constantID = 2, .offset = offsetof(ComputeSpecialization, tlasStackSize), .size = sizeof(uint32_t) },
+        { .constantID = 3, .offset = offsetof(ComputeSpecialization, samplesPerDispatch), .size = sizeof(uint32_t) },
+        { .constantID = 4, .offset = offsetof(ComputeSpecialization, firstHitStrata), .size = sizeof(uint32_t) },
+        { .constantID = 5, .offset = offsetof(ComputeSpecialization, tileCulling), .size = sizeof(uint32_t) },
+        { .constantID = 6, .offset = offsetof(ComputeSpecialization, pixelOrder), .size = sizeof(uint32_t) },
+        { .constantID = 7, .offset = offsetof(ComputeSpecialization, rayBinning), .size = sizeof(uint32_t) },
+        { .constantID = 8, .offset = offsetof(ComputeSpecialization, materialIdBits), .size = sizeof(uint32_t) },
+        { .constantID = 9, .offset = offsetof(ComputeSpecialization, displayFormat), .size = sizeof(uint32_t) },
+        { .constantID = 10, .offset = offsetof(ComputeSpecialization, costCounters), .size = sizeof(uint32_t) },
+        { .constantID = 11, .offset = offsetof(ComputeSpecialization, costOverlay), .size = sizeof(uint32_t) }
+    };
+    VkSpecializationInfo specializationInfo = {
+        .mapEntryCount = sizeof(specializationEntries) / sizeof(VkSpecializationMapEntry),
+        .pMapEntries = specializationEntries,
+        .dataSize = sizeof(specialization),
+        .pData = &specialization
+    };
+    context->computeShaderStage.pSpecializationInfo = &specializationInfo;
 
     VkComputePipelineCreateInfo computePipelineInfo = {
         .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
-        .stage = ComputeShaderStage,
-        .layout = vulkanComputePipelineLayout,
+        .stage = context->computeShaderStage,
+        .layout = context->computePipelineLayout,
     };
 
-    result = vkCreateComputePipelines(vulkanLogicalDevice, VK_NULL_HANDLE, 1, &computePipelineInfo, nullptr, &vulkanComputePipeline);
+    result = CreateCachedComputePipeline(&computePipelineInfo, codeHash, &context->computePipeline);
+    context->computeShaderStage.pSpecializationInfo = nullptr;
     if (result != VK_SUCCESS) {
         return result;
     }
-    
+
+    if (renderOptions.tileCulling) {
+        VkComputePipelineCreateInfo cullPipelineInfo = {
+            .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+            .stage = context->cullShaderStage,
+            .layout = context->computePipelineLayout,
+        };
+        result = CreateCachedComputePipeline(&cullPipelineInfo, cullCodeHash, &context->cullPipeline);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+        context->tileCullingDirty = true;
+    }
+
     VkDescriptorPoolSize poolSize[] = {
         {
             .type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
-            .descriptorCount = 1
+            .descriptorCount = 3
         },
         {
             .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
             .descriptorCount = 1
+        },
+        {
+            .type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .descriptorCount = SCENE_BUFFER_COUNT + 3
+        },
+        {
+            .type = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR,
+            .descriptorCount = 1
         }
     };
 
     VkDescriptorPoolCreateInfo descriptorPoolInfo = {
         .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
         .maxSets = 2,
-        .poolSizeCount = 2,
+        .poolSizeCount = accelerationStructure != VK_NULL_HANDLE ? 4u : 3u,
         .pPoolSizes = poolSize
     };
-    result = vkCreateDescriptorPool(vulkanLogicalDevice, &descriptorPoolInfo, nullptr, &vulkanDescriptorPool);
+    result = vkCreateDescriptorPool(vulkanLogicalDevice, &descriptorPoolInfo, nullptr, &context->descriptorPool);
     if (result != VK_SUCCESS) {
         return result;
     }
 
     VkDescriptorSetAllocateInfo descriptorSetallocInfo = {
         .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
-        .descriptorPool = vulkanDescriptorPool,
+        .descriptorPool = context->descriptorPool,
         .descriptorSetCount = 1,
-        .pSetLayouts = &vulkanComputeDescriptorSetLayout
+        .pSetLayouts = &context->descriptorSetLayout
     };
-    result = vkAllocateDescriptorSets(vulkanLogicalDevice, &descriptorSetallocInfo, &vulkanComputeDescriptorSet);
+    result = vkAllocateDescriptorSets(vulkanLogicalDevice, &descriptorSetallocInfo, &context->descriptorSet);
     if (result != VK_SUCCESS) {
         return result;
     }
 
     VkImageViewCreateInfo computeResultViewInfo = {
         .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
-        .image = vulkanComputeResultImage,
+        .image = context->resultImage,
         .viewType = VK_IMAGE_VIEW_TYPE_2D,
         .format = VK_FORMAT_R32G32B32A32_SFLOAT,
         .subresourceRange = {
@@ -589,7 +1076,7 @@ VkResult BeginRenderingOperation(void)
         }
     };
 
-    result = vkCreateImageView(vulkanLogicalDevice, &computeResultViewInfo, nullptr, &vulkanComputeResultImageView);
+    result = vkCreateImageView(vulkanLogicalDevice, &computeResultViewInfo, nullptr, &context->resultImageView);
     if (result != VK_SUCCESS) {
         return result;
     }
@@ -612,21 +1099,64 @@ VkResult BeginRenderingOperation(void)
         .unnormalizedCoordinates = VK_FALSE
     };
 
-    result = vkCreateSampler(vulkanLogicalDevice, &samplerInfo, nullptr, &vulkanComputeResultImageSampler);
+    result = vkCreateSampler(vulkanLogicalDevice, &samplerInfo, nullptr, &context->resultImageSampler);
     if (result != VK_SUCCESS) {
         return result;
     }
 
     VkDescriptorImageInfo computeImageInfo = {
-        .sampler = vulkanComputeResultImageSampler,
-        .imageView = vulkanComputeResultImageView,
+        .sampler = context->resultImageSampler,
+        .imageView = context->resultImageView,
+        .imageLayout = VK_IMAGE_LAYOUT_GENERAL
+    };
+
+    VkDescriptorImageInfo presentedImageInfo = {
+        .sampler = context->resultImageSampler,
+        .imageView = displayFormat != DISPLAY_FORMAT_RGBA32F ? context->displayImageView : context->resultImageView,
+        .imageLayout = VK_IMAGE_LAYOUT_GENERAL
+    };
+
+    VkDescriptorImageInfo displayStorageInfo = {
+        .imageView = context->displayStorageView,
         .imageLayout = VK_IMAGE_LAYOUT_GENERAL
     };
 
-    VkWriteDescriptorSet write[] = {
+    VkDescriptorImageInfo costImageInfo = {
+        .imageView = context->costImageView,
+        .imageLayout = VK_IMAGE_LAYOUT_GENERAL
+    };
+
+    VkDescriptorBufferInfo sceneBufferInfos[SCENE_BUFFER_COUNT];
+    GetRenderSceneBuffers(context->scene, sceneBufferInfos);
+
+    VkWriteDescriptorSetAccelerationStructureKHR accelerationStructureInfo = {
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR,
+        .accelerationStructureCount = 1,
+        .pAccelerationStructures = &accelerationStructure
+    };
+
+    VkDescriptorBufferInfo firstHitBufferInfo = {
+        .buffer = context->firstHitBuffer,
+        .offset = 0,
+        .range = VK_WHOLE_SIZE
+    };
+
+    VkDescriptorBufferInfo tileCullingBufferInfo = {
+        .buffer = context->tileCullingBuffer,
+        .offset = 0,
+        .range = VK_WHOLE_SIZE
+    };
+
+    VkDescriptorBufferInfo workQueueBufferInfo = {
+        .buffer = context->workQueueBuffer,
+        .offset = 0,
+        .range = VK_WHOLE_SIZE
+    };
+
+    VkWriteDescriptorSet write[7 + SCENE_BUFFER_COUNT + 1] = {
         {
             .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .dstSet = vulkanComputeDescriptorSet,
+            .dstSet = context->descriptorSet,
             .dstBinding = 0,
             .dstArrayElement = 0,
             .descriptorCount = 1,
@@ -635,65 +1165,882 @@ VkResult BeginRenderingOperation(void)
         },
         {
             .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-            .dstSet = vulkanComputeDescriptorSet,
+            .dstSet = context->descriptorSet,
             .dstBinding = 1,
             .dstArrayElement = 0,
             .descriptorCount = 1,
             .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-            .pImageInfo = &computeImageInfo
+            .pImageInfo = &presentedImageInfo
         }
     };
+    for (uint32_t iter = 0; iter < SCENE_BUFFER_COUNT; ++iter) {
+        write[2 + iter] = {
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .dstSet = context->descriptorSet,
+            .dstBinding = SCENE_BUFFER_FIRST_BINDING + iter,
+            .dstArrayElement = 0,
+            .descriptorCount = 1,
+            .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+            .pBufferInfo = &sceneBufferInfos[iter]
+        };
+    }
+    write[2 + SCENE_BUFFER_COUNT] = {
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet = context->descriptorSet,
+        .dstBinding = FIRST_HIT_CACHE_BINDING,
+        .dstArrayElement = 0,
+        .descriptorCount = 1,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .pBufferInfo = &firstHitBufferInfo
+    };
+    write[3 + SCENE_BUFFER_COUNT] = {
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet = context->descriptorSet,
+        .dstBinding = TILE_CULLING_BINDING,
+        .dstArrayElement = 0,
+        .descriptorCount = 1,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .pBufferInfo = &tileCullingBufferInfo
+    };
+    write[4 + SCENE_BUFFER_COUNT] = {
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet = context->descriptorSet,
+        .dstBinding = WORK_QUEUE_BINDING,
+        .dstArrayElement = 0,
+        .descriptorCount = 1,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .pBufferInfo = &workQueueBufferInfo
+    };
+    write[5 + SCENE_BUFFER_COUNT] = {
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet = context->descriptorSet,
+        .dstBinding = DISPLAY_IMAGE_BINDING,
+        .dstArrayElement = 0,
+        .descriptorCount = 1,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+        .pImageInfo = &displayStorageInfo
+    };
+    write[6 + SCENE_BUFFER_COUNT] = {
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .dstSet = context->descriptorSet,
+        .dstBinding = COST_IMAGE_BINDING,
+        .dstArrayElement = 0,
+        .descriptorCount = 1,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+        .pImageInfo = &costImageInfo
+    };
+    write[7 + SCENE_BUFFER_COUNT] = {
+        .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+        .pNext = &accelerationStructureInfo,
+        .dstSet = context->descriptorSet,
+        .dstBinding = SCENE_ACCELERATION_STRUCTURE_BINDING,
+        .dstArrayElement = 0,
+        .descriptorCount = 1,
+        .descriptorType = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR
+    };
 
-    vkUpdateDescriptorSets(vulkanLogicalDevice, 2, write, 0, nullptr);
-    
-    return transitionImageLayout(vulkanComputeResultImage, VK_FORMAT_R32G32B32A32_SFLOAT,
+    vkUpdateDescriptorSets(vulkanLogicalDevice, bindingCount, write, 0, nullptr);
+
+    result = transitionImageLayout(context, context->displayImage, displayFormats[displayFormat].format,
+                                   VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, TRANSITION_FROM_NULL_TO_COMPUTE);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    result = transitionImageLayout(context, context->costImage, VK_FORMAT_R32G32B32A32_UINT,
+                                   VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL, TRANSITION_FROM_NULL_TO_COMPUTE);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    return transitionImageLayout(context, context->resultImage, VK_FORMAT_R32G32B32A32_SFLOAT,
                                  VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_GENERAL,TRANSITION_FROM_NULL_TO_COMPUTE);
+}
+
+// Compute resources of the window, presentation is attached once the swapchain exists.
+static VkResult createWindowResources(RenderContext* context)
+{
+
+    VkResult result;
+    // The overlay is blended into the display image, the accumulation image is presented as is.
+    DisplayFormat displayFormat = renderOptions.displayFormat;
+    if (renderOptions.costOverlay != COST_OVERLAY_NONE && displayFormat == DISPLAY_FORMAT_RGBA32F) {
+        printf("Renderer: the cost overlay needs a display image, presenting rgba16f.\n");
+        displayFormat = DISPLAY_FORMAT_RGBA16F;
+    }
+    context->costCounters = renderOptions.costCounters;
+    SampleControl sampleControl = renderOptions.sampleControl;
+    if (sampleControl != SAMPLE_CONTROL_FIXED && vulkanTimestampValidBits == 0) {
+        printf("Renderer: no timestamps on the compute queue, %u samples per frame.\n",
+               static_cast<unsigned>(SAMPLES_PER_FRAME));
+        sampleControl = SAMPLE_CONTROL_FIXED;
+    }
+    InitSampleBudget(&context->sampleBudget, sampleControl, renderOptions.frameBudget);
+    context->sampleTarget = renderOptions.windowSamples;
+    // The window keeps its camera until told otherwise, the first hit cache pays off there.
+    // Adapted sample counts come with the push constants, fixed ones are specialized.
+    result = createComputeResources(context, WINDOW_WIDTH, WINDOW_HEIGHT, VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT,
+                                    sampleControl == SAMPLE_CONTROL_FIXED ? SAMPLES_PER_FRAME : 0,
+                                    renderOptions.traversal == TRAVERSAL_LINEAR ? 0 : renderOptions.firstHitStrata,
+                                    selectDisplayFormat(displayFormat));
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    if (sampleControl != SAMPLE_CONTROL_FIXED) {
+        VkQueryPoolCreateInfo queryInfo = {
+            .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+            .queryType = VK_QUERY_TYPE_TIMESTAMP,
+            .queryCount = 2
+        };
+        result = vkCreateQueryPool(vulkanLogicalDevice, &queryInfo, nullptr, &context->timestampQuery);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+    SetRenderCamera(context, &defaultCamera, WINDOW_WIDTH, WINDOW_HEIGHT);
+    return VK_SUCCESS;
+}
+
+// Render pass, framebuffers & the pipeline presenting the result in the window.
+static VkResult createPresentationResources(RenderContext* context)
+{
+
+    VkResult result;
+    result = CreateShaderStageFromFile("shader.frag.spv",VK_SHADER_STAGE_FRAGMENT_BIT,&context->graphicsShaderStages[0]);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    result = CreateShaderStageFromFile("shader.vert.spv", VK_SHADER_STAGE_VERTEX_BIT, &context->graphicsShaderStages[1]);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT,VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamicState = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+        .dynamicStateCount = sizeof(dynamicStates) / sizeof(VkDynamicState),
+        .pDynamicStates = dynamicStates
+    };
+
+    VkPipelineVertexInputStateCreateInfo vertexInputInfo = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+        .vertexBindingDescriptionCount = 0,
+        .pVertexBindingDescriptions = nullptr, // Optional
+        .vertexAttributeDescriptionCount = 0,
+        .pVertexAttributeDescriptions = nullptr
+    };
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+        .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+        .primitiveRestartEnable = VK_FALSE
+    };
+
+    VkViewport viewport = {
+        .x = 0.0f,
+        .y = 0.0f,
+        .width = WINDOW_WIDTH,
+        .height = WINDOW_HEIGHT,
+        .minDepth = 0.0f,
+        .maxDepth = 1.0f
+    };
+
+    VkRect2D scissor = {
+        .offset = { 0, 0 },
+        .extent = {
+            .width = WINDOW_WIDTH,
+            .height = WINDOW_HEIGHT
+        }
+    };
+
+    VkPipelineViewportStateCreateInfo viewportState = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+        .viewportCount = 1,
+        .pViewports = &viewport,
+        .scissorCount = 1,
+        .pScissors = &scissor
+    };
+
+    VkPipelineRasterizationStateCreateInfo rasterizer = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+        .depthClampEnable = VK_FALSE,
+        .rasterizerDiscardEnable = VK_FALSE,
+        .polygonMode = VK_POLYGON_MODE_FILL,
+        .lineWidth = 1.0f,
+    };
+
+    VkPipelineMultisampleStateCreateInfo multisampling = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+        .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+        .sampleShadingEnable = VK_FALSE,
+        .minSampleShading = 1.0f, // Optional
+        .pSampleMask = nullptr, // Optional
+        .alphaToCoverageEnable = VK_FALSE, // Optional
+        .alphaToOneEnable = VK_FALSE // Optional
+    };
+
+    VkPipelineColorBlendAttachmentState colorBlendAttachment = {
+        .blendEnable = VK_FALSE,
+        .srcColorBlendFactor = VK_BLEND_FACTOR_ONE,
+        .dstColorBlendFactor = VK_BLEND_FACTOR_ZERO,
+        .colorBlendOp = VK_BLEND_OP_ADD,
+        .srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
+        .dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO,
+        .alphaBlendOp = VK_BLEND_OP_ADD,
+        .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+    };
+
+    VkPipelineColorBlendStateCreateInfo colorBlending = {
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+        .logicOpEnable = VK_FALSE,
+        .logicOp = VK_LOGIC_OP_COPY,
+        .attachmentCount = 1,
+        .pAttachments = &colorBlendAttachment
+    };
+
+
+    VkAttachmentDescription colorAttachment = {
+        .format = vulkanSurfaceFormat.format,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR,
+        .storeOp = VK_ATTACHMENT_STORE_OP_STORE,
+        .stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+        .stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE,
+        .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+        .finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+    };
+    
+    VkAttachmentReference colorAttachmentRef = {
+        .attachment = 0,
+        .layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+    };
+
+    VkSubpassDescription subpass = {
+        .pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS,
+        .colorAttachmentCount = 1,
+        .pColorAttachments = &colorAttachmentRef
+    };
+
+    VkSubpassDependency dependency = {
+        .srcSubpass = VK_SUBPASS_EXTERNAL,
+        .dstSubpass = 0,
+        .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        .dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        .srcAccessMask = 0,
+        .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+    };
+
+    VkRenderPassCreateInfo renderPassInfo = {
+        .sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
+        .attachmentCount = 1,
+        .pAttachments = &colorAttachment,
+        .subpassCount = 1,
+        .pSubpasses = &subpass,
+        .dependencyCount = 1,
+        .pDependencies = &dependency
+    };
+
+    result = vkCreateRenderPass(vulkanLogicalDevice, &renderPassInfo, nullptr, &context->renderPass);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkFramebufferCreateInfo framebufferInfo = {
+        .sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
+        .renderPass = context->renderPass,
+        .attachmentCount = 1,
+        .width = WINDOW_WIDTH,
+        .height = WINDOW_HEIGHT,
+        .layers = 1,
+    };
+
+    context->swapChainFramebuffers = new VkFramebuffer[vulkanSwapChainImageCount];
+    for (uint32_t iter = 0; iter < vulkanSwapChainImageCount; ++iter) {
+        framebufferInfo.pAttachments = &vulkanSwapChainImageViews[iter];
+        result = vkCreateFramebuffer(vulkanLogicalDevice, &framebufferInfo, nullptr, &context->swapChainFramebuffers[iter]);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+
+    VkCommandBufferAllocateInfo allocInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .commandPool = context->commandPool,
+        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .commandBufferCount = 1
+    };
+
+    result = vkAllocateCommandBuffers(vulkanLogicalDevice, &allocInfo, &context->graphicsCommandBuffer);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkSemaphoreCreateInfo semaphoreInfo = {
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO
+    };
+    if (vkCreateSemaphore(vulkanLogicalDevice, &semaphoreInfo, nullptr, &context->imageAvailableSemaphore) != VK_SUCCESS ||
+        vkCreateSemaphore(vulkanLogicalDevice, &semaphoreInfo, nullptr, &context->renderFinishedSemaphore) != VK_SUCCESS) {
+        return VK_ERROR_UNKNOWN;
+    }
+
+    context->graphicsPipelineLayout = context->computePipelineLayout;
+
+    VkGraphicsPipelineCreateInfo pipelineInfo = {
+        .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = nullptr,
+        .stageCount = 2,
+        .pStages = context->graphicsShaderStages,
+        .pVertexInputState = &vertexInputInfo,
+        .pInputAssemblyState = &inputAssembly,
+        .pViewportState = &viewportState,
+        .pRasterizationState = &rasterizer,
+        .pMultisampleState = &multisampling,
+        .pDepthStencilState = nullptr, // Optional
+        .pColorBlendState = &colorBlending,
+        .pDynamicState = &dynamicState,
+        .layout = context->graphicsPipelineLayout,
+        .renderPass = context->renderPass,
+        .subpass = 0
+    };
+
+    return vkCreateGraphicsPipelines(vulkanLogicalDevice, VK_NULL_HANDLE, 1,&pipelineInfo, nullptr, &context->graphicsPipeline);
+}
+
+// Host visible buffer the result image is copied into, mapped for its whole life.
+static VkResult createReadbackBuffer(VkDeviceSize size, VkBuffer* buffer, VkDeviceMemory* memory, void** mapping)
+{
+    // Prefer cached memory, CPU reads from it.
+    VkResult result = CreateBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+        buffer, memory);
+    if (result == VK_ERROR_FEATURE_NOT_PRESENT) {
+        result = CreateBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, buffer, memory);
+    }
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    return vkMapMemory(vulkanLogicalDevice, *memory, 0, VK_WHOLE_SIZE, 0, mapping);
+}
+
+// Compute resources plus a host buffer the tiles are read back through.
+static VkResult createOffscreenResources(RenderContext* context, uint32_t maxTileWidth, uint32_t maxTileHeight)
+{
 
+    VkResult result;
+    context->costCounters = renderOptions.costCounters;
+    // Dispatches of a tile vary in sample count.
+    result = createComputeResources(context, maxTileWidth, maxTileHeight,
+                                    VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                    0, 0, DISPLAY_FORMAT_RGBA32F);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    // Costs follow the colours, 4 uint32_t per pixel.
+    VkDeviceSize readbackSize = static_cast<VkDeviceSize>(maxTileWidth) * maxTileHeight * 4 * sizeof(float) *
+                                (context->costCounters ? 2 : 1);
+    return createReadbackBuffer(readbackSize, &context->readbackBuffer, &context->readbackBufferMemory,
+                                &context->readbackBufferMapping);
+}
+
+// Compute resources for whole frames plus a command buffer, fence & readback buffer per frame in flight.
+static VkResult createSequenceResources(RenderContext* context, uint32_t imageWidth, uint32_t imageHeight)
+{
+
+    VkResult result;
+    result = createComputeResources(context, imageWidth, imageHeight,
+                                    VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                    0, 0, DISPLAY_FORMAT_RGBA32F);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkCommandBufferAllocateInfo allocInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+        .commandPool = context->commandPool,
+        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+        .commandBufferCount = 1
+    };
+    // Signaled, a buffer that never held a frame is free.
+    VkFenceCreateInfo fenceInfo = {
+        .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+        .flags = VK_FENCE_CREATE_SIGNALED_BIT
+    };
+    VkDeviceSize readbackSize = static_cast<VkDeviceSize>(imageWidth) * imageHeight * 4 * sizeof(float);
+    for (SequenceReadback& readback : context->sequenceReadbacks) {
+        result = vkAllocateCommandBuffers(vulkanLogicalDevice, &allocInfo, &readback.commandBuffer);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+        result = vkCreateFence(vulkanLogicalDevice, &fenceInfo, nullptr, &readback.fence);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+        result = createReadbackBuffer(readbackSize, &readback.buffer, &readback.memory, &readback.mapping);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+    return VK_SUCCESS;
+}
+
+VkResult BeginRenderingOperation(IN RenderScene* scene, OUT RenderContext** renderContext)
+{
+    RenderContext* context = new RenderContext{};
+    context->scene = scene;
+    VkResult result = createWindowResources(context);
+    if (result != VK_SUCCESS) {
+        EndRenderingOperation(context);
+        context = nullptr;
+    }
+    *renderContext = context;
+    return result;
+}
+
+VkResult BeginOffscreenRenderingOperation(IN RenderScene* scene, IN uint32_t maxTileWidth, IN uint32_t maxTileHeight,
+                                          OUT RenderContext** renderContext)
+{
+    RenderContext* context = new RenderContext{};
+    context->scene = scene;
+    VkResult result = createOffscreenResources(context, maxTileWidth, maxTileHeight);
+    if (result != VK_SUCCESS) {
+        EndRenderingOperation(context);
+        context = nullptr;
+    }
+    *renderContext = context;
+    return result;
+}
+
+VkResult BeginSequenceRenderingOperation(IN RenderScene* scene, IN uint32_t imageWidth, IN uint32_t imageHeight,
+                                         OUT RenderContext** renderContext)
+{
+    RenderContext* context = new RenderContext{};
+    context->scene = scene;
+    VkResult result = createSequenceResources(context, imageWidth, imageHeight);
+    if (result != VK_SUCCESS) {
+        EndRenderingOperation(context);
+        context = nullptr;
+    }
+    *renderContext = context;
+    return result;
+}
+
+VkResult AttachRenderPresentation(IN RenderContext* context)
+{
+    return createPresentationResources(context);
+}
+
+RenderScene* GetRenderContextScene(IN const RenderContext* context)
+{
+    return context->scene;
 }
 
-VkResult DrawNextFrame(void)
+void SetRenderCamera(IN RenderContext* context, IN const Camera* camera, IN uint32_t imageWidth, IN uint32_t imageHeight)
+{
+    ComputeCameraBasis(camera, imageWidth, imageHeight, &context->renderParameters.camera);
+    context->renderParameters.tileOffset[0] = 0;
+    context->renderParameters.tileOffset[1] = 0;
+    context->renderParameters.tileSize[0] = imageWidth;
+    context->renderParameters.tileSize[1] = imageHeight;
+    context->renderParameters.imageWidth = imageWidth;
+    context->renderParameters.imageHeight = imageHeight;
+    context->accumulatedSamples = 0;
+    context->tileCullingDirty = true;
+}
+
+// Add the query results of the last submission once its fence was waited for.
+static void collectRenderStatistics(RenderContext* context)
+{
+    if (!context->statisticsPending) {
+        return;
+    }
+    uint64_t invocations = 0;
+    if (vkGetQueryPoolResults(vulkanLogicalDevice, context->statisticsQuery, 0, 1, sizeof(invocations), &invocations,
+                              sizeof(invocations), VK_QUERY_RESULT_64_BIT) == VK_SUCCESS) {
+        context->statistics.computeInvocations += invocations;
+    }
+    context->statisticsPending = false;
+}
+
+// Fit the samples of the next window frames to the GPU time of the last one, once its fence was waited for.
+static void collectFrameTime(RenderContext* context)
+{
+    if (!context->timestampsPending) {
+        return;
+    }
+    context->timestampsPending = false;
+    uint64_t timestamps[2];
+    if (vkGetQueryPoolResults(vulkanLogicalDevice, context->timestampQuery, 0, 2, sizeof(timestamps), timestamps,
+                              sizeof(timestamps[0]), VK_QUERY_RESULT_64_BIT) != VK_SUCCESS) {
+        return;
+    }
+    // Timestamps wrap at the valid bits of the queue family.
+    uint64_t mask = vulkanTimestampValidBits >= 64 ? UINT64_MAX : (uint64_t{1} << vulkanTimestampValidBits) - 1;
+    uint64_t ticks = (timestamps[1] - timestamps[0]) & mask;
+    float milliseconds = static_cast<float>(static_cast<double>(ticks) * vulkanTimestampPeriod / 1e6);
+    if (UpdateSampleBudget(&context->sampleBudget, context->frameSamples, milliseconds)) {
+        printf("Renderer: %u samples per frame, last frame took %.2f ms for %u.\n", context->sampleBudget.samples,
+               static_cast<double>(milliseconds), context->frameSamples);
+    }
+}
+
+// Render the samples of tile & copy it into readbackBuffer, ready for the host once the submission completes.
+// instrumented: also query pipeline statistics & copy the tile's costs after its colours, counting sessions only.
+static void recordTileReadback(RenderContext* context, VkCommandBuffer commandBuffer, const RenderTile* tile,
+                               VkBuffer readbackBuffer, bool instrumented)
+{
+    recordTileCulling(context, commandBuffer);
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, context->computePipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, context->computePipelineLayout,
+        0, 1, &context->descriptorSet, 0, 0);
+
+    RenderPushConstants constants = context->renderParameters;
+    constants.tileOffset[0] = static_cast<int32_t>(tile->x);
+    constants.tileOffset[1] = static_cast<int32_t>(tile->y);
+    constants.tileSize[0] = tile->width;
+    constants.tileSize[1] = tile->height;
+    bool statistics = instrumented && context->statisticsQuery != VK_NULL_HANDLE;
+    if (statistics) {
+        vkCmdResetQueryPool(commandBuffer, context->statisticsQuery, 0, 1);
+        vkCmdBeginQuery(commandBuffer, context->statisticsQuery, 0, 0);
+    }
+    for (uint32_t rendered = 0; rendered < tile->sampleCount; rendered += constants.sampleCount) {
+        if (rendered > 0) {
+            recordImageBarrier(commandBuffer, context->resultImage,
+                VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+            if (context->costCounters) {
+                recordImageBarrier(commandBuffer, context->costImage,
+                    VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+                    VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+            }
+        }
+        constants.sampleBase = tile->sampleBase + rendered;
+        constants.sampleCount = std::min(OFFSCREEN_SAMPLES_PER_DISPATCH, tile->sampleCount - rendered);
+        constants.flags = rendered > 0 ? RENDER_FLAG_ACCUMULATE : 0;
+        vkCmdPushConstants(commandBuffer, context->computePipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(constants), &constants);
+        recordComputeDispatch(context, commandBuffer, tile->width, tile->height);
+    }
+    if (statistics) {
+        vkCmdEndQuery(commandBuffer, context->statisticsQuery, 0);
+    }
+
+    recordImageBarrier(commandBuffer, context->resultImage,
+        VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+    VkBufferImageCopy region = {
+        .bufferOffset = 0,
+        .bufferRowLength = tile->width,
+        .bufferImageHeight = tile->height,
+        .imageSubresource = {
+            .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+            .mipLevel = 0,
+            .baseArrayLayer = 0,
+            .layerCount = 1
+        },
+        .imageOffset = { 0, 0, 0 },
+        .imageExtent = { tile->width, tile->height, 1 }
+    };
+    vkCmdCopyImageToBuffer(commandBuffer, context->resultImage, VK_IMAGE_LAYOUT_GENERAL,
+        readbackBuffer, 1, &region);
+    if (instrumented && context->costCounters) {
+        recordImageBarrier(commandBuffer, context->costImage,
+            VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+        region.bufferOffset = static_cast<VkDeviceSize>(tile->width) * tile->height * 4 * sizeof(float);
+        vkCmdCopyImageToBuffer(commandBuffer, context->costImage, VK_IMAGE_LAYOUT_GENERAL,
+            readbackBuffer, 1, &region);
+    }
+
+    VkBufferMemoryBarrier hostBarrier = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_HOST_READ_BIT,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = readbackBuffer,
+        .offset = 0,
+        .size = VK_WHOLE_SIZE
+    };
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+        0, 0, nullptr, 1, &hostBarrier, 0, nullptr);
+}
+
+// Render a tile & wait until it is in the readback buffer.
+static VkResult readbackOffscreenTile(RenderContext* context, const RenderTile* tile)
+{
+
+    VkResult result;
+    if (tile->width > context->resultImageWidth || tile->height > context->resultImageHeight || tile->sampleCount == 0) {
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+    }
+
+    vkWaitForFences(vulkanLogicalDevice, 1, &context->inFlightFence, VK_TRUE, UINT64_MAX);
+    result = reserveTileCulling(context);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    vkResetFences(vulkanLogicalDevice, 1, &context->inFlightFence);
+
+    VkCommandBufferBeginInfo beginInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+    };
+    result = vkBeginCommandBuffer(context->computeCommandBuffer, &beginInfo);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    recordTileReadback(context, context->computeCommandBuffer, tile, context->readbackBuffer, context->costCounters);
+
+    result = vkEndCommandBuffer(context->computeCommandBuffer);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    VkSubmitInfo submitInfo = {
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &context->computeCommandBuffer
+    };
+    result = SubmitVulkanQueue(vulkanComputeQueue, 1, &submitInfo, context->inFlightFence);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    context->statistics.submissions++;
+    context->statisticsPending = context->statisticsQuery != VK_NULL_HANDLE;
+    result = vkWaitForFences(vulkanLogicalDevice, 1, &context->inFlightFence, VK_TRUE, UINT64_MAX);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    collectRenderStatistics(context);
+    return VK_SUCCESS;
+}
+
+VkResult RenderOffscreenTile(IN RenderContext* context, IN const RenderTile* tile, OUT float* accumulation)
+{
+    VkResult result = readbackOffscreenTile(context, tile);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    memcpy(accumulation, context->readbackBufferMapping,
+           static_cast<size_t>(tile->width) * tile->height * 4 * sizeof(float));
+    return VK_SUCCESS;
+}
+
+VkResult RenderOffscreenImage(IN RenderContext* context, IN const Camera* camera, IN uint32_t width,
+                              IN uint32_t height, IN uint32_t samplesPerPixel, IN uint32_t samplesPerTile,
+                              OUT float* image, OUT uint32_t* costs)
+{
+    VkResult result = VK_SUCCESS;
+    if (costs != nullptr && !context->costCounters) {
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+    SetRenderCamera(context, camera, width, height);
+    memset(image, 0, static_cast<size_t>(width) * height * 4 * sizeof(float));
+    if (costs != nullptr) {
+        memset(costs, 0, static_cast<size_t>(width) * height * COST_COUNTER_COUNT * sizeof(uint32_t));
+    }
+    uint32_t tileWidth = context->resultImageWidth;
+    uint32_t tileHeight = context->resultImageHeight;
+    // Sample ranges outermost, like the distributed work items, so results match between both.
+    for (uint32_t sampleBase = 0; sampleBase < samplesPerPixel && result == VK_SUCCESS; sampleBase += samplesPerTile) {
+        for (uint32_t y = 0; y < height && result == VK_SUCCESS; y += tileHeight) {
+            for (uint32_t x = 0; x < width && result == VK_SUCCESS; x += tileWidth) {
+                RenderTile tile = {
+                    .x = x,
+                    .y = y,
+                    .width = std::min(tileWidth, width - x),
+                    .height = std::min(tileHeight, height - y),
+                    .sampleBase = sampleBase,
+                    .sampleCount = std::min(samplesPerTile, samplesPerPixel - sampleBase)
+                };
+                result = readbackOffscreenTile(context, &tile);
+                // Straight from the mapped buffer, no intermediate copy.
+                const float* source = static_cast<const float*>(context->readbackBufferMapping);
+                for (uint32_t row = 0; row < tile.height && result == VK_SUCCESS; ++row) {
+                    float* destination = &image[(static_cast<size_t>(y + row) * width + x) * 4];
+                    for (uint32_t iter = 0; iter < tile.width * 4; ++iter) {
+                        destination[iter] += *source++;
+                    }
+                }
+                const uint32_t* sourceCosts = reinterpret_cast<const uint32_t*>(
+                    static_cast<const float*>(context->readbackBufferMapping) + static_cast<size_t>(tile.width) * tile.height * 4);
+                for (uint32_t row = 0; row < tile.height && result == VK_SUCCESS && costs != nullptr; ++row) {
+                    uint32_t* destination = &costs[(static_cast<size_t>(y + row) * width + x) * COST_COUNTER_COUNT];
+                    for (uint32_t iter = 0; iter < tile.width * COST_COUNTER_COUNT; ++iter) {
+                        destination[iter] += *sourceCosts++;
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
+VkResult SubmitSequenceFrame(IN RenderContext* context, IN const Camera* camera, IN uint32_t samplesPerPixel)
+{
+
+    VkResult result;
+    if (samplesPerPixel == 0) {
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+    }
+    if (context->sequenceSubmitted - context->sequenceReleased >= SEQUENCE_FRAMES_IN_FLIGHT) {
+        return VK_NOT_READY;
+    }
+    // Released, so its previous frame was waited for when acquired.
+    SequenceReadback* readback = &context->sequenceReadbacks[context->sequenceSubmitted % SEQUENCE_FRAMES_IN_FLIGHT];
+    vkResetFences(vulkanLogicalDevice, 1, &readback->fence);
+
+    SetRenderCamera(context, camera, context->resultImageWidth, context->resultImageHeight);
+    VkCommandBufferBeginInfo beginInfo = {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+    };
+    result = vkBeginCommandBuffer(readback->commandBuffer, &beginInfo);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    // The previous frame may still be copied out of the result image.
+    recordImageBarrier(readback->commandBuffer, context->resultImage,
+        VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+    RenderTile frame = {
+        .x = 0,
+        .y = 0,
+        .width = context->resultImageWidth,
+        .height = context->resultImageHeight,
+        .sampleBase = 0,    // Same seeds every frame, the noise does not crawl over still parts.
+        .sampleCount = samplesPerPixel
+    };
+    recordTileReadback(context, readback->commandBuffer, &frame, readback->buffer, false);
+    result = vkEndCommandBuffer(readback->commandBuffer);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    // No wait, the host picks the frame up in AcquireSequenceFrame.
+    VkSubmitInfo submitInfo = {
+        .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &readback->commandBuffer
+    };
+    result = SubmitVulkanQueue(vulkanComputeQueue, 1, &submitInfo, readback->fence);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    context->sequenceSubmitted++;
+    return VK_SUCCESS;
+}
+
+VkResult AcquireSequenceFrame(IN RenderContext* context, OUT const float** accumulation)
+{
+    if (context->sequenceAcquired == context->sequenceSubmitted) {
+        return VK_NOT_READY;
+    }
+    SequenceReadback* readback = &context->sequenceReadbacks[context->sequenceAcquired % SEQUENCE_FRAMES_IN_FLIGHT];
+    VkResult result = vkWaitForFences(vulkanLogicalDevice, 1, &readback->fence, VK_TRUE, UINT64_MAX);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    context->sequenceAcquired++;
+    *accumulation = static_cast<const float*>(readback->mapping);
+    return VK_SUCCESS;
+}
+
+void ReleaseSequenceFrame(IN RenderContext* context)
+{
+    if (context->sequenceReleased < context->sequenceAcquired) {
+        context->sequenceReleased++;
+    }
+}
+
+bool IsRenderConverged(IN const RenderContext* context)
+{
+    return context->sampleTarget != 0 && context->accumulatedSamples >= context->sampleTarget &&
+           GetRenderSceneVersion(context->scene) == context->renderedSceneVersion;
+}
+
+VkResult DrawNextFrame(IN RenderContext* context)
 {
 
     uint32_t imageIndex;
     VkResult result;
 
-    vkWaitForFences(vulkanLogicalDevice, 1, &vulkanInFlightFence, VK_TRUE, UINT64_MAX);
-    vkResetFences(vulkanLogicalDevice, 1, &vulkanInFlightFence);
+    vkWaitForFences(vulkanLogicalDevice, 1, &context->inFlightFence, VK_TRUE, UINT64_MAX);
+    collectRenderStatistics(context);
+    collectFrameTime(context);
+    vkResetFences(vulkanLogicalDevice, 1, &context->inFlightFence);
 
     result = vkAcquireNextImageKHR(vulkanLogicalDevice, vulkanSwapChain, UINT64_MAX,
-                                   vulkanImageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
+                                   context->imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
     if (result != VK_SUCCESS) {
         // Window resize? We cannot resize window!
         // The only reason is Window is closing!
         // F**k Windows bug!
         return result;
     }
-    vkResetCommandBuffer(vulkanGraphicsCommandBuffer, 0);
-    recordGraphicsCommandBuffer(vulkanGraphicsCommandBuffer, imageIndex);
-    recordComputeCommandBuffer(vulkanComputeCommandBuffer);
-    VkSemaphore waitSemaphores[] = { vulkanImageAvailableSemaphore };
+    vkResetCommandBuffer(context->graphicsCommandBuffer, 0);
+    recordGraphicsCommandBuffer(context, context->graphicsCommandBuffer, imageIndex);
+    if (IsRenderConverged(context)) {
+        // Nothing left to render, present the finished image as it is.
+        VkPipelineStageFlags presentWaitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+        VkSubmitInfo presentSubmitInfo = {
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .waitSemaphoreCount = 1,
+            .pWaitSemaphores = &context->imageAvailableSemaphore,
+            .pWaitDstStageMask = presentWaitStages,
+            .commandBufferCount = 1,
+            .pCommandBuffers = &context->graphicsCommandBuffer,
+            .signalSemaphoreCount = 1,
+            .pSignalSemaphores = &context->renderFinishedSemaphore
+        };
+        result = SubmitVulkanQueue(vulkanGraphicsQueue, 1, &presentSubmitInfo, context->inFlightFence);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+        VkPresentInfoKHR presentInfo = {
+            .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+            .waitSemaphoreCount = 1,
+            .pWaitSemaphores = &context->renderFinishedSemaphore,
+            .swapchainCount = 1,
+            .pSwapchains = &vulkanSwapChain,
+            .pImageIndices = &imageIndex
+        };
+        return PresentVulkanQueue(vulkanGraphicsQueue, &presentInfo);
+    }
+    recordComputeCommandBuffer(context, context->computeCommandBuffer);
     VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT };
 
     // First compute, then render.
     VkSubmitInfo computeSubmitInfo = {
         .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
         .waitSemaphoreCount = 1,
-        .pWaitSemaphores = &vulkanImageAvailableSemaphore,
+        .pWaitSemaphores = &context->imageAvailableSemaphore,
         .pWaitDstStageMask = waitStages,
         .commandBufferCount = 1,
-        .pCommandBuffers = &vulkanComputeCommandBuffer,
+        .pCommandBuffers = &context->computeCommandBuffer,
     };
-    result = vkQueueSubmit(vulkanComputeQueue, 1, &computeSubmitInfo, nullptr);
-
+    result = SubmitVulkanQueue(vulkanComputeQueue, 1, &computeSubmitInfo, nullptr);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    context->accumulatedSamples += context->frameSamples;
+    if (IsRenderConverged(context)) {
+        printf("Renderer: converged at %u samples per pixel, idle until something changes.\n",
+               context->accumulatedSamples);
+    }
+    context->statistics.submissions++;
+    context->statisticsPending = context->statisticsQuery != VK_NULL_HANDLE;
+    context->timestampsPending = context->timestampQuery != VK_NULL_HANDLE;
 
     VkSubmitInfo graphicsSubmitInfo = {
         .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
         .commandBufferCount = 1,
-        .pCommandBuffers = &vulkanGraphicsCommandBuffer,
+        .pCommandBuffers = &context->graphicsCommandBuffer,
         .signalSemaphoreCount = 1,
-        .pSignalSemaphores = &vulkanRenderFinishedSemaphore
+        .pSignalSemaphores = &context->renderFinishedSemaphore
     };
-    result = vkQueueSubmit(vulkanGraphicsQueue, 1, &graphicsSubmitInfo, vulkanInFlightFence);
+    result = SubmitVulkanQueue(vulkanGraphicsQueue, 1, &graphicsSubmitInfo, context->inFlightFence);
     if (result != VK_SUCCESS) {
         return result;
     }
@@ -701,74 +2048,162 @@ VkResult DrawNextFrame(void)
     VkPresentInfoKHR presentInfo = {
         .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
         .waitSemaphoreCount = 1,
-        .pWaitSemaphores = &vulkanRenderFinishedSemaphore,
+        .pWaitSemaphores = &context->renderFinishedSemaphore,
         .swapchainCount = 1,
         .pSwapchains = &vulkanSwapChain,
         .pImageIndices = &imageIndex
     };
 
-    return vkQueuePresentKHR(vulkanGraphicsQueue, &presentInfo);
+    result = PresentVulkanQueue(vulkanGraphicsQueue, &presentInfo);
+    if (result == VK_SUCCESS) {
+        ReportFirstFrame();
+    }
+    return result;
+}
+
+VkResult GetRenderStatistics(IN RenderContext* context, OUT RenderStatistics* statistics)
+{
+    *statistics = context->statistics;
+    return context->statisticsQuery != VK_NULL_HANDLE ? VK_SUCCESS : VK_ERROR_FEATURE_NOT_PRESENT;
 }
 
 // End rendering & destroy allocated environments.
-VkResult EndRenderingOperation(void)
+VkResult EndRenderingOperation(IN RenderContext* context)
 {
-    if (vulkanImageAvailableSemaphore != nullptr) {
-        vkDestroySemaphore(vulkanLogicalDevice, vulkanImageAvailableSemaphore, nullptr);
+    if (context == nullptr) {
+        return VK_SUCCESS;
     }
-    if (vulkanRenderFinishedSemaphore != nullptr) {
-        vkDestroySemaphore(vulkanLogicalDevice, vulkanRenderFinishedSemaphore, nullptr);
+    // Other sessions keep using the queues, only wait for this one's last submissions.
+    if (context->inFlightFence != nullptr) {
+        vkWaitForFences(vulkanLogicalDevice, 1, &context->inFlightFence, VK_TRUE, UINT64_MAX);
+    }
+    for (SequenceReadback& readback : context->sequenceReadbacks) {
+        if (readback.fence != nullptr) {
+            vkWaitForFences(vulkanLogicalDevice, 1, &readback.fence, VK_TRUE, UINT64_MAX);
+        }
     }
-    if (vulkanInFlightFence != nullptr) {
-        vkDestroyFence(vulkanLogicalDevice, vulkanInFlightFence, nullptr);
+    if (context->imageAvailableSemaphore != nullptr) {
+        vkDestroySemaphore(vulkanLogicalDevice, context->imageAvailableSemaphore, nullptr);
     }
-    if (vulkanCommandPool != nullptr) {
-        vkDestroyCommandPool(vulkanLogicalDevice, vulkanCommandPool, nullptr);
+    if (context->renderFinishedSemaphore != nullptr) {
+        vkDestroySemaphore(vulkanLogicalDevice, context->renderFinishedSemaphore, nullptr);
     }
-    if (swapChainFramebuffers != nullptr) {
+    if (context->inFlightFence != nullptr) {
+        vkDestroyFence(vulkanLogicalDevice, context->inFlightFence, nullptr);
+    }
+    if (context->commandPool != nullptr) {
+        vkDestroyCommandPool(vulkanLogicalDevice, context->commandPool, nullptr);
+    }
+    if (context->swapChainFramebuffers != nullptr) {
         for (uint32_t iter = 0; iter < vulkanSwapChainImageCount; ++iter) {
-            vkDestroyFramebuffer(vulkanLogicalDevice, swapChainFramebuffers[iter], nullptr);
+            vkDestroyFramebuffer(vulkanLogicalDevice, context->swapChainFramebuffers[iter], nullptr);
         }
-        delete[] swapChainFramebuffers;
+        delete[] context->swapChainFramebuffers;
+    }
+    if (context->graphicsPipeline != nullptr) {
+        vkDestroyPipeline(vulkanLogicalDevice, context->graphicsPipeline, nullptr);
+    }
+    if (context->computePipeline != nullptr) {
+        vkDestroyPipeline(vulkanLogicalDevice, context->computePipeline, nullptr);
+    }
+    if (context->cullPipeline != nullptr) {
+        vkDestroyPipeline(vulkanLogicalDevice, context->cullPipeline, nullptr);
+    }
+    // Graphics pipeline shares the layout of compute pipeline.
+    if (context->computePipelineLayout != nullptr) {
+        vkDestroyPipelineLayout(vulkanLogicalDevice, context->computePipelineLayout, nullptr);
+    }
+    if (context->renderPass != nullptr) {
+        vkDestroyRenderPass(vulkanLogicalDevice, context->renderPass, nullptr);
+    }
+    if (context->descriptorPool != nullptr) {
+        vkDestroyDescriptorPool(vulkanLogicalDevice, context->descriptorPool, nullptr);
+    }
+    if (context->descriptorSetLayout != nullptr) {
+        vkDestroyDescriptorSetLayout(vulkanLogicalDevice, context->descriptorSetLayout, nullptr);
+    }
+    if (context->resultImageSampler != nullptr) {
+        vkDestroySampler(vulkanLogicalDevice, context->resultImageSampler, nullptr);
     }
-    if (vulkanGraphicsPipeline != nullptr) {
-        vkDestroyPipeline(vulkanLogicalDevice, vulkanGraphicsPipeline, nullptr);
+    if (context->resultImageView != nullptr) {
+        vkDestroyImageView(vulkanLogicalDevice, context->resultImageView, nullptr);
     }
-    if (vulkanComputePipeline != nullptr) {
-        vkDestroyPipeline(vulkanLogicalDevice, vulkanComputePipeline, nullptr);
+    if (context->resultImage != nullptr) {
+        vkDestroyImage(vulkanLogicalDevice, context->resultImage, nullptr);
     }
-    if (vulkanGraphicsPipelineLayout != nullptr) {
-        vkDestroyPipelineLayout(vulkanLogicalDevice, vulkanGraphicsPipelineLayout, nullptr);
+    if (context->resultImageMemory!= nullptr) {
+        vkFreeMemory(vulkanLogicalDevice, context->resultImageMemory, nullptr);
     }
-    if (vulkanRenderPass != nullptr) {
-        vkDestroyRenderPass(vulkanLogicalDevice, vulkanRenderPass, nullptr);
+    if (context->displayStorageView != nullptr) {
+        vkDestroyImageView(vulkanLogicalDevice, context->displayStorageView, nullptr);
     }
-    if (vulkanDescriptorPool != nullptr) {
-        vkDestroyDescriptorPool(vulkanLogicalDevice, vulkanDescriptorPool, nullptr);
+    if (context->displayImageView != nullptr) {
+        vkDestroyImageView(vulkanLogicalDevice, context->displayImageView, nullptr);
     }
-    if (vulkanComputeDescriptorSetLayout != nullptr) {
-        vkDestroyDescriptorSetLayout(vulkanLogicalDevice, vulkanComputeDescriptorSetLayout, nullptr);
+    if (context->displayImage != nullptr) {
+        vkDestroyImage(vulkanLogicalDevice, context->displayImage, nullptr);
     }
-    if (vulkanComputeResultImageSampler != nullptr) {
-        vkDestroySampler(vulkanLogicalDevice, vulkanComputeResultImageSampler, nullptr);
+    if (context->displayImageMemory != nullptr) {
+        vkFreeMemory(vulkanLogicalDevice, context->displayImageMemory, nullptr);
     }
-    if (vulkanComputeResultImageView != nullptr) {
-        vkDestroyImageView(vulkanLogicalDevice, vulkanComputeResultImageView, nullptr);
+    if (context->costImageView != nullptr) {
+        vkDestroyImageView(vulkanLogicalDevice, context->costImageView, nullptr);
     }
-    if (vulkanComputeResultImage != nullptr) {
-        vkDestroyImage(vulkanLogicalDevice, vulkanComputeResultImage, nullptr);
+    if (context->costImage != nullptr) {
+        vkDestroyImage(vulkanLogicalDevice, context->costImage, nullptr);
+    }
+    if (context->costImageMemory != nullptr) {
+        vkFreeMemory(vulkanLogicalDevice, context->costImageMemory, nullptr);
+    }
+    if (context->statisticsQuery != nullptr) {
+        vkDestroyQueryPool(vulkanLogicalDevice, context->statisticsQuery, nullptr);
+    }
+    if (context->timestampQuery != nullptr) {
+        vkDestroyQueryPool(vulkanLogicalDevice, context->timestampQuery, nullptr);
+    }
+    if (context->firstHitBuffer != nullptr) {
+        vkDestroyBuffer(vulkanLogicalDevice, context->firstHitBuffer, nullptr);
+    }
+    if (context->firstHitBufferMemory != nullptr) {
+        vkFreeMemory(vulkanLogicalDevice, context->firstHitBufferMemory, nullptr);
+    }
+    destroyTileCullingBuffer(context);
+    if (context->workQueueBuffer != nullptr) {
+        vkDestroyBuffer(vulkanLogicalDevice, context->workQueueBuffer, nullptr);
+    }
+    if (context->workQueueBufferMemory != nullptr) {
+        vkFreeMemory(vulkanLogicalDevice, context->workQueueBufferMemory, nullptr);
+    }
+    if (context->readbackBuffer != nullptr) {
+        vkDestroyBuffer(vulkanLogicalDevice, context->readbackBuffer, nullptr);
+    }
+    if (context->readbackBufferMemory != nullptr) {
+        // Freeing implicitly unmaps.
+        vkFreeMemory(vulkanLogicalDevice, context->readbackBufferMemory, nullptr);
+    }
+    for (SequenceReadback& readback : context->sequenceReadbacks) {
+        if (readback.fence != nullptr) {
+            vkDestroyFence(vulkanLogicalDevice, readback.fence, nullptr);
+        }
+        if (readback.buffer != nullptr) {
+            vkDestroyBuffer(vulkanLogicalDevice, readback.buffer, nullptr);
+        }
+        if (readback.memory != nullptr) {
+            vkFreeMemory(vulkanLogicalDevice, readback.memory, nullptr);
+        }
     }
-    if (vulkanComputeResultImageMemory!= nullptr) {
-        vkFreeMemory(vulkanLogicalDevice, vulkanComputeResultImageMemory, nullptr);
+    if (context->graphicsShaderStages[0].module != nullptr) {
+        vkDestroyShaderModule(vulkanLogicalDevice, context->graphicsShaderStages[0].module, nullptr);
     }
-    if (GraphicsShaderStages[0].module != nullptr) {
-        vkDestroyShaderModule(vulkanLogicalDevice, GraphicsShaderStages[0].module, nullptr);
+    if (context->graphicsShaderStages[1].module != nullptr) {
+        vkDestroyShaderModule(vulkanLogicalDevice, context->graphicsShaderStages[1].module, nullptr);
     }
-    if (GraphicsShaderStages[1].module != nullptr) {
-        vkDestroyShaderModule(vulkanLogicalDevice, GraphicsShaderStages[1].module, nullptr);
+    if (context->computeShaderStage.module != nullptr) {
+        vkDestroyShaderModule(vulkanLogicalDevice, context->computeShaderStage.module, nullptr);
     }
-    if (ComputeShaderStage.module != nullptr) {
-        vkDestroyShaderModule(vulkanLogicalDevice, ComputeShaderStage.module, nullptr);
+    if (context->cullShaderStage.module != nullptr) {
+        vkDestroyShaderModule(vulkanLogicalDevice, context->cullShaderStage.module, nullptr);
     }
+    delete context;
     return VK_SUCCESS;
 }
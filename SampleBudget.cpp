@@ -0,0 +1,75 @@
+/* @file SampleBudget.cpp
+
+    Implementation of the samples per frame controller.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <SampleBudget.hpp>
+#include <algorithm>
+
+// Weight of the newest frame in the smoothed time per sample.
+constexpr float SAMPLE_TIME_SMOOTHING = 0.2f;
+// Relative change of the fitted samples that is acted on, smaller drifts are timing noise.
+constexpr float SAMPLE_HYSTERESIS = 0.1f;
+// Relative gain in samples per millisecond the throughput search keeps doubling for.
+constexpr float THROUGHPUT_GAIN = 1.05f;
+
+void InitSampleBudget(OUT SampleBudget* budget, IN SampleControl control, IN float targetMilliseconds)
+{
+    *budget = SampleBudget{};
+    budget->control = control;
+    budget->target = targetMilliseconds;
+    budget->samples = SAMPLES_PER_FRAME;
+    budget->searching = true;
+}
+
+static uint32_t fitFrameTime(SampleBudget* budget, uint32_t samples, float milliseconds)
+{
+    float sampleMilliseconds = milliseconds / samples;
+    budget->sampleMilliseconds = budget->sampleMilliseconds == 0.f ? sampleMilliseconds :
+        budget->sampleMilliseconds + (sampleMilliseconds - budget->sampleMilliseconds) * SAMPLE_TIME_SMOOTHING;
+    // Fixed costs per frame make small counts look expensive per sample, the fit climbs over a few frames.
+    float fitted = std::clamp(budget->target / std::max(budget->sampleMilliseconds, 1e-6f), 1.f,
+                              static_cast<float>(MAX_SAMPLES_PER_FRAME));
+    float current = static_cast<float>(budget->samples);
+    if (fitted > current * (1.f + SAMPLE_HYSTERESIS) + 0.5f || fitted < current * (1.f - SAMPLE_HYSTERESIS)) {
+        return static_cast<uint32_t>(fitted);
+    }
+    return budget->samples;
+}
+
+// Samples per millisecond grow with the samples of a frame until the GPU is saturated: double them while
+// that pays, then keep the best. Longer frames than the limit halve them again, e.g. after a camera move.
+static uint32_t searchThroughput(SampleBudget* budget, uint32_t samples, float milliseconds)
+{
+    float rate = samples / std::max(milliseconds, 1e-3f);
+    if (!budget->searching) {
+        return milliseconds > THROUGHPUT_FRAME_LIMIT_MS ? std::max(samples / 2, 1u) : budget->samples;
+    }
+    if (rate > budget->bestRate * THROUGHPUT_GAIN) {
+        budget->bestRate = rate;
+        budget->bestSamples = samples;
+        if (samples * 2 <= MAX_SAMPLES_PER_FRAME && milliseconds * 2.f <= THROUGHPUT_FRAME_LIMIT_MS) {
+            return samples * 2;
+        }
+    }
+    budget->searching = false;
+    return budget->bestSamples;
+}
+
+bool UpdateSampleBudget(IN OUT SampleBudget* budget, IN uint32_t samples, IN float milliseconds)
+{
+    if (samples == 0 || milliseconds <= 0.f) {
+        return false;
+    }
+    uint32_t next = budget->samples;
+    if (budget->control == SAMPLE_CONTROL_FRAME_TIME) {
+        next = fitFrameTime(budget, samples, milliseconds);
+    } else if (budget->control == SAMPLE_CONTROL_THROUGHPUT) {
+        next = searchThroughput(budget, samples, milliseconds);
+    }
+    bool changed = next != budget->samples;
+    budget->samples = next;
+    return changed;
+}
@@ -0,0 +1,557 @@
+/* @file Scene.cpp
+
+    Implementation of uploading scenes to the device.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <Scene.hpp>
+#include <SceneFile.hpp>
+#include <Environment.hpp>
+#include <AccelerationStructure.hpp>
+#include <Options.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+// Instance as read by the shader, must match scene_instance in structures.glsl.
+struct RenderInstance {
+    float    worldToObject[12];
+    uint32_t geometry;
+    uint32_t firstSphere;       // Spheres of the geometry, for the linear scan.
+    uint32_t sphereCount;
+    uint32_t padding;
+};
+static_assert(sizeof(RenderInstance) == 64, "Must match scene_instance in structures.glsl");
+
+// Spheres as read by intersection, the material ID goes to its own buffer.
+struct RenderSphere {
+    float    center[3];
+    float    radius;
+};
+static_assert(sizeof(RenderSphere) == 16, "Must match spheres in globals.glsl");
+
+// Material with a half float albedo, must match scene_material in structures.glsl.
+struct RenderMaterial {
+    uint32_t albedoRg;
+    uint32_t albedoBType;           // Low half: albedo blue, high half: SceneMaterialType.
+    float    parameter;
+};
+static_assert(sizeof(RenderMaterial) == 12, "Must match scene_material in structures.glsl");
+
+// Buffers of the device-local part, the top level follows in its own buffer.
+constexpr uint32_t SCENE_STATIC_BUFFER_COUNT = SCENE_BUFFER_SPHERE_MATERIALS + 1;
+
+struct RenderScene {
+    VkBuffer                    buffer;
+    VkDeviceMemory              bufferMemory;
+    VkBuffer                    instanceBuffer;
+    VkDeviceMemory              instanceBufferMemory;
+    uint8_t*                    instanceMapping;
+    VkDescriptorBufferInfo      bufferInfos[SCENE_BUFFER_COUNT];
+    uint64_t                    contentHash;
+    // Host copy of the top level, the TLAS is rebuilt from these when an instance moves.
+    std::vector<SceneInstance>  instances;
+    std::vector<SceneBvhNode>   geometryRoots;
+    std::vector<SceneGeometry>  geometries;
+    RenderSceneTraits           traits;
+    uint64_t                    version;
+    SceneAccelerationStructures* accelerationStructures;   // nullptr without ray queries.
+};
+
+static uint64_t alignUp(IN uint64_t value, IN uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// IEEE half float, rounded to nearest even as unpackHalf2x16 expects.
+static uint32_t halfFloat(IN float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t magnitude = bits & 0x7FFFFFFF;
+    if (magnitude >= 0x47800000) { // Beyond the half range, infinity or NaN.
+        return sign | (magnitude > 0x7F800000 ? 0x7E00 : 0x7C00);
+    }
+    if (magnitude < 0x38800000) { // Denormal half, steps of 2^-24.
+        return sign | static_cast<uint32_t>(std::nearbyint(std::fabs(value) * 16777216.0f));
+    }
+    return sign | ((magnitude + 0xFFF + ((magnitude >> 13) & 1) - 0x38000000) >> 13);
+}
+
+static uint32_t materialIdBits(IN const SceneView* view)
+{
+    return view->materialCount <= 0x10000 ? 16 : 32;
+}
+
+// Spheres, materials & material IDs are converted to the compact device layout,
+// BVH sections are copied as they are.
+static void writeSceneSections(IN const RenderScene* scene, IN const SceneView* view, OUT uint8_t* mapping)
+{
+    RenderSphere* spheres = reinterpret_cast<RenderSphere*>(mapping + scene->bufferInfos[SCENE_BUFFER_SPHERES].offset);
+    uint8_t* sphereMaterials = mapping + scene->bufferInfos[SCENE_BUFFER_SPHERE_MATERIALS].offset;
+    bool shortIds = materialIdBits(view) == 16;
+    for (uint64_t iter = 0; iter < view->sphereCount; ++iter) {
+        const SceneSphere& sphere = view->spheres[iter];
+        spheres[iter] = {
+            .center = { sphere.center[0], sphere.center[1], sphere.center[2] },
+            .radius = sphere.radius
+        };
+        if (shortIds) {
+            uint16_t material = static_cast<uint16_t>(std::min<uint32_t>(sphere.material, 0xFFFF));
+            memcpy(sphereMaterials + iter * sizeof(uint16_t), &material, sizeof(material));
+        }
+        else {
+            memcpy(sphereMaterials + iter * sizeof(uint32_t), &sphere.material, sizeof(uint32_t));
+        }
+    }
+    if (shortIds && view->sphereCount % 2 != 0) {
+        memset(sphereMaterials + view->sphereCount * sizeof(uint16_t), 0, sizeof(uint16_t));
+    }
+    RenderMaterial* materials =
+        reinterpret_cast<RenderMaterial*>(mapping + scene->bufferInfos[SCENE_BUFFER_MATERIALS].offset);
+    for (uint64_t iter = 0; iter < view->materialCount; ++iter) {
+        const SceneMaterial& material = view->materials[iter];
+        materials[iter] = {
+            .albedoRg = halfFloat(material.albedo[0]) | halfFloat(material.albedo[1]) << 16,
+            .albedoBType = halfFloat(material.albedo[2]) | std::min<uint32_t>(material.type, 0xFFFF) << 16,
+            .parameter = material.parameter
+        };
+    }
+    memcpy(mapping + scene->bufferInfos[SCENE_BUFFER_BVH_NODES].offset, view->bvhNodes,
+           scene->bufferInfos[SCENE_BUFFER_BVH_NODES].range);
+    memcpy(mapping + scene->bufferInfos[SCENE_BUFFER_BVH_INDICES].offset, view->bvhIndices,
+           scene->bufferInfos[SCENE_BUFFER_BVH_INDICES].range);
+}
+
+// Write the sections into one staging buffer, then copy it into one device-local buffer.
+static VkResult uploadScene(IN RenderScene* scene, IN const SceneView* view)
+{
+
+    VkResult result;
+    // 16 bit IDs pair up in uints, an odd count is padded.
+    uint64_t materialIdSize = materialIdBits(view) == 16 ? (view->sphereCount + 1) / 2 * sizeof(uint32_t)
+                                                         : view->sphereCount * sizeof(uint32_t);
+    VkDeviceSize sizes[SCENE_STATIC_BUFFER_COUNT] = {
+        view->sphereCount * sizeof(RenderSphere),
+        view->materialCount * sizeof(RenderMaterial),
+        view->bvhNodeCount * sizeof(SceneBvhNode),
+        view->sphereCount * sizeof(uint32_t),
+        materialIdSize
+    };
+    VkDeviceSize totalSize = 0;
+    for (uint32_t iter = 0; iter < SCENE_STATIC_BUFFER_COUNT; ++iter) {
+        totalSize = alignUp(totalSize, SCENE_SECTION_ALIGNMENT);
+        scene->bufferInfos[iter] = {
+            .buffer = VK_NULL_HANDLE,
+            .offset = totalSize,
+            .range = sizes[iter]
+        };
+        totalSize += sizes[iter];
+    }
+
+    VkBuffer stagingBuffer;
+    VkDeviceMemory stagingBufferMemory;
+    result = CreateBuffer(totalSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                          &stagingBuffer, &stagingBufferMemory);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    uint8_t* mapping;
+    result = vkMapMemory(vulkanLogicalDevice, stagingBufferMemory, 0, VK_WHOLE_SIZE, 0,
+                         reinterpret_cast<void**>(&mapping));
+    if (result == VK_SUCCESS) {
+        writeSceneSections(scene, view, mapping);
+        vkUnmapMemory(vulkanLogicalDevice, stagingBufferMemory);
+        result = CreateBuffer(totalSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                              VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &scene->buffer, &scene->bufferMemory);
+    }
+
+    VkCommandPool commandPool = VK_NULL_HANDLE;
+    if (result == VK_SUCCESS) {
+        VkCommandPoolCreateInfo poolInfo = {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
+            .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+            .queueFamilyIndex = vulkanComputeQueueFamilyIndex,
+        };
+        result = vkCreateCommandPool(vulkanLogicalDevice, &poolInfo, nullptr, &commandPool);
+    }
+    VkCommandBuffer commandBuffer;
+    if (result == VK_SUCCESS) {
+        VkCommandBufferAllocateInfo allocInfo = {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+            .commandPool = commandPool,
+            .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+            .commandBufferCount = 1
+        };
+        result = vkAllocateCommandBuffers(vulkanLogicalDevice, &allocInfo, &commandBuffer);
+    }
+    if (result == VK_SUCCESS) {
+        VkCommandBufferBeginInfo beginInfo = {
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+        };
+        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+        VkBufferCopy region = {
+            .srcOffset = 0,
+            .dstOffset = 0,
+            .size = totalSize
+        };
+        vkCmdCopyBuffer(commandBuffer, stagingBuffer, scene->buffer, 1, &region);
+        result = vkEndCommandBuffer(commandBuffer);
+    }
+    if (result == VK_SUCCESS) {
+        VkSubmitInfo submitInfo = {
+            .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+            .commandBufferCount = 1,
+            .pCommandBuffers = &commandBuffer
+        };
+        // Loading is a one-off, wait instead of tracking a fence.
+        result = SubmitVulkanQueueAndWait(vulkanComputeQueue, &submitInfo);
+    }
+
+    if (commandPool != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(vulkanLogicalDevice, commandPool, nullptr);
+    }
+    vkDestroyBuffer(vulkanLogicalDevice, stagingBuffer, nullptr);
+    vkFreeMemory(vulkanLogicalDevice, stagingBufferMemory, nullptr);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+
+    for (uint32_t iter = 0; iter < SCENE_STATIC_BUFFER_COUNT; ++iter) {
+        scene->bufferInfos[iter].buffer = scene->buffer;
+    }
+    scene->contentHash = view->contentHash;
+    return VK_SUCCESS;
+}
+
+// Rebuild the TLAS & write it with the instances, in TLAS leaf order, to the mapped buffer.
+static VkResult writeInstances(IN RenderScene* scene)
+{
+    std::vector<SceneBvhNode> nodes;
+    std::vector<uint32_t> indices;
+    BuildInstanceBvh(scene->instances.data(), scene->instances.size(), scene->geometryRoots.data(), &nodes, &indices);
+    RenderInstance* renderInstances = reinterpret_cast<RenderInstance*>(
+        scene->instanceMapping + scene->bufferInfos[SCENE_BUFFER_INSTANCES].offset);
+    for (size_t iter = 0; iter < indices.size(); ++iter) {
+        const SceneInstance* instance = &scene->instances[indices[iter]];
+        if (!InvertSceneTransform(instance->objectToWorld, renderInstances[iter].worldToObject)) {
+            return VK_ERROR_FORMAT_NOT_SUPPORTED;
+        }
+        renderInstances[iter].geometry = instance->geometry;
+        renderInstances[iter].firstSphere = scene->geometries[instance->geometry].firstSphere;
+        renderInstances[iter].sphereCount = scene->geometries[instance->geometry].sphereCount;
+        renderInstances[iter].padding = 0;
+    }
+    memcpy(scene->instanceMapping + scene->bufferInfos[SCENE_BUFFER_TLAS_NODES].offset, nodes.data(),
+           nodes.size() * sizeof(SceneBvhNode));
+    return VK_SUCCESS;
+}
+
+// The top level is small & changes, it stays host visible instead of going through staging.
+static VkResult uploadInstances(IN RenderScene* scene, IN const SceneView* view)
+{
+    uint64_t geometryCount = view->geometries != nullptr ? view->geometryCount : 1;
+    scene->geometryRoots.assign(view->bvhNodes, view->bvhNodes + geometryCount);
+    if (view->geometries != nullptr) {
+        scene->geometries.assign(view->geometries, view->geometries + geometryCount);
+    } else {
+        scene->geometries = {{
+            .firstSphere = 0,
+            .sphereCount = static_cast<uint32_t>(view->sphereCount),
+            .padding = {}
+        }};
+    }
+    if (view->instances != nullptr) {
+        scene->instances.assign(view->instances, view->instances + view->instanceCount);
+    } else {
+        scene->instances.resize(geometryCount);
+        for (uint64_t iter = 0; iter < geometryCount; ++iter) {
+            scene->instances[iter] = {
+                .objectToWorld = {1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f},
+                .geometry = static_cast<uint32_t>(iter),
+                .padding = {}
+            };
+        }
+    }
+
+    // A binary tree over N instances never has more than 2N - 1 nodes.
+    VkDeviceSize instanceSize = scene->instances.size() * sizeof(RenderInstance);
+    VkDeviceSize nodeOffset = alignUp(instanceSize, SCENE_SECTION_ALIGNMENT);
+    VkDeviceSize nodeSize = (scene->instances.size() * 2 - 1) * sizeof(SceneBvhNode);
+    scene->bufferInfos[SCENE_BUFFER_INSTANCES] = {
+        .buffer = VK_NULL_HANDLE,
+        .offset = 0,
+        .range = instanceSize
+    };
+    scene->bufferInfos[SCENE_BUFFER_TLAS_NODES] = {
+        .buffer = VK_NULL_HANDLE,
+        .offset = nodeOffset,
+        .range = nodeSize
+    };
+    // Prefer memory the device reads fast, e.g. resizable BAR.
+    VkResult result = CreateBuffer(nodeOffset + nodeSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        &scene->instanceBuffer, &scene->instanceBufferMemory);
+    if (result == VK_ERROR_FEATURE_NOT_PRESENT) {
+        result = CreateBuffer(nodeOffset + nodeSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            &scene->instanceBuffer, &scene->instanceBufferMemory);
+    }
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    result = vkMapMemory(vulkanLogicalDevice, scene->instanceBufferMemory, 0, VK_WHOLE_SIZE, 0,
+                         reinterpret_cast<void**>(&scene->instanceMapping));
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    scene->bufferInfos[SCENE_BUFFER_INSTANCES].buffer = scene->instanceBuffer;
+    scene->bufferInfos[SCENE_BUFFER_TLAS_NODES].buffer = scene->instanceBuffer;
+    return writeInstances(scene);
+}
+
+// Levels below root, i.e. the most far children a front to back walk keeps on its stack.
+// Cached BVHs are not validated, the walk stays in bounds & stops at the depth the shader allows.
+static uint32_t bvhDepth(IN const SceneBvhNode* nodes, IN uint64_t nodeCount, IN uint32_t root)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> stack = {{root, 0}};
+    uint32_t depth = 0;
+    while (!stack.empty()) {
+        auto [node, level] = stack.back();
+        stack.pop_back();
+        depth = std::max(depth, level);
+        if (nodes[node].count == 0 && level < SCENE_BVH_MAX_DEPTH && nodes[node].leftOrFirst + 1ULL < nodeCount) {
+            stack.push_back({nodes[node].leftOrFirst, level + 1});
+            stack.push_back({nodes[node].leftOrFirst + 1, level + 1});
+        }
+    }
+    return depth;
+}
+
+static void computeTraits(IN RenderScene* scene, IN const SceneView* view)
+{
+    scene->traits.materialTypes = 0;
+    for (uint64_t iter = 0; iter < view->materialCount; ++iter) {
+        scene->traits.materialTypes |= 1u << std::min(view->materials[iter].type, 31u);
+    }
+    uint64_t geometryCount = view->geometries != nullptr ? view->geometryCount : 1;
+    scene->traits.materialIdBits = materialIdBits(view);
+    scene->traits.bvhDepth = 1;
+    scene->traits.maxSphereCount = 0;
+    for (const SceneGeometry& geometry : scene->geometries) {
+        scene->traits.maxSphereCount = std::max(scene->traits.maxSphereCount, geometry.sphereCount);
+    }
+    for (uint64_t iter = 0; iter < geometryCount; ++iter) {
+        scene->traits.bvhDepth = std::max(scene->traits.bvhDepth, bvhDepth(view->bvhNodes, view->bvhNodeCount,
+                                                                         static_cast<uint32_t>(iter)));
+    }
+    // The top level is rebuilt as instances move, a binary tree over N instances is at most N - 1 deep.
+    scene->traits.tlasDepth = static_cast<uint32_t>(std::clamp<uint64_t>(scene->instances.size() - 1, 1,
+                                                                          SCENE_BVH_MAX_DEPTH));
+}
+
+// Hardware structures are an optimization, without them the compute shader walks the BVH above.
+static VkResult buildAccelerationStructures(IN RenderScene* scene, IN const SceneView* view)
+{
+    if (!vulkanRayQueryEnabled) {
+        return VK_SUCCESS;
+    }
+    VkResult result = BuildSceneAccelerationStructures(view, scene->instances.data(),
+                                                       static_cast<uint32_t>(scene->instances.size()),
+                                                       &scene->accelerationStructures);
+    if (result != VK_SUCCESS) {
+        fprintf(stderr, "Scene: cannot build acceleration structures (%d)%s.\n", result,
+                renderOptions.traversal == TRAVERSAL_RAY_QUERY ? "" : ", using compute traversal");
+        if (renderOptions.traversal == TRAVERSAL_RAY_QUERY) {
+            return result;
+        }
+    }
+    return VK_SUCCESS;
+}
+
+// Upload a view, building its BVH first if it has none.
+static VkResult uploadSceneWithBvh(IN RenderScene* scene, IN SceneView* view,
+                                   OUT std::vector<SceneBvhNode>* nodes, OUT std::vector<uint32_t>* indices,
+                                   OUT bool* built)
+{
+    auto begin = std::chrono::steady_clock::now();
+    *built = view->bvhNodes == nullptr;
+    if (*built) {
+        BuildSceneBvh(view->spheres, view->sphereCount, view->geometries, view->geometryCount, nodes, indices);
+        view->bvhNodes = nodes->data();
+        view->bvhNodeCount = nodes->size();
+        view->bvhIndices = indices->data();
+    }
+    VkResult result = uploadScene(scene, view);
+    if (result == VK_SUCCESS) {
+        result = uploadInstances(scene, view);
+    }
+    if (result == VK_SUCCESS) {
+        result = buildAccelerationStructures(scene, view);
+    }
+    if (result == VK_SUCCESS) {
+        computeTraits(scene, view);
+        ++scene->version;
+    }
+    auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin);
+    printf("Scene: %llu spheres, %llu BVH nodes%s, %llu instances, loaded in %lld ms.\n",
+           static_cast<unsigned long long>(view->sphereCount), static_cast<unsigned long long>(view->bvhNodeCount),
+           *built ? " (built)" : "", static_cast<unsigned long long>(scene->instances.size()),
+           static_cast<long long>(milliseconds.count()));
+    return result;
+}
+
+VkResult LoadRenderScene(IN const char* filename, OUT RenderScene** loaded)
+{
+    if (filename == nullptr) {
+        return LoadRenderSceneFromMemory(nullptr, 0, loaded);
+    }
+    *loaded = nullptr;
+
+    MappedSceneFile file;
+    VkResult result = MapSceneFile(filename, &file);
+    if (result != VK_SUCCESS) {
+        fprintf(stderr, "Scene: cannot map %s.\n", filename);
+        return result;
+    }
+    SceneView view;
+    result = ParseSceneFile(file.data, file.size, &view);
+    if (result != VK_SUCCESS) {
+        fprintf(stderr, "Scene: %s is not a valid scene file.\n", filename);
+        UnmapSceneFile(&file);
+        return result;
+    }
+
+    std::vector<SceneBvhNode> nodes;
+    std::vector<uint32_t> indices;
+    bool built;
+    RenderScene* scene = new RenderScene{};
+    result = uploadSceneWithBvh(scene, &view, &nodes, &indices, &built);
+    if (result != VK_SUCCESS) {
+        UnmapSceneFile(&file);
+        DestroyRenderScene(scene);
+        return result;
+    }
+
+    // Cache the BVH for the next launch, a read-only file just means building it again.
+    if (built && AppendSceneBvh(filename, &view, &nodes, &indices) != VK_SUCCESS) {
+        fprintf(stderr, "Scene: cannot cache BVH in %s.\n", filename);
+    }
+    UnmapSceneFile(&file);
+    *loaded = scene;
+    return VK_SUCCESS;
+}
+
+VkResult LoadRenderSceneFromMemory(IN const void* data, IN size_t size, OUT RenderScene** loaded)
+{
+    *loaded = nullptr;
+    SceneView view;
+    if (size == 0) {
+        view = {
+            .contentHash = HashSceneContent(builtinSceneSpheres, builtinSceneSphereCount,
+                                            builtinSceneMaterials, builtinSceneMaterialCount, nullptr, 0),
+            .spheres = builtinSceneSpheres,
+            .sphereCount = builtinSceneSphereCount,
+            .materials = builtinSceneMaterials,
+            .materialCount = builtinSceneMaterialCount,
+            .bvhNodes = nullptr,
+            .bvhNodeCount = 0,
+            .bvhIndices = nullptr,
+            .geometries = nullptr,
+            .geometryCount = 0,
+            .instances = nullptr,
+            .instanceCount = 0
+        };
+    } else {
+        VkResult result = ParseSceneFile(data, size, &view);
+        if (result != VK_SUCCESS) {
+            return result;
+        }
+    }
+
+    std::vector<SceneBvhNode> nodes;
+    std::vector<uint32_t> indices;
+    bool built;
+    RenderScene* scene = new RenderScene{};
+    VkResult result = uploadSceneWithBvh(scene, &view, &nodes, &indices, &built);
+    if (result != VK_SUCCESS) {
+        DestroyRenderScene(scene);
+        return result;
+    }
+    *loaded = scene;
+    return VK_SUCCESS;
+}
+
+void GetRenderSceneBuffers(IN const RenderScene* scene, OUT VkDescriptorBufferInfo* bufferInfos)
+{
+    memcpy(bufferInfos, scene->bufferInfos, sizeof(scene->bufferInfos));
+}
+
+VkAccelerationStructureKHR GetRenderSceneAccelerationStructure(IN const RenderScene* scene)
+{
+    return GetSceneAccelerationStructure(scene->accelerationStructures);
+}
+
+uint32_t GetRenderSceneInstanceCount(IN const RenderScene* scene)
+{
+    return static_cast<uint32_t>(scene->instances.size());
+}
+
+VkResult SetRenderSceneInstanceTransform(IN RenderScene* scene, IN uint32_t instance,
+                                         IN const float objectToWorld[12])
+{
+    float inverse[12];
+    if (instance >= scene->instances.size() || !InvertSceneTransform(objectToWorld, inverse)) {
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+    }
+    memcpy(scene->instances[instance].objectToWorld, objectToWorld, sizeof(scene->instances[instance].objectToWorld));
+    VkResult result = writeInstances(scene);
+    if (result == VK_SUCCESS && scene->accelerationStructures != nullptr) {
+        result = UpdateSceneAccelerationStructureInstances(scene->accelerationStructures, scene->instances.data(),
+                                                           static_cast<uint32_t>(scene->instances.size()));
+    }
+    ++scene->version;
+    return result;
+}
+
+void GetRenderSceneTraits(IN const RenderScene* scene, OUT RenderSceneTraits* traits)
+{
+    *traits = scene->traits;
+}
+
+uint64_t GetRenderSceneVersion(IN const RenderScene* scene)
+{
+    return scene->version;
+}
+
+uint64_t GetRenderSceneHash(IN const RenderScene* scene)
+{
+    return scene->contentHash;
+}
+
+void DestroyRenderScene(IN RenderScene* scene)
+{
+    if (scene == nullptr) {
+        return;
+    }
+    DestroySceneAccelerationStructures(scene->accelerationStructures);
+    if (scene->buffer != nullptr) {
+        vkDestroyBuffer(vulkanLogicalDevice, scene->buffer, nullptr);
+    }
+    if (scene->bufferMemory != nullptr) {
+        vkFreeMemory(vulkanLogicalDevice, scene->bufferMemory, nullptr);
+    }
+    if (scene->instanceBuffer != nullptr) {
+        vkDestroyBuffer(vulkanLogicalDevice, scene->instanceBuffer, nullptr);
+    }
+    if (scene->instanceBufferMemory != nullptr) {
+        // Freeing implicitly unmaps.
+        vkFreeMemory(vulkanLogicalDevice, scene->instanceBufferMemory, nullptr);
+    }
+    delete scene;
+}
@@ -0,0 +1,659 @@
+/* @file SceneFile.cpp
+
+    Implementation of reading, writing & BVH building of .vcrtscene files.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <SceneFile.hpp>
+#include <Utility.hpp>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// FNV-1a over 64-bit words, all records are multiples of 8 bytes.
+static uint64_t hashWords(IN uint64_t hash, IN const void* data, IN uint64_t size)
+{
+    const uint8_t* cursor = static_cast<const uint8_t*>(data);
+    for (uint64_t iter = 0; iter + sizeof(uint64_t) <= size; iter += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, cursor + iter, sizeof(word));
+        hash = (hash ^ word) * FNV_PRIME;
+    }
+    return hash;
+}
+
+// 64-bit file offsets, scene files may exceed 2GB.
+static bool seekFile(IN FILE* file, IN uint64_t offset)
+{
+#if defined(_WIN32)
+    return _fseeki64(file, static_cast<__int64>(offset), SEEK_SET) == 0;
+#else
+    return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+}
+
+static uint64_t alignUp(IN uint64_t value, IN uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+VkResult MapSceneFile(IN const char* filename, OUT MappedSceneFile* file)
+{
+#if defined(_WIN32)
+    HANDLE fileHandle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fileHandle, &size) || size.QuadPart == 0) {
+        CloseHandle(fileHandle);
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle == nullptr) {
+        CloseHandle(fileHandle);
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    void* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr) {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        return VK_ERROR_MEMORY_MAP_FAILED;
+    }
+    file->data = static_cast<const uint8_t*>(data);
+    file->size = static_cast<size_t>(size.QuadPart);
+    file->fileHandle = fileHandle;
+    file->mappingHandle = mappingHandle;
+#else
+    int descriptor = open(filename, O_RDONLY);
+    if (descriptor < 0) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || status.st_size == 0) {
+        close(descriptor);
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    void* data = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+    // The mapping keeps the file referenced.
+    close(descriptor);
+    if (data == MAP_FAILED) {
+        return VK_ERROR_MEMORY_MAP_FAILED;
+    }
+    // Sections are read front to back exactly once while copying to staging.
+    madvise(data, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+    file->data = static_cast<const uint8_t*>(data);
+    file->size = static_cast<size_t>(status.st_size);
+#endif
+    return VK_SUCCESS;
+}
+
+void UnmapSceneFile(IN MappedSceneFile* file)
+{
+    if (file->data == nullptr) {
+        return;
+    }
+#if defined(_WIN32)
+    UnmapViewOfFile(file->data);
+    CloseHandle(file->mappingHandle);
+    CloseHandle(file->fileHandle);
+#else
+    munmap(const_cast<uint8_t*>(file->data), file->size);
+#endif
+    file->data = nullptr;
+    file->size = 0;
+}
+
+// Children follow their parent as the builder emits them, which also rules out cycles. Node & index
+// counts were checked against the geometries & spheres already.
+static bool validateBvh(IN const SceneView* view)
+{
+    for (uint64_t iter = 0; iter < view->bvhNodeCount; ++iter) {
+        const SceneBvhNode* node = &view->bvhNodes[iter];
+        if (node->count == 0 ? node->leftOrFirst <= iter || node->leftOrFirst + 1ULL >= view->bvhNodeCount :
+                               node->leftOrFirst + static_cast<uint64_t>(node->count) > view->sphereCount) {
+            return false;
+        }
+    }
+    for (uint64_t iter = 0; iter < view->sphereCount; ++iter) {
+        if (view->bvhIndices[iter] >= view->sphereCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+VkResult ParseSceneFile(IN const void* data, IN size_t size, OUT SceneView* view)
+{
+    const SceneFileHeader* header = static_cast<const SceneFileHeader*>(data);
+    if (size < sizeof(SceneFileHeader) || header->magic != SCENE_FILE_MAGIC ||
+        header->version != SCENE_FILE_VERSION || header->sectionCount > SCENE_MAX_SECTIONS) {
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+    }
+
+    memset(view, 0, sizeof(*view));
+    view->contentHash = header->contentHash;
+    const uint8_t* base = static_cast<const uint8_t*>(data);
+    uint64_t bvhIndexCount = 0;
+    for (uint32_t iter = 0; iter < header->sectionCount; ++iter) {
+        const SceneSection& section = header->sections[iter];
+        if (section.offset % SCENE_SECTION_ALIGNMENT != 0 || section.offset > size ||
+            section.elementSize == 0 || section.count > (size - section.offset) / section.elementSize) {
+            return VK_ERROR_FORMAT_NOT_SUPPORTED;
+        }
+        const void* payload = base + section.offset;
+        switch (section.type) {
+            case SCENE_SECTION_SPHERES:
+                if (section.elementSize != sizeof(SceneSphere)) {
+                    return VK_ERROR_FORMAT_NOT_SUPPORTED;
+                }
+                view->spheres = static_cast<const SceneSphere*>(payload);
+                view->sphereCount = section.count;
+                break;
+            case SCENE_SECTION_MATERIALS:
+                if (section.elementSize != sizeof(SceneMaterial)) {
+                    return VK_ERROR_FORMAT_NOT_SUPPORTED;
+                }
+                view->materials = static_cast<const SceneMaterial*>(payload);
+                view->materialCount = section.count;
+                break;
+            case SCENE_SECTION_BVH_NODES:
+                if (section.elementSize != sizeof(SceneBvhNode)) {
+                    return VK_ERROR_FORMAT_NOT_SUPPORTED;
+                }
+                view->bvhNodes = static_cast<const SceneBvhNode*>(payload);
+                view->bvhNodeCount = section.count;
+                break;
+            case SCENE_SECTION_BVH_INDICES:
+                if (section.elementSize != sizeof(uint32_t)) {
+                    return VK_ERROR_FORMAT_NOT_SUPPORTED;
+                }
+                view->bvhIndices = static_cast<const uint32_t*>(payload);
+                bvhIndexCount = section.count;
+                break;
+            case SCENE_SECTION_GEOMETRIES:
+                if (section.elementSize != sizeof(SceneGeometry)) {
+                    return VK_ERROR_FORMAT_NOT_SUPPORTED;
+                }
+                view->geometries = static_cast<const SceneGeometry*>(payload);
+                view->geometryCount = section.count;
+                break;
+            case SCENE_SECTION_INSTANCES:
+                if (section.elementSize != sizeof(SceneInstance)) {
+                    return VK_ERROR_FORMAT_NOT_SUPPORTED;
+                }
+                view->instances = static_cast<const SceneInstance*>(payload);
+                view->instanceCount = section.count;
+                break;
+            default:
+                // Unknown sections of newer writers are skipped.
+                break;
+        }
+    }
+
+    if (view->sphereCount == 0 || view->materialCount == 0 || view->sphereCount > UINT32_MAX) {
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+    }
+    // Scene images also arrive from the network, the shader indexes materials unchecked.
+    for (uint64_t iter = 0; iter < view->sphereCount; ++iter) {
+        if (view->spheres[iter].material >= view->materialCount) {
+            return VK_ERROR_FORMAT_NOT_SUPPORTED;
+        }
+    }
+    // Geometries must partition the spheres in order, each BVH leaf range stays inside its geometry.
+    uint64_t geometryCount = 1;
+    if (view->geometries != nullptr) {
+        uint64_t nextSphere = 0;
+        for (uint64_t iter = 0; iter < view->geometryCount; ++iter) {
+            if (view->geometries[iter].firstSphere != nextSphere || view->geometries[iter].sphereCount == 0) {
+                return VK_ERROR_FORMAT_NOT_SUPPORTED;
+            }
+            nextSphere += view->geometries[iter].sphereCount;
+        }
+        if (nextSphere != view->sphereCount) {
+            return VK_ERROR_FORMAT_NOT_SUPPORTED;
+        }
+        geometryCount = view->geometryCount;
+    }
+    if (view->instances != nullptr) {
+        if (view->instanceCount == 0 || view->instanceCount > UINT32_MAX) {
+            return VK_ERROR_FORMAT_NOT_SUPPORTED;
+        }
+        for (uint64_t iter = 0; iter < view->instanceCount; ++iter) {
+            if (view->instances[iter].geometry >= geometryCount) {
+                return VK_ERROR_FORMAT_NOT_SUPPORTED;
+            }
+        }
+    }
+    // A stale, incomplete or malformed BVH is ignored & rebuilt by the loader.
+    if (header->bvhContentHash != header->contentHash || view->bvhNodeCount < geometryCount ||
+        bvhIndexCount != view->sphereCount || !validateBvh(view)) {
+        view->bvhNodes = nullptr;
+        view->bvhNodeCount = 0;
+        view->bvhIndices = nullptr;
+    }
+    return VK_SUCCESS;
+}
+
+uint64_t HashSceneContent(IN const SceneSphere* spheres, IN uint64_t sphereCount,
+                          IN const SceneMaterial* materials, IN uint64_t materialCount,
+                          IN const SceneGeometry* geometries, IN uint64_t geometryCount)
+{
+    uint64_t hash = hashWords(FNV_OFFSET_BASIS, spheres, sphereCount * sizeof(SceneSphere));
+    hash = hashWords(hash, materials, materialCount * sizeof(SceneMaterial));
+    return hashWords(hash, geometries, geometryCount * sizeof(SceneGeometry));
+}
+
+bool InvertSceneTransform(IN const float transform[12], OUT float inverse[12])
+{
+    const float* row0 = &transform[0];
+    const float* row1 = &transform[4];
+    const float* row2 = &transform[8];
+    // Adjugate of the linear part, rows of the inverse.
+    float cofactors[9] = {
+        row1[1] * row2[2] - row1[2] * row2[1], row0[2] * row2[1] - row0[1] * row2[2], row0[1] * row1[2] - row0[2] * row1[1],
+        row1[2] * row2[0] - row1[0] * row2[2], row0[0] * row2[2] - row0[2] * row2[0], row0[2] * row1[0] - row0[0] * row1[2],
+        row1[0] * row2[1] - row1[1] * row2[0], row0[1] * row2[0] - row0[0] * row2[1], row0[0] * row1[1] - row0[1] * row1[0]
+    };
+    float determinant = row0[0] * cofactors[0] + row0[1] * cofactors[3] + row0[2] * cofactors[6];
+    if (fabsf(determinant) < FLT_MIN) {
+        return false;
+    }
+    for (uint32_t row = 0; row < 3; ++row) {
+        float* result = &inverse[row * 4];
+        for (uint32_t column = 0; column < 3; ++column) {
+            result[column] = cofactors[row * 3 + column] / determinant;
+        }
+        result[3] = -(result[0] * transform[3] + result[1] * transform[7] + result[2] * transform[11]);
+    }
+    return true;
+}
+
+// BVH building: binned SAH, falling back to median splits where the depth budget runs out.
+
+constexpr uint32_t BVH_BIN_COUNT = 16;
+constexpr uint32_t BVH_MAX_LEAF_SIZE = 4;
+
+struct BvhBounds {
+    float minimum[3];
+    float maximum[3];
+};
+
+struct BvhBuilder {
+    std::vector<BvhBounds>     bounds;      // Per primitive, spheres or instances.
+    std::vector<SceneBvhNode>* nodes;
+    std::vector<uint32_t>*     indices;
+};
+
+static void resetBounds(OUT BvhBounds* bounds)
+{
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+        bounds->minimum[axis] = FLT_MAX;
+        bounds->maximum[axis] = -FLT_MAX;
+    }
+}
+
+static void growBounds(IN OUT BvhBounds* bounds, IN const BvhBounds* other)
+{
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+        bounds->minimum[axis] = std::min(bounds->minimum[axis], other->minimum[axis]);
+        bounds->maximum[axis] = std::max(bounds->maximum[axis], other->maximum[axis]);
+    }
+}
+
+static void sphereBounds(IN const SceneSphere* sphere, OUT BvhBounds* bounds)
+{
+    float radius = fabsf(sphere->radius);
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+        bounds->minimum[axis] = sphere->center[axis] - radius;
+        bounds->maximum[axis] = sphere->center[axis] + radius;
+    }
+}
+
+static float centroid(IN const BvhBounds* bounds, IN uint32_t axis)
+{
+    return 0.5f * (bounds->minimum[axis] + bounds->maximum[axis]);
+}
+
+static float surfaceArea(IN const BvhBounds* bounds)
+{
+    float extent[3];
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+        extent[axis] = std::max(0.f, bounds->maximum[axis] - bounds->minimum[axis]);
+    }
+    return extent[0] * extent[1] + extent[1] * extent[2] + extent[2] * extent[0];
+}
+
+static uint32_t ceilLog2(IN uint64_t value)
+{
+    uint32_t result = 0;
+    while ((1ULL << result) < value) {
+        ++result;
+    }
+    return result;
+}
+
+// Partition indices[first, first + count) & fill nodes[nodeIndex].
+static void buildBvhNode(IN BvhBuilder* builder, IN uint32_t nodeIndex, IN uint32_t first, IN uint32_t count,
+                         IN uint32_t depth)
+{
+    uint32_t* indices = builder->indices->data();
+    BvhBounds bounds, centroidBounds;
+    resetBounds(&bounds);
+    resetBounds(&centroidBounds);
+    for (uint32_t iter = first; iter < first + count; ++iter) {
+        const BvhBounds* primitive = &builder->bounds[indices[iter]];
+        growBounds(&bounds, primitive);
+        BvhBounds point;
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            point.minimum[axis] = point.maximum[axis] = centroid(primitive, axis);
+        }
+        growBounds(&centroidBounds, &point);
+    }
+
+    SceneBvhNode* node = &(*builder->nodes)[nodeIndex];
+    memcpy(node->boundsMin, bounds.minimum, sizeof(node->boundsMin));
+    memcpy(node->boundsMax, bounds.maximum, sizeof(node->boundsMax));
+    node->leftOrFirst = first;
+    node->count = count;
+    if (count <= BVH_MAX_LEAF_SIZE) {
+        return;
+    }
+
+    uint32_t axis = 0;
+    for (uint32_t iter = 1; iter < 3; ++iter) {
+        if (centroidBounds.maximum[iter] - centroidBounds.minimum[iter] >
+            centroidBounds.maximum[axis] - centroidBounds.minimum[axis]) {
+            axis = iter;
+        }
+    }
+    float axisMinimum = centroidBounds.minimum[axis];
+    float axisExtent = centroidBounds.maximum[axis] - axisMinimum;
+    uint32_t middle = first + count / 2;
+    bool partitioned = false;
+    // SAH only while the remaining depth can still absorb an unbalanced split.
+    // Coincident centers cannot be binned, they are split at the median as well.
+    bool useSah = depth + 1 + ceilLog2((count + BVH_MAX_LEAF_SIZE - 1) / BVH_MAX_LEAF_SIZE) < SCENE_BVH_MAX_DEPTH &&
+                  axisExtent > 0.f;
+    if (useSah) {
+        BvhBounds binBounds[BVH_BIN_COUNT];
+        uint32_t binCounts[BVH_BIN_COUNT] = {};
+        for (uint32_t bin = 0; bin < BVH_BIN_COUNT; ++bin) {
+            resetBounds(&binBounds[bin]);
+        }
+        float scale = BVH_BIN_COUNT / axisExtent;
+        for (uint32_t iter = first; iter < first + count; ++iter) {
+            const BvhBounds* primitive = &builder->bounds[indices[iter]];
+            uint32_t bin = std::min(BVH_BIN_COUNT - 1,
+                                    static_cast<uint32_t>((centroid(primitive, axis) - axisMinimum) * scale));
+            growBounds(&binBounds[bin], primitive);
+            binCounts[bin]++;
+        }
+
+        // Sweep from the right to get suffix costs, then from the left to pick the cheapest plane.
+        float rightCosts[BVH_BIN_COUNT];
+        BvhBounds accumulated;
+        resetBounds(&accumulated);
+        uint32_t accumulatedCount = 0;
+        for (uint32_t bin = BVH_BIN_COUNT - 1; bin > 0; --bin) {
+            growBounds(&accumulated, &binBounds[bin]);
+            accumulatedCount += binCounts[bin];
+            rightCosts[bin] = surfaceArea(&accumulated) * accumulatedCount;
+        }
+        resetBounds(&accumulated);
+        accumulatedCount = 0;
+        float bestCost = FLT_MAX;
+        uint32_t bestPlane = 0;
+        for (uint32_t plane = 1; plane < BVH_BIN_COUNT; ++plane) {
+            growBounds(&accumulated, &binBounds[plane - 1]);
+            accumulatedCount += binCounts[plane - 1];
+            float cost = surfaceArea(&accumulated) * accumulatedCount + rightCosts[plane];
+            if (accumulatedCount > 0 && accumulatedCount < count && cost < bestCost) {
+                bestCost = cost;
+                bestPlane = plane;
+            }
+        }
+
+        if (bestPlane != 0) {
+            float leafCost = surfaceArea(&bounds) * count;
+            if (count <= BVH_MAX_LEAF_SIZE * 2 && leafCost <= bestCost) {
+                return;
+            }
+            uint32_t* partition = std::partition(indices + first, indices + first + count,
+                [builder, axis, axisMinimum, scale, bestPlane](uint32_t index) {
+                    float position = centroid(&builder->bounds[index], axis);
+                    return std::min(BVH_BIN_COUNT - 1, static_cast<uint32_t>((position - axisMinimum) * scale)) < bestPlane;
+                });
+            middle = static_cast<uint32_t>(partition - indices);
+            partitioned = true;
+        }
+    }
+
+    if (!partitioned) {
+        // Object median: always balanced, bounds the depth.
+        std::nth_element(indices + first, indices + middle, indices + first + count,
+            [builder, axis](uint32_t left, uint32_t right) {
+                return centroid(&builder->bounds[left], axis) < centroid(&builder->bounds[right], axis);
+            });
+    }
+    uint32_t leftChild = static_cast<uint32_t>(builder->nodes->size());
+    builder->nodes->resize(leftChild + 2);
+    node = &(*builder->nodes)[nodeIndex];
+    node->leftOrFirst = leftChild;
+    node->count = 0;
+    buildBvhNode(builder, leftChild, first, middle - first, depth + 1);
+    buildBvhNode(builder, leftChild + 1, middle, first + count - middle, depth + 1);
+}
+
+// Build the BVHs of consecutive primitive ranges, roots at nodes [0, rangeCount).
+static void buildBvh(IN BvhBuilder* builder, IN const uint32_t* rangeFirsts, IN const uint32_t* rangeCounts,
+                     IN uint64_t rangeCount)
+{
+    uint64_t primitiveCount = builder->bounds.size();
+    builder->indices->resize(primitiveCount);
+    for (uint64_t iter = 0; iter < primitiveCount; ++iter) {
+        (*builder->indices)[iter] = static_cast<uint32_t>(iter);
+    }
+    builder->nodes->clear();
+    builder->nodes->reserve(primitiveCount / BVH_MAX_LEAF_SIZE * 2 + rangeCount);
+    builder->nodes->resize(rangeCount);
+    for (uint64_t iter = 0; iter < rangeCount; ++iter) {
+        buildBvhNode(builder, static_cast<uint32_t>(iter), rangeFirsts[iter], rangeCounts[iter], 0);
+    }
+}
+
+void BuildSceneBvh(IN const SceneSphere* spheres, IN uint64_t sphereCount,
+                   IN const SceneGeometry* geometries, IN uint64_t geometryCount,
+                   OUT std::vector<SceneBvhNode>* nodes, OUT std::vector<uint32_t>* indices)
+{
+    BvhBuilder builder = {
+        .bounds = std::vector<BvhBounds>(sphereCount),
+        .nodes = nodes,
+        .indices = indices
+    };
+    for (uint64_t iter = 0; iter < sphereCount; ++iter) {
+        sphereBounds(&spheres[iter], &builder.bounds[iter]);
+    }
+    if (geometries == nullptr) {
+        uint32_t first = 0;
+        uint32_t count = static_cast<uint32_t>(sphereCount);
+        buildBvh(&builder, &first, &count, 1);
+        return;
+    }
+    std::vector<uint32_t> firsts(geometryCount), counts(geometryCount);
+    for (uint64_t iter = 0; iter < geometryCount; ++iter) {
+        firsts[iter] = geometries[iter].firstSphere;
+        counts[iter] = geometries[iter].sphereCount;
+    }
+    buildBvh(&builder, firsts.data(), counts.data(), geometryCount);
+}
+
+void BuildInstanceBvh(IN const SceneInstance* instances, IN uint64_t instanceCount, IN const SceneBvhNode* bvhNodes,
+                      OUT std::vector<SceneBvhNode>* nodes, OUT std::vector<uint32_t>* indices)
+{
+    BvhBuilder builder = {
+        .bounds = std::vector<BvhBounds>(instanceCount),
+        .nodes = nodes,
+        .indices = indices
+    };
+    for (uint64_t iter = 0; iter < instanceCount; ++iter) {
+        // World bounds of an affine transformed box, per row: center & absolute extent.
+        const float* transform = instances[iter].objectToWorld;
+        const SceneBvhNode* root = &bvhNodes[instances[iter].geometry];
+        for (uint32_t row = 0; row < 3; ++row) {
+            float center = transform[row * 4 + 3];
+            float extent = 0.f;
+            for (uint32_t column = 0; column < 3; ++column) {
+                center += transform[row * 4 + column] * 0.5f * (root->boundsMin[column] + root->boundsMax[column]);
+                extent += fabsf(transform[row * 4 + column]) * 0.5f * (root->boundsMax[column] - root->boundsMin[column]);
+            }
+            builder.bounds[iter].minimum[row] = center - extent;
+            builder.bounds[iter].maximum[row] = center + extent;
+        }
+    }
+    uint32_t first = 0;
+    uint32_t count = static_cast<uint32_t>(instanceCount);
+    buildBvh(&builder, &first, &count, 1);
+}
+
+VkResult BeginSceneFile(IN const char* filename, OUT SceneFileWriter* writer)
+{
+    memset(writer, 0, sizeof(*writer));
+    writer->file = fopen(filename, "wb");
+    if (writer->file == nullptr) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    writer->header.magic = SCENE_FILE_MAGIC;
+    writer->header.version = SCENE_FILE_VERSION;
+    writer->hash = FNV_OFFSET_BASIS;
+    writer->position = sizeof(writer->header);
+    // Placeholder, the real header is written by EndSceneFile.
+    if (fwrite(&writer->header, sizeof(writer->header), 1, writer->file) != 1) {
+        fclose(writer->file);
+        return VK_ERROR_UNKNOWN;
+    }
+    return VK_SUCCESS;
+}
+
+VkResult BeginSceneSection(IN SceneFileWriter* writer, IN SceneSectionType type, IN uint32_t elementSize)
+{
+    if (writer->header.sectionCount == SCENE_MAX_SECTIONS) {
+        return VK_ERROR_TOO_MANY_OBJECTS;
+    }
+    static const uint8_t zeros[SCENE_SECTION_ALIGNMENT] = {};
+    uint64_t offset = alignUp(writer->position, SCENE_SECTION_ALIGNMENT);
+    uint64_t paddingSize = offset - writer->position;
+    if (paddingSize != 0 && fwrite(zeros, 1, paddingSize, writer->file) != paddingSize) {
+        return VK_ERROR_UNKNOWN;
+    }
+    writer->position = offset;
+    writer->currentSection = &writer->header.sections[writer->header.sectionCount++];
+    writer->currentSection->type = type;
+    writer->currentSection->elementSize = elementSize;
+    writer->currentSection->count = 0;
+    writer->currentSection->offset = offset;
+    return VK_SUCCESS;
+}
+
+VkResult WriteSceneSectionData(IN SceneFileWriter* writer, IN const void* elements, IN uint64_t count)
+{
+    SceneSection* section = writer->currentSection;
+    uint64_t size = count * section->elementSize;
+    if (fwrite(elements, 1, size, writer->file) != size) {
+        return VK_ERROR_UNKNOWN;
+    }
+    writer->position += size;
+    if (section->type == SCENE_SECTION_SPHERES || section->type == SCENE_SECTION_MATERIALS ||
+        section->type == SCENE_SECTION_GEOMETRIES) {
+        writer->hash = hashWords(writer->hash, elements, size);
+    }
+    section->count += count;
+    return VK_SUCCESS;
+}
+
+VkResult EndSceneFile(IN SceneFileWriter* writer)
+{
+    writer->header.contentHash = writer->hash;
+    for (uint32_t iter = 0; iter < writer->header.sectionCount; ++iter) {
+        if (writer->header.sections[iter].type == SCENE_SECTION_BVH_NODES) {
+            writer->header.bvhContentHash = writer->hash;
+        }
+    }
+    bool failed = !seekFile(writer->file, 0) ||
+                  fwrite(&writer->header, sizeof(writer->header), 1, writer->file) != 1;
+    failed = (fclose(writer->file) != 0) || failed;
+    writer->file = nullptr;
+    return failed ? VK_ERROR_UNKNOWN : VK_SUCCESS;
+}
+
+VkResult AppendSceneBvh(IN const char* filename, IN const SceneView* view,
+                        IN const std::vector<SceneBvhNode>* nodes, IN const std::vector<uint32_t>* indices)
+{
+    FILE* file = fopen(filename, "r+b");
+    if (file == nullptr) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    SceneFileHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || header.contentHash != view->contentHash) {
+        fclose(file);
+        return VK_ERROR_FORMAT_NOT_SUPPORTED;
+    }
+
+    // Drop stale BVH sections, their payload stays as dead bytes in the file.
+    uint64_t end = sizeof(header);
+    uint32_t kept = 0;
+    for (uint32_t iter = 0; iter < header.sectionCount; ++iter) {
+        const SceneSection& section = header.sections[iter];
+        end = std::max(end, section.offset + section.count * section.elementSize);
+        if (header.sections[iter].type != SCENE_SECTION_BVH_NODES &&
+            header.sections[iter].type != SCENE_SECTION_BVH_INDICES) {
+            header.sections[kept++] = header.sections[iter];
+        }
+    }
+    if (kept + 2 > SCENE_MAX_SECTIONS) {
+        fclose(file);
+        return VK_ERROR_TOO_MANY_OBJECTS;
+    }
+    header.sectionCount = kept;
+
+    SceneFileWriter writer = {
+        .file = file,
+        .header = header,
+        .hash = view->contentHash,
+        .position = end,
+        .currentSection = nullptr
+    };
+    VkResult result = VK_SUCCESS;
+    if (!seekFile(file, end)) {
+        result = VK_ERROR_UNKNOWN;
+    }
+    if (result == VK_SUCCESS) {
+        result = BeginSceneSection(&writer, SCENE_SECTION_BVH_NODES, sizeof(SceneBvhNode));
+    }
+    if (result == VK_SUCCESS) {
+        result = WriteSceneSectionData(&writer, nodes->data(), nodes->size());
+    }
+    if (result == VK_SUCCESS) {
+        result = BeginSceneSection(&writer, SCENE_SECTION_BVH_INDICES, sizeof(uint32_t));
+    }
+    if (result == VK_SUCCESS) {
+        result = WriteSceneSectionData(&writer, indices->data(), indices->size());
+    }
+    if (result != VK_SUCCESS) {
+        fclose(file);
+        return result;
+    }
+    return EndSceneFile(&writer);
+}
@@ -1,56 +1,399 @@
 /* @file SceneGenerator.hpp
  *
- *  Random scene generator for shader, since random is extremely difficult in GLSL.
+ *  Random scene generator, writes .vcrtscene files from the book scene up to stress-scale scenes.
+ *  Every chunk of spheres draws from its own counter-based random stream,
+ *  so the output is bit-identical for any thread count.
  *  SPDX-License-Identifier: WTFPL
  *
  */
+#include <SceneFile.hpp>
+#include <atomic>
+#include <cmath>
 #include <cstdio>
-#include <random>
-
-typedef struct vec3 {
-    float x, y, z;
-    vec3(float x, float y, float z) : x(x), y(y), z(z) {}
-    vec3 operator-(vec3 in) { return vec3(x - in.x, y - in.y, z - in.z); }
-    float length() { return x * x + y * y + z * z; }
-} point3;
-
-double random_double() {
-    static std::uniform_real_distribution<double> distribution(0.0, 1.0);
-    static std::mt19937 generator;
-    return distribution(generator);
-}
-
-int main(void) {
-    for (int a = -11; a < 11; a++) {
-        for (int b = -11; b < 11; b++) {
-            auto choose_mat = random_double();
-            point3 center(a + 0.9 * random_double(), 0.2, b + 0.9 * random_double());
-            if ((center - point3(4, 0.2, 0)).length() < 0.9) {
-                continue;
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+enum Distribution {
+    DISTRIBUTION_BOOK,      // 22x22 jittered grid & three big spheres of Ray Tracing in One Weekend.
+    DISTRIBUTION_GRID,      // Jittered grid on the ground plane.
+    DISTRIBUTION_CLUSTERED, // Gaussian clusters above the ground plane.
+    DISTRIBUTION_UNIFORM    // Uniform in a cube, no ground.
+};
+
+struct GeneratorOptions {
+    const char*  filename = "scene.vcrtscene";
+    Distribution distribution = DISTRIBUTION_BOOK;
+    uint64_t     count = 0;             // 0: 484 for book, 10^6 otherwise.
+    float        minimumRadius = 0.2f;
+    float        maximumRadius = 0.2f;
+    float        materialMix[3] = {0.8f, 0.15f, 0.05f};  // Diffuse, metal, glass weights.
+    uint32_t     paletteSize = 256;
+    uint64_t     seed = 0;
+    uint32_t     threadCount = 0;       // 0: hardware concurrency.
+    uint32_t     instanceCount = 0;     // 0: plain scene, otherwise copies of the generated spheres.
+    bool         buildBvh = false;
+};
+
+// Spheres per random stream & per unit of work. Fixed, the output must not depend on threads.
+constexpr uint64_t CHUNK_SIZE = 65536;
+// Chunks generated in parallel before they are written out in order, bounds memory use.
+constexpr uint64_t CHUNKS_PER_BATCH = 64;
+constexpr uint32_t VALUES_PER_SPHERE = 8;
+// Streams of values not tied to a chunk.
+constexpr uint64_t MATERIAL_STREAM = ~0ULL;
+constexpr uint64_t CLUSTER_STREAM = ~0ULL - 1;
+constexpr uint64_t INSTANCE_STREAM = ~0ULL - 2;
+constexpr uint32_t CLUSTER_SIZE = 4096;
+
+static GeneratorOptions options;
+
+// SplitMix64 finalizer over (seed, stream, counter): a counter-based generator, any value is random-access.
+static uint64_t random_bits(uint64_t stream, uint64_t counter) {
+    uint64_t z = options.seed + stream * 0x9e3779b97f4a7c15ULL + counter * 0xd1b54a32d192ed03ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z = (z ^ (z >> 31)) * 0x9e3779b97f4a7c15ULL;
+    return z ^ (z >> 29);
+}
+
+static float random_float(uint64_t stream, uint64_t counter) {
+    return static_cast<float>(random_bits(stream, counter) >> 40) / 16777216.0f;
+}
+
+// Ground & feature spheres, appended after the generated ones.
+static uint64_t extra_sphere_count() {
+    switch (options.distribution) {
+        case DISTRIBUTION_BOOK: return 4;
+        case DISTRIBUTION_UNIFORM: return 0;
+        default: return 1;
+    }
+}
+
+static uint32_t pick_material(float choose_mat) {
+    // Palette entries are laid out in mix order, see generate_palette.
+    return std::min(options.paletteSize - 1, static_cast<uint32_t>(choose_mat * options.paletteSize));
+}
+
+static std::vector<SceneMaterial> generate_palette() {
+    std::vector<SceneMaterial> palette(options.paletteSize + extra_sphere_count());
+    float total = options.materialMix[0] + options.materialMix[1] + options.materialMix[2];
+    for (uint32_t iter = 0; iter < options.paletteSize; ++iter) {
+        float choose_mat = (iter + 0.5f) / options.paletteSize * total;
+        SceneMaterial& material = palette[iter];
+        uint64_t counter = iter * VALUES_PER_SPHERE;
+        if (choose_mat < options.materialMix[0]) {
+            material.type = SCENE_MATERIAL_LAMBERTIAN;
+        } else if (choose_mat < options.materialMix[0] + options.materialMix[1]) {
+            material.type = SCENE_MATERIAL_METAL;
+        } else {
+            material = {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f};
+            continue;
+        }
+        for (uint32_t channel = 0; channel < 3; ++channel) {
+            material.albedo[channel] = random_float(MATERIAL_STREAM, counter + channel);
+        }
+        material.parameter = random_float(MATERIAL_STREAM, counter + 3);
+    }
+
+    // Materials of the extra spheres, in extra sphere order.
+    SceneMaterial* extra = &palette[options.paletteSize];
+    if (options.distribution == DISTRIBUTION_BOOK) {
+        extra[0] = {{1.0f, 1.0f, 1.0f}, SCENE_MATERIAL_GLASS, 1.5f};
+        extra[1] = {{0.4f, 0.2f, 0.1f}, SCENE_MATERIAL_LAMBERTIAN, 1.0f};
+        extra[2] = {{0.7f, 0.6f, 0.5f}, SCENE_MATERIAL_METAL, 1.0f};
+        extra[3] = {{0.5f, 0.5f, 0.5f}, SCENE_MATERIAL_LAMBERTIAN, 1.0f};
+    } else if (options.distribution != DISTRIBUTION_UNIFORM) {
+        extra[0] = {{0.5f, 0.5f, 0.5f}, SCENE_MATERIAL_LAMBERTIAN, 1.0f};
+    }
+    return palette;
+}
+
+static std::vector<SceneSphere> generate_extra_spheres() {
+    uint32_t material = options.paletteSize;
+    std::vector<SceneSphere> spheres;
+    if (options.distribution == DISTRIBUTION_BOOK) {
+        spheres.push_back({{0.0f, 1.0f, 0.0f}, 1.0f, material++});
+        spheres.push_back({{-4.0f, 1.0f, 0.0f}, 1.0f, material++});
+        spheres.push_back({{4.0f, 1.0f, 0.0f}, 1.0f, material++});
+    }
+    if (options.distribution != DISTRIBUTION_UNIFORM) {
+        spheres.push_back({{0.0f, -1000.0f, 0.0f}, 1000.0f, material});
+    }
+    return spheres;
+}
+
+// Side length in cells of the square the grid-like distributions fill.
+static uint64_t grid_side() {
+    return options.distribution == DISTRIBUTION_BOOK ? 22 : static_cast<uint64_t>(ceil(sqrt(double(options.count))));
+}
+
+// Horizontal size of the area the generated spheres cover.
+static float generated_extent() {
+    switch (options.distribution) {
+        case DISTRIBUTION_CLUSTERED:
+            return static_cast<float>(sqrt(double(options.count)) + sqrt(double(CLUSTER_SIZE)) * 2.0);
+        case DISTRIBUTION_UNIFORM:
+            return static_cast<float>(cbrt(double(options.count))) * 2.0f;
+        default:
+            return static_cast<float>(grid_side()) + 1.0f;
+    }
+}
+
+// Copies of geometry 0 (the generated spheres) on a square grid, each turned around the y axis.
+// Geometry 1 (ground & feature spheres) is placed once, untransformed.
+static std::vector<SceneInstance> generate_instances(uint32_t geometryCount) {
+    std::vector<SceneInstance> instances;
+    uint32_t side = static_cast<uint32_t>(ceil(sqrt(double(options.instanceCount))));
+    // Diagonal spacing, turned copies do not overlap.
+    float spacing = generated_extent() * 1.4142136f;
+    for (uint32_t iter = 0; iter < options.instanceCount; ++iter) {
+        float angle = 6.2831853f * random_float(INSTANCE_STREAM, iter);
+        float c = cosf(angle), s = sinf(angle);
+        float x = (static_cast<float>(iter % side) - 0.5f * (side - 1)) * spacing;
+        float z = (static_cast<float>(iter / side) - 0.5f * (side - 1)) * spacing;
+        instances.push_back({{c, 0.0f, s, x,  0.0f, 1.0f, 0.0f, 0.0f,  -s, 0.0f, c, z}, 0});
+    }
+    if (geometryCount > 1) {
+        instances.push_back({{1.0f, 0.0f, 0.0f, 0.0f,  0.0f, 1.0f, 0.0f, 0.0f,  0.0f, 0.0f, 1.0f, 0.0f}, 1});
+    }
+    return instances;
+}
+
+static void generate_sphere(uint64_t index, uint64_t stream, uint64_t counter, SceneSphere* sphere) {
+    float value[VALUES_PER_SPHERE];
+    for (uint32_t iter = 0; iter < VALUES_PER_SPHERE; ++iter) {
+        value[iter] = random_float(stream, counter + iter);
+    }
+    float radius = options.minimumRadius + (options.maximumRadius - options.minimumRadius) * value[0];
+    float* center = sphere->center;
+    switch (options.distribution) {
+        case DISTRIBUTION_BOOK:
+        case DISTRIBUTION_GRID: {
+            // Book: a + 0.9 * random_double(), centered around the origin.
+            int64_t side = static_cast<int64_t>(grid_side());
+            int64_t a = static_cast<int64_t>(index % side) - side / 2;
+            int64_t b = static_cast<int64_t>(index / side) - side / 2;
+            center[0] = a + 0.9f * value[1];
+            center[1] = radius;
+            center[2] = b + 0.9f * value[2];
+            if (options.distribution == DISTRIBUTION_BOOK) {
+                float dx = center[0] - 4.0f, dz = center[2];
+                float distance = sqrtf(dx * dx + dz * dz);
+                if (distance < 0.9f) {
+                    // The book skips these, push them out of the metal sphere instead to keep the count fixed.
+                    float scale = distance > 0.f ? 0.9f / distance : 0.f;
+                    center[0] = distance > 0.f ? 4.0f + dx * scale : 4.9f;
+                    center[2] = dz * scale;
+                }
             }
-            printf("sphere(vec3(%.2f,%.2f,%.2f), 0.2, ", center.x, center.y,
-                         center.z);
-            if (choose_mat < 0.8) {
-                // diffuse
-                printf("vec3(%.2f,%.2f,%.2f), vec3(TEXTURE_LAMBERTIAN,%.2f,0.0)),\n",
-                             random_double(), random_double(), random_double(),
-                             random_double());
-            } else if (choose_mat < 0.95) {
-                // metal
-                printf("vec3(%.2f,%.2f,%.2f), vec3(TEXTURE_METAL,%.2f,0.0)),\n",
-                             random_double(), random_double(), random_double(),
-                             random_double());
+            break;
+        }
+        case DISTRIBUTION_CLUSTERED: {
+            uint64_t clusterCount = std::max<uint64_t>(1, options.count / CLUSTER_SIZE);
+            uint64_t cluster = random_bits(stream, counter + 1) % clusterCount;
+            float extent = static_cast<float>(sqrt(double(options.count)));
+            float clusterScale = sqrtf(static_cast<float>(CLUSTER_SIZE)) * 0.5f;
+            // Box-Muller for the offset from the cluster center.
+            float r = sqrtf(-2.0f * logf(std::max(value[2], 1e-7f)));
+            float phi = 6.2831853f * value[3];
+            float height = -logf(std::max(value[4], 1e-7f));
+            center[0] = (random_float(CLUSTER_STREAM, cluster * 2) - 0.5f) * extent + r * cosf(phi) * clusterScale;
+            center[1] = radius + height * clusterScale * 0.5f;
+            center[2] = (random_float(CLUSTER_STREAM, cluster * 2 + 1) - 0.5f) * extent + r * sinf(phi) * clusterScale;
+            break;
+        }
+        case DISTRIBUTION_UNIFORM: {
+            float extent = static_cast<float>(cbrt(double(options.count))) * 2.0f;
+            for (uint32_t axis = 0; axis < 3; ++axis) {
+                center[axis] = (value[1 + axis] - 0.5f) * extent;
+            }
+            break;
+        }
+    }
+    sphere->radius = radius;
+    sphere->material = pick_material(value[VALUES_PER_SPHERE - 1]);
+    memset(sphere->padding, 0, sizeof(sphere->padding));
+}
+
+static void generate_chunk(uint64_t chunk, SceneSphere* spheres) {
+    uint64_t first = chunk * CHUNK_SIZE;
+    uint64_t count = std::min(CHUNK_SIZE, options.count - first);
+    for (uint64_t iter = 0; iter < count; ++iter) {
+        generate_sphere(first + iter, chunk, iter * VALUES_PER_SPHERE, &spheres[iter]);
+    }
+}
+
+static bool parse_options(int argc, char** argv) {
+    for (int iter = 1; iter < argc; ++iter) {
+        const char* option = argv[iter];
+        const char* value = iter + 1 < argc ? argv[iter + 1] : nullptr;
+        bool valid = true;
+        if (strcmp(option, "--bvh") == 0) {
+            options.buildBvh = true;
+            continue;
+        } else if (option[0] != '-') {
+            options.filename = option;
+            continue;
+        } else if (value == nullptr) {
+            valid = false;
+        } else if (strcmp(option, "--count") == 0) {
+            options.count = strtoull(value, nullptr, 10);
+            valid = options.count > 0 && options.count < UINT32_MAX;
+        } else if (strcmp(option, "--distribution") == 0) {
+            if (strcmp(value, "book") == 0) {
+                options.distribution = DISTRIBUTION_BOOK;
+            } else if (strcmp(value, "grid") == 0) {
+                options.distribution = DISTRIBUTION_GRID;
+            } else if (strcmp(value, "clustered") == 0) {
+                options.distribution = DISTRIBUTION_CLUSTERED;
+            } else if (strcmp(value, "uniform") == 0) {
+                options.distribution = DISTRIBUTION_UNIFORM;
             } else {
-                // glass
-                printf("vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),\n");
+                valid = false;
+            }
+        } else if (strcmp(option, "--radius") == 0) {
+            int parsed = sscanf(value, "%f,%f", &options.minimumRadius, &options.maximumRadius);
+            if (parsed == 1) {
+                options.maximumRadius = options.minimumRadius;
             }
+            valid = parsed >= 1 && options.minimumRadius > 0.f && options.maximumRadius >= options.minimumRadius;
+        } else if (strcmp(option, "--materials") == 0) {
+            float* mix = options.materialMix;
+            valid = sscanf(value, "%f,%f,%f", &mix[0], &mix[1], &mix[2]) == 3 &&
+                    mix[0] >= 0.f && mix[1] >= 0.f && mix[2] >= 0.f && mix[0] + mix[1] + mix[2] > 0.f;
+        } else if (strcmp(option, "--palette") == 0) {
+            options.paletteSize = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+            valid = options.paletteSize > 0 && options.paletteSize <= 65536;
+        } else if (strcmp(option, "--seed") == 0) {
+            options.seed = strtoull(value, nullptr, 10);
+        } else if (strcmp(option, "--threads") == 0) {
+            options.threadCount = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+        } else if (strcmp(option, "--instances") == 0) {
+            options.instanceCount = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+            valid = options.instanceCount > 0 && options.instanceCount <= 1u << 24;
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            fprintf(stderr,
+                "Usage: %s [options] [output.vcrtscene]\n"
+                "  --distribution D       book (default), grid, clustered or uniform.\n"
+                "  --count N              Number of generated spheres (default 484 for book, 1000000 otherwise).\n"
+                "  --radius MIN[,MAX]     Radius range (default 0.2).\n"
+                "  --materials D,M,G      Weights of diffuse, metal & glass materials (default 0.8,0.15,0.05).\n"
+                "  --palette N            Number of distinct random materials (default 256).\n"
+                "  --seed N               Random seed (default 0).\n"
+                "  --threads N            Generator threads (default: all cores), does not change the output.\n"
+                "  --instances N          Place N turned copies of the generated spheres, stored once.\n"
+                "  --bvh                  Store a BVH, otherwise the renderer builds it on first load.\n",
+                argv[0]);
+            return false;
+        }
+        ++iter;
+    }
+    if (options.count == 0) {
+        options.count = options.distribution == DISTRIBUTION_BOOK ? 22 * 22 : 1000000;
+    }
+    if (options.distribution == DISTRIBUTION_BOOK) {
+        options.count = std::min<uint64_t>(options.count, 22 * 22);
+    }
+    if (options.threadCount == 0) {
+        options.threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (!parse_options(argc, argv)) {
+        return -1;
+    }
+
+    SceneFileWriter writer;
+    if (BeginSceneFile(options.filename, &writer) != VK_SUCCESS ||
+        BeginSceneSection(&writer, SCENE_SECTION_SPHERES, sizeof(SceneSphere)) != VK_SUCCESS) {
+        fprintf(stderr, "Cannot write %s.\n", options.filename);
+        return -1;
+    }
+
+    // Kept for the BVH only, otherwise each batch is dropped once written.
+    std::vector<SceneSphere> allSpheres;
+    std::vector<SceneSphere> batch(CHUNK_SIZE * CHUNKS_PER_BATCH);
+    uint64_t chunkCount = (options.count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    for (uint64_t firstChunk = 0; firstChunk < chunkCount; firstChunk += CHUNKS_PER_BATCH) {
+        uint64_t lastChunk = std::min(chunkCount, firstChunk + CHUNKS_PER_BATCH);
+        std::atomic<uint64_t> nextChunk(firstChunk);
+        std::vector<std::thread> threads;
+        for (uint32_t iter = 0; iter < std::min<uint64_t>(options.threadCount, lastChunk - firstChunk); ++iter) {
+            threads.emplace_back([&nextChunk, &batch, firstChunk, lastChunk]() {
+                for (uint64_t chunk; (chunk = nextChunk.fetch_add(1)) < lastChunk;) {
+                    generate_chunk(chunk, &batch[(chunk - firstChunk) * CHUNK_SIZE]);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        uint64_t batchCount = std::min(options.count, lastChunk * CHUNK_SIZE) - firstChunk * CHUNK_SIZE;
+        if (WriteSceneSectionData(&writer, batch.data(), batchCount) != VK_SUCCESS) {
+            fprintf(stderr, "Cannot write %s.\n", options.filename);
+            return -1;
+        }
+        if (options.buildBvh) {
+            allSpheres.insert(allSpheres.end(), batch.begin(), batch.begin() + batchCount);
+        }
+    }
+
+    std::vector<SceneSphere> extraSpheres = generate_extra_spheres();
+    std::vector<SceneMaterial> palette = generate_palette();
+    if (WriteSceneSectionData(&writer, extraSpheres.data(), extraSpheres.size()) != VK_SUCCESS ||
+        BeginSceneSection(&writer, SCENE_SECTION_MATERIALS, sizeof(SceneMaterial)) != VK_SUCCESS ||
+        WriteSceneSectionData(&writer, palette.data(), palette.size()) != VK_SUCCESS) {
+        fprintf(stderr, "Cannot write %s.\n", options.filename);
+        return -1;
+    }
+
+    // Geometries follow the materials, the content hash covers them in this order.
+    std::vector<SceneGeometry> geometries;
+    std::vector<SceneInstance> instances;
+    if (options.instanceCount > 0) {
+        geometries.push_back({0, static_cast<uint32_t>(options.count)});
+        if (!extraSpheres.empty()) {
+            geometries.push_back({static_cast<uint32_t>(options.count), static_cast<uint32_t>(extraSpheres.size())});
         }
+        instances = generate_instances(static_cast<uint32_t>(geometries.size()));
+        if (BeginSceneSection(&writer, SCENE_SECTION_GEOMETRIES, sizeof(SceneGeometry)) != VK_SUCCESS ||
+            WriteSceneSectionData(&writer, geometries.data(), geometries.size()) != VK_SUCCESS ||
+            BeginSceneSection(&writer, SCENE_SECTION_INSTANCES, sizeof(SceneInstance)) != VK_SUCCESS ||
+            WriteSceneSectionData(&writer, instances.data(), instances.size()) != VK_SUCCESS) {
+            fprintf(stderr, "Cannot write %s.\n", options.filename);
+            return -1;
+        }
+    }
+
+    if (options.buildBvh) {
+        allSpheres.insert(allSpheres.end(), extraSpheres.begin(), extraSpheres.end());
+        std::vector<SceneBvhNode> nodes;
+        std::vector<uint32_t> indices;
+        BuildSceneBvh(allSpheres.data(), allSpheres.size(), geometries.empty() ? nullptr : geometries.data(),
+                      geometries.size(), &nodes, &indices);
+        if (BeginSceneSection(&writer, SCENE_SECTION_BVH_NODES, sizeof(SceneBvhNode)) != VK_SUCCESS ||
+            WriteSceneSectionData(&writer, nodes.data(), nodes.size()) != VK_SUCCESS ||
+            BeginSceneSection(&writer, SCENE_SECTION_BVH_INDICES, sizeof(uint32_t)) != VK_SUCCESS ||
+            WriteSceneSectionData(&writer, indices.data(), indices.size()) != VK_SUCCESS) {
+            fprintf(stderr, "Cannot write %s.\n", options.filename);
+            return -1;
+        }
+    }
+
+    if (EndSceneFile(&writer) != VK_SUCCESS) {
+        fprintf(stderr, "Cannot write %s.\n", options.filename);
+        return -1;
     }
-    printf("\n");
-    printf("sphere(vec3(0, 1, 0),1.0, vec3(1.0,1.0,1.0), "
-           "vec3(TEXTURE_GLASS,1.5,0.0)),\n");
-    printf("sphere(vec3(-4, 1, 0),1.0, vec3(0.4, 0.2, 0.1), "
-           "vec3(TEXTURE_LAMBERTIAN,1.0,0.0)),\n");
-    printf("sphere(vec3(4, 1, 0),1.0, vec3(0.7, 0.6, 0.5), "
-           "vec3(TEXTURE_METAL,1.0,0.0)),\n");
+    printf("%llu spheres, %u materials, %u instances written to %s.\n",
+           static_cast<unsigned long long>(options.count + extraSpheres.size()),
+           static_cast<unsigned>(palette.size()), static_cast<unsigned>(instances.size()), options.filename);
+    return 0;
 }
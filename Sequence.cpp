@@ -0,0 +1,325 @@
+/* @file Sequence.cpp
+
+    Implementation of image sequence rendering: frames are read back asynchronously & written by an
+    encoder thread while the GPU renders the following ones.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <Sequence.hpp>
+#include <ImageOutput.hpp>
+#include <Options.hpp>
+#include <Renderer.hpp>
+#include <Scene.hpp>
+#include <Utility.hpp>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+static Camera interpolateCamera(IN const Camera* from, IN const Camera* to, IN float t)
+{
+    Camera camera = *to;
+    for (uint32_t iter = 0; iter < 3; ++iter) {
+        camera.lookfrom[iter] = from->lookfrom[iter] + (to->lookfrom[iter] - from->lookfrom[iter]) * t;
+        camera.lookat[iter] = from->lookat[iter] + (to->lookat[iter] - from->lookat[iter]) * t;
+    }
+    camera.vfov = from->vfov + (to->vfov - from->vfov) * t;
+    return camera;
+}
+
+VkResult LoadCameraPath(IN const char* filename, IN const Camera* base, OUT std::vector<Camera>* cameras)
+{
+    FILE* file = fopen(filename, "r");
+    if (file == nullptr) {
+        fprintf(stderr, "Sequence: cannot open camera path %s.\n", filename);
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    cameras->clear();
+    VkResult result = VK_SUCCESS;
+    Camera previous = *base;
+    uint32_t previousFrame = 0;
+    char line[512];
+    for (uint32_t lineNumber = 1; fgets(line, sizeof(line), file) != nullptr; ++lineNumber) {
+        char* comment = strchr(line, '#');
+        if (comment != nullptr) {
+            *comment = '\0';
+        }
+        Camera key = previous;
+        uint32_t frame;
+        int fields = sscanf(line, "%u %f %f %f %f %f %f %f", &frame,
+                            &key.lookfrom[0], &key.lookfrom[1], &key.lookfrom[2],
+                            &key.lookat[0], &key.lookat[1], &key.lookat[2], &key.vfov);
+        if (fields <= 0) {
+            continue;
+        }
+        if (fields < 7 || (!cameras->empty() && frame <= previousFrame)) {
+            fprintf(stderr, "Sequence: %s:%u: expected a later frame, lookfrom, lookat & an optional vfov.\n",
+                    filename, lineNumber);
+            result = VK_ERROR_INITIALIZATION_FAILED;
+            break;
+        }
+        // Frames before the first keyframe hold it, later ones blend from the previous keyframe.
+        for (uint32_t iter = cameras->empty() ? 0 : previousFrame + 1; iter <= frame; ++iter) {
+            float t = cameras->empty() ? 1.f : static_cast<float>(iter - previousFrame) / (frame - previousFrame);
+            cameras->push_back(interpolateCamera(&previous, &key, t));
+        }
+        previous = key;
+        previousFrame = frame;
+    }
+    fclose(file);
+    if (result == VK_SUCCESS && cameras->empty()) {
+        fprintf(stderr, "Sequence: %s has no keyframes.\n", filename);
+        result = VK_ERROR_INITIALIZATION_FAILED;
+    }
+    return result;
+}
+
+// Where the frames go: one video stream, or a numbered image per frame.
+struct SequenceOutput {
+    const char*       name;
+    FILE*             stream;   // nullptr for numbered images.
+    bool              pipe;
+    VideoStreamFormat format;
+};
+
+// "|command" pipes a stream into command, .y4m & .rgb files hold a stream, anything else is an image name.
+static VkResult openOutput(IN const char* name, OUT SequenceOutput* output)
+{
+    *output = {
+        .name = name,
+        .stream = nullptr,
+        .pipe = name[0] == '|',
+        .format = renderOptions.streamFormat
+    };
+    if (output->pipe) {
+#if defined(_WIN32)
+        output->stream = _popen(name + 1, "wb");
+#else
+        // A command that exits early fails the next write instead of killing us.
+        signal(SIGPIPE, SIG_IGN);
+        output->stream = popen(name + 1, "w");
+#endif
+    } else if (HasExtension(name, ".y4m") || HasExtension(name, ".rgb")) {
+        output->format = HasExtension(name, ".y4m") ? VIDEO_STREAM_Y4M : VIDEO_STREAM_RGB24;
+        output->stream = fopen(name, "wb");
+    } else {
+        return VK_SUCCESS;
+    }
+    if (output->stream == nullptr) {
+        return VK_ERROR_INITIALIZATION_FAILED;
+    }
+    return WriteVideoStreamHeader(output->stream, output->format, renderOptions.imageWidth,
+                                  renderOptions.imageHeight, renderOptions.framesPerSecond);
+}
+
+static VkResult closeOutput(IN SequenceOutput* output)
+{
+    if (output->stream == nullptr) {
+        return VK_SUCCESS;
+    }
+#if defined(_WIN32)
+    int status = output->pipe ? _pclose(output->stream) : fclose(output->stream);
+#else
+    int status = output->pipe ? pclose(output->stream) : fclose(output->stream);
+#endif
+    output->stream = nullptr;
+    return status == 0 ? VK_SUCCESS : VK_ERROR_UNKNOWN;
+}
+
+// Image name of a frame: printf style %d or %0Nd in the name, else the number before the extension.
+static std::string frameFileName(IN const char* pattern, IN uint32_t frame)
+{
+    char number[16];
+    std::string name(pattern);
+    const char* percent = strchr(pattern, '%');
+    if (percent != nullptr) {
+        // Only the width is taken from the pattern, the name is not a format string.
+        char* end;
+        unsigned long width = strtoul(percent + 1, &end, 10);
+        if (*end == 'd' || *end == 'u') {
+            snprintf(number, sizeof(number), "%0*u", static_cast<int>(std::min(width, 10ul)), frame);
+            return name.substr(0, percent - pattern) + number + (end + 1);
+        }
+    }
+    size_t slash = name.find_last_of("/\\");
+    size_t dot = name.rfind('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        dot = name.size();
+    }
+    snprintf(number, sizeof(number), ".%04u", frame);
+    return name.insert(dot, number);
+}
+
+struct EncodedFrame {
+    uint32_t     index;
+    const float* accumulation;  // Mapped readback buffer, released by the render thread once written.
+};
+
+// Writes acquired frames in order, on its own thread so the GPU never waits for the disk or the pipe.
+struct FrameEncoder {
+    std::mutex               mutex;
+    std::condition_variable  changed;
+    std::deque<EncodedFrame> frames;
+    uint32_t                 written = 0;
+    uint32_t                 frameCount = 0;
+    bool                     finished = false;  // No more frames coming.
+    VkResult                 result = VK_SUCCESS;
+    SequenceOutput           output;
+};
+
+static void encodeFrames(IN FrameEncoder* encoder)
+{
+    for (;;) {
+        EncodedFrame frame;
+        {
+            std::unique_lock<std::mutex> lock(encoder->mutex);
+            while (encoder->frames.empty() && !encoder->finished) {
+                encoder->changed.wait(lock);
+            }
+            if (encoder->frames.empty() || encoder->result != VK_SUCCESS) {
+                return;
+            }
+            frame = encoder->frames.front();
+            encoder->frames.pop_front();
+        }
+
+        VkResult result;
+        if (encoder->output.stream != nullptr) {
+            result = WriteVideoStreamFrame(encoder->output.stream, encoder->output.format, renderOptions.imageWidth,
+                                           renderOptions.imageHeight, frame.accumulation);
+        } else {
+            std::string filename = frameFileName(encoder->output.name, frame.index);
+            result = WriteAccumulationImage(filename.c_str(), renderOptions.imageWidth, renderOptions.imageHeight,
+                                            frame.accumulation);
+        }
+
+        std::lock_guard<std::mutex> lock(encoder->mutex);
+        encoder->written++;
+        encoder->result = result;
+        if (result != VK_SUCCESS) {
+            fprintf(stderr, "Sequence: cannot write frame %u to %s.\n", frame.index, encoder->output.name);
+        } else if (encoder->written % 16 == 0 || encoder->written == encoder->frameCount) {
+            printf("Sequence: %u/%u frames written.\n", encoder->written, encoder->frameCount);
+        }
+        encoder->changed.notify_all();
+    }
+}
+
+// Wait until count frames are written, or writing failed.
+static VkResult waitForEncoder(IN FrameEncoder* encoder, IN uint32_t count)
+{
+    std::unique_lock<std::mutex> lock(encoder->mutex);
+    while (encoder->written < count && encoder->result == VK_SUCCESS) {
+        encoder->changed.wait(lock);
+    }
+    return encoder->result;
+}
+
+// Wait for the oldest frame in flight & queue it for writing.
+static VkResult handOverFrame(IN RenderContext* context, IN FrameEncoder* encoder, IN uint32_t index)
+{
+    const float* accumulation;
+    VkResult result = AcquireSequenceFrame(context, &accumulation);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    std::lock_guard<std::mutex> lock(encoder->mutex);
+    encoder->frames.push_back({ index, accumulation });
+    encoder->changed.notify_all();
+    return VK_SUCCESS;
+}
+
+// Keep the GPU fed: frame N+1 is queued before frame N is waited for, and a readback buffer is only
+// waited for when the encoder is SEQUENCE_FRAMES_IN_FLIGHT - 1 frames behind.
+static VkResult renderFrames(IN RenderContext* context, IN const std::vector<Camera>* cameras,
+                             IN FrameEncoder* encoder)
+{
+    uint32_t frameCount = static_cast<uint32_t>(cameras->size());
+    uint32_t acquired = 0;
+    uint32_t released = 0;
+    VkResult result = VK_SUCCESS;
+    for (uint32_t frame = 0; frame < frameCount && result == VK_SUCCESS; ++frame) {
+        result = SubmitSequenceFrame(context, &(*cameras)[frame], renderOptions.samplesPerPixel);
+        while (result == VK_NOT_READY) {
+            // Every readback buffer holds a frame, reuse the oldest once it is written.
+            result = waitForEncoder(encoder, released + 1);
+            if (result == VK_SUCCESS) {
+                ReleaseSequenceFrame(context);
+                released++;
+                result = SubmitSequenceFrame(context, &(*cameras)[frame], renderOptions.samplesPerPixel);
+            }
+        }
+        if (result == VK_SUCCESS && frame + 1 - acquired >= 2) {
+            result = handOverFrame(context, encoder, acquired++);
+        }
+    }
+    while (result == VK_SUCCESS && acquired < frameCount) {
+        result = handOverFrame(context, encoder, acquired++);
+    }
+    return result == VK_SUCCESS ? waitForEncoder(encoder, frameCount) : result;
+}
+
+VkResult RunSequenceRendering(void)
+{
+    std::vector<Camera> cameras;
+    VkResult result = LoadCameraPath(renderOptions.cameraPath, &renderOptions.camera, &cameras);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    FrameEncoder encoder;
+    encoder.frameCount = static_cast<uint32_t>(cameras.size());
+    result = openOutput(renderOptions.outputFile, &encoder.output);
+    if (result != VK_SUCCESS) {
+        fprintf(stderr, "Sequence: cannot open %s.\n", renderOptions.outputFile);
+        closeOutput(&encoder.output);
+        return result;
+    }
+
+    RenderScene* scene;
+    result = LoadRenderScene(renderOptions.sceneFile, &scene);
+    if (result != VK_SUCCESS) {
+        fprintf(stderr, "Sequence: cannot load scene.\n");
+        closeOutput(&encoder.output);
+        return result;
+    }
+    RenderContext* context;
+    result = BeginSequenceRenderingOperation(scene, renderOptions.imageWidth, renderOptions.imageHeight, &context);
+    if (result != VK_SUCCESS) {
+        fprintf(stderr, "Sequence: cannot begin rendering.\n");
+        DestroyRenderScene(scene);
+        closeOutput(&encoder.output);
+        return result;
+    }
+    printf("Sequence: %u frames of %ux%u, %u spp.\n", encoder.frameCount, renderOptions.imageWidth,
+           renderOptions.imageHeight, renderOptions.samplesPerPixel);
+
+    auto begin = std::chrono::steady_clock::now();
+    std::thread thread(encodeFrames, &encoder);
+    result = renderFrames(context, &cameras, &encoder);
+    {
+        std::lock_guard<std::mutex> lock(encoder.mutex);
+        encoder.finished = true;
+        encoder.changed.notify_all();
+    }
+    // The encoder reads the readback buffers, which go away with the session.
+    thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    EndRenderingOperation(context);
+    DestroyRenderScene(scene);
+    VkResult closed = closeOutput(&encoder.output);
+    if (result == VK_SUCCESS) {
+        result = closed;
+        printf("Sequence: %u frames, %.3f s, %.2f frames/s.\n", encoder.written, seconds,
+               seconds > 0 ? encoder.written / seconds : 0.0);
+    }
+    return result;
+}
@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <Environment.hpp>
+#include <Utility.hpp>
 
 #if defined(LOAD_SHADER_FROM_MEMORY)
 #include <cstring>
@@ -21,6 +22,21 @@ static const uint32_t fragSpirv[] = {
 static const uint32_t compSpirv[] = {
 #include "shader.comp.spv"
 };
+static const uint32_t compRayQuerySpirv[] = {
+#include "shader.rayquery.comp.spv"
+};
+static const uint32_t compLinearSpirv[] = {
+#include "shader.linear.comp.spv"
+};
+static const uint32_t compPersistentSpirv[] = {
+#include "shader.persistent.comp.spv"
+};
+static const uint32_t compFloat16Spirv[] = {
+#include "shader.float16.comp.spv"
+};
+static const uint32_t cullSpirv[] = {
+#include "cull.comp.spv"
+};
 #else
 #if (defined __STDC_LIB_EXT1__ || _MSC_VER > 1400)
 #define __STDC_WANT_LIB_EXT1__  // For fopen_s
@@ -32,7 +48,7 @@ static const uint32_t compSpirv[] = {
 #endif
 
 VkResult CreateShaderStageFromFile(IN const char* filename, IN VkShaderStageFlagBits stage,
-    OUT VkPipelineShaderStageCreateInfo* shaderStageCreateInfo)
+    OUT VkPipelineShaderStageCreateInfo* shaderStageCreateInfo, OUT uint64_t* codeHash)
 {
 
     VkResult result;
@@ -49,6 +65,21 @@ VkResult CreateShaderStageFromFile(IN const char* filename, IN VkShaderStageFlag
     } else if (strcmp(filename, "shader.comp.spv") == 0) {
         codeSize = sizeof(compSpirv);
         spirv = &compSpirv[0];
+    } else if (strcmp(filename, "shader.rayquery.comp.spv") == 0) {
+        codeSize = sizeof(compRayQuerySpirv);
+        spirv = &compRayQuerySpirv[0];
+    } else if (strcmp(filename, "shader.linear.comp.spv") == 0) {
+        codeSize = sizeof(compLinearSpirv);
+        spirv = &compLinearSpirv[0];
+    } else if (strcmp(filename, "shader.persistent.comp.spv") == 0) {
+        codeSize = sizeof(compPersistentSpirv);
+        spirv = &compPersistentSpirv[0];
+    } else if (strcmp(filename, "shader.float16.comp.spv") == 0) {
+        codeSize = sizeof(compFloat16Spirv);
+        spirv = &compFloat16Spirv[0];
+    } else if (strcmp(filename, "cull.comp.spv") == 0) {
+        codeSize = sizeof(cullSpirv);
+        spirv = &cullSpirv[0];
     }
     VkShaderModuleCreateInfo createInfo {
         .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
@@ -77,6 +108,9 @@ VkResult CreateShaderStageFromFile(IN const char* filename, IN VkShaderStageFlag
     };
 #endif
 
+    if (codeHash != nullptr) {
+        *codeHash = HashBytes(FNV_OFFSET_BASIS, createInfo.pCode, createInfo.codeSize);
+    }
     VkShaderModule shaderModule;
     result = vkCreateShaderModule(vulkanLogicalDevice, &createInfo, nullptr, &shaderModule);
     if (result != VK_SUCCESS) {
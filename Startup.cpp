@@ -0,0 +1,183 @@
+/* @file Startup.cpp
+
+    Implementation of the startup graph.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <Startup.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Taken during static initialization, close enough to process start.
+static const Clock::time_point processStart = Clock::now();
+
+static double millisecondsSinceStart(void)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - processStart).count();
+}
+
+enum StepState {
+    STEP_WAITING,
+    STEP_RUNNING,
+    STEP_DONE,
+    STEP_FAILED,
+    STEP_SKIPPED                    // Not run, an earlier step failed.
+};
+
+struct StepInfo {
+    const char*                    name;
+    uint32_t                       flags;
+    std::function<VkResult(void)>  function;
+    std::vector<StartupStep>       dependencies;
+    StepState                      state;
+    VkResult                       result;
+    double                         begin;   // Milliseconds since process start.
+    double                         end;
+};
+
+struct StartupGraph {
+    std::vector<StepInfo>   steps;
+    std::mutex              mutex;
+    std::condition_variable changed;
+    size_t                  finished;       // Done, failed or skipped.
+    VkResult                result;
+};
+
+StartupGraph* CreateStartupGraph(void)
+{
+    StartupGraph* graph = new StartupGraph{};
+    graph->result = VK_SUCCESS;
+    return graph;
+}
+
+StartupStep AddStartupStep(IN StartupGraph* graph, IN const char* name, IN uint32_t flags,
+                           IN std::function<VkResult(void)> function,
+                           IN std::initializer_list<StartupStep> dependencies)
+{
+    StepInfo step = {
+        .name = name,
+        .flags = flags,
+        .function = std::move(function),
+        .dependencies = dependencies,
+        .state = STEP_WAITING,
+        .result = VK_SUCCESS,
+        .begin = 0.0,
+        .end = 0.0
+    };
+    for (StartupStep dependency : dependencies) {
+        assert(dependency < graph->steps.size());
+        (void)dependency;
+    }
+    graph->steps.push_back(std::move(step));
+    return static_cast<StartupStep>(graph->steps.size() - 1);
+}
+
+// First waiting step of this kind of thread whose dependencies are done, UINT32_MAX if none. Mutex held.
+static StartupStep nextReadyStep(IN StartupGraph* graph, IN bool mainThread)
+{
+    for (size_t iter = 0; iter < graph->steps.size(); ++iter) {
+        const StepInfo& step = graph->steps[iter];
+        if (step.state != STEP_WAITING || ((step.flags & STARTUP_STEP_MAIN_THREAD) != 0) != mainThread) {
+            continue;
+        }
+        bool ready = std::all_of(step.dependencies.begin(), step.dependencies.end(), [graph](StartupStep dependency) {
+            return graph->steps[dependency].state == STEP_DONE;
+        });
+        if (ready) {
+            return static_cast<StartupStep>(iter);
+        }
+    }
+    return UINT32_MAX;
+}
+
+// Run ready steps of one kind of thread until every step has finished.
+static void runSteps(IN StartupGraph* graph, IN bool mainThread)
+{
+    std::unique_lock<std::mutex> lock(graph->mutex);
+    for (;;) {
+        StartupStep ready;
+        while ((ready = nextReadyStep(graph, mainThread)) == UINT32_MAX && graph->finished < graph->steps.size()) {
+            graph->changed.wait(lock);
+        }
+        if (ready == UINT32_MAX) {
+            return;
+        }
+        StepInfo& step = graph->steps[ready];
+        step.state = STEP_RUNNING;
+        step.begin = millisecondsSinceStart();
+        lock.unlock();
+        VkResult result = step.function();
+        lock.lock();
+        step.end = millisecondsSinceStart();
+        step.result = result;
+        step.state = result == VK_SUCCESS ? STEP_DONE : STEP_FAILED;
+        ++graph->finished;
+        if (result != VK_SUCCESS && graph->result == VK_SUCCESS) {
+            // Nothing new starts, running steps finish.
+            graph->result = result;
+            for (StepInfo& waiting : graph->steps) {
+                if (waiting.state == STEP_WAITING) {
+                    waiting.state = STEP_SKIPPED;
+                    ++graph->finished;
+                }
+            }
+        }
+        graph->changed.notify_all();
+    }
+}
+
+VkResult RunStartupGraph(IN StartupGraph* graph)
+{
+    uint32_t poolSteps = static_cast<uint32_t>(std::count_if(graph->steps.begin(), graph->steps.end(),
+        [](const StepInfo& step) { return (step.flags & STARTUP_STEP_MAIN_THREAD) == 0; }));
+    // Steps mostly wait on the driver or the disk, overlap a few even on a single core.
+    uint32_t threadCount = std::min(std::max(std::thread::hardware_concurrency(), 2u), poolSteps);
+    std::vector<std::thread> pool;
+    for (uint32_t iter = 0; iter < threadCount; ++iter) {
+        pool.emplace_back(runSteps, graph, false);
+    }
+    runSteps(graph, true);
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+
+    for (const StepInfo& step : graph->steps) {
+        const char* thread = (step.flags & STARTUP_STEP_MAIN_THREAD) != 0 ? "main" : "pool";
+        if (step.state == STEP_SKIPPED) {
+            printf("Startup: %-22s skipped.\n", step.name);
+        } else if (step.state == STEP_FAILED) {
+            printf("Startup: %-22s %9.2f ms .. %9.2f ms on %s, failed (%d).\n", step.name, step.begin, step.end,
+                   thread, step.result);
+        } else {
+            printf("Startup: %-22s %9.2f ms .. %9.2f ms on %s (%.2f ms).\n", step.name, step.begin, step.end,
+                   thread, step.end - step.begin);
+        }
+    }
+    if (graph->result == VK_SUCCESS) {
+        printf("Startup: ready after %.2f ms.\n", millisecondsSinceStart());
+    }
+    return graph->result;
+}
+
+void DestroyStartupGraph(IN StartupGraph* graph)
+{
+    delete graph;
+}
+
+void ReportFirstFrame(void)
+{
+    static std::atomic<bool> reported;
+    if (!reported.exchange(true)) {
+        printf("Startup: first frame presented after %.2f ms.\n", millisecondsSinceStart());
+    }
+}
@@ -0,0 +1,53 @@
+/* @file Utility.cpp
+
+    Implementation of the shared helpers.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#include <Utility.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <system_error>
+
+uint64_t HashBytes(IN uint64_t hash, IN const void* data, IN size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t iter = 0; iter < size; ++iter) {
+        hash = (hash ^ bytes[iter]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+bool HasExtension(IN const char* filename, IN const char* extension)
+{
+    size_t length = strlen(filename);
+    size_t extensionLength = strlen(extension);
+    return length >= extensionLength && strcmp(filename + length - extensionLength, extension) == 0;
+}
+
+bool WriteFileAtomic(IN const std::filesystem::path& path, IN const FileChunk* chunks, IN uint32_t chunkCount)
+{
+    std::filesystem::path temporary = path;
+    temporary += "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".tmp";
+    FILE* file = fopen(temporary.string().c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool written = true;
+    for (uint32_t iter = 0; iter < chunkCount && written; ++iter) {
+        written = fwrite(chunks[iter].data, 1, chunks[iter].size, file) == chunks[iter].size;
+    }
+    written = fclose(file) == 0 && written;
+    std::error_code error;
+    if (written) {
+        std::filesystem::rename(temporary, path, error);
+        written = !error;
+    }
+    if (!written) {
+        std::filesystem::remove(temporary, error);
+    }
+    return written;
+}
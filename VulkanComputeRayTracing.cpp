@@ -14,29 +14,277 @@ using std::endl;
 const char16_t* applicationName = u"Vulkan Compute Raytracing";
 const char*     applicationNameNarrow = "Vulkan Compute Raytracing";
 
-int main()
+// The window is created on the main thread, which later runs its event loop. Scene upload & the compute
+// pipeline proceed meanwhile, the presentation pipeline waits for both the session & the swapchain.
+static int runWindow(void)
 {
-    cout << "Hello Vulkan." << endl;
-    if (CreateVulkanRuntimeEnvironment() != VK_SUCCESS) {
+    RenderScene* scene = nullptr;
+    RenderContext* context = nullptr;
+    StartupGraph* graph = CreateStartupGraph();
+    StartupStep instance = AddStartupStep(graph, "instance", 0, []() {
+        return CreateVulkanRuntimeEnvironment(false);
+    });
+    StartupStep window = AddStartupStep(graph, "window", STARTUP_STEP_MAIN_THREAD, CreateVulkanWindowSurface,
+                                        { instance });
+    StartupStep device = AddStartupStep(graph, "device", 0, CreateVulkanWindowDevice, { instance });
+    StartupStep swapchain = AddStartupStep(graph, "swapchain", 0, CreateVulkanWindowFrontend, { window, device });
+    StartupStep sceneUpload = AddStartupStep(graph, "scene", 0, [&scene]() {
+        return LoadRenderScene(renderOptions.sceneFile, &scene);
+    }, { device });
+    StartupStep compute = AddStartupStep(graph, "compute pipeline", 0, [&scene, &context]() {
+        return BeginRenderingOperation(scene, &context);
+    }, { sceneUpload });
+    AddStartupStep(graph, "presentation pipeline", 0, [&context]() {
+        return AttachRenderPresentation(context);
+    }, { compute, swapchain });
+    VkResult result = RunStartupGraph(graph);
+    DestroyStartupGraph(graph);
+    if (result != VK_SUCCESS) {
+        cerr << "Cannot start rendering." << endl;
+        return -1;
+    }
+    PlatformEnterEventLoop(context);
+    if (renderOptions.costCounters) {
+        RenderStatistics statistics;
+        bool queried = GetRenderStatistics(context, &statistics) == VK_SUCCESS;
+        PrintRenderStatistics(&statistics, queried, 0);
+    }
+    EndRenderingOperation(context);
+    DestroyRenderScene(scene);
+    DestroyVulkanWindowFrontend();
+    DestroyVulkanRuntimeEnvironment();
+    return 0;
+}
+
+static int runWorker(void)
+{
+    if (CreateVulkanRuntimeEnvironment(true) != VK_SUCCESS) {
         cerr << "Cannot create Vulkan runtime environment." << endl;
         return -1;
     }
-    if (CreateVulkanWindowEnvironment() != VK_SUCCESS) {
-        cerr << "Cannot create Vulkan window environment." << endl;
+    if (CreateVulkanHeadlessEnvironment() != VK_SUCCESS) {
+        cerr << "Cannot create Vulkan headless environment." << endl;
         return -1;
     }
-    if (CreateVulkanWindowFrontend() != VK_SUCCESS) {
-        cerr << "Cannot create Vulkan window frontend." << endl;
+    VkResult result = RunRenderWorker(renderOptions.listenPort);
+    DestroyVulkanRuntimeEnvironment();
+    return result == VK_SUCCESS ? 0 : -1;
+}
+
+static int runSequence(void)
+{
+    if (CreateVulkanRuntimeEnvironment(true) != VK_SUCCESS) {
+        cerr << "Cannot create Vulkan runtime environment." << endl;
         return -1;
     }
-    if (BeginRenderingOperation() != VK_SUCCESS) {
-        cerr << "Cannot begin rendering operation." << endl;
+    if (CreateVulkanHeadlessEnvironment() != VK_SUCCESS) {
+        cerr << "Cannot create Vulkan headless environment." << endl;
         return -1;
     }
-    PlatformEnterEventLoop();
-    EndRenderingOperation();
-    DestroyVulkanWindowFrontend();
+    VkResult result = RunSequenceRendering();
+    DestroyVulkanRuntimeEnvironment();
+    return result == VK_SUCCESS ? 0 : -1;
+}
+
+static int runPoster(void)
+{
+    if (CreateVulkanRuntimeEnvironment(true) != VK_SUCCESS) {
+        cerr << "Cannot create Vulkan runtime environment." << endl;
+        return -1;
+    }
+    if (CreateVulkanHeadlessEnvironment() != VK_SUCCESS) {
+        cerr << "Cannot create Vulkan headless environment." << endl;
+        return -1;
+    }
+    VkResult result = RunPosterRendering();
+    DestroyVulkanRuntimeEnvironment();
+    return result == VK_SUCCESS ? 0 : -1;
+}
+
+static int runDaemon(void)
+{
+    if (CreateVulkanRuntimeEnvironment(true) != VK_SUCCESS) {
+        cerr << "Cannot create Vulkan runtime environment." << endl;
+        return -1;
+    }
+    if (CreateVulkanHeadlessEnvironment() != VK_SUCCESS) {
+        cerr << "Cannot create Vulkan headless environment." << endl;
+        return -1;
+    }
+    VkResult result = RunRenderDaemon(renderOptions.daemonSocket);
     DestroyVulkanRuntimeEnvironment();
+    return result == VK_SUCCESS ? 0 : -1;
+}
+
+// Render the whole offline image at the current shading precision into image (RGB sums + sample count).
+// costs & statistics of a counting session, if not null.
+static VkResult renderOfflineImage(IN RenderScene* scene, OUT float* image, OUT uint32_t* costs = nullptr,
+                                   OUT RenderStatistics* statistics = nullptr, OUT bool* queried = nullptr)
+{
+    uint32_t width = renderOptions.imageWidth;
+    uint32_t height = renderOptions.imageHeight;
+    uint32_t tileSize = renderOptions.tileSize;
+    RenderContext* context;
+    VkResult result = BeginOffscreenRenderingOperation(scene, std::min(tileSize, width), std::min(tileSize, height),
+                                                       &context);
+    if (result != VK_SUCCESS) {
+        return result;
+    }
+    result = RenderOffscreenImage(context, &renderOptions.camera, width, height, renderOptions.samplesPerPixel,
+                                  renderOptions.samplesPerTile, image, costs);
+    if (statistics != nullptr) {
+        *queried = GetRenderStatistics(context, statistics) == VK_SUCCESS;
+    }
+    EndRenderingOperation(context);
+    return result;
+}
+
+// Same samples (seeds) at fp32 & fp16 shading, so what differs is the precision, not the noise.
+static int runPrecisionComparison(void)
+{
+    // The fp16 variant only exists for the compute BVH, which the device is then created for.
+    renderOptions.traversal = TRAVERSAL_COMPUTE;
+    renderOptions.persistentWorkgroups = 0;
+    if (CreateVulkanRuntimeEnvironment(true) != VK_SUCCESS) {
+        cerr << "Cannot create Vulkan runtime environment." << endl;
+        return -1;
+    }
+    if (CreateVulkanHeadlessEnvironment() != VK_SUCCESS) {
+        cerr << "Cannot create Vulkan headless environment." << endl;
+        return -1;
+    }
+    if (!vulkanFloat16Enabled) {
+        cerr << "Device has no shaderFloat16, nothing to compare." << endl;
+        DestroyVulkanRuntimeEnvironment();
+        return -1;
+    }
+    RenderScene* scene;
+    if (LoadRenderScene(renderOptions.sceneFile, &scene) != VK_SUCCESS) {
+        cerr << "Cannot load scene." << endl;
+        DestroyVulkanRuntimeEnvironment();
+        return -1;
+    }
+    size_t pixelCount = static_cast<size_t>(renderOptions.imageWidth) * renderOptions.imageHeight;
+    std::vector<float> reference(pixelCount * 4);
+    std::vector<float> half(pixelCount * 4);
+    renderOptions.shadingPrecision = SHADING_PRECISION_FP32;
+    VkResult result = renderOfflineImage(scene, reference.data());
+    if (result == VK_SUCCESS) {
+        renderOptions.shadingPrecision = SHADING_PRECISION_FP16;
+        result = renderOfflineImage(scene, half.data());
+    }
+    DestroyRenderScene(scene);
+    DestroyVulkanRuntimeEnvironment();
+    if (result != VK_SUCCESS) {
+        cerr << "Cannot render." << endl;
+        return -1;
+    }
+
+    // Averaged colours, clamped to what the display shows.
+    double sum[2][3] = {};
+    double squaredError = 0.0;
+    double maxError = 0.0;
+    for (size_t pixel = 0; pixel < pixelCount; ++pixel) {
+        const float* a = &reference[pixel * 4];
+        const float* b = &half[pixel * 4];
+        for (int channel = 0; channel < 3; ++channel) {
+            double colourA = a[3] > 0.0f ? std::min(std::max(a[channel] / a[3], 0.0f), 1.0f) : 0.0;
+            double colourB = b[3] > 0.0f ? std::min(std::max(b[channel] / b[3], 0.0f), 1.0f) : 0.0;
+            sum[0][channel] += colourA;
+            sum[1][channel] += colourB;
+            squaredError += (colourA - colourB) * (colourA - colourB);
+            maxError = std::max(maxError, std::abs(colourA - colourB));
+        }
+    }
+    double rmse = std::sqrt(squaredError / (pixelCount * 3));
+    printf("Precision: fp32 mean %.5f %.5f %.5f, fp16 mean %.5f %.5f %.5f.\n",
+           sum[0][0] / pixelCount, sum[0][1] / pixelCount, sum[0][2] / pixelCount,
+           sum[1][0] / pixelCount, sum[1][1] / pixelCount, sum[1][2] / pixelCount);
+    printf("Precision: RMSE %.6f, max %.6f, PSNR %.2f dB.\n", rmse, maxError,
+           rmse > 0.0 ? 20.0 * std::log10(1.0 / rmse) : INFINITY);
+    return WriteAccumulationImage(renderOptions.outputFile, renderOptions.imageWidth, renderOptions.imageHeight,
+                                  half.data()) == VK_SUCCESS ? 0 : -1;
+}
+
+// Offline render counting costs: histograms, pipeline statistics & a heatmap of one counter as the output image.
+static int runCostReport(void)
+{
+    if (CreateVulkanRuntimeEnvironment(true) != VK_SUCCESS) {
+        cerr << "Cannot create Vulkan runtime environment." << endl;
+        return -1;
+    }
+    if (CreateVulkanHeadlessEnvironment() != VK_SUCCESS) {
+        cerr << "Cannot create Vulkan headless environment." << endl;
+        return -1;
+    }
+    RenderScene* scene;
+    if (LoadRenderScene(renderOptions.sceneFile, &scene) != VK_SUCCESS) {
+        cerr << "Cannot load scene." << endl;
+        DestroyVulkanRuntimeEnvironment();
+        return -1;
+    }
+    uint32_t width = renderOptions.imageWidth;
+    uint32_t height = renderOptions.imageHeight;
+    size_t pixelCount = static_cast<size_t>(width) * height;
+    std::vector<float> image(pixelCount * 4);
+    std::vector<uint32_t> costs(pixelCount * COST_COUNTER_COUNT);
+    RenderStatistics statistics;
+    bool queried;
+    VkResult result = renderOfflineImage(scene, image.data(), costs.data(), &statistics, &queried);
+    DestroyRenderScene(scene);
+    DestroyVulkanRuntimeEnvironment();
+    if (result != VK_SUCCESS) {
+        cerr << "Cannot render." << endl;
+        return -1;
+    }
+
+    PrintCostHistograms(width, height, image.data(), costs.data());
+    PrintRenderStatistics(&statistics, queried, static_cast<uint64_t>(pixelCount) * renderOptions.samplesPerPixel);
+    CostCounter counter = renderOptions.costOverlay != COST_OVERLAY_NONE ?
+                          static_cast<CostCounter>(renderOptions.costOverlay - 1) : COST_SPHERE_TESTS;
+    std::vector<float> heatmap(pixelCount * 4);
+    BuildCostHeatmap(width, height, image.data(), costs.data(), counter, heatmap.data());
+    return WriteAccumulationImage(renderOptions.outputFile, width, height, heatmap.data()) == VK_SUCCESS ? 0 : -1;
+}
+
+int main(int argc, char** argv)
+{
+    if (!ParseCommandLine(argc, argv)) {
+        return -1;
+    }
+    cout << "Hello Vulkan." << endl;
+    int result;
+    switch (renderOptions.mode) {
+        case RENDER_MODE_WORKER:
+            result = runWorker();
+            break;
+        case RENDER_MODE_COORDINATOR:
+            // Coordinator only merges results, it does not need a GPU.
+            result = RunRenderCoordinator() == VK_SUCCESS ? 0 : -1;
+            break;
+        case RENDER_MODE_COMPARE_PRECISION:
+            result = runPrecisionComparison();
+            break;
+        case RENDER_MODE_SEQUENCE:
+            result = runSequence();
+            break;
+        case RENDER_MODE_DAEMON:
+            result = runDaemon();
+            break;
+        case RENDER_MODE_COST_REPORT:
+            result = runCostReport();
+            break;
+        case RENDER_MODE_POSTER:
+            result = runPoster();
+            break;
+        case RENDER_MODE_SUBMIT:
+            // The daemon owns the device, submitting needs no GPU.
+            result = SubmitRenderJob(renderOptions.daemonSocket) == VK_SUCCESS ? 0 : -1;
+            break;
+        default:
+            result = runWindow();
+            break;
+    }
     cout << "Bye Vulkan." << endl;
-    return 0;
+    return result;
 }
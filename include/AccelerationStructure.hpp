@@ -0,0 +1,32 @@
+/* @file AccelerationStructure.hpp
+
+    Hardware acceleration structures of the scene, traversed by ray queries.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef ACCELERATION_STRUCTURE_HPP
+#define ACCELERATION_STRUCTURE_HPP
+
+#include <Common.hpp>
+#include <SceneFile.hpp>
+
+// BLASes & TLAS of one scene.
+struct SceneAccelerationStructures;
+
+// Build one BLAS of sphere AABBs per geometry & a TLAS over instances. Needs vulkanRayQueryEnabled.
+// Instance custom indices hold the first sphere of the geometry, so scenes are limited to 2^24 spheres.
+VkResult BuildSceneAccelerationStructures(IN const SceneView* view, IN const SceneInstance* instances,
+                                          IN uint32_t instanceCount, OUT SceneAccelerationStructures** structures);
+
+// Rebuild the TLAS only, after instances moved. The instance count must stay the same.
+VkResult UpdateSceneAccelerationStructureInstances(IN SceneAccelerationStructures* structures,
+                                                   IN const SceneInstance* instances, IN uint32_t instanceCount);
+
+// TLAS to bind, VK_NULL_HANDLE if structures is nullptr.
+VkAccelerationStructureKHR GetSceneAccelerationStructure(IN const SceneAccelerationStructures* structures);
+
+// Destroy the structures, nullptr is ignored.
+void DestroySceneAccelerationStructures(IN SceneAccelerationStructures* structures);
+
+#endif
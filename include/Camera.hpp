@@ -0,0 +1,37 @@
+/* @file Camera.hpp
+
+    Camera description & conversion to shader-side parameters.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef CAMERA_HPP
+#define CAMERA_HPP
+
+#include <Common.hpp>
+
+struct Camera {
+    float lookfrom[3];  // Point camera is looking from
+    float lookat[3];    // Point camera is looking at
+    float vup[3];       // Camera-relative "up" direction
+    float vfov;         // Vertical field of view in degrees
+};
+
+// Camera basis consumed by shader.comp, vec4-aligned for std430.
+struct CameraBasis {
+    float center[4];
+    float pixel00[4];
+    float pixelDeltaU[4];
+    float pixelDeltaV[4];
+};
+
+extern const Camera defaultCamera;
+
+// Calculate viewport & pixel deltas of a imageWidth x imageHeight image.
+void ComputeCameraBasis(IN const Camera* camera, IN uint32_t imageWidth, IN uint32_t imageHeight,
+                        OUT CameraBasis* basis);
+
+// Turn lookfrom yawDegrees around lookat about vup & scale its distance to lookat by distanceScale.
+void OrbitCamera(IN OUT Camera* camera, IN float yawDegrees, IN float distanceScale);
+
+#endif
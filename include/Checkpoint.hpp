@@ -0,0 +1,51 @@
+/* @file Checkpoint.hpp
+
+    Checkpoints of long offline renders: the accumulation so far & which work items it holds, so a
+    render interrupted by a crash or preemption continues where it was instead of starting over.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <Common.hpp>
+#include <Options.hpp>
+#include <vector>
+
+constexpr uint32_t CHECKPOINT_MAGIC = 0x4B524356; // "VCRK"
+constexpr uint32_t CHECKPOINT_VERSION = 1;
+
+// File: header, one byte per work item (1 if done) & 4 floats per pixel, native endianness & float format.
+struct CheckpointHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key;
+    uint32_t imageWidth;
+    uint32_t imageHeight;
+    uint32_t workCount;
+    uint32_t doneCount;
+};
+
+// The samples of a work item follow from its tile & sample range, so done flags are all of the sampler state.
+struct Checkpoint {
+    uint64_t             key;           // HashCheckpointKey of the render.
+    uint32_t             imageWidth;
+    uint32_t             imageHeight;
+    uint32_t             doneCount;
+    std::vector<uint8_t> done;
+    std::vector<float>   accumulation;  // RGB sums & sample count per pixel.
+};
+
+// Everything deciding which samples the work items hold: scene file image, camera, image size & work split.
+uint64_t HashCheckpointKey(IN const void* scene, IN size_t sceneSize, IN const RenderOptions* options);
+
+// Written aside & renamed over filename, a crash while writing keeps the previous checkpoint.
+VkResult WriteCheckpoint(IN const char* filename, IN const Checkpoint* checkpoint);
+
+// Read the checkpoint of the render with key, image size & work count. Checkpoints of another render, corrupt or
+// truncated files are rejected with VK_ERROR_FORMAT_NOT_SUPPORTED before anything is allocated for them.
+VkResult ReadCheckpoint(IN const char* filename, IN uint64_t key, IN uint32_t imageWidth, IN uint32_t imageHeight,
+                        IN uint32_t workCount, OUT Checkpoint* checkpoint);
+
+#endif
@@ -23,6 +23,7 @@
 constexpr auto WINDOW_WIDTH = 1280;
 constexpr auto WINDOW_HEIGHT = 720;
 constexpr auto RENDER_ITERATION = 100;
+constexpr auto SAMPLES_PER_FRAME = 1;
 
 extern const char16_t *applicationName;
 extern const char     *applicationNameNarrow;
@@ -0,0 +1,27 @@
+/* @file CostReport.hpp
+
+    Where the frame time goes: histograms & false colour heatmaps of the per pixel cost counters,
+    plus the pipeline statistics of a counting session.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef COST_REPORT_HPP
+#define COST_REPORT_HPP
+
+#include <Common.hpp>
+#include <Renderer.hpp>
+
+// Print a log2 histogram, mean & percentiles of each counter per sample of a pixel.
+// image: RGB sums & sample count (4 floats per pixel), costs: COST_COUNTER_COUNT sums per pixel.
+void PrintCostHistograms(IN uint32_t width, IN uint32_t height, IN const float* image, IN const uint32_t* costs);
+
+// Print the totals of a session. pixelSamples: samples rendered in all, 0 if unknown.
+void PrintRenderStatistics(IN const RenderStatistics* statistics, IN bool queried, IN uint64_t pixelSamples);
+
+// False colour of counter per pixel, same ramp & scale as the window overlay, as an accumulation image
+// (4 floats per pixel) for WriteAccumulationImage.
+void BuildCostHeatmap(IN uint32_t width, IN uint32_t height, IN const float* image, IN const uint32_t* costs,
+                      IN CostCounter counter, OUT float* heatmap);
+
+#endif
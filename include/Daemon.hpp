@@ -0,0 +1,63 @@
+/* @file Daemon.hpp
+
+    Render daemon: keeps the device, loaded scenes & their pipelines resident and renders jobs sent
+    over a local socket, highest priority first.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef DAEMON_HPP
+#define DAEMON_HPP
+
+#include <Common.hpp>
+#include <Camera.hpp>
+
+constexpr uint32_t DAEMON_MAGIC = 0x4A524356; // "VCRJ"
+
+// Client -> daemon: header, DaemonJob & scenePathSize bytes of path.
+// Daemon -> client: header, DaemonResult & 4 floats per pixel unless they are in shared memory.
+// Client -> daemon: header only, once it read the pixels from shared memory.
+// A connection may send any number of jobs, each is answered before the next one is read.
+enum DaemonMessageType {
+    DAEMON_MESSAGE_JOB = 1,
+    DAEMON_MESSAGE_RESULT,
+    DAEMON_MESSAGE_RESULT_READ
+};
+
+struct DaemonMessageHeader {
+    uint32_t magic;
+    uint32_t type;
+    uint64_t payloadSize;
+};
+
+enum DaemonJobFlags {
+    DAEMON_JOB_SHARED_MEMORY = 1    // Leave the pixels in a shared memory object, unlinked after the client read it.
+};
+
+struct DaemonJob {
+    uint32_t imageWidth;
+    uint32_t imageHeight;
+    uint32_t samplesPerPixel;
+    int32_t  priority;          // Higher first, in order of arrival among equals.
+    Camera   camera;
+    uint32_t flags;             // DaemonJobFlags.
+    uint32_t scenePathSize;     // .vcrtscene path following the job, 0 for the built-in scene.
+};
+
+struct DaemonResult {
+    int32_t  status;            // VkResult of the job.
+    uint32_t imageWidth;
+    uint32_t imageHeight;
+    uint32_t sceneResident;     // Scene & pipelines were loaded by an earlier job.
+    uint64_t queuedMicroseconds;
+    uint64_t renderMicroseconds;
+    char     sharedMemoryName[64]; // POSIX shared memory object holding the pixels, empty if they follow.
+};
+
+// Serve jobs on the local socket at socketPath until the process is killed. Needs a headless environment.
+VkResult RunRenderDaemon(IN const char* socketPath);
+
+// Send the job described by renderOptions to the daemon at socketPath & write the output image.
+VkResult SubmitRenderJob(IN const char* socketPath);
+
+#endif
@@ -0,0 +1,54 @@
+/* @file Distributed.hpp
+
+    Distributed tile rendering: a coordinator hands out work to worker nodes over TCP.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef DISTRIBUTED_HPP
+#define DISTRIBUTED_HPP
+
+#include <Common.hpp>
+#include <Camera.hpp>
+#include <Renderer.hpp>
+
+// Wire format: every message is a header followed by payloadSize bytes.
+// Both sides are expected to share endianness & float format.
+constexpr uint32_t DISTRIBUTED_MAGIC = 0x54524356; // "VCRT"
+
+enum DistributedMessageType {
+    DISTRIBUTED_MESSAGE_SETUP = 1,      // Coordinator -> worker, DistributedSetup + scene file image.
+    DISTRIBUTED_MESSAGE_TILE_REQUEST,   // Coordinator -> worker, DistributedTileHeader.
+    DISTRIBUTED_MESSAGE_TILE_RESULT,    // Worker -> coordinator, DistributedTileHeader + 4 floats per pixel.
+    DISTRIBUTED_MESSAGE_BYE,            // Coordinator -> worker, no payload.
+    DISTRIBUTED_MESSAGE_PROGRESS        // Worker -> coordinator, no payload: still rendering the requested tile.
+};
+
+struct DistributedMessageHeader {
+    uint32_t magic;
+    uint32_t type;
+    uint64_t payloadSize;
+};
+
+// Sent once per connection.
+struct DistributedSetup {
+    uint32_t imageWidth;
+    uint32_t imageHeight;
+    uint32_t maxTileWidth;
+    uint32_t maxTileHeight;
+    Camera   camera;
+    uint64_t sceneSize;     // Bytes of .vcrtscene following, 0 for the built-in scene.
+};
+
+struct DistributedTileHeader {
+    uint32_t   workId;
+    RenderTile tile;
+};
+
+// Serve coordinators on port until the process is killed. Needs a headless environment.
+VkResult RunRenderWorker(IN uint16_t port);
+
+// Render the frame described by renderOptions on renderOptions.workers & write the output image.
+VkResult RunRenderCoordinator(void);
+
+#endif
@@ -18,12 +18,49 @@ extern uint32_t vulkanGraphicsQueueFamilyIndex;
 extern uint32_t vulkanComputeQueueFamilyIndex;
 extern VkQueue vulkanGraphicsQueue;
 extern VkQueue vulkanComputeQueue;
+// Core API both the instance & the device were created for, e.g. VK_API_VERSION_1_1.
+extern uint32_t vulkanApiVersion;
+// Device created with VK_KHR_acceleration_structure & VK_KHR_ray_query.
+extern bool vulkanRayQueryEnabled;
+// Compute shaders may use subgroup ballots (Vulkan 1.1).
+extern bool vulkanSubgroupBallotSupported;
+// Device created with shaderFloat16 (VK_KHR_shader_float16_int8, core in 1.2) whenever it has it.
+extern bool vulkanFloat16Enabled;
+// Device created with pipelineStatisticsQuery, only requested when counting costs.
+extern bool vulkanPipelineStatisticsEnabled;
+// Nanoseconds per timestamp tick & valid bits of timestamps on the compute queue, 0 bits if it has none.
+extern float vulkanTimestampPeriod;
+extern uint32_t vulkanTimestampValidBits;
 
-// Create vulkan runtime environment.
-VkResult CreateVulkanRuntimeEnvironment(void);
+// Create vulkan runtime environment, without window system extensions if headless.
+VkResult CreateVulkanRuntimeEnvironment(IN bool headless);
 
-// Create vulkan window environment.
-VkResult CreateVulkanWindowEnvironment(void);
+// Create vulkan device with swapchain support. Independent of the window, both may be created at once.
+VkResult CreateVulkanWindowDevice(void);
+
+// Create window & its surface, on the thread that later runs the event loop.
+VkResult CreateVulkanWindowSurface(void);
+
+// Create vulkan device without window & swapchain, for offscreen rendering.
+VkResult CreateVulkanHeadlessEnvironment(void);
+
+// Index of a memory type allowed by typeFilter with all properties, UINT32_MAX if none.
+uint32_t FindMemoryType(IN uint32_t typeFilter, IN VkMemoryPropertyFlags properties);
+
+// Create a buffer with its own bound memory.
+VkResult CreateBuffer(IN VkDeviceSize size, IN VkBufferUsageFlags usage, IN VkMemoryPropertyFlags properties,
+                      OUT VkBuffer* buffer, OUT VkDeviceMemory* memory);
+
+// Queue access for render sessions on any thread, these serialize the host side of the shared queues.
+VkResult SubmitVulkanQueue(IN VkQueue queue, IN uint32_t submitCount, IN const VkSubmitInfo* submits,
+                           IN VkFence fence);
+
+VkResult PresentVulkanQueue(IN VkQueue queue, IN const VkPresentInfoKHR* presentInfo);
+
+// Submit one batch & wait for just that batch, for one-off uploads & builds.
+VkResult SubmitVulkanQueueAndWait(IN VkQueue queue, IN const VkSubmitInfo* submit);
+
+VkResult WaitVulkanDeviceIdle(void);
 
 // Clean up vulkan runtime environment.
 VkResult DestroyVulkanRuntimeEnvironment(void);
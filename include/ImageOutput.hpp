@@ -0,0 +1,51 @@
+/* @file ImageOutput.hpp
+
+    Write rendered images to disk.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef IMAGE_OUTPUT_HPP
+#define IMAGE_OUTPUT_HPP
+
+#include <Common.hpp>
+#include <cstdio>
+
+// Write an accumulation buffer (RGB sums + sample count per pixel, 4 floats each).
+// The format is chosen by extension: .pfm keeps linear floats, anything else is 8-bit sRGB PPM.
+VkResult WriteAccumulationImage(IN const char* filename, IN uint32_t width, IN uint32_t height,
+                                IN const float* accumulation);
+
+// Uncompressed video, frames appended one after the other to a file or pipe.
+enum VideoStreamFormat {
+    VIDEO_STREAM_Y4M,       // YUV4MPEG2 4:4:4 (BT.601), what ffmpeg reads from a pipe without further options.
+    VIDEO_STREAM_RGB24      // Raw 8-bit sRGB, needs -f rawvideo -pix_fmt rgb24 -video_size WxH -framerate FPS.
+};
+
+// Header of the stream, nothing for raw frames.
+VkResult WriteVideoStreamHeader(IN FILE* stream, IN VideoStreamFormat format, IN uint32_t width, IN uint32_t height,
+                                IN uint32_t framesPerSecond);
+
+// Append an accumulation buffer (as for WriteAccumulationImage) as the next frame.
+VkResult WriteVideoStreamFrame(IN FILE* stream, IN VideoStreamFormat format, IN uint32_t width, IN uint32_t height,
+                               IN const float* accumulation);
+
+// Tiled TIFF of 8-bit sRGB RGB for images too large to hold: tiles are written in any order as they complete,
+// only their offsets stay in memory. BigTIFF once the file could pass 4 GiB.
+struct TiledImageWriter;
+
+// TIFF tiles are a multiple of this many pixels wide & high.
+constexpr uint32_t TIFF_TILE_ALIGNMENT = 16;
+
+VkResult BeginTiledImage(IN const char* filename, IN uint32_t width, IN uint32_t height, IN uint32_t tileSize,
+                         OUT TiledImageWriter** writer);
+
+// Write the tile at x, y (multiples of tileSize) from an accumulation buffer of width x height pixels,
+// smaller than tileSize at the right & bottom edge of the image.
+VkResult WriteImageTile(IN TiledImageWriter* writer, IN uint32_t x, IN uint32_t y, IN uint32_t width,
+                        IN uint32_t height, IN const float* accumulation);
+
+// Write the directory & close the file. writer is freed either way, tiles never written read as black.
+VkResult EndTiledImage(IN TiledImageWriter* writer);
+
+#endif
@@ -0,0 +1,51 @@
+/* @file Network.hpp
+
+    Minimal blocking TCP & local (UNIX domain) socket wrappers for distributed rendering & the daemon.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef NETWORK_HPP
+#define NETWORK_HPP
+
+#include <Common.hpp>
+#include <cstddef>
+
+#if defined(_WIN32)
+typedef uintptr_t NetSocket;    // SOCKET
+constexpr NetSocket INVALID_NET_SOCKET = ~static_cast<uintptr_t>(0);
+#else
+typedef int NetSocket;
+constexpr NetSocket INVALID_NET_SOCKET = -1;
+#endif
+
+// Initialize & clean up the socket library (WSAStartup on Win32).
+bool NetInitialize(void);
+void NetCleanup(void);
+
+// Listen on all interfaces.
+NetSocket NetListen(IN uint16_t port);
+
+// Wait for an incoming connection.
+NetSocket NetAccept(IN NetSocket listener);
+
+// Connect to host:port.
+NetSocket NetConnect(IN const char* host, IN uint16_t port);
+
+// Listen on a UNIX domain socket at path, replacing a stale one nobody listens on.
+// Fails with pathInUse set if path is anything else, e.g. a file or the socket of a running daemon.
+NetSocket NetListenLocal(IN const char* path, OUT bool* pathInUse = nullptr);
+
+// Connect to the UNIX domain socket at path.
+NetSocket NetConnectLocal(IN const char* path);
+
+// Fail blocking receives after timeoutSeconds, 0 to wait forever.
+bool NetSetReceiveTimeout(IN NetSocket socket, IN uint32_t timeoutSeconds);
+
+// Send or receive exactly size bytes, false on error, timeout or closed connection.
+bool NetSendAll(IN NetSocket socket, IN const void* data, IN size_t size);
+bool NetReceiveAll(IN NetSocket socket, OUT void* data, IN size_t size);
+
+void NetClose(IN NetSocket socket);
+
+#endif
@@ -0,0 +1,130 @@
+/* @file Options.hpp
+
+    Command line options of the application.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef OPTIONS_HPP
+#define OPTIONS_HPP
+
+#include <Common.hpp>
+#include <Camera.hpp>
+#include <ImageOutput.hpp>
+
+enum RenderMode {
+    RENDER_MODE_WINDOW,         // Interactive, progressive rendering into a window.
+    RENDER_MODE_WORKER,         // Render tiles requested by a coordinator.
+    RENDER_MODE_COORDINATOR,    // Distribute a frame over workers & merge the results.
+    RENDER_MODE_COMPARE_PRECISION, // Render offline with fp32 & fp16 shading, report how far apart they are.
+    RENDER_MODE_SEQUENCE,       // Render the frames of a camera path offline & write each as it completes.
+    RENDER_MODE_DAEMON,         // Keep the device & scenes resident, render jobs sent over a local socket.
+    RENDER_MODE_SUBMIT,         // Send one offline render to a daemon & write the image it returns.
+    RENDER_MODE_COST_REPORT,    // Render offline with cost counters, print histograms & write a heatmap.
+    RENDER_MODE_POSTER          // Render offline tile by tile into a tiled file, for images larger than memory.
+};
+
+enum TraversalMode {
+    TRAVERSAL_AUTO,             // Hardware ray queries where supported, the compute BVH otherwise.
+    TRAVERSAL_COMPUTE,          // Always walk the BVH in the compute shader.
+    TRAVERSAL_RAY_QUERY,        // Require hardware ray queries.
+    TRAVERSAL_LINEAR            // Test every sphere, staged through workgroup shared memory.
+};
+
+enum PixelOrder {
+    PIXEL_ORDER_ROWS,           // Invocation (x, y) renders pixel (x, y).
+    PIXEL_ORDER_MORTON,         // Z-order inside each 16x16 workgroup.
+    PIXEL_ORDER_STRIPS          // Z-order, workgroups walk the image in column strips.
+};
+
+// Image the window presents, the accumulation itself always stays fp32.
+enum DisplayFormat {
+    DISPLAY_FORMAT_RGBA32F,     // Sample the accumulation image directly.
+    DISPLAY_FORMAT_RGBA16F,     // The compute shader also writes the averaged colour at half the size.
+    DISPLAY_FORMAT_B10G11R11    // Same, packed unsigned floats at a quarter of the size.
+};
+
+// Arithmetic of the shading math (attenuation, Schlick, scatter directions), intersection is always fp32.
+enum ShadingPrecision {
+    SHADING_PRECISION_FP32,
+    SHADING_PRECISION_FP16      // Compute BVH only, where the device has shaderFloat16.
+};
+
+// When the window draws its next frame.
+enum FramePacing {
+    FRAME_PACING_COMPOSITOR,    // Once the compositor can use it (Wayland frame callbacks, mapped X windows).
+    FRAME_PACING_THROUGHPUT     // As fast as possible, events are only taken between frames.
+};
+
+// How many samples each window frame renders.
+enum SampleControl {
+    SAMPLE_CONTROL_FIXED,           // SAMPLES_PER_FRAME, compiled into the shader.
+    SAMPLE_CONTROL_FRAME_TIME,      // As many as fit frameBudget of GPU time, measured with timestamps.
+    SAMPLE_CONTROL_THROUGHPUT       // As many as raise samples per second, frames stay responsive.
+};
+
+// GPU time per window frame the samples are fitted to by default, leaves room below a 60 Hz refresh.
+constexpr float DEFAULT_FRAME_BUDGET_MS = 12.f;
+
+// Samples per pixel after which an unchanged window image counts as converged & the window stops rendering.
+constexpr uint32_t DEFAULT_WINDOW_SAMPLES = 4096;
+
+// Seconds between checkpoints of a distributed render.
+constexpr uint32_t DEFAULT_CHECKPOINT_INTERVAL = 300;
+
+// Cost counter shown as false colour by the window & written by --cost-report, CostCounter + 1.
+enum CostOverlay {
+    COST_OVERLAY_NONE,
+    COST_OVERLAY_BOUNCES,
+    COST_OVERLAY_SPHERE_TESTS,
+    COST_OVERLAY_NODES,
+    COST_OVERLAY_CAPPED_PATHS
+};
+
+// Resident workgroups of 256 lanes for --persistent-threads on, enough to fill current desktop GPUs.
+constexpr uint32_t DEFAULT_PERSISTENT_WORKGROUPS = 256;
+
+struct RenderOptions {
+    RenderMode  mode = RENDER_MODE_WINDOW;
+    uint32_t    imageWidth = WINDOW_WIDTH;
+    uint32_t    imageHeight = WINDOW_HEIGHT;
+    uint32_t    samplesPerPixel = RENDER_ITERATION;
+    uint32_t    tileSize = 64;
+    uint32_t    samplesPerTile = 16;
+    uint16_t    listenPort = 0;
+    const char* workers = nullptr;      // Comma separated host:port list.
+    const char* outputFile = "output.ppm";
+    const char* sceneFile = nullptr;    // .vcrtscene, built-in scene if nullptr.
+    TraversalMode traversal = TRAVERSAL_AUTO;
+    const char* pipelineCacheDirectory = nullptr; // Specialized pipelines, per-user cache if nullptr.
+    uint32_t    firstHitStrata = 0;     // Cached primary hits per pixel in the window, 0 disables.
+    bool        tileCulling = false;    // Primary rays only test spheres projected onto their tile.
+    uint32_t    persistentWorkgroups = 0; // Workgroups of the persistent threads kernel, 0 disables.
+    PixelOrder  pixelOrder = PIXEL_ORDER_ROWS;
+    bool        rayBinning = false;     // Sort bounce rays of a workgroup by direction & origin.
+    DisplayFormat displayFormat = DISPLAY_FORMAT_RGBA16F;
+    FramePacing framePacing = FRAME_PACING_COMPOSITOR;
+    SampleControl sampleControl = SAMPLE_CONTROL_FRAME_TIME;
+    float       frameBudget = DEFAULT_FRAME_BUDGET_MS; // Milliseconds, SAMPLE_CONTROL_FRAME_TIME.
+    uint32_t    windowSamples = DEFAULT_WINDOW_SAMPLES; // Convergence target of the window, 0 never stops.
+    ShadingPrecision shadingPrecision = SHADING_PRECISION_FP32;
+    Camera      camera = defaultCamera;
+    const char* cameraPath = nullptr;   // Keyframes of a sequence, see Sequence.hpp.
+    uint32_t    framesPerSecond = 30;   // Written into video streams.
+    VideoStreamFormat streamFormat = VIDEO_STREAM_Y4M; // Of frames piped to a command.
+    const char* daemonSocket = nullptr; // Local socket path of the daemon to serve or submit to.
+    int32_t     jobPriority = 0;        // Of a submitted job, higher renders first.
+    bool        sharedMemoryResult = false; // Receive the image through shared memory instead of the socket.
+    bool        costCounters = false;   // Shader counts per pixel costs, sessions query pipeline statistics.
+    CostOverlay costOverlay = COST_OVERLAY_NONE;
+    const char* checkpointFile = nullptr; // Coordinator progress, written every checkpointInterval seconds.
+    uint32_t    checkpointInterval = DEFAULT_CHECKPOINT_INTERVAL;
+    bool        resume = false;         // Continue from checkpointFile.
+};
+
+extern RenderOptions renderOptions;
+
+// Fill renderOptions from command line, print usage on failure.
+bool ParseCommandLine(IN int argc, IN char** argv);
+
+#endif
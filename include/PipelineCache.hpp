@@ -0,0 +1,19 @@
+/* @file PipelineCache.hpp
+
+    Compute pipelines cached on disk, one file per shader variant & device.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef PIPELINE_CACHE_HPP
+#define PIPELINE_CACHE_HPP
+
+#include <Common.hpp>
+
+// Create the pipeline through a VkPipelineCache stored under renderOptions.pipelineCacheDirectory.
+// The file is keyed on codeHash, the specialization constants of the stage & the device/driver,
+// so a variant is compiled by the driver once & loaded from disk afterwards.
+VkResult CreateCachedComputePipeline(IN const VkComputePipelineCreateInfo* createInfo, IN uint64_t codeHash,
+                                     OUT VkPipeline* pipeline);
+
+#endif
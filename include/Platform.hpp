@@ -18,7 +18,7 @@ extern const uint32_t platformExtensionCount;
 // Create platform-specific window.
 VkResult PlatformCreateWindow(OUT VkSurfaceKHR *surface);
 
-// Enter platform-specific event loop.
-void PlatformEnterEventLoop(void);
+// Enter platform-specific event loop, drawing the frames of the window's render session.
+void PlatformEnterEventLoop(IN RenderContext* context);
 
 #endif
@@ -0,0 +1,19 @@
+/* @file Poster.hpp
+
+    Out-of-core rendering of images too large for the device or host memory: tile after tile, each one
+    with all its samples & streamed to a tiled image file as it completes.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef POSTER_HPP
+#define POSTER_HPP
+
+#include <Common.hpp>
+
+// Render renderOptions.imageWidth x imageHeight in tiles of renderOptions.tileSize (a multiple of
+// TIFF_TILE_ALIGNMENT) into the tiled TIFF renderOptions.outputFile. Device & host memory only hold one tile.
+// Needs a headless environment.
+VkResult RunPosterRendering(void);
+
+#endif
@@ -0,0 +1,53 @@
+/* @file RenderThread.hpp
+
+    Render thread of the window: draws the frames of its session while the platform thread only handles
+    window system events & posts what they change through a lock-free single producer single consumer queue.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef RENDER_THREAD_HPP
+#define RENDER_THREAD_HPP
+
+#include <Common.hpp>
+#include <Camera.hpp>
+#include <Renderer.hpp>
+
+enum RenderEventType {
+    RENDER_EVENT_CAMERA,                // Look through camera, restarts accumulation.
+    RENDER_EVENT_INSTANCE_TRANSFORM,    // Move scene instance to objectToWorld.
+    RENDER_EVENT_VISIBILITY,            // Whether the window can be seen at all, hidden windows draw nothing.
+    RENDER_EVENT_FRAME_WANTED,          // The compositor can take the next frame, see RENDER_THREAD_FRAME_CALLBACKS.
+    RENDER_EVENT_EXPOSE,                // The window system lost the shown image, present it again even if converged.
+    RENDER_EVENT_QUIT
+};
+
+struct RenderEvent {
+    RenderEventType type;
+    uint32_t        instance;
+    bool            visible;
+    Camera          camera;
+    float           objectToWorld[12];
+};
+
+enum RenderThreadFlags {
+    RENDER_THREAD_FRAME_CALLBACKS = 1   // Draw one frame per RENDER_EVENT_FRAME_WANTED, else as fast as possible.
+};
+
+// Events posted but not taken yet, a full queue makes the platform thread wait.
+constexpr uint32_t RENDER_EVENT_QUEUE_SIZE = 256;
+
+struct RenderThread;
+
+// Start drawing the frames of the window session context. beginFrame, if not null, runs on the render thread
+// before each frame, e.g. to request a frame callback its present commits.
+// Once the session converged (IsRenderConverged) the thread sleeps until an event changes something.
+RenderThread* StartRenderThread(IN RenderContext* context, IN uint32_t flags, IN void (*beginFrame)(void));
+
+// Queue event for the next frame boundary. Only one thread may post to a render thread.
+void PostRenderEvent(IN RenderThread* thread, IN const RenderEvent* event);
+
+// Post RENDER_EVENT_QUIT, wait for the frame being drawn & the thread to end.
+void StopRenderThread(IN RenderThread* thread);
+
+#endif
@@ -9,14 +9,113 @@
 #define RENDERER_HPP
 
 #include <Common.hpp>
+#include <Camera.hpp>
+#include <Scene.hpp>
 
-// Create pipeline, submit tasks...
-VkResult BeginRenderingOperation(void);
+// Push constants of shader.comp, must match RenderParameters in globals.glsl.
+struct RenderPushConstants {
+    CameraBasis camera;
+    int32_t     tileOffset[2];  // Offset of the dispatch inside the full image.
+    uint32_t    tileSize[2];    // Extent of the dispatch.
+    uint32_t    sampleBase;     // Index of the first sample, seeds the random sequence.
+    uint32_t    sampleCount;    // Samples per pixel of the dispatch.
+    uint32_t    flags;
+    uint32_t    imageWidth;     // Full image, sizes the culling tile grid.
+    uint32_t    imageHeight;
+};
+
+enum RenderFlagBits {
+    RENDER_FLAG_ACCUMULATE = 0x1    // Add to the result image instead of overwriting it.
+};
+
+// Per pixel cost counters summed over its samples with --cost-report/--cost-overlay, see COST_COUNTERS
+// in globals.glsl. One uint32_t each per pixel, in this order.
+enum CostCounter {
+    COST_BOUNCES,           // Path segments that hit something & were shaded.
+    COST_SPHERE_TESTS,      // Ray-sphere intersection tests.
+    COST_NODES,             // BVH & TLAS nodes visited by the compute traversal, ray queries hide theirs.
+    COST_CAPPED_PATHS,      // Paths cut at the bounce limit.
+    COST_COUNTER_COUNT
+};
+
+// Totals of a counting session since it began.
+struct RenderStatistics {
+    uint64_t submissions;           // Frames or tiles submitted.
+    uint64_t computeInvocations;    // Of the path tracing dispatches, pipeline statistics query.
+};
+
+// A rectangle of the final image & a range of its samples.
+struct RenderTile {
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+    uint32_t sampleBase;
+    uint32_t sampleCount;
+};
+
+// A render session: pipelines, images, descriptors & per-frame resources drawing one scene into one target.
+// Sessions share the device & its queues, any number may exist at once, each used by one thread at a time.
+// The scene must outlive its sessions & stay unchanged while any of them renders.
+struct RenderContext;
+
+// Create compute pipeline & window sized images of the window session, needs no swapchain yet.
+VkResult BeginRenderingOperation(IN RenderScene* scene, OUT RenderContext** context);
+
+// Create the graphics pipeline presenting the window session, once the window frontend exists.
+// Only one window session, it owns the swapchain framebuffers.
+VkResult AttachRenderPresentation(IN RenderContext* context);
+
+// Create compute pipeline only, rendering tiles up to maxTileWidth x maxTileHeight offscreen.
+VkResult BeginOffscreenRenderingOperation(IN RenderScene* scene, IN uint32_t maxTileWidth, IN uint32_t maxTileHeight,
+                                          OUT RenderContext** context);
+
+// Scene the session was begun with.
+RenderScene* GetRenderContextScene(IN const RenderContext* context);
+
+// Use camera for following frames/tiles of a imageWidth x imageHeight image, restarts accumulation.
+void SetRenderCamera(IN RenderContext* context, IN const Camera* camera, IN uint32_t imageWidth,
+                     IN uint32_t imageHeight);
+
+// Render a tile & read back RGB sums and sample count (4 floats per pixel, tile->width per row).
+VkResult RenderOffscreenTile(IN RenderContext* context, IN const RenderTile* tile, OUT float* accumulation);
+
+// Render a whole imageWidth x imageHeight image in tiles of the session's size, samplesPerTile samples each,
+// & accumulate RGB sums and sample count (4 floats per pixel) into image.
+// costs: COST_COUNTER_COUNT sums per pixel, only if the session counts costs (renderOptions.costCounters).
+VkResult RenderOffscreenImage(IN RenderContext* context, IN const Camera* camera, IN uint32_t imageWidth,
+                              IN uint32_t imageHeight, IN uint32_t samplesPerPixel, IN uint32_t samplesPerTile,
+                              OUT float* image, OUT uint32_t* costs = nullptr);
+
+// Whole frames of a sequence in flight: the GPU renders the next ones while the host reads back older ones.
+constexpr uint32_t SEQUENCE_FRAMES_IN_FLIGHT = 3;
+
+// Create compute pipeline plus a readback buffer per frame in flight, for imageWidth x imageHeight frames.
+VkResult BeginSequenceRenderingOperation(IN RenderScene* scene, IN uint32_t imageWidth, IN uint32_t imageHeight,
+                                         OUT RenderContext** context);
+
+// Queue a frame of samplesPerPixel seen from camera & its copy to a free readback buffer, without waiting.
+// VK_NOT_READY while all SEQUENCE_FRAMES_IN_FLIGHT buffers hold frames, release the oldest first.
+VkResult SubmitSequenceFrame(IN RenderContext* context, IN const Camera* camera, IN uint32_t samplesPerPixel);
+
+// Wait for the oldest frame not acquired yet, VK_NOT_READY if there is none. Its RGB sums & sample count
+// (4 floats per pixel) may be read on any thread until released, frames are released in acquisition order.
+VkResult AcquireSequenceFrame(IN RenderContext* context, OUT const float** accumulation);
+
+void ReleaseSequenceFrame(IN RenderContext* context);
 
 // Draw next frame, to be called by platform handlers.
-VkResult DrawNextFrame(void);
+VkResult DrawNextFrame(IN RenderContext* context);
+
+// Whether the window session holds renderOptions.windowSamples per pixel of its current camera & scene.
+// DrawNextFrame then only presents the finished image again, until either changes.
+bool IsRenderConverged(IN const RenderContext* context);
+
+// Statistics of a counting session so far. VK_ERROR_FEATURE_NOT_PRESENT without pipeline statistics, submissions
+// are still counted.
+VkResult GetRenderStatistics(IN RenderContext* context, OUT RenderStatistics* statistics);
 
-// End rendering & destroy allocated environments.
-VkResult EndRenderingOperation(void);
+// End rendering & destroy the session, nullptr is ignored.
+VkResult EndRenderingOperation(IN RenderContext* context);
 
-#endif
\ No newline at end of file
+#endif
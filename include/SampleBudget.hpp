@@ -0,0 +1,35 @@
+/* @file SampleBudget.hpp
+
+    Samples per window frame fitted to the GPU time measured for earlier frames, so the same binary
+    renders one sample a frame on a CPU rasterizer & hundreds on a fast GPU.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef SAMPLE_BUDGET_HPP
+#define SAMPLE_BUDGET_HPP
+
+#include <Common.hpp>
+#include <Options.hpp>
+
+// Upper bound of samples in one window frame.
+constexpr uint32_t MAX_SAMPLES_PER_FRAME = 256;
+// Frames of SAMPLE_CONTROL_THROUGHPUT stay below this, the window must keep reacting.
+constexpr float THROUGHPUT_FRAME_LIMIT_MS = 100.f;
+
+struct SampleBudget {
+    SampleControl control;
+    float         target;               // Milliseconds, SAMPLE_CONTROL_FRAME_TIME.
+    uint32_t      samples;              // Of the next frame.
+    float         sampleMilliseconds;   // Smoothed GPU time per sample, 0 until measured.
+    uint32_t      bestSamples;          // Throughput search: highest samples per millisecond so far.
+    float         bestRate;
+    bool          searching;            // Still doubling the samples while the rate improves.
+};
+
+void InitSampleBudget(OUT SampleBudget* budget, IN SampleControl control, IN float targetMilliseconds);
+
+// Account a frame of samples that took milliseconds of GPU time. True if budget->samples changed.
+bool UpdateSampleBudget(IN OUT SampleBudget* budget, IN uint32_t samples, IN float milliseconds);
+
+#endif
@@ -0,0 +1,72 @@
+/* @file Scene.hpp
+
+    Device copy of the scene rendered by the compute shader.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef SCENE_HPP
+#define SCENE_HPP
+
+#include <Common.hpp>
+#include <cstddef>
+
+// Storage buffers of the scene, bound after the result image (bindings 2, 3, ...).
+enum SceneBuffer {
+    SCENE_BUFFER_SPHERES,           // Center & radius only, what intersection reads.
+    SCENE_BUFFER_MATERIALS,
+    SCENE_BUFFER_BVH_NODES,
+    SCENE_BUFFER_BVH_INDICES,
+    SCENE_BUFFER_SPHERE_MATERIALS,  // Material ID per sphere, RenderSceneTraits::materialIdBits wide.
+    SCENE_BUFFER_INSTANCES,         // Top level, host visible & rewritten when instances move.
+    SCENE_BUFFER_TLAS_NODES,
+    SCENE_BUFFER_COUNT
+};
+constexpr uint32_t SCENE_BUFFER_FIRST_BINDING = 2;
+// TLAS, only bound when the scene is traversed by ray queries.
+constexpr uint32_t SCENE_ACCELERATION_STRUCTURE_BINDING = SCENE_BUFFER_FIRST_BINDING + SCENE_BUFFER_COUNT;
+
+// Device copy of one scene, any number may be loaded at once & shared by render sessions.
+struct RenderScene;
+
+// Load a .vcrtscene file, or the built-in scene if filename is nullptr.
+// A missing BVH is built & written back into the file.
+VkResult LoadRenderScene(IN const char* filename, OUT RenderScene** scene);
+
+// Load a scene file image received from elsewhere, the built-in scene if size is 0.
+VkResult LoadRenderSceneFromMemory(IN const void* data, IN size_t size, OUT RenderScene** scene);
+
+// Descriptor ranges of the scene, SCENE_BUFFER_COUNT entries.
+void GetRenderSceneBuffers(IN const RenderScene* scene, OUT VkDescriptorBufferInfo* bufferInfos);
+
+// TLAS to bind, VK_NULL_HANDLE if the scene is traversed by the compute shader.
+VkAccelerationStructureKHR GetRenderSceneAccelerationStructure(IN const RenderScene* scene);
+
+uint32_t GetRenderSceneInstanceCount(IN const RenderScene* scene);
+
+// Move an instance (row-major affine 3x4), only the top level BVH is rebuilt.
+// No session may be using the scene, e.g. call between frames after waiting for them.
+VkResult SetRenderSceneInstanceTransform(IN RenderScene* scene, IN uint32_t instance,
+                                         IN const float objectToWorld[12]);
+
+// What the compute shader is specialized on, fixed while the scene is loaded.
+struct RenderSceneTraits {
+    uint32_t materialTypes;     // Bit (1 << SCENE_MATERIAL_*) per material type in the scene.
+    uint32_t bvhDepth;          // Deepest geometry BVH, bounds its traversal stack.
+    uint32_t tlasDepth;         // Bound of the top level depth, holds whatever instances move.
+    uint32_t maxSphereCount;    // Spheres of the largest geometry.
+    uint32_t materialIdBits;    // 16 or 32.
+};
+
+void GetRenderSceneTraits(IN const RenderScene* scene, OUT RenderSceneTraits* traits);
+
+// Changes whenever the device copy does, e.g. an instance moved.
+uint64_t GetRenderSceneVersion(IN const RenderScene* scene);
+
+// Content hash of the scene.
+uint64_t GetRenderSceneHash(IN const RenderScene* scene);
+
+// Destroy the scene, nullptr is ignored.
+void DestroyRenderScene(IN RenderScene* scene);
+
+#endif
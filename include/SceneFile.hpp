@@ -0,0 +1,93 @@
+/* @file SceneFile.hpp
+
+    Reading, writing & BVH building of .vcrtscene files. Does not touch the device.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef SCENE_FILE_HPP
+#define SCENE_FILE_HPP
+
+#include <Common.hpp>
+#include <SceneFormat.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+// Sections of a scene, pointing into a mapping or memory owned by someone else.
+struct SceneView {
+    uint64_t             contentHash;
+    const SceneSphere*   spheres;
+    uint64_t             sphereCount;
+    const SceneMaterial* materials;
+    uint64_t             materialCount;
+    const SceneBvhNode*  bvhNodes;      // nullptr if the file has no (up-to-date) BVH.
+    uint64_t             bvhNodeCount;
+    const uint32_t*      bvhIndices;
+    const SceneGeometry* geometries;    // nullptr if the file has none, all spheres form one geometry.
+    uint64_t             geometryCount;
+    const SceneInstance* instances;     // nullptr if the file has none, each geometry is placed once.
+    uint64_t             instanceCount;
+};
+
+struct MappedSceneFile {
+    const uint8_t* data;
+    size_t         size;
+#if defined(_WIN32)
+    void*          fileHandle;
+    void*          mappingHandle;
+#endif
+};
+
+// Map a scene file read-only.
+VkResult MapSceneFile(IN const char* filename, OUT MappedSceneFile* file);
+void UnmapSceneFile(IN MappedSceneFile* file);
+
+// Validate header & section bounds of a file image, no data is copied.
+VkResult ParseSceneFile(IN const void* data, IN size_t size, OUT SceneView* view);
+
+// FNV-1a of sphere, material & geometry records, as stored in the header.
+uint64_t HashSceneContent(IN const SceneSphere* spheres, IN uint64_t sphereCount,
+                          IN const SceneMaterial* materials, IN uint64_t materialCount,
+                          IN const SceneGeometry* geometries, IN uint64_t geometryCount);
+
+// Build one BVH per geometry (a single one if geometries is nullptr), at most SCENE_BVH_MAX_DEPTH deep.
+// The roots come first, followed by the remaining nodes of all geometries.
+void BuildSceneBvh(IN const SceneSphere* spheres, IN uint64_t sphereCount,
+                   IN const SceneGeometry* geometries, IN uint64_t geometryCount,
+                   OUT std::vector<SceneBvhNode>* nodes, OUT std::vector<uint32_t>* indices);
+
+// Build the top level BVH over instances, bounded by the transformed roots of their geometries.
+// Leaves cover instance indices [leftOrFirst, leftOrFirst + count).
+void BuildInstanceBvh(IN const SceneInstance* instances, IN uint64_t instanceCount, IN const SceneBvhNode* bvhNodes,
+                      OUT std::vector<SceneBvhNode>* nodes, OUT std::vector<uint32_t>* indices);
+
+// Inverse of an affine row-major 3x4 transform, false if it is singular.
+bool InvertSceneTransform(IN const float transform[12], OUT float inverse[12]);
+
+// Streamed writer: sections are written one after another, the header last.
+struct SceneFileWriter {
+    FILE*           file;
+    SceneFileHeader header;
+    uint64_t        hash;
+    uint64_t        position;
+    SceneSection*   currentSection;
+};
+
+VkResult BeginSceneFile(IN const char* filename, OUT SceneFileWriter* writer);
+VkResult BeginSceneSection(IN SceneFileWriter* writer, IN SceneSectionType type, IN uint32_t elementSize);
+VkResult WriteSceneSectionData(IN SceneFileWriter* writer, IN const void* elements, IN uint64_t count);
+// Write the header, BVH sections written along are marked as built for this content.
+VkResult EndSceneFile(IN SceneFileWriter* writer);
+
+// Write BVH sections after the existing ones, so the next launch does not rebuild it.
+VkResult AppendSceneBvh(IN const char* filename, IN const SceneView* view,
+                        IN const std::vector<SceneBvhNode>* nodes, IN const std::vector<uint32_t>* indices);
+
+// Book scene of Ray Tracing in One Weekend, used without a scene file.
+extern const SceneSphere   builtinSceneSpheres[];
+extern const uint32_t      builtinSceneSphereCount;
+extern const SceneMaterial builtinSceneMaterials[];
+extern const uint32_t      builtinSceneMaterialCount;
+
+#endif
@@ -0,0 +1,100 @@
+/* @file SceneFormat.hpp
+
+    On-disk layout of .vcrtscene files, shared by the renderer & SceneGenerator.
+    BVH records are laid out exactly as the std430 buffers in globals.glsl & are copied
+    to the GPU as they are, spheres & materials are repacked on upload (see Scene.cpp).
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef SCENE_FORMAT_HPP
+#define SCENE_FORMAT_HPP
+
+#include <cstdint>
+
+constexpr uint32_t SCENE_FILE_MAGIC = 0x53524356;   // "VCRS"
+constexpr uint32_t SCENE_FILE_VERSION = 1;
+constexpr uint32_t SCENE_MAX_SECTIONS = 8;
+// Section payloads start at this alignment, covers minStorageBufferOffsetAlignment of all devices.
+constexpr uint64_t SCENE_SECTION_ALIGNMENT = 256;
+// Deepest BVH a scene may contain, the traversal stack in the shader has this size.
+constexpr uint32_t SCENE_BVH_MAX_DEPTH = 32;
+
+enum SceneSectionType {
+    SCENE_SECTION_SPHERES = 1,      // SceneSphere[count]
+    SCENE_SECTION_MATERIALS,        // SceneMaterial[count]
+    SCENE_SECTION_BVH_NODES,        // SceneBvhNode[count], the root of geometry N is node N.
+    SCENE_SECTION_BVH_INDICES,      // uint32_t[sphere count], sphere indices in leaf order.
+    SCENE_SECTION_GEOMETRIES,       // SceneGeometry[count], optional: all spheres form geometry 0.
+    SCENE_SECTION_INSTANCES         // SceneInstance[count], optional: one identity instance per geometry.
+};
+
+enum SceneMaterialType {
+    SCENE_MATERIAL_LAMBERTIAN = 1,  // Same values as TEXTURE_* in textures.glsl.
+    SCENE_MATERIAL_METAL = 2,
+    SCENE_MATERIAL_GLASS = 3
+};
+
+struct SceneSection {
+    uint32_t type;
+    uint32_t elementSize;
+    uint64_t count;
+    uint64_t offset;                // From the beginning of file, SCENE_SECTION_ALIGNMENT aligned.
+};
+
+struct SceneFileHeader {
+    uint32_t     magic;
+    uint32_t     version;
+    uint32_t     sectionCount;
+    uint32_t     reserved;
+    uint64_t     contentHash;       // FNV-1a of sphere, material & geometry sections.
+    uint64_t     bvhContentHash;    // contentHash the BVH sections were built for.
+    SceneSection sections[SCENE_MAX_SECTIONS];
+    uint8_t      padding[32];
+};
+static_assert(sizeof(SceneFileHeader) == SCENE_SECTION_ALIGNMENT, "Header occupies the first aligned block");
+
+struct SceneSphere {
+    float    center[3];
+    float    radius;
+    uint32_t material;
+    uint32_t padding[3];
+};
+static_assert(sizeof(SceneSphere) == 32, "Part of the file format");
+
+struct SceneMaterial {
+    float    albedo[3];
+    uint32_t type;                  // SceneMaterialType
+    float    parameter;             // Reflect ratio in diffuse, fuzziness in metal, eta in glass.
+    float    padding[3];
+};
+static_assert(sizeof(SceneMaterial) == 32, "Part of the file format");
+
+// Interior nodes (count == 0) have children leftOrFirst & leftOrFirst + 1,
+// leaves cover BVH indices [leftOrFirst, leftOrFirst + count).
+struct SceneBvhNode {
+    float    boundsMin[3];
+    uint32_t leftOrFirst;
+    float    boundsMax[3];
+    uint32_t count;
+};
+static_assert(sizeof(SceneBvhNode) == 32, "Must match bvh_node in globals.glsl");
+
+// Bottom level: a run of spheres sharing one BVH, geometries partition the sphere section in order.
+struct SceneGeometry {
+    uint32_t firstSphere;
+    uint32_t sphereCount;
+    uint32_t padding[2];
+};
+static_assert(sizeof(SceneGeometry) == 16, "Records are multiples of 8 bytes");
+
+// Top level: a geometry placed in the world. The transform is affine, row-major 3x4.
+// Instances are not part of contentHash, moving them keeps the BVH valid.
+struct SceneInstance {
+    float    objectToWorld[12];
+    uint32_t geometry;
+    uint32_t padding[3];
+};
+static_assert(sizeof(SceneInstance) == 64, "Records are multiples of 8 bytes");
+
+#endif
@@ -0,0 +1,25 @@
+/* @file Sequence.hpp
+
+    Offline rendering of image sequences (animations, turntables) along a camera path.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef SEQUENCE_HPP
+#define SEQUENCE_HPP
+
+#include <Common.hpp>
+#include <Camera.hpp>
+#include <vector>
+
+// Cameras of every frame of a camera path file, one keyframe per line:
+//     FRAME  LOOKFROM_X LOOKFROM_Y LOOKFROM_Z  LOOKAT_X LOOKAT_Y LOOKAT_Z  [VFOV]
+// Keyframes ascend, frames in between are interpolated linearly & '#' starts a comment.
+// base supplies vup, and the field of view until a keyframe sets one.
+VkResult LoadCameraPath(IN const char* filename, IN const Camera* base, OUT std::vector<Camera>* cameras);
+
+// Render every frame of renderOptions.cameraPath & write it to renderOptions.outputFile, as numbered images
+// or one video stream (file or "|command" pipe). Needs a headless environment.
+VkResult RunSequenceRendering(void);
+
+#endif
@@ -10,8 +10,9 @@
 
 #include <Common.hpp>
 
-// Load & bind.
+// Load & bind. codeHash, if given, receives a hash of the SPIR-V to key pipeline caches on.
 VkResult CreateShaderStageFromFile (IN const char* filename, IN VkShaderStageFlagBits stage, 
-                                    OUT VkPipelineShaderStageCreateInfo* shaderStageCreateInfo);
+                                    OUT VkPipelineShaderStageCreateInfo* shaderStageCreateInfo,
+                                    OUT uint64_t* codeHash = nullptr);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,39 @@
+/* @file Startup.hpp
+
+    Startup as a small dependency graph: each step runs on a thread pool as soon as the steps it depends on
+    are done, so window creation, device creation & pipeline compilation overlap.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef STARTUP_HPP
+#define STARTUP_HPP
+
+#include <Common.hpp>
+#include <functional>
+#include <initializer_list>
+
+typedef uint32_t StartupStep;
+
+enum StartupStepFlags {
+    STARTUP_STEP_MAIN_THREAD = 1    // Run on the thread calling RunStartupGraph, e.g. window creation.
+};
+
+struct StartupGraph;
+
+StartupGraph* CreateStartupGraph(void);
+
+// Add a step running function once all of dependencies succeeded. Steps only depend on earlier ones.
+StartupStep AddStartupStep(IN StartupGraph* graph, IN const char* name, IN uint32_t flags,
+                           IN std::function<VkResult(void)> function,
+                           IN std::initializer_list<StartupStep> dependencies = {});
+
+// Run every step & print when each ran. Stops scheduling at the first failure, which is returned.
+VkResult RunStartupGraph(IN StartupGraph* graph);
+
+void DestroyStartupGraph(IN StartupGraph* graph);
+
+// Print the time from process start to the first presented frame, once.
+void ReportFirstFrame(void);
+
+#endif
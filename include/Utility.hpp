@@ -0,0 +1,32 @@
+/* @file Utility.hpp
+
+    Helpers shared by the on-disk caches & files of the renderer.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+#ifndef UTILITY_HPP
+#define UTILITY_HPP
+
+#include <Common.hpp>
+#include <filesystem>
+
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+// FNV-1a over size bytes, continued from hash. Start with FNV_OFFSET_BASIS.
+uint64_t HashBytes(IN uint64_t hash, IN const void* data, IN size_t size);
+
+// True if filename ends with extension, e.g. ".pfm". Case-sensitive.
+bool HasExtension(IN const char* filename, IN const char* extension);
+
+struct FileChunk {
+    const void* data;
+    size_t      size;
+};
+
+// Write the chunks one after another to a unique file beside path & rename it over path, so readers
+// never see a partial file, even from another process or after a crash mid-write.
+bool WriteFileAtomic(IN const std::filesystem::path& path, IN const FileChunk* chunks, IN uint32_t chunkCount);
+
+#endif
@@ -9,10 +9,21 @@
 #define VULKAN_COMPUTE_RAYTRACING_HPP
 
 #include <iostream>
+#include <vector>
+#include <cmath>
 #include <Common.hpp>
 #include <Frontend.hpp>
 #include <Platform.hpp>
 #include <Renderer.hpp>
+#include <Scene.hpp>
 #include <Environment.hpp>
+#include <Options.hpp>
+#include <Distributed.hpp>
+#include <ImageOutput.hpp>
+#include <Sequence.hpp>
+#include <Daemon.hpp>
+#include <Startup.hpp>
+#include <CostReport.hpp>
+#include <Poster.hpp>
 
 #endif
@@ -7,12 +7,15 @@
 
 #include <Platform.hpp>
 #include <Environment.hpp>
+#include <Options.hpp>
+#include <RenderThread.hpp>
 #include <tuple>
 
 #if defined(VCRT_PLATFORM_HAS_X11) || defined(VCRT_PLATFORM_HAS_WAYLAND)
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <poll.h>
 #endif
 
 #if defined(VCRT_PLATFORM_HAS_X11)
@@ -42,7 +45,10 @@ namespace {
 
 using CreateWindowT = VkResult (*)(OUT VkSurfaceKHR *surface);
 using ShowWindowT = void (*)(void);
-using EventLoopT = void (*)(void);
+// Runs on the render thread before each frame paced by frame callbacks, nullptr without them.
+using BeginFrameT = void (*)(void);
+// Dispatch the events of the display connection, waiting up to timeout ms (-1: forever) when none are queued.
+using PumpEventsT = void (*)(int timeout);
 
 struct WinSysInfo {
 #if defined(VCRT_PLATFORM_HAS_X11)
@@ -61,6 +67,9 @@ struct WinSysInfo {
     xdg_toplevel            *wl_xdg_toplevel;
 #endif
     bool quit  = false;
+    bool throughput = false;            // FRAME_PACING_THROUGHPUT, frames are neither paced nor paused.
+    RenderThread* renderThread = nullptr;
+    Camera camera = defaultCamera;      // Of the window, moved by the arrow keys.
     uint32_t width  = WINDOW_WIDTH;
     uint32_t height = WINDOW_HEIGHT;
 } winSys;
@@ -82,8 +91,10 @@ VkResult PlatformCreateXWindow(OUT VkSurfaceKHR *surface)
     uint32_t mask = XCB_CW_BACK_PIXEL | XCB_CW_EVENT_MASK;
     uint32_t values[2] = {
         winSys.xcb_screen->black_pixel,
+        XCB_EVENT_MASK_KEY_PRESS |
         XCB_EVENT_MASK_KEY_RELEASE |
         XCB_EVENT_MASK_EXPOSURE |
+        XCB_EVENT_MASK_VISIBILITY_CHANGE |
         XCB_EVENT_MASK_STRUCTURE_NOTIFY
     };
     xcb_create_window(winSys.xcb_connection,           /* connection    */
@@ -190,6 +201,23 @@ static xdg_toplevel_listener toplevelListener = {
     .close = handleToplevelClose
 };
 
+// The compositor is ready for the next frame, dispatched on the platform thread.
+static void handleFrameDone(void* data, struct wl_callback* callback, uint32_t time)
+{
+    wl_callback_destroy(callback);
+    RenderEvent frame = {
+        .type = RENDER_EVENT_FRAME_WANTED
+    };
+    PostRenderEvent(winSys.renderThread, &frame);
+
+    static_cast<void>(data);
+    static_cast<void>(time);
+}
+
+static const struct wl_callback_listener frameListener = {
+    .done = handleFrameDone
+};
+
 VkResult PlatformCreateWaylandWindow(OUT VkSurfaceKHR *surface)
 {
     winSys.wl_display_instance = wl_display_connect(nullptr);
@@ -274,38 +302,115 @@ void PlatformShowXWindow(void)
     xcb_flush(winSys.xcb_connection);
 }
 
-void PlatformHandleXEvent(void)
+constexpr int X_EVENT_RECHECK_MS = 50;
+
+// X has no frame callbacks, a mapped window that is not fully obscured takes frames.
+static void postVisibility(bool visible)
 {
-    xcb_generic_event_t* event = xcb_poll_for_event(winSys.xcb_connection);
-    while (event) {
-        uint8_t event_code = event->response_type & 0x7f;
-        switch (event_code) {
-            case XCB_EXPOSE:
-                // TODO: Resize window
-                break;
-            case XCB_CLIENT_MESSAGE:
-                if ((*reinterpret_cast<xcb_client_message_event_t*>(event))
-                        .data.data32[0] ==
-                    (*winSys.xcb_atom_wm_delete_window).atom) {
+    if (!winSys.throughput) {
+        RenderEvent visibility = {
+            .type = RENDER_EVENT_VISIBILITY,
+            .visible = visible
+        };
+        PostRenderEvent(winSys.renderThread, &visibility);
+    }
+}
+
+// Left & right orbit around the look at point, up & down move closer & away.
+static void moveCamera(uint8_t keycode)
+{
+    switch (keycode) {
+        case 113: // Left
+            OrbitCamera(&winSys.camera, -5.f, 1.f);
+            break;
+        case 114: // Right
+            OrbitCamera(&winSys.camera, 5.f, 1.f);
+            break;
+        case 111: // Up
+            OrbitCamera(&winSys.camera, 0.f, 0.9f);
+            break;
+        case 116: // Down
+            OrbitCamera(&winSys.camera, 0.f, 1.f / 0.9f);
+            break;
+        default:
+            return;
+    }
+    RenderEvent camera = {
+        .type = RENDER_EVENT_CAMERA,
+        .camera = winSys.camera
+    };
+    PostRenderEvent(winSys.renderThread, &camera);
+}
+
+static void handleXEvent(xcb_generic_event_t* event)
+{
+    uint8_t event_code = event->response_type & 0x7f;
+    switch (event_code) {
+        case XCB_EXPOSE: {
+            RenderEvent expose = {
+                .type = RENDER_EVENT_EXPOSE
+            };
+            PostRenderEvent(winSys.renderThread, &expose);
+            break;
+        }
+        case XCB_MAP_NOTIFY:
+            postVisibility(true);
+            break;
+        case XCB_UNMAP_NOTIFY:
+            postVisibility(false);
+            break;
+        case XCB_VISIBILITY_NOTIFY:
+            postVisibility(reinterpret_cast<const xcb_visibility_notify_event_t*>(event)->state !=
+                           XCB_VISIBILITY_FULLY_OBSCURED);
+            break;
+        case XCB_KEY_PRESS:
+            moveCamera(reinterpret_cast<const xcb_key_press_event_t*>(event)->detail);
+            break;
+        case XCB_CLIENT_MESSAGE:
+            if ((*reinterpret_cast<xcb_client_message_event_t*>(event))
+                    .data.data32[0] ==
+                (*winSys.xcb_atom_wm_delete_window).atom) {
+                winSys.quit = true;
+            }
+            break;
+        case XCB_KEY_RELEASE: {
+            auto* key =
+                reinterpret_cast<const xcb_key_release_event_t*>(event);
+            switch (key->detail) {
+                case 0x9: // Escape
                     winSys.quit = true;
-                }
-                break;
-            case XCB_KEY_RELEASE: {
-                auto* key =
-                    reinterpret_cast<const xcb_key_release_event_t*>(event);
-                switch (key->detail) {
-                    case 0x9: // Escape
-                        winSys.quit = true;
-                        break;
-                }
-                break;
+                    break;
             }
-            default:
-                break;
+            break;
         }
+        default:
+            break;
+    }
+}
+
+void PlatformPumpXEvents(int timeout)
+{
+    xcb_flush(winSys.xcb_connection);
+    xcb_generic_event_t* event = xcb_poll_for_event(winSys.xcb_connection);
+    if (event == nullptr && timeout != 0) {
+        pollfd display = {
+            .fd = xcb_get_file_descriptor(winSys.xcb_connection),
+            .events = POLLIN,
+            .revents = 0
+        };
+        // The WSI presenting on the render thread reads the same connection & may queue our events
+        // without poll seeing them, look again now and then.
+        poll(&display, 1, timeout < 0 || timeout > X_EVENT_RECHECK_MS ? X_EVENT_RECHECK_MS : timeout);
+        event = xcb_poll_for_event(winSys.xcb_connection);
+    }
+    while (event) {
+        handleXEvent(event);
         free(event);
         event = xcb_poll_for_event(winSys.xcb_connection);
     }
+    if (xcb_connection_has_error(winSys.xcb_connection)) {
+        winSys.quit = true;
+    }
 }
 #endif
 
@@ -315,31 +420,60 @@ void PlatformShowWaylandWindow(void)
     // No need to show explicitly.
 }
 
-void PlatformHandleWaylandEvent(void)
+// Ask for a callback when the compositor can take the frame after this one, committed by its present.
+// Runs on the render thread, the callback is dispatched on the platform thread.
+void PlatformBeginWaylandFrame(void)
 {
-    wl_display_roundtrip(winSys.wl_display_instance);
+    wl_callback* callback = wl_surface_frame(winSys.wl_surface_instance);
+    wl_callback_add_listener(callback, &frameListener, nullptr);
+}
+
+// Read the display socket only when poll says so, no round trips: the WSI reads it on other queues too.
+void PlatformPumpWaylandEvents(int timeout)
+{
+    wl_display* display = winSys.wl_display_instance;
+    while (wl_display_prepare_read(display) != 0) {
+        wl_display_dispatch_pending(display);
+    }
+    if (winSys.quit) {
+        timeout = 0;
+    }
+    wl_display_flush(display);
+    pollfd fd = {
+        .fd = wl_display_get_fd(display),
+        .events = POLLIN,
+        .revents = 0
+    };
+    if (poll(&fd, 1, timeout) > 0 && (fd.revents & POLLIN) != 0) {
+        wl_display_read_events(display);
+    } else {
+        wl_display_cancel_read(display);
+    }
+    if (wl_display_dispatch_pending(display) == -1) {
+        winSys.quit = true;
+    }
 }
 #endif
 
 auto WindowSystemEventDispatch()
-    -> std::tuple<ShowWindowT, EventLoopT>
+    -> std::tuple<ShowWindowT, BeginFrameT, PumpEventsT>
 {
 #if defined(VCRT_PLATFORM_HAS_X11) && defined(VCRT_PLATFORM_HAS_WAYLAND)
     char const* const session = getenv("XDG_SESSION_TYPE");
     assert(session != nullptr);
     if (strcmp(session, "x11") == 0) {
-        return std::make_tuple(&PlatformShowXWindow, &PlatformHandleXEvent);
+        return std::make_tuple(&PlatformShowXWindow, static_cast<BeginFrameT>(nullptr), &PlatformPumpXEvents);
     } else if (strcmp(session, "wayland") == 0) {
-        return std::make_tuple(&PlatformShowWaylandWindow,
-                              &PlatformHandleWaylandEvent);
+        return std::make_tuple(&PlatformShowWaylandWindow, &PlatformBeginWaylandFrame,
+                              &PlatformPumpWaylandEvents);
     }
     assert(false && "Unknown window system.");
-    return std::make_tuple(nullptr, nullptr);
+    return std::make_tuple(nullptr, nullptr, nullptr);
 #elif defined(VCRT_PLATFORM_HAS_X11)
-    return std::make_tuple(&PlatformShowXWindow, &PlatformHandleXEvent);
+    return std::make_tuple(&PlatformShowXWindow, static_cast<BeginFrameT>(nullptr), &PlatformPumpXEvents);
 #elif defined(VCRT_PLATFORM_HAS_WAYLAND)
-    return std::make_tuple(&PlatformShowWaylandWindow,
-                          &PlatformHandleWaylandEvent);
+    return std::make_tuple(&PlatformShowWaylandWindow, &PlatformBeginWaylandFrame,
+                          &PlatformPumpWaylandEvents);
 #else
 #error "Unknown window system."
 #endif
@@ -353,15 +487,23 @@ VkResult PlatformCreateWindow(OUT VkSurfaceKHR *surface)
     return create_window(surface);
 }
 
-void PlatformEnterEventLoop(void)
+void PlatformEnterEventLoop(IN RenderContext* context)
 {
-    auto [showWindow, handleEvent] = WindowSystemEventDispatch();
+    auto [showWindow, beginFrame, pumpEvents] = WindowSystemEventDispatch();
+    winSys.throughput = renderOptions.framePacing == FRAME_PACING_THROUGHPUT;
+    if (winSys.throughput) {
+        beginFrame = nullptr;
+    }
 
+    // Posted to before showing, the first map & frame callback events go to the render thread.
+    winSys.renderThread = StartRenderThread(context, beginFrame != nullptr ? RENDER_THREAD_FRAME_CALLBACKS : 0,
+                                            beginFrame);
     showWindow();
 
+    // This thread only sleeps in poll & dispatches, however long a frame takes.
     while (!winSys.quit) {
-        DrawNextFrame();
-        handleEvent();
-        vkDeviceWaitIdle(vulkanLogicalDevice);
+        pumpEvents(-1);
     }
+    StopRenderThread(winSys.renderThread);
+    winSys.renderThread = nullptr;
 }
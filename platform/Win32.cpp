@@ -11,10 +11,12 @@
 #include <Windows.h>
 #include <Platform.hpp>
 #include <Environment.hpp>
+#include <RenderThread.hpp>
 #include <vulkan/vulkan_win32.h>
 
 static HWND mainWindowHwnd;
 static HINSTANCE executableInstance;
+static RenderThread* renderThread;
 const char* platformExtensions[] = {
     "VK_KHR_surface",
     "VK_KHR_win32_surface"
@@ -29,6 +31,16 @@ static LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM l
             PostQuitMessage(0);
             return 0;
         }
+        case WM_PAINT: {
+            // Validated by DefWindowProc, the render thread presents the image again.
+            if (renderThread != nullptr) {
+                RenderEvent expose = {
+                    .type = RENDER_EVENT_EXPOSE
+                };
+                PostRenderEvent(renderThread, &expose);
+            }
+            break;
+        }
     }
     return DefWindowProc(hwnd,uMsg,wParam,lParam);
 }
@@ -74,34 +86,23 @@ VkResult PlatformCreateWindow(OUT VkSurfaceKHR* surface)
 
 static BOOL windowExiting = FALSE;
 
-void PlatformEnterEventLoop(void)
+// Frames are drawn on the render thread, this one only waits for & dispatches messages.
+void PlatformEnterEventLoop(IN RenderContext* context)
 {
     MSG msg;
     BOOL bRet;
 
+    renderThread = StartRenderThread(context, 0, nullptr);
     ShowWindow(mainWindowHwnd, SW_SHOWNORMAL);
-    while (true)
+    while ((bRet = GetMessage(&msg, NULL, 0, 0)) != 0)
     {
-        bRet = PeekMessage(&msg, NULL, 0, 0, PM_REMOVE);
         if (bRet == -1) {
-            windowExiting = TRUE;
-            return;
-        }
-        if (msg.message == WM_QUIT) {
-            windowExiting = TRUE;
-            return;
-        }
-        else
-        {
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
+            break;
         }
-        if (windowExiting != TRUE) {
-            if (DrawNextFrame() == VK_ERROR_OUT_OF_DATE_KHR) {
-                windowExiting = TRUE;
-            }
-            vkDeviceWaitIdle(vulkanLogicalDevice);
-        }
-
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
     }
+    windowExiting = TRUE;
+    StopRenderThread(renderThread);
+    renderThread = nullptr;
 }
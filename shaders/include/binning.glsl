@@ -0,0 +1,106 @@
+/* @file binning.glsl
+
+    Bounce ray binning: the rays of a workgroup are sorted by direction octant & origin cell before
+    they are traced, so neighbouring lanes walk the same part of the scene.
+    SPDX-License-Identifier: WTFPL
+
+*/
+
+// Direction octants times 2x2x2 cells of the scene bounds.
+#define RAY_BIN_COUNT 64
+// One ray per invocation of the 16x16 workgroup.
+#define BINNED_RAY_COUNT 256
+
+shared vec3 binned_origins[BINNED_RAY_COUNT];      // Per owning lane.
+shared vec3 binned_directions[BINNED_RAY_COUNT];
+shared bool binned_active[BINNED_RAY_COUNT];
+shared uvec4 binned_hits[BINNED_RAY_COUNT];        // See pack_hit().
+shared uint binned_owners[BINNED_RAY_COUNT];       // Per sorted slot.
+shared uvec4 binned_costs[BINNED_RAY_COUNT];       // Per owning lane, what tracing its ray cost.
+shared uint ray_bin_starts[RAY_BIN_COUNT];
+
+uint ray_bin(ray r) {
+    uvec3 octant = uvec3(lessThan(r.direction, vec3(0.0)));
+    vec3 extent = max(tlas_nodes[0].bounds_max - tlas_nodes[0].bounds_min, vec3(1e-6));
+    uvec3 cell = uvec3(clamp((r.origin - tlas_nodes[0].bounds_min) / extent * 2.0, vec3(0.0), vec3(1.0)));
+    return (octant.x | octant.y << 1 | octant.z << 2) << 3 | cell.x | cell.y << 1 | cell.z << 2;
+}
+
+// Closest hit of every lane's ray, each traced by the lane its sorted slot falls to.
+// Must be called in workgroup uniform control flow, inactive lanes only help tracing.
+bool hit_world_binned(ray r, bool active, out hit_record global_hit_record) {
+    uint lane = gl_LocalInvocationIndex;
+    uint bin = active ? ray_bin(r) : RAY_BIN_COUNT - 1;
+    binned_origins[lane] = r.origin;
+    binned_directions[lane] = r.direction;
+    binned_active[lane] = active;
+    if (lane < RAY_BIN_COUNT) {
+        ray_bin_starts[lane] = 0;
+    }
+    barrier();
+    // Counting sort: rank inside the bin, then bin offsets.
+    uint rank = atomicAdd(ray_bin_starts[bin], 1u);
+    barrier();
+    if (lane == 0) {
+        uint start = 0;
+        for (uint i = 0; i < RAY_BIN_COUNT; i++) {
+            uint count = ray_bin_starts[i];
+            ray_bin_starts[i] = start;
+            start += count;
+        }
+    }
+    barrier();
+    binned_owners[ray_bin_starts[bin] + rank] = lane;
+    barrier();
+
+    uint owner = binned_owners[lane];
+    if (binned_active[owner]) {
+        ray binned_ray = ray(binned_origins[owner], binned_directions[owner]);
+        hit_record binned_hit;
+        binned_hit.max_t = infinity;
+        binned_hit.min_t = 0.001;
+        uvec4 lane_costs = path_costs;
+        bool hit = hit_world(binned_ray, binned_hit);
+        binned_hits[owner] = pack_hit(hit, binned_hit);
+        // Charged to the pixel the ray belongs to, not the lane that traced it.
+        if (COST_COUNTERS != 0) {
+            binned_costs[owner] = path_costs - lane_costs;
+            path_costs = lane_costs;
+        }
+    }
+    barrier();
+    if (COST_COUNTERS != 0 && active) {
+        path_costs += binned_costs[lane];
+    }
+    return active && unpack_hit(binned_hits[lane], r, global_hit_record);
+}
+
+// ray_color_from() with binned bounces, in workgroup uniform control flow.
+vec3 ray_color_binned(ray r, bool active, bool hit, hit_record global_hit_record) {
+
+    shading_vec3 color = shading_vec3(1.0);
+    vec3 result = vec3(0);
+
+    for(int pass=0;pass<MAX_RECURSION_LEVEL;pass++) {
+        if (pass > 0) {
+            if (!workgroup_any(active)) {
+                break;
+            }
+            hit = hit_world_binned(r, active, global_hit_record);
+        }
+        if (!active) {
+            continue;
+        }
+        if (hit) {
+            texture_dispatcher(global_hit_record, color, r);
+        }
+        else { // Hit sky.
+            result = vec3(color) * sky_color(r);
+            active = false;
+        }
+    }
+    if (active) {
+        count_cost(COST_CAPPED_PATH);
+    }
+    return result;
+}
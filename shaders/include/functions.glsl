@@ -7,15 +7,32 @@
 
 #include "globals.glsl"
 
-float rand(vec2 co) {
-    return fract(sin(dot(co.xy ,vec2(12.9898,78.233))) * 43758.5453);
+// PCG hash, a random stream depends only on (pixel, sample index),
+// so any tile/sample range renders identically on every machine.
+uint random_state;
+
+uint pcg_hash(uint value) {
+    uint state = value * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+void seed_random(uvec2 pixel, uint sample_index) {
+    random_state = pcg_hash(pixel.x + pcg_hash(pixel.y + pcg_hash(sample_index)));
+}
+
+float random_float() {
+    random_state = random_state * 747796405u + 2891336453u;
+    return float(pcg_hash(random_state) >> 8) / 16777216.0;
 }
 
-bool hit_sphere(const sphere s, ray r, inout hit_record global_hit_record) {
-    vec3 oc = r.origin - s.center;
+// s: center & radius of sphere number `sphere`.
+bool hit_sphere(const vec4 s, uint sphere, ray r, inout hit_record global_hit_record) {
+    count_cost(COST_SPHERE_TEST);
+    vec3 oc = r.origin - s.xyz;
     float a = dot(r.direction,r.direction);
     float half_b = dot(oc, r.direction);
-    float c = dot(oc,oc) - s.radius*s.radius;
+    float c = dot(oc,oc) - s.w*s.w;
     float discriminant = half_b*half_b - a*c;
     if (discriminant < 0) {
         return false;
@@ -32,15 +49,305 @@ bool hit_sphere(const sphere s, ray r, inout hit_record global_hit_record) {
 
     global_hit_record.max_t = root;
     global_hit_record.point = root*r.direction+r.origin;
-    vec3 normal = (global_hit_record.point - s.center) / s.radius;
+    vec3 normal = (global_hit_record.point - s.xyz) / s.w;
     global_hit_record.normal = normal;//faceforward(normal, normal, r.direction);
-    global_hit_record.texture = s.texture;
-    global_hit_record.colour = s.colour;
+    global_hit_record.sphere = sphere;
     return true;
 }
 
-vec3 random_in_unit_sphere(vec3 seed) {
-    return normalize(vec3(rand(seed.xy),rand(seed.xz),rand(seed.yz)));
+// Entry distance of the ray into a box, infinity if it misses or enters beyond max_t.
+float hit_aabb(vec3 bounds_min, vec3 bounds_max, vec3 origin, vec3 inverse_direction, float min_t, float max_t) {
+    vec3 t0 = (bounds_min - origin) * inverse_direction;
+    vec3 t1 = (bounds_max - origin) * inverse_direction;
+    vec3 t_near = min(t0, t1);
+    vec3 t_far = max(t0, t1);
+    float t_enter = max(max(t_near.x, t_near.y), max(t_near.z, min_t));
+    float t_exit = min(min(t_far.x, t_far.y), min(t_far.z, max_t));
+    return t_enter <= t_exit ? t_enter : infinity;
+}
+
+// Closest hit in one geometry, walking its BVH front to back. The ray is in object space.
+bool hit_geometry(uint root, ray r, inout hit_record global_hit_record) {
+    vec3 inverse_direction = 1.0 / r.direction;
+    uint stack[BVH_STACK_SIZE];
+    int stack_size = 0;
+    uint node_index = root;
+    bool hit = false;
+
+    if (hit_aabb(bvh_nodes[root].bounds_min, bvh_nodes[root].bounds_max, r.origin, inverse_direction,
+                 global_hit_record.min_t, global_hit_record.max_t) == infinity) {
+        return false;
+    }
+    while (true) {
+        bvh_node node = bvh_nodes[node_index];
+        count_cost(COST_NODE);
+        if (node.count > 0) {
+            for (uint i = node.left_or_first; i < node.left_or_first + node.count; i++) {
+                uint sphere = bvh_indices[i];
+                if (hit_sphere(spheres[sphere], sphere, r, global_hit_record)) {
+                    hit = true;
+                }
+            }
+        } else {
+            uint near_child = node.left_or_first;
+            uint far_child = near_child + 1;
+            float near_t = hit_aabb(bvh_nodes[near_child].bounds_min, bvh_nodes[near_child].bounds_max,
+                                    r.origin, inverse_direction, global_hit_record.min_t, global_hit_record.max_t);
+            float far_t = hit_aabb(bvh_nodes[far_child].bounds_min, bvh_nodes[far_child].bounds_max,
+                                   r.origin, inverse_direction, global_hit_record.min_t, global_hit_record.max_t);
+            if (far_t < near_t) {
+                uint child = near_child; near_child = far_child; far_child = child;
+                float t = near_t; near_t = far_t; far_t = t;
+            }
+            if (near_t != infinity) {
+                if (far_t != infinity) {
+                    stack[stack_size++] = far_child;
+                }
+                node_index = near_child;
+                continue;
+            }
+        }
+        if (stack_size == 0) {
+            break;
+        }
+        node_index = stack[--stack_size];
+    }
+    return hit;
+}
+
+uint sphere_material(uint sphere) {
+    if (MATERIAL_ID_BITS == 16) {
+        return (sphere_materials[sphere >> 1] >> ((sphere & 1u) << 4)) & 0xFFFFu;
+    }
+    return sphere_materials[sphere];
+}
+
+// Colour & texture of global_hit_record.material.
+void load_material(inout hit_record global_hit_record) {
+    scene_material material = materials[min(global_hit_record.material, uint(materials.length()) - 1)];
+    vec2 albedo_b_type = unpackHalf2x16(material.albedo_b_type);
+    global_hit_record.colour = vec3(unpackHalf2x16(material.albedo_rg), albedo_b_type.x);
+    global_hit_record.texture = vec3(material.albedo_b_type >> 16, material.parameter, 0.0);
+}
+
+void apply_material(inout hit_record global_hit_record) {
+    global_hit_record.material = sphere_material(global_hit_record.sphere);
+    load_material(global_hit_record);
+}
+
+// Back to world space: the point from t, the normal by the transposed world to object transform.
+
+void finish_hit(ray r, mat3 object_to_world_normal, inout hit_record global_hit_record) {
+    global_hit_record.point = r.origin + global_hit_record.max_t * r.direction;
+    global_hit_record.normal = normalize(object_to_world_normal * global_hit_record.normal);
+    apply_material(global_hit_record);
+}
+
+shared bool shared_any;
+
+// True if the condition holds for any lane. Must be called in workgroup uniform control flow.
+bool workgroup_any(bool condition) {
+    barrier();
+    if (gl_LocalInvocationIndex == 0) {
+        shared_any = false;
+    }
+    barrier();
+    if (condition) {
+        shared_any = true;
+    }
+    barrier();
+    return shared_any;
+}
+
+#ifdef USE_RAY_QUERY
+// Closest hit in the world, traversed by the hardware. Sphere AABBs are candidates,
+// hit_sphere() on the object space ray decides & commits them.
+bool hit_world(ray r, inout hit_record global_hit_record) {
+    rayQueryEXT query;
+    rayQueryInitializeEXT(query, scene_acceleration_structure, gl_RayFlagsOpaqueEXT, 0xFF,
+                          r.origin, global_hit_record.min_t, r.direction, global_hit_record.max_t);
+    while (rayQueryProceedEXT(query)) {
+        if (rayQueryGetIntersectionTypeEXT(query, false) != gl_RayQueryCandidateIntersectionAABBEXT) {
+            continue;
+        }
+        // Custom index: first sphere of the geometry, primitives are its spheres in order.
+        uint sphere = rayQueryGetIntersectionInstanceCustomIndexEXT(query, false)
+                    + rayQueryGetIntersectionPrimitiveIndexEXT(query, false);
+        ray object_ray = ray(rayQueryGetIntersectionObjectRayOriginEXT(query, false),
+                             rayQueryGetIntersectionObjectRayDirectionEXT(query, false));
+        if (hit_sphere(spheres[sphere], sphere, object_ray, global_hit_record)) {
+            rayQueryGenerateIntersectionEXT(query, global_hit_record.max_t);
+        }
+    }
+
+    if (rayQueryGetIntersectionTypeEXT(query, true) == gl_RayQueryCommittedIntersectionNoneEXT) {
+        return false;
+    }
+    mat3 world_to_object = mat3(rayQueryGetIntersectionWorldToObjectEXT(query, true));
+    finish_hit(r, transpose(world_to_object), global_hit_record);
+    return true;
+}
+#elif defined(USE_SHARED_SCENE)
+// One sphere per invocation of a 16x16 workgroup.
+#define SHARED_SPHERE_COUNT 256
+shared vec4 shared_spheres[SHARED_SPHERE_COUNT];
+
+// Closest hit in the world by testing every sphere of every instance. The workgroup loads each chunk
+// of spheres once into shared memory & all its rays test against it, so scene reads drop by the
+// workgroup size. Must be called in workgroup uniform control flow, inactive lanes only help loading.
+bool hit_world(ray r, bool active, inout hit_record global_hit_record) {
+    int hit_instance = -1;
+    for (uint instance_index = 0; instance_index < instances.length(); instance_index++) {
+        scene_instance instance = instances[instance_index];
+        vec4 origin = vec4(r.origin, 1.0);
+        ray object_ray = ray(vec3(dot(instance.world_to_object[0], origin),
+                                  dot(instance.world_to_object[1], origin),
+                                  dot(instance.world_to_object[2], origin)),
+                             vec3(dot(instance.world_to_object[0].xyz, r.direction),
+                                  dot(instance.world_to_object[1].xyz, r.direction),
+                                  dot(instance.world_to_object[2].xyz, r.direction)));
+        uint last_sphere = instance.first_sphere + instance.sphere_count;
+        for (uint chunk = instance.first_sphere; chunk < last_sphere; chunk += SHARED_SPHERE_COUNT) {
+            uint chunk_size = min(SHARED_SPHERE_COUNT, last_sphere - chunk);
+            barrier(); // Everyone is done with the previous chunk.
+            if (gl_LocalInvocationIndex < chunk_size) {
+                shared_spheres[gl_LocalInvocationIndex] = spheres[chunk + gl_LocalInvocationIndex];
+            }
+            barrier();
+            if (active) {
+                for (uint i = 0; i < chunk_size; i++) {
+                    if (hit_sphere(shared_spheres[i], chunk + i, object_ray, global_hit_record)) {
+                        hit_instance = int(instance_index);
+                    }
+                }
+            }
+        }
+    }
+
+    if (hit_instance < 0) {
+        return false;
+    }
+    scene_instance instance = instances[hit_instance];
+    finish_hit(r, mat3(instance.world_to_object[0].xyz, instance.world_to_object[1].xyz,
+                       instance.world_to_object[2].xyz), global_hit_record);
+    return true;
+}
+#else
+// Closest hit in the world: walk the instance BVH, then the geometry of each instance in object space.
+// Object space directions are not normalized, so t is the same in both spaces.
+bool hit_world(ray r, inout hit_record global_hit_record) {
+    vec3 inverse_direction = 1.0 / r.direction;
+    uint stack[TLAS_STACK_SIZE];
+    int stack_size = 0;
+    uint node_index = 0;
+    int hit_instance = -1;
+
+    if (hit_aabb(tlas_nodes[0].bounds_min, tlas_nodes[0].bounds_max, r.origin, inverse_direction,
+                 global_hit_record.min_t, global_hit_record.max_t) == infinity) {
+        return false;
+    }
+    while (true) {
+        bvh_node node = tlas_nodes[node_index];
+        count_cost(COST_NODE);
+        if (node.count > 0) {
+            for (uint i = node.left_or_first; i < node.left_or_first + node.count; i++) {
+                scene_instance instance = instances[i];
+                vec4 origin = vec4(r.origin, 1.0);
+                ray object_ray = ray(vec3(dot(instance.world_to_object[0], origin),
+                                          dot(instance.world_to_object[1], origin),
+                                          dot(instance.world_to_object[2], origin)),
+                                     vec3(dot(instance.world_to_object[0].xyz, r.direction),
+                                          dot(instance.world_to_object[1].xyz, r.direction),
+                                          dot(instance.world_to_object[2].xyz, r.direction)));
+                if (hit_geometry(instance.geometry, object_ray, global_hit_record)) {
+                    hit_instance = int(i);
+                }
+            }
+        } else {
+            uint near_child = node.left_or_first;
+            uint far_child = near_child + 1;
+            float near_t = hit_aabb(tlas_nodes[near_child].bounds_min, tlas_nodes[near_child].bounds_max,
+                                    r.origin, inverse_direction, global_hit_record.min_t, global_hit_record.max_t);
+            float far_t = hit_aabb(tlas_nodes[far_child].bounds_min, tlas_nodes[far_child].bounds_max,
+                                   r.origin, inverse_direction, global_hit_record.min_t, global_hit_record.max_t);
+            if (far_t < near_t) {
+                uint child = near_child; near_child = far_child; far_child = child;
+                float t = near_t; near_t = far_t; far_t = t;
+            }
+            if (near_t != infinity) {
+                if (far_t != infinity) {
+                    stack[stack_size++] = far_child;
+                }
+                node_index = near_child;
+                continue;
+            }
+        }
+        if (stack_size == 0) {
+            break;
+        }
+        node_index = stack[--stack_size];
+    }
+
+    if (hit_instance < 0) {
+        return false;
+    }
+    // Rows of world to object as columns: its transpose.
+    scene_instance instance = instances[hit_instance];
+    finish_hit(r, mat3(instance.world_to_object[0].xyz, instance.world_to_object[1].xyz,
+                       instance.world_to_object[2].xyz), global_hit_record);
+    return true;
+}
+#endif
+
+// Tile culling: per CULL_TILE_SIZE square of the full image, the spheres whose projection may cover it,
+// listed by cull.comp before the first dispatch after a restart.
+uint cull_tile(ivec2 pixel) {
+    uint tiles_x = (parameters.image_width + CULL_TILE_SIZE - 1) / CULL_TILE_SIZE;
+    return uint(pixel.y) / CULL_TILE_SIZE * tiles_x + uint(pixel.x) / CULL_TILE_SIZE;
+}
+
+// A tile that overflowed its candidates falls back to the whole world.
+bool tile_culled(uint tile) {
+    return TILE_CULLING != 0 && tile_data[tile] <= TILE_CANDIDATE_CAPACITY;
+}
+
+// Closest hit among the candidates of a tile, only valid for rays through the tile.
+bool hit_tile(ray r, uint tile, inout hit_record global_hit_record) {
+    uint tiles_x = (parameters.image_width + CULL_TILE_SIZE - 1) / CULL_TILE_SIZE;
+    uint tiles_y = (parameters.image_height + CULL_TILE_SIZE - 1) / CULL_TILE_SIZE;
+    uint candidates = tiles_x * tiles_y + tile * TILE_CANDIDATE_CAPACITY * 2;
+    int hit_instance = -1;
+    for (uint i = 0; i < tile_data[tile]; i++) {
+        uint instance_index = tile_data[candidates + i * 2];
+        scene_instance instance = instances[instance_index];
+        vec4 origin = vec4(r.origin, 1.0);
+        ray object_ray = ray(vec3(dot(instance.world_to_object[0], origin),
+                                  dot(instance.world_to_object[1], origin),
+                                  dot(instance.world_to_object[2], origin)),
+                             vec3(dot(instance.world_to_object[0].xyz, r.direction),
+                                  dot(instance.world_to_object[1].xyz, r.direction),
+                                  dot(instance.world_to_object[2].xyz, r.direction)));
+        uint sphere = tile_data[candidates + i * 2 + 1];
+        if (hit_sphere(spheres[sphere], sphere, object_ray, global_hit_record)) {
+            hit_instance = int(instance_index);
+        }
+    }
+
+    if (hit_instance < 0) {
+        return false;
+    }
+    scene_instance instance = instances[hit_instance];
+    finish_hit(r, mat3(instance.world_to_object[0].xyz, instance.world_to_object[1].xyz,
+                       instance.world_to_object[2].xyz), global_hit_record);
+    return true;
+}
+
+shading_vec3 random_in_unit_sphere() {
+    // Uniform on the sphere surface: uniform z & uniform angle.
+    shading_float z = shading_float(2.0 * random_float() - 1.0);
+    shading_float phi = shading_float(6.28318530718 * random_float());
+    shading_float r = sqrt(max(shading_float(0.0), shading_float(1.0) - z*z));
+    return shading_vec3(r*cos(phi), r*sin(phi), z);
 }
 
 bool modified_refract(const in vec3 v, const in vec3 n, const in float ni_over_nt,
@@ -55,38 +362,132 @@ bool modified_refract(const in vec3 v, const in vec3 n, const in float ni_over_n
     }
 }
 
-float schlick(float cosine, float ior) {
-    float r0 = (1.-ior)/(1.+ior);
+shading_float schlick(shading_float cosine, shading_float ior) {
+    shading_float one = shading_float(1.0);
+    shading_float r0 = (one-ior)/(one+ior);
     r0 = r0*r0;
-    return r0 + (1.-r0)*pow((1.-cosine),5.);
+    return r0 + (one-r0)*pow((one-cosine),shading_float(5.0));
 }
 
+vec3 sky_color(ray r) {
+    vec3 unit_direction = normalize(r.direction);
+    float a = 0.5*(unit_direction.y + 1.0);
+    return mix(vec3(1),vec3(.5,.7,1), a);
+}
 
-vec3 ray_color(ray r) {
+#ifdef USE_SHARED_SCENE
+// Same as below with every bounce in workgroup uniform control flow: lanes whose ray has left the
+// scene stay inactive until the whole workgroup is done.
+vec3 ray_color(ray r, ivec2 pixel, bool active) {
 
     hit_record global_hit_record;
-    global_hit_record.max_t = infinity;
-    vec3 color = vec3(1.0,1.0,1.0);
-    bool t;
+    shading_vec3 color = shading_vec3(1.0);
+    vec3 result = vec3(0);
 
-    // Non-recursion version ray-tracing WA because GLSL does not allow recursion.
     for(int pass=0;pass<MAX_RECURSION_LEVEL;pass++) {
-        t = false;
+        if (!workgroup_any(active)) {
+            break;
+        }
         global_hit_record.max_t = infinity;
         global_hit_record.min_t = 0.001;
-        for(int i=0;i<world.length();i++) {
-            if(hit_sphere(world[i], r, global_hit_record)) {
-                t = true;
-            }
+        // Primary rays of culled tiles only test their candidates, the rest scan the world together.
+        bool culled = active && pass == 0 && tile_culled(cull_tile(pixel));
+        bool hit = false;
+        if (culled) {
+            hit = hit_tile(r, cull_tile(pixel), global_hit_record);
+        }
+        if (workgroup_any(active && !culled)) {
+            hit = hit_world(r, active && !culled, global_hit_record) || hit;
+        }
+        if (!active) {
+            continue;
         }
-        if (t) {
+        if (hit) {
             texture_dispatcher(global_hit_record, color, r);
         }
         else { // Hit sky.
-                vec3 unit_direction = normalize(r.direction);
-                float a = 0.5*(unit_direction.y + 1.0);
-                color *= mix(vec3(1),vec3(.5,.7,1), a);
-            return color;
+                result = vec3(color) * sky_color(r);
+                active = false;
         }
     }
+    if (active) {
+        count_cost(COST_CAPPED_PATH);
+    }
+    return result;
+}
+#else
+// Colour of a path whose first hit is known, hit is false if r leaves the scene right away.
+vec3 ray_color_from(ray r, bool hit, hit_record global_hit_record) {
+
+    shading_vec3 color = shading_vec3(1.0);
+
+    // Non-recursion version ray-tracing WA because GLSL does not allow recursion.
+    for(int pass=0;pass<MAX_RECURSION_LEVEL;pass++) {
+        if (pass > 0) {
+            global_hit_record.max_t = infinity;
+            global_hit_record.min_t = 0.001;
+            hit = hit_world(r, global_hit_record);
+        }
+        if (hit) {
+            texture_dispatcher(global_hit_record, color, r);
+        }
+        else { // Hit sky.
+            return vec3(color) * sky_color(r);
+        }
+    }
+    count_cost(COST_CAPPED_PATH);
+    return vec3(0);
+}
+
+// Primary ray through pixel of the full image.
+bool first_hit(ray r, ivec2 pixel, out hit_record global_hit_record) {
+    global_hit_record.max_t = infinity;
+    global_hit_record.min_t = 0.001;
+    uint tile = cull_tile(pixel);
+    if (tile_culled(tile)) {
+        return hit_tile(r, tile, global_hit_record);
+    }
+    return hit_world(r, global_hit_record);
+}
+
+// Packed hits of the first hit cache & the ray binning: t, octahedral normal, material, hit flag.
+// The ray is known when unpacking, so the point follows from t.
+vec2 octahedral_encode(vec3 n) {
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    vec2 folded = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    return n.z >= 0.0 ? n.xy : folded;
+}
+
+vec3 octahedral_decode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.y += n.y >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+uvec4 pack_hit(bool hit, hit_record global_hit_record) {
+    return uvec4(floatBitsToUint(global_hit_record.max_t),
+                 packSnorm2x16(octahedral_encode(global_hit_record.normal)),
+                 global_hit_record.material, hit ? 1u : 0u);
+}
+
+bool unpack_hit(uvec4 encoded, ray r, out hit_record global_hit_record) {
+    global_hit_record.min_t = 0.001;
+    global_hit_record.max_t = uintBitsToFloat(encoded.x);
+    global_hit_record.point = r.origin + global_hit_record.max_t * r.direction;
+    global_hit_record.normal = octahedral_decode(unpackSnorm2x16(encoded.y));
+    global_hit_record.material = encoded.z;
+    load_material(global_hit_record);
+    return encoded.w != 0;
+}
+
+// The primary ray of a first hit cache entry repeats exactly.
+void store_first_hit(uint entry, bool hit, hit_record global_hit_record) {
+    first_hits[entry] = pack_hit(hit, global_hit_record);
+}
+
+bool load_first_hit(uint entry, ray r, out hit_record global_hit_record) {
+    return unpack_hit(first_hits[entry], r, global_hit_record);
 }
+#endif
@@ -5,515 +5,113 @@
 
 */
 #include "structures.glsl"
+
+// Specialized per scene by the renderer (ComputeSpecialization in Renderer.cpp), defaults fit any scene.
+// Material types absent from the scene, bit (1 << TEXTURE_*), are compiled out of texture_dispatcher().
+layout (constant_id = 0) const uint MATERIAL_TYPES = 0xE;
+// Traversal stacks sized to the depth of the scene BVHs, at most SCENE_BVH_MAX_DEPTH.
+layout (constant_id = 1) const uint BVH_STACK_SIZE = 32;
+layout (constant_id = 2) const uint TLAS_STACK_SIZE = 32;
+// Fixed samples per dispatch lets the sample loop unroll, 0 takes parameters.sample_count.
+layout (constant_id = 3) const uint SAMPLES_PER_DISPATCH = 0;
+// Window only: primary hits of this many fixed sub-pixel positions are cached per pixel, 0 disables.
+layout (constant_id = 4) const uint FIRST_HIT_STRATA = 0;
+// Primary rays only test the spheres listed for their tile by cull.comp, 0 disables.
+layout (constant_id = 5) const uint TILE_CULLING = 0;
+// Invocation to pixel: 0 rows, 1 Z-order inside each 16x16 workgroup, 2 Z-order & workgroups in strips.
+layout (constant_id = 6) const uint PIXEL_ORDER = 0;
+// Bounce rays of a workgroup are sorted by direction octant & origin cell before tracing, see binning.glsl.
+layout (constant_id = 7) const uint RAY_BINNING = 0;
+// Width of the sphere material IDs, 16 packs two per uint (scenes of at most 65536 materials).
+layout (constant_id = 8) const uint MATERIAL_ID_BITS = 32;
+// Window only: the resolved colour is also stored for presentation, 1 as rgba16f, 2 as B10G11R11.
+// 0 presents the accumulation image itself.
+layout (constant_id = 9) const uint DISPLAY_FORMAT = 0;
+// Per pixel costs summed over its samples into CostImage: bounces, hit_sphere() calls, BVH nodes visited &
+// paths cut at MAX_RECURSION_LEVEL. 0 compiles the counting out. Must match CostCounter in Renderer.hpp.
+layout (constant_id = 10) const uint COST_COUNTERS = 0;
+// Window only: false colour of counter COST_OVERLAY - 1 blended over the display image, 0 disables.
+layout (constant_id = 11) const uint COST_OVERLAY = 0;
+
+// Costs of the pixel being rendered, see COST_COUNTERS.
+#define COST_BOUNCE uvec4(1u, 0u, 0u, 0u)
+#define COST_SPHERE_TEST uvec4(0u, 1u, 0u, 0u)
+#define COST_NODE uvec4(0u, 0u, 1u, 0u)
+#define COST_CAPPED_PATH uvec4(0u, 0u, 0u, 1u)
+uvec4 path_costs;
+
+void count_cost(uvec4 cost) {
+    if (COST_COUNTERS != 0) {
+        path_costs += cost;
+    }
+}
+
 #include "textures.glsl"
-#if 0
-#define SAMPLES_PER_PIXEL 100
-#else
-#define SAMPLES_PER_PIXEL 1
-#endif
 #define MAX_RECURSION_LEVEL 50
 
-#define IMAGE_WIDTH 1280
-#define IMAGE_HEIGHT 720
+#define RENDER_FLAG_ACCUMULATE 0x1
 
-// Camera
+// Must match CULL_TILE_SIZE & TILE_CANDIDATE_CAPACITY in Renderer.cpp.
+#define CULL_TILE_SIZE 16u
+#define TILE_CANDIDATE_CAPACITY 128u
 
-vec3 camera_lookfrom = vec3(13,2,3); // Point camera is looking from
-vec3 camera_lookat = vec3(0,0,0); // Point camera is looking at
-vec3 camera_vup = vec3(0,1,0); // Camera-relative "up" direction
-float camera_vfov = 20;
+// Must match RenderPushConstants in Renderer.hpp.
+layout (push_constant) uniform RenderParameters {
+    vec4 camera_center;     // Camera basis, computed on host for the full image.
+    vec4 pixel00_loc;
+    vec4 pixel_delta_u;
+    vec4 pixel_delta_v;
+    ivec2 tile_offset;      // Offset of this dispatch inside the full image.
+    uvec2 tile_size;
+    uint sample_base;       // Index of the first sample, seeds the random sequence.
+    uint sample_count;
+    uint flags;
+    uint image_width;       // Full image, sizes the culling tile grid.
+    uint image_height;
+} parameters;
 
 const float infinity = 1e5;
 
-// World.
-const sphere world[] = {
-    // Generated by SceneGenerator.cpp.
-    sphere(vec3(-10.13,0.20,-10.25), 0.2, vec3(0.19,0.55,0.31), vec3(TEXTURE_LAMBERTIAN,0.22,0.0)),
-    sphere(vec3(-10.13,0.20,-9.10), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-10.90,0.20,-8.12), 0.2, vec3(0.11,0.00,0.30), vec3(TEXTURE_LAMBERTIAN,0.80,0.0)),
-    sphere(vec3(-10.55,0.20,-7.21), 0.2, vec3(0.68,0.21,0.36), vec3(TEXTURE_LAMBERTIAN,0.80,0.0)),
-    sphere(vec3(-10.57,0.20,-6.33), 0.2, vec3(0.80,0.30,0.17), vec3(TEXTURE_LAMBERTIAN,0.42,0.0)),
-    sphere(vec3(-10.87,0.20,-5.21), 0.2, vec3(0.76,0.13,0.82), vec3(TEXTURE_LAMBERTIAN,0.99,0.0)),
-    sphere(vec3(-10.89,0.20,-4.40), 0.2, vec3(0.41,0.04,0.05), vec3(TEXTURE_LAMBERTIAN,0.21,0.0)),
-    sphere(vec3(-10.29,0.20,-3.56), 0.2, vec3(0.00,0.71,0.81), vec3(TEXTURE_LAMBERTIAN,0.92,0.0)),
-    sphere(vec3(-10.59,0.20,-2.42), 0.2, vec3(0.81,0.88,0.57), vec3(TEXTURE_LAMBERTIAN,0.77,0.0)),
-    sphere(vec3(-10.26,0.20,-1.26), 0.2, vec3(0.58,0.42,0.41), vec3(TEXTURE_LAMBERTIAN,0.94,0.0)),
-    sphere(vec3(-10.79,0.20,-0.31), 0.2, vec3(0.30,0.33,0.99), vec3(TEXTURE_LAMBERTIAN,0.81,0.0)),
-    sphere(vec3(-10.18,0.20,0.20), 0.2, vec3(0.99,0.78,0.96), vec3(TEXTURE_LAMBERTIAN,0.85,0.0)),
-    sphere(vec3(-10.46,0.20,1.71), 0.2, vec3(0.39,0.68,0.70), vec3(TEXTURE_LAMBERTIAN,0.73,0.0)),
-    sphere(vec3(-10.53,0.20,2.19), 0.2, vec3(0.36,0.59,0.35), vec3(TEXTURE_LAMBERTIAN,0.40,0.0)),
-    sphere(vec3(-10.64,0.20,3.14), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-10.65,0.20,4.65), 0.2, vec3(0.62,0.86,0.44), vec3(TEXTURE_LAMBERTIAN,0.93,0.0)),
-    sphere(vec3(-10.69,0.20,5.42), 0.2, vec3(0.72,0.99,0.72), vec3(TEXTURE_LAMBERTIAN,0.53,0.0)),
-    sphere(vec3(-10.50,0.20,6.45), 0.2, vec3(0.45,0.55,0.46), vec3(TEXTURE_METAL,0.50,0.0)),
-    sphere(vec3(-10.55,0.20,7.54), 0.2, vec3(0.36,0.98,0.03), vec3(TEXTURE_METAL,0.98,0.0)),
-    sphere(vec3(-10.23,0.20,8.31), 0.2, vec3(0.13,0.75,0.66), vec3(TEXTURE_LAMBERTIAN,0.05,0.0)),
-    sphere(vec3(-10.75,0.20,9.09), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-10.44,0.20,10.07), 0.2, vec3(0.44,0.53,0.68), vec3(TEXTURE_METAL,0.01,0.0)),
-    sphere(vec3(-9.66,0.20,-10.88), 0.2, vec3(0.50,0.25,0.04), vec3(TEXTURE_LAMBERTIAN,0.76,0.0)),
-    sphere(vec3(-9.26,0.20,-9.12), 0.2, vec3(0.54,0.25,0.05), vec3(TEXTURE_METAL,0.30,0.0)),
-    sphere(vec3(-9.97,0.20,-8.69), 0.2, vec3(0.27,0.21,0.88), vec3(TEXTURE_METAL,0.16,0.0)),
-    sphere(vec3(-9.56,0.20,-7.80), 0.2, vec3(0.44,0.76,0.65), vec3(TEXTURE_LAMBERTIAN,0.95,0.0)),
-    sphere(vec3(-9.71,0.20,-6.95), 0.2, vec3(0.26,0.81,0.91), vec3(TEXTURE_LAMBERTIAN,0.40,0.0)),
-    sphere(vec3(-9.66,0.20,-5.56), 0.2, vec3(0.81,0.62,0.29), vec3(TEXTURE_LAMBERTIAN,0.72,0.0)),
-    sphere(vec3(-9.69,0.20,-4.65), 0.2, vec3(0.46,0.38,0.67), vec3(TEXTURE_LAMBERTIAN,0.82,0.0)),
-    sphere(vec3(-9.56,0.20,-3.18), 0.2, vec3(0.87,0.39,0.11), vec3(TEXTURE_LAMBERTIAN,0.76,0.0)),
-    sphere(vec3(-9.51,0.20,-2.17), 0.2, vec3(0.99,0.95,0.20), vec3(TEXTURE_LAMBERTIAN,0.14,0.0)),
-    sphere(vec3(-9.65,0.20,-1.99), 0.2, vec3(0.02,0.54,0.48), vec3(TEXTURE_LAMBERTIAN,0.78,0.0)),
-    sphere(vec3(-9.20,0.20,-0.82), 0.2, vec3(0.80,0.24,0.15), vec3(TEXTURE_METAL,0.44,0.0)),
-    sphere(vec3(-9.42,0.20,0.08), 0.2, vec3(0.35,0.73,0.58), vec3(TEXTURE_LAMBERTIAN,0.63,0.0)),
-    sphere(vec3(-9.85,0.20,1.64), 0.2, vec3(0.80,0.04,0.45), vec3(TEXTURE_LAMBERTIAN,0.13,0.0)),
-    sphere(vec3(-9.71,0.20,2.75), 0.2, vec3(0.11,0.78,0.42), vec3(TEXTURE_LAMBERTIAN,0.66,0.0)),
-    sphere(vec3(-9.31,0.20,3.16), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-9.91,0.20,4.22), 0.2, vec3(0.21,0.97,0.28), vec3(TEXTURE_LAMBERTIAN,0.34,0.0)),
-    sphere(vec3(-9.83,0.20,5.20), 0.2, vec3(0.30,0.17,0.41), vec3(TEXTURE_LAMBERTIAN,0.40,0.0)),
-    sphere(vec3(-9.31,0.20,6.14), 0.2, vec3(0.58,0.02,0.96), vec3(TEXTURE_LAMBERTIAN,0.88,0.0)),
-    sphere(vec3(-9.88,0.20,7.30), 0.2, vec3(0.50,0.23,0.85), vec3(TEXTURE_LAMBERTIAN,0.29,0.0)),
-    sphere(vec3(-9.74,0.20,8.01), 0.2, vec3(0.72,0.36,0.38), vec3(TEXTURE_LAMBERTIAN,0.10,0.0)),
-    sphere(vec3(-9.62,0.20,9.46), 0.2, vec3(0.26,0.40,0.25), vec3(TEXTURE_LAMBERTIAN,0.69,0.0)),
-    sphere(vec3(-9.45,0.20,10.43), 0.2, vec3(0.33,0.25,0.51), vec3(TEXTURE_METAL,0.49,0.0)),
-    sphere(vec3(-8.72,0.20,-10.46), 0.2, vec3(0.32,0.75,0.23), vec3(TEXTURE_LAMBERTIAN,0.96,0.0)),
-    sphere(vec3(-8.52,0.20,-9.14), 0.2, vec3(0.29,0.67,0.93), vec3(TEXTURE_LAMBERTIAN,0.87,0.0)),
-    sphere(vec3(-8.37,0.20,-8.79), 0.2, vec3(0.14,0.94,0.42), vec3(TEXTURE_LAMBERTIAN,0.20,0.0)),
-    sphere(vec3(-8.61,0.20,-7.57), 0.2, vec3(0.08,0.91,0.51), vec3(TEXTURE_LAMBERTIAN,0.24,0.0)),
-    sphere(vec3(-8.83,0.20,-6.44), 0.2, vec3(0.91,0.86,0.28), vec3(TEXTURE_LAMBERTIAN,0.40,0.0)),
-    sphere(vec3(-8.54,0.20,-5.84), 0.2, vec3(0.29,0.82,0.36), vec3(TEXTURE_LAMBERTIAN,0.82,0.0)),
-    sphere(vec3(-8.82,0.20,-4.56), 0.2, vec3(0.88,0.62,0.20), vec3(TEXTURE_LAMBERTIAN,0.86,0.0)),
-    sphere(vec3(-8.85,0.20,-3.15), 0.2, vec3(0.13,0.60,0.56), vec3(TEXTURE_LAMBERTIAN,0.97,0.0)),
-    sphere(vec3(-8.72,0.20,-2.50), 0.2, vec3(0.82,0.24,0.74), vec3(TEXTURE_LAMBERTIAN,0.12,0.0)),
-    sphere(vec3(-8.21,0.20,-1.72), 0.2, vec3(0.13,0.06,0.74), vec3(TEXTURE_LAMBERTIAN,0.67,0.0)),
-    sphere(vec3(-8.59,0.20,-0.99), 0.2, vec3(0.34,0.50,0.53), vec3(TEXTURE_LAMBERTIAN,0.63,0.0)),
-    sphere(vec3(-8.84,0.20,0.21), 0.2, vec3(0.71,0.88,0.73), vec3(TEXTURE_LAMBERTIAN,0.60,0.0)),
-    sphere(vec3(-8.98,0.20,1.43), 0.2, vec3(0.47,0.08,0.65), vec3(TEXTURE_LAMBERTIAN,0.75,0.0)),
-    sphere(vec3(-8.19,0.20,2.48), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-8.18,0.20,3.18), 0.2, vec3(0.33,0.33,0.85), vec3(TEXTURE_LAMBERTIAN,0.37,0.0)),
-    sphere(vec3(-8.96,0.20,4.53), 0.2, vec3(0.43,0.49,0.49), vec3(TEXTURE_LAMBERTIAN,0.77,0.0)),
-    sphere(vec3(-8.12,0.20,5.70), 0.2, vec3(0.63,0.07,0.63), vec3(TEXTURE_LAMBERTIAN,0.75,0.0)),
-    sphere(vec3(-8.71,0.20,6.27), 0.2, vec3(0.72,0.52,0.99), vec3(TEXTURE_LAMBERTIAN,0.63,0.0)),
-    sphere(vec3(-8.33,0.20,7.30), 0.2, vec3(0.46,0.08,0.68), vec3(TEXTURE_LAMBERTIAN,0.68,0.0)),
-    sphere(vec3(-8.94,0.20,8.06), 0.2, vec3(0.13,0.48,0.26), vec3(TEXTURE_LAMBERTIAN,0.53,0.0)),
-    sphere(vec3(-8.13,0.20,9.11), 0.2, vec3(0.42,0.72,0.27), vec3(TEXTURE_LAMBERTIAN,0.76,0.0)),
-    sphere(vec3(-8.45,0.20,10.05), 0.2, vec3(0.92,0.94,0.90), vec3(TEXTURE_LAMBERTIAN,0.49,0.0)),
-    sphere(vec3(-7.80,0.20,-10.29), 0.2, vec3(0.71,0.23,0.51), vec3(TEXTURE_LAMBERTIAN,0.45,0.0)),
-    sphere(vec3(-7.75,0.20,-9.41), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-7.60,0.20,-9.00), 0.2, vec3(0.25,0.22,0.30), vec3(TEXTURE_LAMBERTIAN,0.97,0.0)),
-    sphere(vec3(-7.63,0.20,-7.56), 0.2, vec3(0.28,0.72,0.54), vec3(TEXTURE_METAL,0.22,0.0)),
-    sphere(vec3(-7.70,0.20,-6.32), 0.2, vec3(0.88,0.01,0.86), vec3(TEXTURE_LAMBERTIAN,0.80,0.0)),
-    sphere(vec3(-7.17,0.20,-5.92), 0.2, vec3(0.95,0.90,0.98), vec3(TEXTURE_LAMBERTIAN,0.91,0.0)),
-    sphere(vec3(-7.30,0.20,-4.99), 0.2, vec3(0.33,0.65,0.59), vec3(TEXTURE_METAL,0.03,0.0)),
-    sphere(vec3(-7.12,0.20,-3.89), 0.2, vec3(0.07,0.71,0.66), vec3(TEXTURE_LAMBERTIAN,0.53,0.0)),
-    sphere(vec3(-7.99,0.20,-2.61), 0.2, vec3(0.99,0.31,0.34), vec3(TEXTURE_LAMBERTIAN,0.07,0.0)),
-    sphere(vec3(-7.68,0.20,-1.23), 0.2, vec3(0.96,0.22,0.84), vec3(TEXTURE_LAMBERTIAN,0.75,0.0)),
-    sphere(vec3(-7.32,0.20,-0.12), 0.2, vec3(0.83,0.20,0.35), vec3(TEXTURE_LAMBERTIAN,0.19,0.0)),
-    sphere(vec3(-7.22,0.20,0.69), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-7.25,0.20,1.30), 0.2, vec3(0.49,0.21,0.12), vec3(TEXTURE_LAMBERTIAN,0.55,0.0)),
-    sphere(vec3(-7.68,0.20,2.68), 0.2, vec3(0.83,0.85,0.98), vec3(TEXTURE_LAMBERTIAN,0.77,0.0)),
-    sphere(vec3(-7.12,0.20,3.05), 0.2, vec3(0.03,0.08,0.87), vec3(TEXTURE_LAMBERTIAN,0.84,0.0)),
-    sphere(vec3(-7.45,0.20,4.66), 0.2, vec3(0.92,0.27,0.95), vec3(TEXTURE_LAMBERTIAN,0.66,0.0)),
-    sphere(vec3(-7.22,0.20,5.28), 0.2, vec3(0.94,0.56,0.81), vec3(TEXTURE_LAMBERTIAN,0.23,0.0)),
-    sphere(vec3(-7.86,0.20,6.60), 0.2, vec3(0.07,0.18,0.63), vec3(TEXTURE_LAMBERTIAN,0.97,0.0)),
-    sphere(vec3(-7.58,0.20,7.71), 0.2, vec3(0.01,0.90,0.65), vec3(TEXTURE_LAMBERTIAN,0.88,0.0)),
-    sphere(vec3(-7.91,0.20,8.53), 0.2, vec3(0.69,0.33,0.23), vec3(TEXTURE_LAMBERTIAN,0.99,0.0)),
-    sphere(vec3(-7.17,0.20,9.20), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-7.58,0.20,10.39), 0.2, vec3(0.64,0.15,0.84), vec3(TEXTURE_METAL,0.56,0.0)),
-    sphere(vec3(-6.60,0.20,-10.42), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-6.52,0.20,-9.93), 0.2, vec3(0.26,0.19,0.74), vec3(TEXTURE_LAMBERTIAN,0.78,0.0)),
-    sphere(vec3(-6.39,0.20,-8.59), 0.2, vec3(0.32,0.10,0.19), vec3(TEXTURE_LAMBERTIAN,0.18,0.0)),
-    sphere(vec3(-6.25,0.20,-7.98), 0.2, vec3(0.30,0.16,0.14), vec3(TEXTURE_LAMBERTIAN,0.24,0.0)),
-    sphere(vec3(-6.30,0.20,-6.63), 0.2, vec3(0.95,0.29,0.02), vec3(TEXTURE_LAMBERTIAN,0.44,0.0)),
-    sphere(vec3(-6.75,0.20,-5.92), 0.2, vec3(0.59,0.80,0.75), vec3(TEXTURE_LAMBERTIAN,0.20,0.0)),
-    sphere(vec3(-6.49,0.20,-4.47), 0.2, vec3(0.26,0.02,0.90), vec3(TEXTURE_LAMBERTIAN,0.19,0.0)),
-    sphere(vec3(-6.50,0.20,-3.46), 0.2, vec3(0.04,0.40,0.93), vec3(TEXTURE_LAMBERTIAN,0.10,0.0)),
-    sphere(vec3(-6.88,0.20,-2.63), 0.2, vec3(0.45,0.85,0.06), vec3(TEXTURE_LAMBERTIAN,0.61,0.0)),
-    sphere(vec3(-6.80,0.20,-1.94), 0.2, vec3(0.74,0.95,0.98), vec3(TEXTURE_LAMBERTIAN,0.64,0.0)),
-    sphere(vec3(-6.38,0.20,-0.38), 0.2, vec3(0.74,0.44,0.99), vec3(TEXTURE_LAMBERTIAN,0.23,0.0)),
-    sphere(vec3(-6.11,0.20,0.33), 0.2, vec3(0.85,0.40,0.84), vec3(TEXTURE_LAMBERTIAN,0.73,0.0)),
-    sphere(vec3(-6.68,0.20,1.85), 0.2, vec3(0.84,0.72,0.40), vec3(TEXTURE_LAMBERTIAN,0.38,0.0)),
-    sphere(vec3(-6.40,0.20,2.06), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-6.85,0.20,3.33), 0.2, vec3(0.40,0.40,0.15), vec3(TEXTURE_LAMBERTIAN,0.11,0.0)),
-    sphere(vec3(-6.91,0.20,4.41), 0.2, vec3(0.73,0.75,0.47), vec3(TEXTURE_LAMBERTIAN,0.92,0.0)),
-    sphere(vec3(-6.81,0.20,5.59), 0.2, vec3(0.81,0.42,0.06), vec3(TEXTURE_LAMBERTIAN,0.05,0.0)),
-    sphere(vec3(-6.63,0.20,6.80), 0.2, vec3(0.68,0.07,0.03), vec3(TEXTURE_LAMBERTIAN,0.20,0.0)),
-    sphere(vec3(-6.67,0.20,7.30), 0.2, vec3(0.06,0.09,0.18), vec3(TEXTURE_LAMBERTIAN,0.80,0.0)),
-    sphere(vec3(-6.56,0.20,8.64), 0.2, vec3(0.38,0.07,0.40), vec3(TEXTURE_LAMBERTIAN,0.91,0.0)),
-    sphere(vec3(-6.87,0.20,9.33), 0.2, vec3(0.53,1.00,0.87), vec3(TEXTURE_METAL,0.42,0.0)),
-    sphere(vec3(-6.96,0.20,10.30), 0.2, vec3(0.43,0.33,0.18), vec3(TEXTURE_LAMBERTIAN,0.86,0.0)),
-    sphere(vec3(-5.88,0.20,-10.77), 0.2, vec3(0.58,0.28,0.95), vec3(TEXTURE_LAMBERTIAN,0.09,0.0)),
-    sphere(vec3(-5.30,0.20,-9.71), 0.2, vec3(0.39,0.01,0.19), vec3(TEXTURE_LAMBERTIAN,0.37,0.0)),
-    sphere(vec3(-5.36,0.20,-8.11), 0.2, vec3(0.88,0.93,0.62), vec3(TEXTURE_METAL,0.64,0.0)),
-    sphere(vec3(-5.47,0.20,-7.35), 0.2, vec3(0.46,0.30,0.64), vec3(TEXTURE_LAMBERTIAN,0.06,0.0)),
-    sphere(vec3(-5.55,0.20,-6.50), 0.2, vec3(0.90,0.93,0.71), vec3(TEXTURE_METAL,0.13,0.0)),
-    sphere(vec3(-5.40,0.20,-5.69), 0.2, vec3(0.43,0.64,0.27), vec3(TEXTURE_LAMBERTIAN,0.66,0.0)),
-    sphere(vec3(-5.36,0.20,-4.70), 0.2, vec3(0.60,0.92,0.24), vec3(TEXTURE_METAL,0.65,0.0)),
-    sphere(vec3(-5.55,0.20,-3.30), 0.2, vec3(0.24,0.28,0.40), vec3(TEXTURE_LAMBERTIAN,0.89,0.0)),
-    sphere(vec3(-5.82,0.20,-2.64), 0.2, vec3(0.50,0.78,0.61), vec3(TEXTURE_LAMBERTIAN,0.77,0.0)),
-    sphere(vec3(-5.88,0.20,-1.25), 0.2, vec3(0.98,0.13,0.50), vec3(TEXTURE_LAMBERTIAN,0.25,0.0)),
-    sphere(vec3(-5.39,0.20,-0.80), 0.2, vec3(0.84,0.91,0.67), vec3(TEXTURE_LAMBERTIAN,0.45,0.0)),
-    sphere(vec3(-5.21,0.20,0.86), 0.2, vec3(0.84,0.42,0.97), vec3(TEXTURE_LAMBERTIAN,0.71,0.0)),
-    sphere(vec3(-5.91,0.20,1.61), 0.2, vec3(0.08,0.78,0.22), vec3(TEXTURE_LAMBERTIAN,0.70,0.0)),
-    sphere(vec3(-5.92,0.20,2.19), 0.2, vec3(0.92,0.17,0.98), vec3(TEXTURE_LAMBERTIAN,0.52,0.0)),
-    sphere(vec3(-5.24,0.20,3.52), 0.2, vec3(0.20,0.01,0.01), vec3(TEXTURE_LAMBERTIAN,0.39,0.0)),
-    sphere(vec3(-5.25,0.20,4.18), 0.2, vec3(0.28,0.29,0.08), vec3(TEXTURE_LAMBERTIAN,0.78,0.0)),
-    sphere(vec3(-5.80,0.20,5.83), 0.2, vec3(0.05,0.33,0.08), vec3(TEXTURE_LAMBERTIAN,0.28,0.0)),
-    sphere(vec3(-5.69,0.20,6.49), 0.2, vec3(0.90,0.86,1.00), vec3(TEXTURE_LAMBERTIAN,0.53,0.0)),
-    sphere(vec3(-5.25,0.20,7.55), 0.2, vec3(0.76,0.75,0.65), vec3(TEXTURE_LAMBERTIAN,0.99,0.0)),
-    sphere(vec3(-5.34,0.20,8.49), 0.2, vec3(0.97,0.59,0.49), vec3(TEXTURE_LAMBERTIAN,0.78,0.0)),
-    sphere(vec3(-5.67,0.20,9.03), 0.2, vec3(0.44,0.48,0.78), vec3(TEXTURE_LAMBERTIAN,0.08,0.0)),
-    sphere(vec3(-5.67,0.20,10.47), 0.2, vec3(0.47,0.02,0.60), vec3(TEXTURE_LAMBERTIAN,0.12,0.0)),
-    sphere(vec3(-4.92,0.20,-10.70), 0.2, vec3(0.04,0.48,0.52), vec3(TEXTURE_LAMBERTIAN,0.21,0.0)),
-    sphere(vec3(-4.23,0.20,-9.14), 0.2, vec3(0.92,0.82,0.86), vec3(TEXTURE_METAL,0.98,0.0)),
-    sphere(vec3(-4.52,0.20,-8.26), 0.2, vec3(0.86,0.02,0.17), vec3(TEXTURE_LAMBERTIAN,0.91,0.0)),
-    sphere(vec3(-4.34,0.20,-7.29), 0.2, vec3(0.92,0.56,0.59), vec3(TEXTURE_METAL,0.73,0.0)),
-    sphere(vec3(-4.44,0.20,-6.91), 0.2, vec3(0.57,0.32,0.29), vec3(TEXTURE_LAMBERTIAN,0.73,0.0)),
-    sphere(vec3(-4.12,0.20,-5.95), 0.2, vec3(0.97,0.32,0.64), vec3(TEXTURE_LAMBERTIAN,0.79,0.0)),
-    sphere(vec3(-4.49,0.20,-4.17), 0.2, vec3(0.98,0.12,0.96), vec3(TEXTURE_LAMBERTIAN,0.45,0.0)),
-    sphere(vec3(-4.49,0.20,-3.46), 0.2, vec3(0.51,0.06,0.41), vec3(TEXTURE_LAMBERTIAN,0.76,0.0)),
-    sphere(vec3(-4.52,0.20,-2.52), 0.2, vec3(0.37,0.33,0.47), vec3(TEXTURE_LAMBERTIAN,0.68,0.0)),
-    sphere(vec3(-4.70,0.20,-1.34), 0.2, vec3(0.10,0.91,0.06), vec3(TEXTURE_LAMBERTIAN,0.66,0.0)),
-    sphere(vec3(-4.40,0.20,-0.65), 0.2, vec3(0.41,0.21,0.46), vec3(TEXTURE_LAMBERTIAN,0.50,0.0)),
-    sphere(vec3(-4.90,0.20,0.44), 0.2, vec3(0.26,0.33,0.29), vec3(TEXTURE_LAMBERTIAN,0.36,0.0)),
-    sphere(vec3(-4.98,0.20,1.06), 0.2, vec3(0.60,0.74,0.90), vec3(TEXTURE_LAMBERTIAN,0.13,0.0)),
-    sphere(vec3(-4.78,0.20,2.82), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-4.49,0.20,3.40), 0.2, vec3(0.35,0.56,0.04), vec3(TEXTURE_METAL,0.35,0.0)),
-    sphere(vec3(-4.20,0.20,4.57), 0.2, vec3(0.68,0.66,0.34), vec3(TEXTURE_LAMBERTIAN,0.86,0.0)),
-    sphere(vec3(-5.00,0.20,5.02), 0.2, vec3(0.63,0.20,1.00), vec3(TEXTURE_LAMBERTIAN,0.39,0.0)),
-    sphere(vec3(-4.25,0.20,6.77), 0.2, vec3(0.42,0.65,0.28), vec3(TEXTURE_METAL,0.92,0.0)),
-    sphere(vec3(-4.39,0.20,7.42), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-4.61,0.20,8.51), 0.2, vec3(0.28,0.98,0.92), vec3(TEXTURE_METAL,0.32,0.0)),
-    sphere(vec3(-4.20,0.20,9.30), 0.2, vec3(0.12,0.52,0.31), vec3(TEXTURE_LAMBERTIAN,0.11,0.0)),
-    sphere(vec3(-4.74,0.20,10.28), 0.2, vec3(0.49,0.26,0.41), vec3(TEXTURE_LAMBERTIAN,0.33,0.0)),
-    sphere(vec3(-3.96,0.20,-10.16), 0.2, vec3(0.21,0.45,0.78), vec3(TEXTURE_LAMBERTIAN,0.98,0.0)),
-    sphere(vec3(-3.52,0.20,-9.51), 0.2, vec3(0.15,0.65,0.08), vec3(TEXTURE_LAMBERTIAN,0.67,0.0)),
-    sphere(vec3(-3.62,0.20,-8.17), 0.2, vec3(0.44,0.80,0.62), vec3(TEXTURE_LAMBERTIAN,0.64,0.0)),
-    sphere(vec3(-3.76,0.20,-7.26), 0.2, vec3(0.97,0.80,0.71), vec3(TEXTURE_LAMBERTIAN,0.06,0.0)),
-    sphere(vec3(-3.17,0.20,-6.96), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-3.89,0.20,-5.66), 0.2, vec3(0.89,0.87,0.01), vec3(TEXTURE_LAMBERTIAN,0.44,0.0)),
-    sphere(vec3(-3.64,0.20,-4.72), 0.2, vec3(0.29,0.55,0.22), vec3(TEXTURE_LAMBERTIAN,0.40,0.0)),
-    sphere(vec3(-3.27,0.20,-3.96), 0.2, vec3(0.43,0.23,0.31), vec3(TEXTURE_LAMBERTIAN,0.62,0.0)),
-    sphere(vec3(-3.39,0.20,-2.22), 0.2, vec3(0.64,0.17,0.80), vec3(TEXTURE_LAMBERTIAN,0.58,0.0)),
-    sphere(vec3(-3.57,0.20,-1.18), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-3.36,0.20,-0.19), 0.2, vec3(0.89,0.23,0.53), vec3(TEXTURE_LAMBERTIAN,0.43,0.0)),
-    sphere(vec3(-3.64,0.20,0.85), 0.2, vec3(0.89,0.21,0.45), vec3(TEXTURE_LAMBERTIAN,0.03,0.0)),
-    sphere(vec3(-3.88,0.20,1.07), 0.2, vec3(0.84,0.81,0.87), vec3(TEXTURE_METAL,0.51,0.0)),
-    sphere(vec3(-3.41,0.20,2.74), 0.2, vec3(0.68,0.82,0.28), vec3(TEXTURE_METAL,0.90,0.0)),
-    sphere(vec3(-3.40,0.20,3.70), 0.2, vec3(0.65,0.57,0.20), vec3(TEXTURE_LAMBERTIAN,0.75,0.0)),
-    sphere(vec3(-3.27,0.20,4.57), 0.2, vec3(0.95,0.03,0.73), vec3(TEXTURE_LAMBERTIAN,0.79,0.0)),
-    sphere(vec3(-3.88,0.20,5.19), 0.2, vec3(0.70,0.01,0.89), vec3(TEXTURE_LAMBERTIAN,0.87,0.0)),
-    sphere(vec3(-3.59,0.20,6.59), 0.2, vec3(0.53,0.44,0.57), vec3(TEXTURE_METAL,0.73,0.0)),
-    sphere(vec3(-3.46,0.20,7.58), 0.2, vec3(0.25,0.13,0.68), vec3(TEXTURE_LAMBERTIAN,0.77,0.0)),
-    sphere(vec3(-3.46,0.20,8.17), 0.2, vec3(0.90,0.30,0.34), vec3(TEXTURE_LAMBERTIAN,0.77,0.0)),
-    sphere(vec3(-3.75,0.20,9.52), 0.2, vec3(0.14,0.19,0.70), vec3(TEXTURE_LAMBERTIAN,0.16,0.0)),
-    sphere(vec3(-3.74,0.20,10.27), 0.2, vec3(0.17,0.74,0.14), vec3(TEXTURE_LAMBERTIAN,0.00,0.0)),
-    sphere(vec3(-2.53,0.20,-10.28), 0.2, vec3(0.46,0.87,0.70), vec3(TEXTURE_LAMBERTIAN,0.09,0.0)),
-    sphere(vec3(-2.71,0.20,-9.52), 0.2, vec3(0.38,0.25,0.56), vec3(TEXTURE_METAL,0.18,0.0)),
-    sphere(vec3(-2.77,0.20,-8.11), 0.2, vec3(0.38,0.73,0.44), vec3(TEXTURE_LAMBERTIAN,0.42,0.0)),
-    sphere(vec3(-2.89,0.20,-7.24), 0.2, vec3(0.79,1.00,0.79), vec3(TEXTURE_LAMBERTIAN,0.48,0.0)),
-    sphere(vec3(-2.70,0.20,-6.14), 0.2, vec3(0.69,0.97,0.61), vec3(TEXTURE_LAMBERTIAN,0.05,0.0)),
-    sphere(vec3(-2.81,0.20,-5.82), 0.2, vec3(0.02,0.72,0.87), vec3(TEXTURE_LAMBERTIAN,0.86,0.0)),
-    sphere(vec3(-2.55,0.20,-4.72), 0.2, vec3(0.80,0.13,0.71), vec3(TEXTURE_LAMBERTIAN,0.73,0.0)),
-    sphere(vec3(-2.70,0.20,-3.63), 0.2, vec3(0.67,0.78,0.31), vec3(TEXTURE_LAMBERTIAN,0.62,0.0)),
-    sphere(vec3(-2.34,0.20,-2.35), 0.2, vec3(0.11,0.10,0.64), vec3(TEXTURE_LAMBERTIAN,0.64,0.0)),
-    sphere(vec3(-2.33,0.20,-1.58), 0.2, vec3(0.97,0.55,0.80), vec3(TEXTURE_LAMBERTIAN,0.09,0.0)),
-    sphere(vec3(-2.34,0.20,-0.19), 0.2, vec3(0.11,0.91,0.40), vec3(TEXTURE_LAMBERTIAN,0.79,0.0)),
-    sphere(vec3(-2.88,0.20,0.19), 0.2, vec3(0.96,0.60,0.09), vec3(TEXTURE_LAMBERTIAN,0.07,0.0)),
-    sphere(vec3(-2.26,0.20,1.77), 0.2, vec3(0.77,0.16,0.67), vec3(TEXTURE_LAMBERTIAN,0.47,0.0)),
-    sphere(vec3(-2.35,0.20,2.48), 0.2, vec3(0.46,0.14,0.58), vec3(TEXTURE_LAMBERTIAN,0.21,0.0)),
-    sphere(vec3(-2.59,0.20,3.36), 0.2, vec3(0.30,0.78,0.56), vec3(TEXTURE_LAMBERTIAN,0.62,0.0)),
-    sphere(vec3(-2.69,0.20,4.63), 0.2, vec3(0.13,0.32,0.39), vec3(TEXTURE_METAL,0.02,0.0)),
-    sphere(vec3(-2.99,0.20,5.67), 0.2, vec3(0.79,0.97,0.28), vec3(TEXTURE_LAMBERTIAN,1.00,0.0)),
-    sphere(vec3(-2.65,0.20,6.14), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-2.59,0.20,7.45), 0.2, vec3(0.15,0.85,0.60), vec3(TEXTURE_METAL,0.12,0.0)),
-    sphere(vec3(-2.93,0.20,8.64), 0.2, vec3(0.99,0.86,0.00), vec3(TEXTURE_LAMBERTIAN,0.72,0.0)),
-    sphere(vec3(-2.45,0.20,9.30), 0.2, vec3(0.16,0.12,0.03), vec3(TEXTURE_LAMBERTIAN,0.91,0.0)),
-    sphere(vec3(-2.90,0.20,10.09), 0.2, vec3(0.86,0.17,0.50), vec3(TEXTURE_LAMBERTIAN,0.94,0.0)),
-    sphere(vec3(-1.60,0.20,-10.53), 0.2, vec3(0.85,0.31,0.15), vec3(TEXTURE_LAMBERTIAN,0.32,0.0)),
-    sphere(vec3(-1.63,0.20,-9.15), 0.2, vec3(0.87,0.64,0.36), vec3(TEXTURE_LAMBERTIAN,0.77,0.0)),
-    sphere(vec3(-1.16,0.20,-8.63), 0.2, vec3(0.34,0.35,0.81), vec3(TEXTURE_METAL,0.44,0.0)),
-    sphere(vec3(-1.35,0.20,-7.91), 0.2, vec3(0.06,0.90,0.41), vec3(TEXTURE_LAMBERTIAN,0.01,0.0)),
-    sphere(vec3(-1.70,0.20,-6.59), 0.2, vec3(0.25,0.10,0.22), vec3(TEXTURE_METAL,0.42,0.0)),
-    sphere(vec3(-1.62,0.20,-5.61), 0.2, vec3(0.75,0.01,0.15), vec3(TEXTURE_LAMBERTIAN,0.44,0.0)),
-    sphere(vec3(-1.93,0.20,-4.18), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-1.97,0.20,-3.92), 0.2, vec3(0.25,0.85,0.15), vec3(TEXTURE_LAMBERTIAN,0.12,0.0)),
-    sphere(vec3(-1.14,0.20,-2.29), 0.2, vec3(0.42,0.59,0.69), vec3(TEXTURE_METAL,0.35,0.0)),
-    sphere(vec3(-1.49,0.20,-1.99), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-1.75,0.20,-0.33), 0.2, vec3(0.42,0.51,0.81), vec3(TEXTURE_LAMBERTIAN,0.93,0.0)),
-    sphere(vec3(-1.74,0.20,0.89), 0.2, vec3(0.71,0.06,0.78), vec3(TEXTURE_LAMBERTIAN,0.27,0.0)),
-    sphere(vec3(-1.69,0.20,1.79), 0.2, vec3(0.60,0.18,0.44), vec3(TEXTURE_LAMBERTIAN,0.72,0.0)),
-    sphere(vec3(-1.73,0.20,2.01), 0.2, vec3(0.44,0.75,0.70), vec3(TEXTURE_LAMBERTIAN,0.64,0.0)),
-    sphere(vec3(-1.23,0.20,3.09), 0.2, vec3(0.31,0.58,0.48), vec3(TEXTURE_METAL,0.31,0.0)),
-    sphere(vec3(-1.30,0.20,4.49), 0.2, vec3(0.74,0.56,0.72), vec3(TEXTURE_LAMBERTIAN,0.29,0.0)),
-    sphere(vec3(-1.66,0.20,5.79), 0.2, vec3(0.50,0.95,0.65), vec3(TEXTURE_LAMBERTIAN,0.33,0.0)),
-    sphere(vec3(-1.17,0.20,6.86), 0.2, vec3(0.95,0.39,0.46), vec3(TEXTURE_LAMBERTIAN,0.38,0.0)),
-    sphere(vec3(-1.99,0.20,7.81), 0.2, vec3(0.00,0.02,0.94), vec3(TEXTURE_LAMBERTIAN,0.67,0.0)),
-    sphere(vec3(-1.91,0.20,8.54), 0.2, vec3(0.62,0.61,0.17), vec3(TEXTURE_LAMBERTIAN,0.39,0.0)),
-    sphere(vec3(-1.97,0.20,9.23), 0.2, vec3(0.11,0.95,0.72), vec3(TEXTURE_LAMBERTIAN,0.34,0.0)),
-    sphere(vec3(-1.77,0.20,10.40), 0.2, vec3(0.35,0.24,0.80), vec3(TEXTURE_METAL,0.76,0.0)),
-    sphere(vec3(-0.20,0.20,-10.75), 0.2, vec3(0.46,0.15,0.29), vec3(TEXTURE_LAMBERTIAN,0.78,0.0)),
-    sphere(vec3(-0.35,0.20,-9.29), 0.2, vec3(0.54,0.38,0.02), vec3(TEXTURE_LAMBERTIAN,0.28,0.0)),
-    sphere(vec3(-0.55,0.20,-8.25), 0.2, vec3(0.37,0.56,0.91), vec3(TEXTURE_LAMBERTIAN,0.84,0.0)),
-    sphere(vec3(-0.49,0.20,-7.72), 0.2, vec3(0.53,0.94,0.07), vec3(TEXTURE_LAMBERTIAN,0.08,0.0)),
-    sphere(vec3(-0.47,0.20,-6.43), 0.2, vec3(0.74,0.61,0.83), vec3(TEXTURE_LAMBERTIAN,0.99,0.0)),
-    sphere(vec3(-0.89,0.20,-5.35), 0.2, vec3(0.67,0.67,0.72), vec3(TEXTURE_LAMBERTIAN,0.68,0.0)),
-    sphere(vec3(-0.66,0.20,-4.95), 0.2, vec3(0.65,0.53,0.11), vec3(TEXTURE_LAMBERTIAN,0.62,0.0)),
-    sphere(vec3(-0.19,0.20,-3.14), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-0.66,0.20,-2.87), 0.2, vec3(0.82,0.72,0.53), vec3(TEXTURE_METAL,0.68,0.0)),
-    sphere(vec3(-0.33,0.20,-1.39), 0.2, vec3(0.84,0.02,0.58), vec3(TEXTURE_LAMBERTIAN,0.92,0.0)),
-    sphere(vec3(-0.72,0.20,-0.75), 0.2, vec3(0.38,0.17,0.48), vec3(TEXTURE_LAMBERTIAN,0.01,0.0)),
-    sphere(vec3(-0.85,0.20,0.88), 0.2, vec3(0.68,0.41,0.73), vec3(TEXTURE_LAMBERTIAN,0.87,0.0)),
-    sphere(vec3(-0.59,0.20,1.27), 0.2, vec3(0.59,0.08,0.15), vec3(TEXTURE_LAMBERTIAN,0.69,0.0)),
-    sphere(vec3(-0.13,0.20,2.73), 0.2, vec3(0.11,0.47,0.70), vec3(TEXTURE_LAMBERTIAN,0.10,0.0)),
-    sphere(vec3(-0.83,0.20,3.38), 0.2, vec3(0.55,0.08,0.39), vec3(TEXTURE_LAMBERTIAN,0.11,0.0)),
-    sphere(vec3(-0.10,0.20,4.90), 0.2, vec3(0.78,0.72,0.60), vec3(TEXTURE_LAMBERTIAN,0.64,0.0)),
-    sphere(vec3(-0.79,0.20,5.09), 0.2, vec3(0.95,0.34,0.70), vec3(TEXTURE_LAMBERTIAN,0.38,0.0)),
-    sphere(vec3(-0.27,0.20,6.48), 0.2, vec3(0.74,0.38,0.30), vec3(TEXTURE_METAL,0.12,0.0)),
-    sphere(vec3(-0.63,0.20,7.71), 0.2, vec3(0.87,0.04,0.69), vec3(TEXTURE_LAMBERTIAN,0.90,0.0)),
-    sphere(vec3(-0.40,0.20,8.06), 0.2, vec3(0.37,0.80,0.45), vec3(TEXTURE_LAMBERTIAN,0.82,0.0)),
-    sphere(vec3(-0.99,0.20,9.55), 0.2, vec3(0.53,0.21,0.63), vec3(TEXTURE_LAMBERTIAN,0.33,0.0)),
-    sphere(vec3(-0.62,0.20,10.47), 0.2, vec3(0.33,0.47,0.83), vec3(TEXTURE_LAMBERTIAN,0.50,0.0)),
-    sphere(vec3(0.33,0.20,-10.13), 0.2, vec3(0.55,0.60,0.50), vec3(TEXTURE_METAL,0.34,0.0)),
-    sphere(vec3(0.46,0.20,-9.54), 0.2, vec3(0.83,0.80,0.17), vec3(TEXTURE_LAMBERTIAN,0.03,0.0)),
-    sphere(vec3(0.08,0.20,-8.87), 0.2, vec3(0.82,0.87,0.39), vec3(TEXTURE_LAMBERTIAN,0.74,0.0)),
-    sphere(vec3(0.49,0.20,-7.75), 0.2, vec3(0.66,0.08,0.78), vec3(TEXTURE_LAMBERTIAN,0.04,0.0)),
-    sphere(vec3(0.29,0.20,-6.48), 0.2, vec3(0.92,0.34,0.03), vec3(TEXTURE_LAMBERTIAN,0.28,0.0)),
-    sphere(vec3(0.55,0.20,-5.24), 0.2, vec3(0.93,0.05,0.37), vec3(TEXTURE_LAMBERTIAN,0.81,0.0)),
-    sphere(vec3(0.87,0.20,-4.97), 0.2, vec3(0.11,0.20,0.08), vec3(TEXTURE_METAL,0.67,0.0)),
-    sphere(vec3(0.64,0.20,-3.66), 0.2, vec3(0.82,0.85,0.22), vec3(TEXTURE_LAMBERTIAN,0.47,0.0)),
-    sphere(vec3(0.36,0.20,-2.93), 0.2, vec3(0.35,0.41,0.45), vec3(TEXTURE_LAMBERTIAN,0.31,0.0)),
-    sphere(vec3(0.49,0.20,-1.93), 0.2, vec3(0.69,0.52,0.17), vec3(TEXTURE_LAMBERTIAN,0.38,0.0)),
-    sphere(vec3(0.43,0.20,-0.74), 0.2, vec3(0.19,0.05,0.99), vec3(TEXTURE_LAMBERTIAN,0.81,0.0)),
-    sphere(vec3(0.54,0.20,0.40), 0.2, vec3(0.49,0.43,0.22), vec3(TEXTURE_LAMBERTIAN,0.36,0.0)),
-    sphere(vec3(0.09,0.20,1.13), 0.2, vec3(0.60,0.31,0.49), vec3(TEXTURE_LAMBERTIAN,0.55,0.0)),
-    sphere(vec3(0.42,0.20,2.39), 0.2, vec3(0.13,0.94,0.89), vec3(TEXTURE_LAMBERTIAN,0.86,0.0)),
-    sphere(vec3(0.51,0.20,3.49), 0.2, vec3(0.56,0.47,0.43), vec3(TEXTURE_LAMBERTIAN,0.61,0.0)),
-    sphere(vec3(0.70,0.20,4.87), 0.2, vec3(0.30,0.90,0.25), vec3(TEXTURE_METAL,0.19,0.0)),
-    sphere(vec3(0.81,0.20,5.57), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(0.56,0.20,6.72), 0.2, vec3(0.18,0.34,0.86), vec3(TEXTURE_LAMBERTIAN,0.18,0.0)),
-    sphere(vec3(0.14,0.20,7.67), 0.2, vec3(0.64,0.59,0.39), vec3(TEXTURE_LAMBERTIAN,0.16,0.0)),
-    sphere(vec3(0.35,0.20,8.33), 0.2, vec3(0.74,0.64,0.72), vec3(TEXTURE_LAMBERTIAN,0.69,0.0)),
-    sphere(vec3(0.39,0.20,9.07), 0.2, vec3(0.92,0.61,0.32), vec3(TEXTURE_LAMBERTIAN,0.65,0.0)),
-    sphere(vec3(0.19,0.20,10.61), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(1.61,0.20,-10.41), 0.2, vec3(0.77,0.78,0.49), vec3(TEXTURE_LAMBERTIAN,0.33,0.0)),
-    sphere(vec3(1.85,0.20,-9.45), 0.2, vec3(0.80,0.93,0.20), vec3(TEXTURE_LAMBERTIAN,0.45,0.0)),
-    sphere(vec3(1.58,0.20,-9.00), 0.2, vec3(0.13,0.94,0.65), vec3(TEXTURE_LAMBERTIAN,0.44,0.0)),
-    sphere(vec3(1.08,0.20,-7.44), 0.2, vec3(0.71,0.66,0.81), vec3(TEXTURE_LAMBERTIAN,0.10,0.0)),
-    sphere(vec3(1.53,0.20,-6.87), 0.2, vec3(0.02,0.99,0.90), vec3(TEXTURE_METAL,0.83,0.0)),
-    sphere(vec3(1.28,0.20,-5.12), 0.2, vec3(0.68,0.39,0.59), vec3(TEXTURE_LAMBERTIAN,0.55,0.0)),
-    sphere(vec3(1.40,0.20,-4.79), 0.2, vec3(0.83,0.76,0.53), vec3(TEXTURE_LAMBERTIAN,0.61,0.0)),
-    sphere(vec3(1.70,0.20,-3.91), 0.2, vec3(0.49,0.22,0.74), vec3(TEXTURE_LAMBERTIAN,0.02,0.0)),
-    sphere(vec3(1.63,0.20,-2.31), 0.2, vec3(0.49,0.84,0.40), vec3(TEXTURE_LAMBERTIAN,0.99,0.0)),
-    sphere(vec3(1.84,0.20,-1.50), 0.2, vec3(0.73,0.24,0.77), vec3(TEXTURE_LAMBERTIAN,0.92,0.0)),
-    sphere(vec3(1.02,0.20,-0.24), 0.2, vec3(0.36,0.71,0.52), vec3(TEXTURE_LAMBERTIAN,0.14,0.0)),
-    sphere(vec3(1.05,0.20,0.23), 0.2, vec3(0.28,0.14,0.71), vec3(TEXTURE_LAMBERTIAN,0.56,0.0)),
-    sphere(vec3(1.47,0.20,1.26), 0.2, vec3(0.66,0.54,0.83), vec3(TEXTURE_LAMBERTIAN,0.15,0.0)),
-    sphere(vec3(1.74,0.20,2.74), 0.2, vec3(0.34,0.02,0.77), vec3(TEXTURE_LAMBERTIAN,0.22,0.0)),
-    sphere(vec3(1.53,0.20,3.26), 0.2, vec3(0.06,0.67,0.22), vec3(TEXTURE_LAMBERTIAN,0.35,0.0)),
-    sphere(vec3(1.88,0.20,4.34), 0.2, vec3(0.88,0.98,0.74), vec3(TEXTURE_LAMBERTIAN,0.75,0.0)),
-    sphere(vec3(1.33,0.20,5.36), 0.2, vec3(0.75,0.45,0.58), vec3(TEXTURE_LAMBERTIAN,0.04,0.0)),
-    sphere(vec3(1.26,0.20,6.67), 0.2, vec3(0.08,0.62,0.51), vec3(TEXTURE_LAMBERTIAN,0.25,0.0)),
-    sphere(vec3(1.26,0.20,7.68), 0.2, vec3(0.70,0.18,0.92), vec3(TEXTURE_LAMBERTIAN,0.19,0.0)),
-    sphere(vec3(1.89,0.20,8.62), 0.2, vec3(0.78,0.08,0.61), vec3(TEXTURE_LAMBERTIAN,0.83,0.0)),
-    sphere(vec3(1.08,0.20,9.33), 0.2, vec3(0.33,0.84,0.64), vec3(TEXTURE_METAL,0.92,0.0)),
-    sphere(vec3(1.24,0.20,10.42), 0.2, vec3(0.90,0.96,0.66), vec3(TEXTURE_LAMBERTIAN,0.99,0.0)),
-    sphere(vec3(2.04,0.20,-10.88), 0.2, vec3(0.63,0.47,0.14), vec3(TEXTURE_LAMBERTIAN,0.54,0.0)),
-    sphere(vec3(2.36,0.20,-9.18), 0.2, vec3(0.92,0.12,0.92), vec3(TEXTURE_METAL,0.71,0.0)),
-    sphere(vec3(2.56,0.20,-8.71), 0.2, vec3(0.32,0.25,0.92), vec3(TEXTURE_LAMBERTIAN,0.72,0.0)),
-    sphere(vec3(2.38,0.20,-7.80), 0.2, vec3(0.83,0.57,0.48), vec3(TEXTURE_LAMBERTIAN,0.49,0.0)),
-    sphere(vec3(2.73,0.20,-6.38), 0.2, vec3(0.43,0.15,0.13), vec3(TEXTURE_LAMBERTIAN,0.82,0.0)),
-    sphere(vec3(2.76,0.20,-5.60), 0.2, vec3(0.30,0.45,0.28), vec3(TEXTURE_LAMBERTIAN,0.40,0.0)),
-    sphere(vec3(2.22,0.20,-4.12), 0.2, vec3(0.27,0.65,0.53), vec3(TEXTURE_LAMBERTIAN,0.09,0.0)),
-    sphere(vec3(2.25,0.20,-3.15), 0.2, vec3(0.35,0.99,0.12), vec3(TEXTURE_LAMBERTIAN,0.61,0.0)),
-    sphere(vec3(2.58,0.20,-2.39), 0.2, vec3(0.29,0.00,0.29), vec3(TEXTURE_LAMBERTIAN,0.53,0.0)),
-    sphere(vec3(2.46,0.20,-1.46), 0.2, vec3(0.33,0.55,0.99), vec3(TEXTURE_LAMBERTIAN,0.65,0.0)),
-    sphere(vec3(2.10,0.20,-0.32), 0.2, vec3(0.04,0.59,0.82), vec3(TEXTURE_LAMBERTIAN,0.16,0.0)),
-    sphere(vec3(2.70,0.20,0.29), 0.2, vec3(0.98,0.78,0.65), vec3(TEXTURE_LAMBERTIAN,0.31,0.0)),
-    sphere(vec3(2.77,0.20,1.06), 0.2, vec3(0.35,0.55,0.28), vec3(TEXTURE_LAMBERTIAN,0.34,0.0)),
-    sphere(vec3(2.32,0.20,2.18), 0.2, vec3(0.08,0.35,0.30), vec3(TEXTURE_LAMBERTIAN,0.22,0.0)),
-    sphere(vec3(2.43,0.20,3.32), 0.2, vec3(0.79,0.31,0.83), vec3(TEXTURE_LAMBERTIAN,0.74,0.0)),
-    sphere(vec3(2.07,0.20,4.05), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(2.47,0.20,5.52), 0.2, vec3(0.73,0.72,0.21), vec3(TEXTURE_LAMBERTIAN,0.95,0.0)),
-    sphere(vec3(2.40,0.20,6.23), 0.2, vec3(0.74,0.00,0.90), vec3(TEXTURE_LAMBERTIAN,0.68,0.0)),
-    sphere(vec3(2.87,0.20,7.20), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(2.73,0.20,8.23), 0.2, vec3(0.77,0.84,0.87), vec3(TEXTURE_METAL,0.23,0.0)),
-    sphere(vec3(2.62,0.20,9.24), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(2.08,0.20,10.69), 0.2, vec3(0.16,0.55,0.78), vec3(TEXTURE_LAMBERTIAN,0.89,0.0)),
-    sphere(vec3(3.49,0.20,-10.89), 0.2, vec3(0.48,0.55,0.71), vec3(TEXTURE_LAMBERTIAN,0.50,0.0)),
-    sphere(vec3(3.30,0.20,-9.91), 0.2, vec3(0.69,1.00,0.50), vec3(TEXTURE_LAMBERTIAN,0.95,0.0)),
-    sphere(vec3(3.48,0.20,-8.94), 0.2, vec3(0.41,0.86,0.17), vec3(TEXTURE_LAMBERTIAN,0.11,0.0)),
-    sphere(vec3(3.02,0.20,-7.25), 0.2, vec3(0.31,0.44,0.77), vec3(TEXTURE_LAMBERTIAN,0.88,0.0)),
-    sphere(vec3(3.70,0.20,-6.55), 0.2, vec3(0.60,0.11,0.71), vec3(TEXTURE_LAMBERTIAN,0.61,0.0)),
-    sphere(vec3(3.27,0.20,-5.74), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(3.89,0.20,-4.56), 0.2, vec3(0.02,0.07,0.43), vec3(TEXTURE_METAL,0.38,0.0)),
-    sphere(vec3(3.87,0.20,-3.21), 0.2, vec3(0.98,0.60,0.54), vec3(TEXTURE_METAL,0.21,0.0)),
-    sphere(vec3(3.63,0.20,-2.28), 0.2, vec3(0.63,0.50,0.95), vec3(TEXTURE_LAMBERTIAN,0.79,0.0)),
-    sphere(vec3(3.51,0.20,-1.33), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(3.17,0.20,1.75), 0.2, vec3(0.02,0.61,0.45), vec3(TEXTURE_METAL,0.28,0.0)),
-    sphere(vec3(3.20,0.20,2.78), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(3.48,0.20,3.79), 0.2, vec3(0.85,0.77,0.37), vec3(TEXTURE_METAL,0.47,0.0)),
-    sphere(vec3(3.05,0.20,4.61), 0.2, vec3(0.32,0.96,0.62), vec3(TEXTURE_METAL,0.52,0.0)),
-    sphere(vec3(3.69,0.20,5.37), 0.2, vec3(0.79,0.08,0.55), vec3(TEXTURE_LAMBERTIAN,0.95,0.0)),
-    sphere(vec3(3.39,0.20,6.50), 0.2, vec3(0.29,0.50,0.12), vec3(TEXTURE_LAMBERTIAN,0.62,0.0)),
-    sphere(vec3(3.33,0.20,7.75), 0.2, vec3(0.58,0.42,0.60), vec3(TEXTURE_LAMBERTIAN,0.64,0.0)),
-    sphere(vec3(3.85,0.20,8.76), 0.2, vec3(0.43,0.67,0.07), vec3(TEXTURE_LAMBERTIAN,0.13,0.0)),
-    sphere(vec3(3.21,0.20,9.04), 0.2, vec3(0.61,0.37,0.92), vec3(TEXTURE_LAMBERTIAN,0.87,0.0)),
-    sphere(vec3(3.20,0.20,10.83), 0.2, vec3(0.48,0.76,0.32), vec3(TEXTURE_LAMBERTIAN,0.14,0.0)),
-    sphere(vec3(4.34,0.20,-10.91), 0.2, vec3(0.60,0.68,0.72), vec3(TEXTURE_LAMBERTIAN,0.53,0.0)),
-    sphere(vec3(4.23,0.20,-9.28), 0.2, vec3(0.13,0.33,0.83), vec3(TEXTURE_LAMBERTIAN,0.10,0.0)),
-    sphere(vec3(4.65,0.20,-8.72), 0.2, vec3(0.03,0.18,0.64), vec3(TEXTURE_LAMBERTIAN,0.90,0.0)),
-    sphere(vec3(4.30,0.20,-7.70), 0.2, vec3(0.85,0.86,0.36), vec3(TEXTURE_LAMBERTIAN,0.98,0.0)),
-    sphere(vec3(4.19,0.20,-6.20), 0.2, vec3(0.60,0.16,0.62), vec3(TEXTURE_LAMBERTIAN,0.83,0.0)),
-    sphere(vec3(4.81,0.20,-5.37), 0.2, vec3(0.47,0.60,0.83), vec3(TEXTURE_LAMBERTIAN,0.05,0.0)),
-    sphere(vec3(4.54,0.20,-4.29), 0.2, vec3(0.04,0.60,0.21), vec3(TEXTURE_LAMBERTIAN,0.97,0.0)),
-    sphere(vec3(4.21,0.20,-3.89), 0.2, vec3(0.22,0.36,0.82), vec3(TEXTURE_LAMBERTIAN,0.29,0.0)),
-    sphere(vec3(4.37,0.20,-2.72), 0.2, vec3(0.02,0.08,0.85), vec3(TEXTURE_LAMBERTIAN,0.74,0.0)),
-    sphere(vec3(4.33,0.20,-1.16), 0.2, vec3(0.55,0.46,0.61), vec3(TEXTURE_LAMBERTIAN,0.91,0.0)),
-    sphere(vec3(4.84,0.20,0.68), 0.2, vec3(1.00,0.40,0.60), vec3(TEXTURE_LAMBERTIAN,0.10,0.0)),
-    sphere(vec3(4.17,0.20,1.27), 0.2, vec3(0.31,0.74,0.23), vec3(TEXTURE_LAMBERTIAN,0.17,0.0)),
-    sphere(vec3(4.63,0.20,2.70), 0.2, vec3(0.90,0.16,0.76), vec3(TEXTURE_METAL,0.86,0.0)),
-    sphere(vec3(4.27,0.20,3.60), 0.2, vec3(0.83,0.09,0.56), vec3(TEXTURE_LAMBERTIAN,0.69,0.0)),
-    sphere(vec3(4.27,0.20,4.20), 0.2, vec3(0.37,0.41,0.06), vec3(TEXTURE_LAMBERTIAN,0.31,0.0)),
-    sphere(vec3(4.21,0.20,5.52), 0.2, vec3(0.22,0.17,0.26), vec3(TEXTURE_METAL,0.49,0.0)),
-    sphere(vec3(4.10,0.20,6.75), 0.2, vec3(0.23,0.81,0.48), vec3(TEXTURE_METAL,0.45,0.0)),
-    sphere(vec3(4.21,0.20,7.34), 0.2, vec3(0.67,0.23,0.36), vec3(TEXTURE_LAMBERTIAN,0.21,0.0)),
-    sphere(vec3(4.02,0.20,8.45), 0.2, vec3(0.65,0.00,0.84), vec3(TEXTURE_METAL,0.58,0.0)),
-    sphere(vec3(4.21,0.20,9.35), 0.2, vec3(0.75,0.24,0.38), vec3(TEXTURE_METAL,0.11,0.0)),
-    sphere(vec3(4.82,0.20,10.19), 0.2, vec3(0.72,0.26,0.95), vec3(TEXTURE_METAL,0.15,0.0)),
-    sphere(vec3(5.31,0.20,-10.45), 0.2, vec3(0.91,0.39,0.59), vec3(TEXTURE_LAMBERTIAN,0.10,0.0)),
-    sphere(vec3(5.78,0.20,-9.84), 0.2, vec3(0.90,0.73,0.99), vec3(TEXTURE_LAMBERTIAN,0.83,0.0)),
-    sphere(vec3(5.12,0.20,-8.71), 0.2, vec3(0.87,0.30,0.87), vec3(TEXTURE_METAL,0.91,0.0)),
-    sphere(vec3(5.41,0.20,-7.82), 0.2, vec3(0.18,0.30,0.82), vec3(TEXTURE_LAMBERTIAN,0.75,0.0)),
-    sphere(vec3(5.07,0.20,-6.53), 0.2, vec3(0.65,0.17,0.14), vec3(TEXTURE_LAMBERTIAN,0.91,0.0)),
-    sphere(vec3(5.89,0.20,-5.95), 0.2, vec3(0.92,0.65,0.01), vec3(TEXTURE_LAMBERTIAN,0.94,0.0)),
-    sphere(vec3(5.15,0.20,-4.88), 0.2, vec3(0.56,0.87,0.82), vec3(TEXTURE_LAMBERTIAN,0.92,0.0)),
-    sphere(vec3(5.27,0.20,-3.46), 0.2, vec3(0.11,0.75,0.79), vec3(TEXTURE_LAMBERTIAN,0.43,0.0)),
-    sphere(vec3(5.46,0.20,-2.83), 0.2, vec3(0.45,0.35,0.41), vec3(TEXTURE_LAMBERTIAN,0.23,0.0)),
-    sphere(vec3(5.70,0.20,-1.77), 0.2, vec3(0.85,0.66,0.95), vec3(TEXTURE_LAMBERTIAN,0.80,0.0)),
-    sphere(vec3(5.43,0.20,-0.70), 0.2, vec3(0.17,0.65,0.48), vec3(TEXTURE_METAL,0.34,0.0)),
-    sphere(vec3(5.72,0.20,0.39), 0.2, vec3(0.86,0.40,0.53), vec3(TEXTURE_LAMBERTIAN,0.67,0.0)),
-    sphere(vec3(5.09,0.20,1.72), 0.2, vec3(0.66,0.60,0.89), vec3(TEXTURE_LAMBERTIAN,0.65,0.0)),
-    sphere(vec3(5.54,0.20,2.48), 0.2, vec3(0.31,0.61,0.23), vec3(TEXTURE_LAMBERTIAN,0.71,0.0)),
-    sphere(vec3(5.51,0.20,3.39), 0.2, vec3(0.84,0.09,0.36), vec3(TEXTURE_LAMBERTIAN,0.25,0.0)),
-    sphere(vec3(5.19,0.20,4.02), 0.2, vec3(0.96,0.27,0.60), vec3(TEXTURE_LAMBERTIAN,0.13,0.0)),
-    sphere(vec3(5.37,0.20,5.20), 0.2, vec3(0.92,0.38,0.44), vec3(TEXTURE_LAMBERTIAN,0.05,0.0)),
-    sphere(vec3(5.06,0.20,6.78), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(5.36,0.20,7.62), 0.2, vec3(0.42,0.19,0.46), vec3(TEXTURE_LAMBERTIAN,0.80,0.0)),
-    sphere(vec3(5.86,0.20,8.33), 0.2, vec3(0.07,0.80,0.20), vec3(TEXTURE_METAL,0.64,0.0)),
-    sphere(vec3(5.41,0.20,9.20), 0.2, vec3(0.16,0.20,0.74), vec3(TEXTURE_METAL,0.81,0.0)),
-    sphere(vec3(5.38,0.20,10.19), 0.2, vec3(0.59,0.48,0.59), vec3(TEXTURE_LAMBERTIAN,0.07,0.0)),
-    sphere(vec3(6.85,0.20,-10.13), 0.2, vec3(0.32,0.44,0.64), vec3(TEXTURE_LAMBERTIAN,0.92,0.0)),
-    sphere(vec3(6.18,0.20,-9.44), 0.2, vec3(0.96,0.52,0.09), vec3(TEXTURE_LAMBERTIAN,0.39,0.0)),
-    sphere(vec3(6.72,0.20,-8.64), 0.2, vec3(0.23,0.86,0.77), vec3(TEXTURE_LAMBERTIAN,0.71,0.0)),
-    sphere(vec3(6.53,0.20,-7.99), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(6.27,0.20,-6.77), 0.2, vec3(0.63,0.00,0.07), vec3(TEXTURE_METAL,0.69,0.0)),
-    sphere(vec3(6.72,0.20,-5.87), 0.2, vec3(0.87,0.04,0.03), vec3(TEXTURE_LAMBERTIAN,0.13,0.0)),
-    sphere(vec3(6.07,0.20,-4.92), 0.2, vec3(0.63,0.31,0.99), vec3(TEXTURE_LAMBERTIAN,0.03,0.0)),
-    sphere(vec3(6.51,0.20,-3.65), 0.2, vec3(0.26,0.26,0.59), vec3(TEXTURE_LAMBERTIAN,0.99,0.0)),
-    sphere(vec3(6.32,0.20,-2.99), 0.2, vec3(0.59,0.23,0.90), vec3(TEXTURE_METAL,0.12,0.0)),
-    sphere(vec3(6.18,0.20,-1.85), 0.2, vec3(0.65,0.53,0.39), vec3(TEXTURE_LAMBERTIAN,0.96,0.0)),
-    sphere(vec3(6.78,0.20,-0.86), 0.2, vec3(0.01,0.47,0.59), vec3(TEXTURE_LAMBERTIAN,0.44,0.0)),
-    sphere(vec3(6.58,0.20,0.86), 0.2, vec3(0.12,0.56,0.54), vec3(TEXTURE_LAMBERTIAN,0.24,0.0)),
-    sphere(vec3(6.30,0.20,1.54), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(6.48,0.20,2.50), 0.2, vec3(0.42,0.98,0.36), vec3(TEXTURE_LAMBERTIAN,0.77,0.0)),
-    sphere(vec3(6.10,0.20,3.54), 0.2, vec3(0.49,0.42,0.10), vec3(TEXTURE_LAMBERTIAN,0.18,0.0)),
-    sphere(vec3(6.07,0.20,4.63), 0.2, vec3(0.70,0.55,0.85), vec3(TEXTURE_METAL,0.72,0.0)),
-    sphere(vec3(6.10,0.20,5.05), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(6.59,0.20,6.73), 0.2, vec3(0.95,0.26,0.21), vec3(TEXTURE_LAMBERTIAN,0.22,0.0)),
-    sphere(vec3(6.88,0.20,7.13), 0.2, vec3(0.67,0.21,0.93), vec3(TEXTURE_METAL,0.77,0.0)),
-    sphere(vec3(6.30,0.20,8.20), 0.2, vec3(0.84,0.23,0.72), vec3(TEXTURE_LAMBERTIAN,0.70,0.0)),
-    sphere(vec3(6.05,0.20,9.05), 0.2, vec3(0.97,0.90,0.25), vec3(TEXTURE_LAMBERTIAN,0.65,0.0)),
-    sphere(vec3(6.70,0.20,10.53), 0.2, vec3(0.28,0.51,0.91), vec3(TEXTURE_LAMBERTIAN,0.97,0.0)),
-    sphere(vec3(7.58,0.20,-10.59), 0.2, vec3(0.64,0.22,0.93), vec3(TEXTURE_LAMBERTIAN,0.97,0.0)),
-    sphere(vec3(7.82,0.20,-9.15), 0.2, vec3(0.87,0.39,0.64), vec3(TEXTURE_LAMBERTIAN,0.02,0.0)),
-    sphere(vec3(7.30,0.20,-8.27), 0.2, vec3(0.82,0.39,0.60), vec3(TEXTURE_LAMBERTIAN,0.62,0.0)),
-    sphere(vec3(7.82,0.20,-7.14), 0.2, vec3(0.21,0.81,0.66), vec3(TEXTURE_LAMBERTIAN,0.79,0.0)),
-    sphere(vec3(7.12,0.20,-6.31), 0.2, vec3(0.31,0.53,0.34), vec3(TEXTURE_LAMBERTIAN,0.14,0.0)),
-    sphere(vec3(7.18,0.20,-5.22), 0.2, vec3(0.79,0.49,0.61), vec3(TEXTURE_LAMBERTIAN,0.24,0.0)),
-    sphere(vec3(7.21,0.20,-4.91), 0.2, vec3(0.73,0.08,0.47), vec3(TEXTURE_LAMBERTIAN,0.70,0.0)),
-    sphere(vec3(7.77,0.20,-3.16), 0.2, vec3(0.82,0.41,0.19), vec3(TEXTURE_LAMBERTIAN,0.87,0.0)),
-    sphere(vec3(7.70,0.20,-2.26), 0.2, vec3(0.75,0.60,0.99), vec3(TEXTURE_METAL,0.17,0.0)),
-    sphere(vec3(7.28,0.20,-1.85), 0.2, vec3(0.60,0.58,0.94), vec3(TEXTURE_LAMBERTIAN,0.77,0.0)),
-    sphere(vec3(7.22,0.20,-0.70), 0.2, vec3(0.75,0.04,0.02), vec3(TEXTURE_LAMBERTIAN,0.91,0.0)),
-    sphere(vec3(7.59,0.20,0.19), 0.2, vec3(0.88,0.95,0.97), vec3(TEXTURE_LAMBERTIAN,0.52,0.0)),
-    sphere(vec3(7.34,0.20,1.24), 0.2, vec3(0.83,0.43,0.29), vec3(TEXTURE_LAMBERTIAN,0.16,0.0)),
-    sphere(vec3(7.81,0.20,2.39), 0.2, vec3(0.57,0.44,0.46), vec3(TEXTURE_LAMBERTIAN,0.46,0.0)),
-    sphere(vec3(7.04,0.20,3.56), 0.2, vec3(0.03,0.03,0.12), vec3(TEXTURE_METAL,0.89,0.0)),
-    sphere(vec3(7.57,0.20,4.58), 0.2, vec3(0.20,0.84,0.32), vec3(TEXTURE_LAMBERTIAN,0.49,0.0)),
-    sphere(vec3(7.46,0.20,5.54), 0.2, vec3(0.23,0.38,0.87), vec3(TEXTURE_LAMBERTIAN,0.36,0.0)),
-    sphere(vec3(7.40,0.20,6.38), 0.2, vec3(0.06,0.92,0.98), vec3(TEXTURE_LAMBERTIAN,0.26,0.0)),
-    sphere(vec3(7.13,0.20,7.37), 0.2, vec3(0.10,0.53,0.81), vec3(TEXTURE_LAMBERTIAN,0.41,0.0)),
-    sphere(vec3(7.73,0.20,8.15), 0.2, vec3(0.74,0.03,0.46), vec3(TEXTURE_LAMBERTIAN,0.46,0.0)),
-    sphere(vec3(7.33,0.20,9.31), 0.2, vec3(0.97,0.92,0.58), vec3(TEXTURE_LAMBERTIAN,0.84,0.0)),
-    sphere(vec3(7.04,0.20,10.57), 0.2, vec3(0.10,0.05,0.61), vec3(TEXTURE_LAMBERTIAN,0.07,0.0)),
-    sphere(vec3(8.21,0.20,-10.64), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(8.80,0.20,-9.93), 0.2, vec3(0.02,0.23,0.75), vec3(TEXTURE_LAMBERTIAN,0.16,0.0)),
-    sphere(vec3(8.03,0.20,-8.85), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(8.51,0.20,-7.59), 0.2, vec3(0.32,0.24,0.43), vec3(TEXTURE_LAMBERTIAN,0.46,0.0)),
-    sphere(vec3(8.03,0.20,-6.98), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(8.42,0.20,-5.69), 0.2, vec3(0.10,0.44,0.91), vec3(TEXTURE_LAMBERTIAN,0.20,0.0)),
-    sphere(vec3(8.42,0.20,-4.39), 0.2, vec3(0.39,0.85,0.26), vec3(TEXTURE_LAMBERTIAN,0.38,0.0)),
-    sphere(vec3(8.43,0.20,-3.43), 0.2, vec3(0.56,0.63,0.11), vec3(TEXTURE_LAMBERTIAN,0.57,0.0)),
-    sphere(vec3(8.12,0.20,-3.00), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(8.68,0.20,-1.15), 0.2, vec3(0.84,0.54,0.75), vec3(TEXTURE_LAMBERTIAN,0.99,0.0)),
-    sphere(vec3(8.24,0.20,-0.15), 0.2, vec3(0.20,0.19,0.07), vec3(TEXTURE_LAMBERTIAN,0.01,0.0)),
-    sphere(vec3(8.41,0.20,0.53), 0.2, vec3(0.89,0.95,0.20), vec3(TEXTURE_METAL,0.92,0.0)),
-    sphere(vec3(8.23,0.20,1.67), 0.2, vec3(0.79,0.51,0.55), vec3(TEXTURE_METAL,0.92,0.0)),
-    sphere(vec3(8.76,0.20,2.66), 0.2, vec3(0.98,0.82,0.63), vec3(TEXTURE_LAMBERTIAN,0.66,0.0)),
-    sphere(vec3(8.20,0.20,3.70), 0.2, vec3(0.14,0.84,0.73), vec3(TEXTURE_METAL,0.45,0.0)),
-    sphere(vec3(8.20,0.20,4.84), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(8.00,0.20,5.33), 0.2, vec3(0.73,0.77,0.46), vec3(TEXTURE_METAL,0.93,0.0)),
-    sphere(vec3(8.54,0.20,6.42), 0.2, vec3(0.62,0.10,0.53), vec3(TEXTURE_METAL,0.22,0.0)),
-    sphere(vec3(8.69,0.20,7.80), 0.2, vec3(0.19,0.33,0.37), vec3(TEXTURE_LAMBERTIAN,0.80,0.0)),
-    sphere(vec3(8.83,0.20,8.22), 0.2, vec3(0.93,0.52,0.40), vec3(TEXTURE_LAMBERTIAN,0.36,0.0)),
-    sphere(vec3(8.17,0.20,9.13), 0.2, vec3(0.27,0.78,0.08), vec3(TEXTURE_LAMBERTIAN,0.49,0.0)),
-    sphere(vec3(8.16,0.20,10.58), 0.2, vec3(0.16,0.17,0.54), vec3(TEXTURE_LAMBERTIAN,0.36,0.0)),
-    sphere(vec3(9.18,0.20,-10.39), 0.2, vec3(0.01,0.06,0.87), vec3(TEXTURE_LAMBERTIAN,0.88,0.0)),
-    sphere(vec3(9.41,0.20,-9.56), 0.2, vec3(0.88,0.16,0.20), vec3(TEXTURE_LAMBERTIAN,0.28,0.0)),
-    sphere(vec3(9.67,0.20,-8.10), 0.2, vec3(0.20,0.83,0.47), vec3(TEXTURE_LAMBERTIAN,0.75,0.0)),
-    sphere(vec3(9.19,0.20,-7.41), 0.2, vec3(0.92,0.08,0.20), vec3(TEXTURE_METAL,0.64,0.0)),
-    sphere(vec3(9.51,0.20,-6.75), 0.2, vec3(0.51,0.76,0.42), vec3(TEXTURE_LAMBERTIAN,0.80,0.0)),
-    sphere(vec3(9.08,0.20,-5.41), 0.2, vec3(0.81,0.22,0.65), vec3(TEXTURE_LAMBERTIAN,0.71,0.0)),
-    sphere(vec3(9.16,0.20,-4.29), 0.2, vec3(0.29,0.07,0.66), vec3(TEXTURE_METAL,0.85,0.0)),
-    sphere(vec3(9.25,0.20,-3.11), 0.2, vec3(0.45,0.02,0.13), vec3(TEXTURE_LAMBERTIAN,0.92,0.0)),
-    sphere(vec3(9.31,0.20,-2.35), 0.2, vec3(0.91,0.07,0.35), vec3(TEXTURE_LAMBERTIAN,0.09,0.0)),
-    sphere(vec3(9.79,0.20,-1.23), 0.2, vec3(0.90,0.87,0.90), vec3(TEXTURE_LAMBERTIAN,0.85,0.0)),
-    sphere(vec3(9.89,0.20,-0.25), 0.2, vec3(0.63,0.39,0.87), vec3(TEXTURE_LAMBERTIAN,0.91,0.0)),
-    sphere(vec3(9.30,0.20,0.78), 0.2, vec3(0.66,0.97,0.30), vec3(TEXTURE_LAMBERTIAN,0.93,0.0)),
-    sphere(vec3(9.04,0.20,1.18), 0.2, vec3(0.54,0.13,0.87), vec3(TEXTURE_LAMBERTIAN,0.15,0.0)),
-    sphere(vec3(9.12,0.20,2.42), 0.2, vec3(0.73,0.41,0.22), vec3(TEXTURE_LAMBERTIAN,0.20,0.0)),
-    sphere(vec3(9.75,0.20,3.79), 0.2, vec3(0.57,0.72,0.46), vec3(TEXTURE_LAMBERTIAN,0.48,0.0)),
-    sphere(vec3(9.65,0.20,4.15), 0.2, vec3(0.53,0.11,0.55), vec3(TEXTURE_METAL,0.97,0.0)),
-    sphere(vec3(9.78,0.20,5.84), 0.2, vec3(0.16,0.30,0.61), vec3(TEXTURE_LAMBERTIAN,0.98,0.0)),
-    sphere(vec3(9.16,0.20,6.67), 0.2, vec3(0.80,0.86,0.00), vec3(TEXTURE_LAMBERTIAN,0.06,0.0)),
-    sphere(vec3(9.80,0.20,7.49), 0.2, vec3(0.23,0.25,0.94), vec3(TEXTURE_LAMBERTIAN,0.32,0.0)),
-    sphere(vec3(9.20,0.20,8.08), 0.2, vec3(0.08,0.52,0.94), vec3(TEXTURE_LAMBERTIAN,0.62,0.0)),
-    sphere(vec3(9.11,0.20,9.34), 0.2, vec3(0.12,0.27,0.40), vec3(TEXTURE_LAMBERTIAN,0.70,0.0)),
-    sphere(vec3(9.42,0.20,10.87), 0.2, vec3(0.12,0.02,0.45), vec3(TEXTURE_METAL,0.52,0.0)),
-    sphere(vec3(10.88,0.20,-10.33), 0.2, vec3(0.95,0.61,0.77), vec3(TEXTURE_LAMBERTIAN,0.99,0.0)),
-    sphere(vec3(10.29,0.20,-9.96), 0.2, vec3(0.69,0.94,0.64), vec3(TEXTURE_METAL,0.18,0.0)),
-    sphere(vec3(10.01,0.20,-8.44), 0.2, vec3(0.56,0.68,0.21), vec3(TEXTURE_LAMBERTIAN,0.84,0.0)),
-    sphere(vec3(10.85,0.20,-7.86), 0.2, vec3(0.80,0.38,0.91), vec3(TEXTURE_METAL,0.93,0.0)),
-    sphere(vec3(10.15,0.20,-6.15), 0.2, vec3(0.38,0.96,0.25), vec3(TEXTURE_LAMBERTIAN,0.37,0.0)),
-    sphere(vec3(10.01,0.20,-5.18), 0.2, vec3(0.34,0.91,0.08), vec3(TEXTURE_LAMBERTIAN,0.03,0.0)),
-    sphere(vec3(10.33,0.20,-4.42), 0.2, vec3(0.18,0.16,0.76), vec3(TEXTURE_LAMBERTIAN,0.03,0.0)),
-    sphere(vec3(10.25,0.20,-3.22), 0.2, vec3(0.72,0.80,0.73), vec3(TEXTURE_LAMBERTIAN,0.11,0.0)),
-    sphere(vec3(10.46,0.20,-2.62), 0.2, vec3(0.77,0.73,0.39), vec3(TEXTURE_METAL,0.09,0.0)),
-    sphere(vec3(10.45,0.20,-1.36), 0.2, vec3(0.48,0.90,0.29), vec3(TEXTURE_LAMBERTIAN,0.44,0.0)),
-    sphere(vec3(10.63,0.20,-0.59), 0.2, vec3(0.58,0.58,0.61), vec3(TEXTURE_LAMBERTIAN,0.95,0.0)),
-    sphere(vec3(10.12,0.20,0.64), 0.2, vec3(0.90,0.78,0.12), vec3(TEXTURE_LAMBERTIAN,0.17,0.0)),
-    sphere(vec3(10.39,0.20,1.30), 0.2, vec3(0.55,0.47,0.98), vec3(TEXTURE_METAL,0.40,0.0)),
-    sphere(vec3(10.82,0.20,2.46), 0.2, vec3(0.02,0.90,0.91), vec3(TEXTURE_LAMBERTIAN,0.35,0.0)),
-    sphere(vec3(10.78,0.20,3.44), 0.2, vec3(0.86,0.49,0.34), vec3(TEXTURE_LAMBERTIAN,0.18,0.0)),
-    sphere(vec3(10.20,0.20,4.73), 0.2, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(10.73,0.20,5.41), 0.2, vec3(0.33,0.15,0.72), vec3(TEXTURE_LAMBERTIAN,0.55,0.0)),
-    sphere(vec3(10.36,0.20,6.43), 0.2, vec3(0.21,0.57,0.34), vec3(TEXTURE_LAMBERTIAN,0.23,0.0)),
-    sphere(vec3(10.34,0.20,7.48), 0.2, vec3(0.99,0.21,0.48), vec3(TEXTURE_LAMBERTIAN,0.25,0.0)),
-    sphere(vec3(10.13,0.20,8.04), 0.2, vec3(0.70,0.78,0.87), vec3(TEXTURE_LAMBERTIAN,0.15,0.0)),
-    sphere(vec3(10.16,0.20,9.03), 0.2, vec3(0.54,0.00,0.81), vec3(TEXTURE_LAMBERTIAN,0.39,0.0)),
-    sphere(vec3(10.80,0.20,10.66), 0.2, vec3(0.37,0.86,0.91), vec3(TEXTURE_METAL,0.36,0.0)),
-
-    sphere(vec3(0, 1, 0),1.0, vec3(1.0,1.0,1.0), vec3(TEXTURE_GLASS,1.5,0.0)),
-    sphere(vec3(-4, 1, 0),1.0, vec3(0.4, 0.2, 0.1), vec3(TEXTURE_LAMBERTIAN,1.0,0.0)),
-    sphere(vec3(4, 1, 0),1.0, vec3(0.7, 0.6, 0.5), vec3(TEXTURE_METAL,1.0,0.0)),
-
-    sphere(vec3(0,-1000,0),1000, vec3(0.5, 0.5, 0.5), vec3(TEXTURE_LAMBERTIAN,1.0,0.0)),
+// World, uploaded from a scene file. Intersection only reads the spheres, 16 bytes each.
+layout (std430, set = 0, binding = 2) readonly buffer SceneSpheres {
+    vec4 spheres[];     // Center, radius.
 };
-
+layout (std430, set = 0, binding = 3) readonly buffer SceneMaterials {
+    scene_material materials[];
+};
+layout (std430, set = 0, binding = 4) readonly buffer SceneBvhNodes {
+    bvh_node bvh_nodes[];
+};
+layout (std430, set = 0, binding = 5) readonly buffer SceneBvhIndices {
+    uint bvh_indices[];
+};
+// Per sphere, MATERIAL_ID_BITS wide, see sphere_material().
+layout (std430, set = 0, binding = 6) readonly buffer SceneSphereMaterials {
+    uint sphere_materials[];
+};
+// Top level: leaves cover instances [left_or_first, left_or_first + count).
+layout (std430, set = 0, binding = 7) readonly buffer SceneInstances {
+    scene_instance instances[];
+};
+layout (std430, set = 0, binding = 8) readonly buffer SceneTlasNodes {
+    bvh_node tlas_nodes[];
+};
+#ifdef USE_RAY_QUERY
+// Hardware TLAS over the same instances, replaces walking the BVHs above.
+layout (set = 0, binding = 9) uniform accelerationStructureEXT scene_acceleration_structure;
+#endif
+// Per texel & stratum, written by samples [0, FIRST_HIT_STRATA) after every restart, read after.
+layout (std430, set = 0, binding = 10) buffer FirstHitCache {
+    uvec4 first_hits[];
+};
+// Tile culling: candidate count per tile, then TILE_CANDIDATE_CAPACITY (instance, sphere) pairs per tile.
+// Counts above the capacity mark overflowed tiles.
+layout (std430, set = 0, binding = 11) buffer TileCulling {
+    uint tile_data[];
+};
+#ifdef USE_PERSISTENT_THREADS
+// Next pixel of the dispatch to hand out, zeroed before every dispatch.
+layout (std430, set = 0, binding = 12) buffer WorkQueue {
+    uint next_work_item;
+};
+#endif
@@ -5,14 +5,39 @@
 
 */
 
-precision mediump float;
+// Precision qualifiers do nothing in Vulkan GLSL. Shading math that tolerates half precision (path
+// throughput, Schlick, random directions) uses these instead, half floats in the USE_FLOAT16 variant.
+// Intersection math always stays fp32.
+#ifdef USE_FLOAT16
+#define shading_float float16_t
+#define shading_vec3 f16vec3
+#else
+#define shading_float float
+#define shading_vec3 vec3
+#endif
 
-struct sphere {
-    vec3 center;
-    float radius;
-    vec3 colour;
-    vec3 texture;   // texture.x: texture type (diffuse/metal/glass)
-                    // texture.y: texture param1(reflect ratio in diffuse, fuzzness in metal, eta in glass)
+// Scene records, must match the Render* records in Scene.cpp & SceneBvhNode in SceneFormat.hpp.
+// Spheres are vec4(center, radius), their material IDs live in their own buffer.
+struct scene_material {
+    uint albedo_rg;     // Half floats, see load_material().
+    uint albedo_b_type; // Low half: albedo blue, high half: texture type (diffuse/metal/glass)
+    float parameter;    // reflect ratio in diffuse, fuzzness in metal, eta in glass
+};
+
+struct bvh_node {
+    vec3 bounds_min;
+    uint left_or_first;     // Interior: left child, right child follows. Leaf: first BVH index.
+    vec3 bounds_max;
+    uint count;             // 0 for interior nodes.
+};
+
+// Instance as written by Scene.cpp, rows of the affine world to object transform.
+struct scene_instance {
+    vec4 world_to_object[3];
+    uint geometry;          // Root node of its bottom level BVH.
+    uint first_sphere;      // Spheres of the geometry, for the linear scan.
+    uint sphere_count;
+    uint padding0;
 };
 
 struct ray {
@@ -25,7 +50,10 @@ struct hit_record {
     vec3 normal;
     float min_t;
     float max_t;
-    vec3 texture;
+    uint sphere;    // Closest sphere, its material is only looked up once the hit is final.
+    uint material;
+    vec3 texture;   // texture.x: texture type (diffuse/metal/glass)
+                    // texture.y: texture param1(reflect ratio in diffuse, fuzzness in metal, eta in glass)
     vec3 colour;
 };
 
@@ -11,20 +11,21 @@
 #define TEXTURE_METAL 2
 #define TEXTURE_GLASS 3
 
-vec3 random_in_unit_sphere(vec3 seed);
+shading_vec3 random_in_unit_sphere();
 bool modified_refract(const in vec3 v, const in vec3 n, const in float ni_over_nt, out vec3 refracted);
-float schlick(float cosine, float ior);
-float rand(vec2 co);
+shading_float schlick(shading_float cosine, shading_float ior);
+float random_float();
 
-void texture_lambertian(hit_record record, inout vec3 colour, inout ray generated_ray) {
+// colour: throughput of the path, attenuated by the material.
+void texture_lambertian(hit_record record, inout shading_vec3 colour, inout ray generated_ray) {
     //   direction = -faceforward(direction, global_hit_record.normal, direction);
-    vec3 direction = record.normal+random_in_unit_sphere(generated_ray.direction);
-    colour = colour*record.colour*record.texture.y;
+    vec3 direction = record.normal+vec3(random_in_unit_sphere());
+    colour = colour*shading_vec3(record.colour)*shading_float(record.texture.y);
     generated_ray.origin = record.point;
     generated_ray.direction = direction;
 }
 
-void texture_glass(hit_record record, inout vec3 colour, inout ray generated_ray) {
+void texture_glass(hit_record record, inout shading_vec3 colour, inout ray generated_ray) {
         vec3 outward_normal, refracted;
         vec3 reflected = reflect(generated_ray.direction, record.normal);
         float ni_over_nt, reflect_prob, cosine;
@@ -41,31 +42,36 @@ void texture_glass(hit_record record, inout vec3 colour, inout ray generated_ray
         }
 
         if (modified_refract(generated_ray.direction, outward_normal, ni_over_nt, refracted)) {
-	        reflect_prob = schlick(cosine, record.texture.y);
+	        reflect_prob = float(schlick(shading_float(cosine), shading_float(record.texture.y)));
         } else {
             reflect_prob = 1.;
         }
 
         generated_ray.origin = record.point;
 
-        if (rand(record.point.xy) < reflect_prob) {
+        if (random_float() < reflect_prob) {
             generated_ray.direction = reflected;
         } else {
             generated_ray.direction = refracted;
         }
 }
 
-void texture_metal(hit_record record, inout vec3 colour, inout ray generated_ray) {
-    vec3 direction = reflect(generated_ray.direction,record.normal)+record.texture.y*random_in_unit_sphere(generated_ray.direction);
-    colour = colour*record.colour;
+void texture_metal(hit_record record, inout shading_vec3 colour, inout ray generated_ray) {
+    vec3 direction = reflect(generated_ray.direction,record.normal)+record.texture.y*vec3(random_in_unit_sphere());
+    colour = colour*shading_vec3(record.colour);
     generated_ray.origin = record.point;
     generated_ray.direction = direction;
 }
 
-void texture_dispatcher(hit_record record, inout vec3 colour, inout ray generated_ray) {
-    switch(int(record.texture.x)) {
-        case TEXTURE_LAMBERTIAN:texture_lambertian(record,colour,generated_ray);break;
-        case TEXTURE_METAL:texture_metal(record,colour,generated_ray);break;
-        case TEXTURE_GLASS:texture_glass(record,colour,generated_ray);break;
+// Branches of material types the scene lacks fold away on specialization.
+void texture_dispatcher(hit_record record, inout shading_vec3 colour, inout ray generated_ray) {
+    count_cost(COST_BOUNCE);
+    int type = int(record.texture.x);
+    if ((MATERIAL_TYPES & (1u << TEXTURE_LAMBERTIAN)) != 0 && type == TEXTURE_LAMBERTIAN) {
+        texture_lambertian(record,colour,generated_ray);
+    } else if ((MATERIAL_TYPES & (1u << TEXTURE_METAL)) != 0 && type == TEXTURE_METAL) {
+        texture_metal(record,colour,generated_ray);
+    } else if ((MATERIAL_TYPES & (1u << TEXTURE_GLASS)) != 0 && type == TEXTURE_GLASS) {
+        texture_glass(record,colour,generated_ray);
     }
 }
@@ -11,5 +11,7 @@ layout (location = 0) out vec4 outColor;
 layout (set = 0, binding = 1) uniform sampler2D OutputImage;
 
 void main() {
-    outColor = texelFetch(OutputImage, ivec2(gl_FragCoord.xy), 0);
+    // RGB sums & sample count, or the resolved display image with an alpha of 1.
+    vec4 accumulated = texelFetch(OutputImage, ivec2(gl_FragCoord.xy), 0);
+    outColor = vec4(accumulated.rgb / max(accumulated.a, 1.0), 1.0);
 }